@@ -0,0 +1,94 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include <Vulkano/VulkanContext.hpp>
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Benchmarks {
+    /// @brief Create an instance and device without a surface or validation (validation skews CPU timings)
+    Vulkano::Result<void> CreateHeadlessContext(Vulkano::VulkanContext& context);
+
+    /// @brief Create an instance with VK_EXT_headless_surface, a headless surface and a device that can present to it.
+    /// The caller destroys the surface before shutting the context down.
+    Vulkano::Result<VkSurfaceKHR> CreateHeadlessSurfaceContext(Vulkano::VulkanContext& context);
+
+    /// @brief Parse a positive integer argument, or return the fallback if it is missing or invalid
+    unsigned ParseCount(std::span<char*> args, size_t index, unsigned fallback);
+
+    /// @brief Summary of a set of timing samples, in whatever unit they were taken
+    struct Timings {
+        double mean {0.0};
+        double median {0.0};
+        double max {0.0};
+    };
+
+    /// @brief Summarize timing samples (sorts them in place); all zero if there are none
+    Timings Summarize(std::vector<double>& samples);
+
+    /// @brief Bind+dispatch throughput of classic descriptor sets, push descriptors and descriptor buffers
+    /// @param args [draws per frame] [frames]
+    int RunDescriptorBenchmark(std::span<char*> args);
+
+    /// @brief GPU frustum culling over a persistent instance buffer; prints draw counts before and after culling
+    /// @param args [instances] [frames]
+    int RunCullingBenchmark(std::span<char*> args);
+
+    /// @brief SIMD CPU frustum culling and LOD selection against the scalar path, single- and multi-threaded
+    /// @param args [instances] [frames]
+    int RunCpuCullingBenchmark(std::span<char*> args);
+
+    /// @brief Mesh ingest on generated sample meshes: vertex shader invocations and bytes before and after
+    /// @param args [cache size]
+    int RunMeshBenchmark(std::span<char*> args);
+
+    /// @brief Triangles per second of the meshlet renderer's mesh shader path (culled and unculled) and its
+    /// multi-draw indirect fallback on a grid of dense spheres
+    /// @param args [grid size] [frames]
+    int RunMeshletBenchmark(std::span<char*> args);
+
+    /// @brief Sprites per millisecond of CPU (add, sort and pack) and GPU time for the sprite batcher, drawing
+    /// randomly textured and layered sprites in one instanced draw
+    /// @param args [sprites] [frames]
+    int RunSpriteBenchmark(std::span<char*> args);
+
+    /// @brief Frame time of a million-particle fountain simulated on the compute queue and drawn indirectly, with the
+    /// CPU cost of Simulate (which must not grow with the particle count)
+    /// @param args [particles] [frames]
+    int RunParticleBenchmark(std::span<char*> args);
+
+    /// @brief Measures a fill-bound load at full resolution, then lowers the GPU time target and reports how the
+    /// dynamic resolution scale converges
+    /// @param args [layers] [frames]
+    int RunDynamicResolutionBenchmark(std::span<char*> args);
+
+    /// @brief Swapchain recreate latency on a headless surface: the previous full vk-bootstrap rebuild against
+    /// SwapchainManager::Recreate's capabilities-only path
+    /// @param args [iterations]
+    int RunRecreateBenchmark(std::span<char*> args);
+
+    /// @brief Latency of frames that finish in compute: hopping to the present queue (semaphore plus ownership
+    /// transfer) against presenting from the compute queue
+    /// @param args [frames]
+    int RunComputePresentBenchmark(std::span<char*> args);
+
+    /// @brief Rendering the same draws into every layer of a layered target: one pass per layer against a single
+    /// multiview pass, comparing recording time and GPU time
+    /// @param args [views] [draws] [frames]
+    int RunMultiviewBenchmark(std::span<char*> args);
+
+    /// @brief Cost of GPU hang breadcrumbs: the same frame of barrier-separated passes with and without markers at
+    /// every pass boundary
+    /// @param args [passes] [frames]
+    int RunBreadcrumbBenchmark(std::span<char*> args);
+
+    /// @brief Time to recover from device loss with VulkanContext::RecoverDevice (swapchain, frame synchronizer and
+    /// breadcrumbs registered) against creating the context and those objects from scratch
+    /// @param args [iterations]
+    int RunRecoveryBenchmark(std::span<char*> args);
+}  // namespace Benchmarks
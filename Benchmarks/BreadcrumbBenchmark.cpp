@@ -0,0 +1,180 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Benchmarks.hpp"
+
+#include <Vulkano/Breadcrumbs.hpp>
+#include <Vulkano/Buffer.hpp>
+#include <Vulkano/FrameSynchronizer.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Benchmarks {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+        using Vulkano::u32;
+        using Vulkano::u64;
+
+        constexpr u32 kFramesInFlight {2};
+        constexpr VkDeviceSize kPassBytes {256 * 1024};  // Each pass fills its own slice of the scratch buffer
+
+        struct ModeResult {
+            double recordMs {0.0};  // CPU time recording a frame
+            double gpuMs {0.0};
+        };
+    }  // namespace
+
+    int RunBreadcrumbBenchmark(std::span<char*> args) {
+        using namespace Vulkano;
+
+        const u32 passes = std::max(ParseCount(args, 0, 64), 1u);
+        const u32 frames = ParseCount(args, 1, 500);
+
+        VulkanContext context;
+        AssertResult(CreateHeadlessContext(context));
+
+        if (!context.GetDeviceProperties().limits.timestampComputeAndGraphics) {
+            std::fprintf(stderr, "Device doesn't support timestamps on graphics queues\n");
+            return EXIT_FAILURE;
+        }
+
+        FrameSynchronizer frameSync;
+        AssertResult(frameSync.Initialize(&context, kFramesInFlight));
+
+        Breadcrumbs breadcrumbs;
+        AssertResult(breadcrumbs.Initialize(&context, {}));
+        std::vector<u32> passIds;
+        for (u32 pass = 0; pass < passes; pass++) {
+            passIds.push_back(breadcrumbs.RegisterPass("Pass " + std::to_string(pass)).value());
+        }
+        frameSync.SetBreadcrumbs(&breadcrumbs);
+
+        Buffer scratch;
+        Buffer::Config scratchConfig;
+        scratchConfig.size  = kPassBytes * passes;
+        scratchConfig.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        AssertResult(scratch.Initialize(&context, scratchConfig));
+
+        const VkDevice device = context.GetDevice();
+        const VkQueue queue   = context.GetGraphicsQueue();
+
+        VkQueryPoolCreateInfo queryInfo {};
+        queryInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+        queryInfo.queryCount = kFramesInFlight * 2;
+        VkQueryPool queries  = VK_NULL_HANDLE;
+        if (vkCreateQueryPool(device, &queryInfo, nullptr, &queries) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create timestamp query pool");
+        }
+        const double timestampPeriod = context.GetDeviceProperties().limits.timestampPeriod;
+
+        // Passes separated by a barrier, the way a frame graph's passes usually are
+        const auto runMode = [&](bool withBreadcrumbs) {
+            ModeResult result;
+            std::vector<bool> pending(kFramesInFlight, false);
+            u32 timedFrames = 0;
+            for (u32 frame = 0; frame < frames; frame++) {
+                AssertResult(frameSync.BeginFrame());
+                breadcrumbs.BeginFrame();
+                const u32 slot = frameSync.GetCurrentFrameIndex();
+                if (pending[slot]) {
+                    u64 timestamps[2] = {};
+                    if (vkGetQueryPoolResults(device,
+                                              queries,
+                                              slot * 2,
+                                              2,
+                                              sizeof(timestamps),
+                                              timestamps,
+                                              sizeof(u64),
+                                              VK_QUERY_RESULT_64_BIT) == VK_SUCCESS) {
+                        result.gpuMs += CAST<double>(timestamps[1] - timestamps[0]) * timestampPeriod / 1.0e6;
+                        timedFrames++;
+                    }
+                }
+
+                const VkCommandBuffer commandBuffer = frameSync.GetCurrentCommandBuffer();
+                VkCommandBufferBeginInfo beginInfo {};
+                beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                vkBeginCommandBuffer(commandBuffer, &beginInfo);
+                vkCmdResetQueryPool(commandBuffer, queries, slot * 2, 2);
+                vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queries, slot * 2);
+
+                const auto recordStart = Clock::now();
+                for (u32 pass = 0; pass < passes; pass++) {
+                    if (withBreadcrumbs) { breadcrumbs.BeginPass(commandBuffer, queue, passIds[pass]); }
+                    vkCmdFillBuffer(commandBuffer, scratch.GetBuffer(), pass * kPassBytes, kPassBytes, frame);
+
+                    VkMemoryBarrier barrier {};
+                    barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+                    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                    vkCmdPipelineBarrier(commandBuffer,
+                                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                         0,
+                                         1,
+                                         &barrier,
+                                         0,
+                                         nullptr,
+                                         0,
+                                         nullptr);
+                    if (withBreadcrumbs) { breadcrumbs.EndPass(commandBuffer, queue, passIds[pass]); }
+                }
+                result.recordMs += std::chrono::duration<double, std::milli>(Clock::now() - recordStart).count();
+
+                vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queries, slot * 2 + 1);
+                vkEndCommandBuffer(commandBuffer);
+
+                VkSubmitInfo submitInfo {};
+                submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                submitInfo.commandBufferCount = 1;
+                submitInfo.pCommandBuffers    = &commandBuffer;
+                if (vkQueueSubmit(queue, 1, &submitInfo, frameSync.GetCurrentFence()) != VK_SUCCESS) {
+                    throw std::runtime_error("Failed to submit breadcrumb frame");
+                }
+                pending[slot] = true;
+                frameSync.EndFrame();
+            }
+            context.WaitIdle();
+
+            result.recordMs /= std::max(frames, 1u);
+            result.gpuMs /= std::max(timedFrames, 1u);
+            return result;
+        };
+
+        const ModeResult without = runMode(false);
+        const ModeResult with    = runMode(true);
+
+        const auto& capabilities = context.GetCapabilities();
+        std::printf("Device: %s\n", context.GetDeviceProperties().deviceName);
+        std::printf("Markers: %s%s%s\n",
+                    breadcrumbs.HasBufferMarkers() ? "buffer markers" : "fill buffer",
+                    capabilities.diagnosticCheckpoints ? ", checkpoints" : "",
+                    capabilities.deviceFault ? ", device fault reports" : "");
+        std::printf("%u passes per frame, %u frames\n", passes, frames);
+        std::printf("%-18s %12s %10s\n", "", "Record ms", "GPU ms");
+        for (const auto& [name, result] : {std::pair {"No breadcrumbs", without}, std::pair {"Breadcrumbs", with}}) {
+            std::printf("%-18s %12.4f %10.4f\n", name, result.recordMs, result.gpuMs);
+        }
+        std::printf("GPU overhead: %.2f%%\n",
+                    without.gpuMs > 0.0 ? 100.0 * (with.gpuMs - without.gpuMs) / without.gpuMs : 0.0);
+        std::printf("%s", breadcrumbs.Describe(false).c_str());
+
+        vkDestroyQueryPool(device, queries, nullptr);
+        scratch.Shutdown();
+        frameSync.Shutdown();
+        breadcrumbs.Shutdown();
+        context.Shutdown();
+
+        return EXIT_SUCCESS;
+    }
+}  // namespace Benchmarks
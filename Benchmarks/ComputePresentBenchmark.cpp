@@ -0,0 +1,237 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Benchmarks.hpp"
+
+#include <Vulkano/FrameSynchronizer.hpp>
+#include <Vulkano/SwapchainManager.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Benchmarks {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+        using Vulkano::u32;
+
+        constexpr VkExtent2D kExtent {1920, 1080};
+
+        /// @brief Layout transition that is also a queue family release or acquire when the families differ
+        void RecordBarrier(VkCommandBuffer commandBuffer,
+                           VkImage image,
+                           VkImageLayout oldLayout,
+                           VkImageLayout newLayout,
+                           VkAccessFlags srcAccess,
+                           VkAccessFlags dstAccess,
+                           VkPipelineStageFlags srcStage,
+                           VkPipelineStageFlags dstStage,
+                           u32 srcFamily = VK_QUEUE_FAMILY_IGNORED,
+                           u32 dstFamily = VK_QUEUE_FAMILY_IGNORED) {
+            VkImageMemoryBarrier barrier {};
+            barrier.sType                       = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.oldLayout                   = oldLayout;
+            barrier.newLayout                   = newLayout;
+            barrier.srcAccessMask               = srcAccess;
+            barrier.dstAccessMask               = dstAccess;
+            barrier.srcQueueFamilyIndex         = srcFamily;
+            barrier.dstQueueFamilyIndex         = dstFamily;
+            barrier.image                       = image;
+            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            barrier.subresourceRange.levelCount = 1;
+            barrier.subresourceRange.layerCount = 1;
+            vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+        }
+
+        void Submit(VkQueue queue,
+                    VkCommandBuffer commandBuffer,
+                    VkSemaphore waitSemaphore,
+                    VkPipelineStageFlags waitStage,
+                    VkSemaphore signalSemaphore,
+                    VkFence fence) {
+            VkSubmitInfo submitInfo {};
+            submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.waitSemaphoreCount   = 1;
+            submitInfo.pWaitSemaphores      = &waitSemaphore;
+            submitInfo.pWaitDstStageMask    = &waitStage;
+            submitInfo.commandBufferCount   = 1;
+            submitInfo.pCommandBuffers      = &commandBuffer;
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores    = &signalSemaphore;
+            if (vkQueueSubmit(queue, 1, &submitInfo, fence) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to submit frame");
+            }
+        }
+
+        /// @brief Frames that finish in compute (a clear stands in for the compute pass writing the image), timed from
+        /// the acquire until the last submit's fence signals after the present was queued. Frames are serialized so
+        /// each sample is one frame's latency, not throughput.
+        /// @param presentFromCompute Present on the compute queue; otherwise hop to the present queue through a
+        /// semaphore and, across families, an ownership transfer
+        std::vector<double>
+        RunFrames(Vulkano::VulkanContext& context, VkSurfaceKHR surface, bool presentFromCompute, u32 frames) {
+            using namespace Vulkano;
+
+            SwapchainConfig config;
+            config.imageUsage         = VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+            config.presentFromCompute = presentFromCompute;
+
+            SwapchainManager swapchain;
+            AssertResult(swapchain.Initialize(&context, surface, kExtent.width, kExtent.height, config));
+            if (!(swapchain.GetImageUsage() & VK_IMAGE_USAGE_TRANSFER_DST_BIT)) {
+                throw std::runtime_error("Surface doesn't support transfer destination swapchain images");
+            }
+
+            const u32 computeFamily = context.GetQueueFamilies().computeFamily;
+            const u32 presentFamily = swapchain.GetPresentFamily();
+            const bool direct       = swapchain.IsPresentingFromCompute();
+            const bool transfer     = computeFamily != presentFamily && !direct;
+
+            FrameSynchronizer computeSync;
+            FrameSynchronizer presentSync;
+            AssertResult(computeSync.Initialize(&context, 1, computeFamily));
+            AssertResult(presentSync.Initialize(&context, 1, presentFamily));
+
+            std::vector<double> samples;
+            for (u32 frame = 0; frame < frames; frame++) {
+                const auto start = Clock::now();
+                AssertResult(computeSync.BeginFrame());
+                if (!direct) { AssertResult(presentSync.BeginFrame()); }
+
+                const auto imageIndex = swapchain.AcquireNextImage(computeSync.GetCurrentImageAvailableSemaphore());
+                if (!imageIndex) { throw std::runtime_error(imageIndex.error()); }
+                const VkImage image           = swapchain.GetImages()[*imageIndex];
+                const VkSemaphore presentWait = swapchain.GetPresentSemaphore(*imageIndex);
+
+                VkCommandBufferBeginInfo beginInfo {};
+                beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+                const VkCommandBuffer computeCommands = computeSync.GetCurrentCommandBuffer();
+                vkBeginCommandBuffer(computeCommands, &beginInfo);
+                RecordBarrier(computeCommands,
+                              image,
+                              VK_IMAGE_LAYOUT_UNDEFINED,
+                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                              0,
+                              VK_ACCESS_TRANSFER_WRITE_BIT,
+                              VK_PIPELINE_STAGE_TRANSFER_BIT,
+                              VK_PIPELINE_STAGE_TRANSFER_BIT);
+                const VkClearColorValue color {{CAST<float>(frame % 256) / 255.0f, 0.25f, 0.5f, 1.0f}};
+                VkImageSubresourceRange range {};
+                range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+                range.levelCount = 1;
+                range.layerCount = 1;
+                vkCmdClearColorImage(computeCommands, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &color, 1, &range);
+                RecordBarrier(computeCommands,
+                              image,
+                              VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                              VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                              VK_ACCESS_TRANSFER_WRITE_BIT,
+                              0,
+                              VK_PIPELINE_STAGE_TRANSFER_BIT,
+                              VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                              transfer ? computeFamily : VK_QUEUE_FAMILY_IGNORED,
+                              transfer ? presentFamily : VK_QUEUE_FAMILY_IGNORED);
+                vkEndCommandBuffer(computeCommands);
+
+                Submit(context.GetComputeQueue(),
+                       computeCommands,
+                       computeSync.GetCurrentImageAvailableSemaphore(),
+                       VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       direct ? presentWait : computeSync.GetCurrentRenderFinishedSemaphore(),
+                       computeSync.GetCurrentFence());
+
+                if (!direct) {
+                    // The hop: a present-queue submit whose only job is the ownership acquire
+                    const VkCommandBuffer presentCommands = presentSync.GetCurrentCommandBuffer();
+                    vkBeginCommandBuffer(presentCommands, &beginInfo);
+                    if (transfer) {
+                        RecordBarrier(presentCommands,
+                                      image,
+                                      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                      VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                                      0,
+                                      0,
+                                      VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                      VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                      computeFamily,
+                                      presentFamily);
+                    }
+                    vkEndCommandBuffer(presentCommands);
+                    Submit(swapchain.GetPresentQueue(),
+                           presentCommands,
+                           computeSync.GetCurrentRenderFinishedSemaphore(),
+                           VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                           presentWait,
+                           presentSync.GetCurrentFence());
+                }
+
+                AssertResult(swapchain.Present(*imageIndex, presentWait));
+                AssertResult((direct ? computeSync : presentSync).WaitForFrame());
+                samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+                computeSync.EndFrame();
+                if (!direct) { presentSync.EndFrame(); }
+            }
+
+            context.WaitIdle();
+            presentSync.Shutdown();
+            computeSync.Shutdown();
+            swapchain.Shutdown();
+            return samples;
+        }
+    }  // namespace
+
+    int RunComputePresentBenchmark(std::span<char*> args) {
+        using namespace Vulkano;
+
+        const u32 frames = ParseCount(args, 0, 500);
+
+        VulkanContext context;
+        const auto surface = CreateHeadlessSurfaceContext(context);
+        if (!surface) {
+            std::fprintf(stderr, "%s\n", surface.error().c_str());
+            return EXIT_FAILURE;
+        }
+
+        const QueueFamilyIndices& families = context.GetQueueFamilies();
+        std::printf("Device: %s\n", context.GetDeviceProperties().deviceName);
+        std::printf("Compute family %u, present family %u, async compute: %s\n",
+                    families.computeFamily,
+                    families.presentFamily,
+                    families.hasDiscreteCompute ? "yes" : "no");
+
+        VkBool32 computePresent = VK_FALSE;
+        vkGetPhysicalDeviceSurfaceSupportKHR(
+          context.GetPhysicalDevice(), families.computeFamily, *surface, &computePresent);
+        if (!computePresent) {
+            std::fprintf(stderr, "The compute family can't present to this surface\n");
+            vkDestroySurfaceKHR(context.GetInstance(), *surface, nullptr);
+            context.Shutdown();
+            return EXIT_FAILURE;
+        }
+
+        std::vector<double> hop    = RunFrames(context, *surface, false, frames);
+        std::vector<double> direct = RunFrames(context, *surface, true, frames);
+
+        const Timings before = Summarize(hop);
+        const Timings after  = Summarize(direct);
+        std::printf("%u serialized %ux%u frames finishing in compute\n", frames, kExtent.width, kExtent.height);
+        std::printf("%-30s %10s %10s %10s\n", "", "Mean", "Median", "Max");
+        for (const auto& [name, timings] : {std::pair {"Hop to the present queue", before},
+                                            std::pair {"Present from compute", after}}) {
+            std::printf("%-30s %8.3fms %8.3fms %8.3fms\n", name, timings.mean, timings.median, timings.max);
+        }
+        std::printf("Saved per frame (median): %.3fms\n", before.median - after.median);
+
+        vkDestroySurfaceKHR(context.GetInstance(), *surface, nullptr);
+        context.Shutdown();
+
+        return EXIT_SUCCESS;
+    }
+}  // namespace Benchmarks
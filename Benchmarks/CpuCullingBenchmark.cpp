@@ -0,0 +1,141 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Benchmarks.hpp"
+
+#include <Vulkano/CpuCulling.hpp>
+#include <Vulkano/JobSystem.hpp>
+#include <Vulkano/TransientRing.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace Benchmarks {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+        using Vulkano::f32;
+        using Vulkano::u32;
+
+        constexpr u32 kFramesInFlight {2};
+        constexpr f32 kLodThresholds[] = {0.1f, 0.03f, 0.01f};
+
+        struct RunResult {
+            double ms {0.0};
+            std::vector<std::vector<u32>> lods;  // Host copy of the last frame's lists; the arena gets reused
+            u32 visible {0};
+        };
+
+        /// @brief Cull the same scene for a number of frames and return the average time and the last lists
+        RunResult Run(Vulkano::JobSystem* jobs,
+                      bool simd,
+                      const Vulkano::CullingBounds& bounds,
+                      const Vulkano::CpuCulling::View& view,
+                      Vulkano::TransientRing& arena,
+                      u32 frames) {
+            Vulkano::CpuCulling culling;
+            Vulkano::CpuCulling::Config config;
+            config.useSimd = simd;
+            Vulkano::AssertResult(culling.Initialize(jobs, config));
+
+            RunResult result;
+            for (u32 frame = 0; frame < frames; frame++) {
+                arena.BeginFrame(frame % kFramesInFlight);
+                const auto start = Clock::now();
+                auto output      = culling.Cull(bounds, view, arena);
+                result.ms += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+                Vulkano::AssertResult(output);
+
+                if (frame + 1 == frames) {
+                    result.visible = output->visible;
+                    for (u32 lod = 0; lod < output->lodCount; lod++) {
+                        const auto& list = output->lods[lod];
+                        result.lods.emplace_back(list.Indices(), list.Indices() + list.count);
+                    }
+                }
+            }
+            result.ms /= frames;
+            return result;
+        }
+    }  // namespace
+
+    int RunCpuCullingBenchmark(std::span<char*> args) {
+        using namespace Vulkano;
+
+        const u32 instanceCount = ParseCount(args, 0, 1000000);
+        const u32 frames        = ParseCount(args, 1, 50);
+
+        VulkanContext context;
+        AssertResult(CreateHeadlessContext(context));
+
+        JobSystem jobs;
+        TransientRing arena;
+        AssertResult(jobs.Initialize());
+        AssertResult(arena.Initialize(&context, CAST<VkDeviceSize>(instanceCount) * sizeof(u32) + 4096,
+                                      kFramesInFlight,
+                                      VK_BUFFER_USAGE_STORAGE_BUFFER_BIT));
+
+        // Random boxes in a 1km cube around a camera at the origin looking down -Z
+        std::mt19937 random {1234};
+        std::uniform_real_distribution<f32> position {-500.0f, 500.0f};
+        std::uniform_real_distribution<f32> extent {0.25f, 2.0f};
+        CullingBounds bounds;
+        bounds.Resize(instanceCount);
+        for (u32 i = 0; i < instanceCount; i++) {
+            bounds.SetBox(i, position(random), position(random), position(random), extent(random), extent(random),
+                          extent(random));
+        }
+
+        const f32 f = 1.0f / std::tan(1.0471976f * 0.5f);
+        constexpr f32 kNear {0.1f};
+        constexpr f32 kFar {1000.0f};
+
+        CpuCulling::View view;
+        view.viewProjection[0]  = f / (16.0f / 9.0f);
+        view.viewProjection[5]  = f;
+        view.viewProjection[10] = kFar / (kNear - kFar);
+        view.viewProjection[11] = -1.0f;
+        view.viewProjection[14] = kNear * kFar / (kNear - kFar);
+        view.projectionScale    = f;
+        view.shape              = CpuCulling::Shape::Box;
+        view.lodThresholds      = kLodThresholds;
+
+        std::printf("Instances: %u, frames: %u, SIMD path: %s, workers: %u\n",
+                    instanceCount,
+                    frames,
+                    CpuCulling::GetSimdPath(),
+                    jobs.GetThreadCount());
+
+        const RunResult scalar = Run(nullptr, false, bounds, view, arena, frames);
+        std::printf("  %-22s %8.3f ms\n", "Scalar, 1 thread", scalar.ms);
+
+        const RunResult simd = Run(nullptr, true, bounds, view, arena, frames);
+        std::printf("  %-22s %8.3f ms\n", "SIMD, 1 thread", simd.ms);
+
+        const RunResult parallel = Run(&jobs, true, bounds, view, arena, frames);
+        std::printf("  %-22s %8.3f ms\n", "SIMD, job system", parallel.ms);
+        std::printf("  Speedup over scalar: %.2fx (SIMD), %.2fx (SIMD + jobs)\n",
+                    scalar.ms / simd.ms,
+                    scalar.ms / parallel.ms);
+
+        std::printf("Visible: %u of %u (", parallel.visible, instanceCount);
+        for (size_t lod = 0; lod < parallel.lods.size(); lod++) {
+            std::printf("%sLOD%zu %zu", lod > 0 ? ", " : "", lod, parallel.lods[lod].size());
+        }
+        std::printf(")\n");
+
+        // Every path must produce identical, ascending lists
+        const bool matches = simd.lods == scalar.lods && parallel.lods == scalar.lods;
+        if (!matches) { std::printf("Mismatch between the scalar and SIMD paths\n"); }
+
+        arena.Shutdown();
+        context.Shutdown();
+        jobs.Shutdown();
+
+        return matches ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+}  // namespace Benchmarks
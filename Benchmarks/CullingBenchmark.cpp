@@ -0,0 +1,158 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Benchmarks.hpp"
+
+#include <Vulkano/FrameSynchronizer.hpp>
+#include <Vulkano/GpuCulling.hpp>
+#include <Vulkano/JobSystem.hpp>
+#include <Vulkano/PipelineCompiler.hpp>
+#include <Vulkano/ShaderLibrary.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+namespace Benchmarks {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+        using Vulkano::f32;
+        using Vulkano::u32;
+
+        /// @brief Camera at the origin looking down -Z with a Vulkan [0, 1] depth range
+        Vulkano::Mat4 Perspective(f32 fovY, f32 aspect, f32 zNear, f32 zFar) {
+            const f32 f = 1.0f / std::tan(fovY * 0.5f);
+
+            Vulkano::Mat4 m {};
+            m[0]  = f / aspect;
+            m[5]  = f;
+            m[10] = zFar / (zNear - zFar);
+            m[11] = -1.0f;
+            m[14] = zNear * zFar / (zNear - zFar);
+            return m;
+        }
+    }  // namespace
+
+    int RunCullingBenchmark(std::span<char*> args) {
+        using namespace Vulkano;
+
+        const u32 instanceCount = ParseCount(args, 0, 100000);
+        const u32 frames        = ParseCount(args, 1, 20);
+        constexpr u32 kFramesInFlight {2};
+
+        VulkanContext context;
+        AssertResult(CreateHeadlessContext(context));
+
+        const std::filesystem::path shaderPath = std::filesystem::path("Shaders") / "CullInstances.comp.spv";
+        if (!std::filesystem::exists(shaderPath)) {
+            std::fprintf(stderr, "Missing %s (run from the build's bin directory)\n", shaderPath.string().c_str());
+            return EXIT_FAILURE;
+        }
+
+        JobSystem jobs;
+        ShaderLibrary shaders;
+        PipelineCompiler pipelines;
+        FrameSynchronizer frameSync;
+        GpuCulling culling;
+        AssertResult(jobs.Initialize());
+        shaders.LoadAsync(jobs, "CullInstances.comp", shaderPath);
+        AssertResult(shaders.Initialize(&context));
+        AssertResult(pipelines.Initialize(&context, &jobs, &shaders));
+        AssertResult(frameSync.Initialize(&context, kFramesInFlight));
+
+        GpuCulling::Config cullingConfig;
+        cullingConfig.maxInstances        = instanceCount;
+        cullingConfig.maxMeshes           = 1;
+        cullingConfig.framesInFlight      = kFramesInFlight;
+        cullingConfig.uploadBytesPerFrame = sizeof(GpuInstance) * instanceCount + 4096;
+        AssertResult(culling.Initialize(&context, &pipelines, cullingConfig));
+
+        // Random spheres in a 1km cube around a camera with a 60 degree field of view
+        std::mt19937 random {1234};
+        std::uniform_real_distribution<f32> position {-500.0f, 500.0f};
+        std::uniform_real_distribution<f32> radius {0.5f, 3.0f};
+        std::vector<GpuInstance> instances(instanceCount);
+        for (auto& instance : instances) {
+            instance.center[0] = position(random);
+            instance.center[1] = position(random);
+            instance.center[2] = position(random);
+            instance.radius    = radius(random);
+        }
+
+        GpuCulling::View view;
+        view.viewProjection = Perspective(1.0471976f, 16.0f / 9.0f, 0.1f, 1000.0f);
+        view.instanceCount  = instanceCount;
+
+        const Frustum frustum = Frustum::FromViewProjection(view.viewProjection);
+        u32 expectedVisible   = 0;
+        for (const auto& instance : instances) {
+            if (frustum.IntersectsSphere(instance.center[0], instance.center[1], instance.center[2], instance.radius)) {
+                expectedVisible++;
+            }
+        }
+
+        const GpuMeshDraw cube {36, 0, 0, 0};
+        double frameMs  = 0.0;
+        u32 timedFrames = 0;
+
+        // Two extra frames so the last timed frame's counts come back through GetStats
+        for (u32 frame = 0; frame < frames + kFramesInFlight; frame++) {
+            const auto frameStart = Clock::now();
+            AssertResult(frameSync.BeginFrame());
+            culling.BeginFrame(frameSync);
+
+            if (frame == 0) {
+                AssertResult(culling.UpdateMeshes(0, std::span(&cube, 1)));
+                AssertResult(culling.UpdateInstances(0, instances));
+            }
+
+            const VkCommandBuffer commandBuffer = frameSync.GetCurrentCommandBuffer();
+            VkCommandBufferBeginInfo beginInfo {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(commandBuffer, &beginInfo);
+            AssertResult(culling.Cull(frameSync, view));
+            vkEndCommandBuffer(commandBuffer);
+
+            VkSubmitInfo submitInfo {};
+            submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers    = &commandBuffer;
+            if (vkQueueSubmit(context.GetGraphicsQueue(), 1, &submitInfo, frameSync.GetCurrentFence()) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to submit culling frame");
+            }
+            frameSync.EndFrame();
+
+            // Skip the upload frame; with two frames in flight this measures steady-state throughput
+            if (frame > 0 && frame <= frames) {
+                frameMs += std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+                timedFrames++;
+            }
+        }
+        context.WaitIdle();
+
+        const GpuCulling::Stats& stats = culling.GetStats();
+        std::printf("Device: %s\n", context.GetDeviceProperties().deviceName);
+        std::printf("Draw indirect count: %s\n", context.GetCapabilities().drawIndirectCount ? "yes" : "no");
+        std::printf("Draws before culling: %u\n", stats.submitted);
+        std::printf("Draws after culling:  %u (CPU reference %u)\n", stats.visible, expectedVisible);
+        if (timedFrames > 0) { std::printf("Frame time: %.3f ms\n", frameMs / timedFrames); }
+
+        culling.Shutdown();
+        frameSync.Shutdown();
+        pipelines.Shutdown();
+        shaders.Shutdown();
+        context.Shutdown();
+        jobs.Shutdown();
+
+        // The GPU's float math may disagree with the CPU for spheres touching a plane
+        const u32 difference = stats.visible > expectedVisible ? stats.visible - expectedVisible
+                                                               : expectedVisible - stats.visible;
+        return stats.submitted == instanceCount && difference <= instanceCount / 1000 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+}  // namespace Benchmarks
@@ -0,0 +1,306 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Benchmarks.hpp"
+
+#include <Vulkano/Buffer.hpp>
+#include <Vulkano/DescriptorStream.hpp>
+#include <Vulkano/JobSystem.hpp>
+#include <Vulkano/PipelineCompiler.hpp>
+#include <Vulkano/ShaderLibrary.hpp>
+#include <Vulkano/TransientRing.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+
+namespace Benchmarks {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+        using Vulkano::u32;
+
+        // Layout of DescriptorBench.comp's uniform block
+        struct Params {
+            u32 index;
+            u32 value;
+        };
+
+        constexpr u32 ExpectedValue(u32 frame, u32 draw) {
+            return frame * 7919u + draw + 1u;
+        }
+
+        struct PathResult {
+            double recordNsPerDraw {0.0};  // CPU cost of ring push + bind + dispatch, averaged over timed frames
+            double frameMs {0.0};          // Record + submit + wait for the GPU
+            bool verified {false};
+        };
+
+        /// @brief Command pool, buffer and fence for recording and waiting on one frame at a time
+        class Submitter {
+        public:
+            explicit Submitter(Vulkano::VulkanContext& context) : mDevice(context.GetDevice()) {
+                VkCommandPoolCreateInfo poolInfo {};
+                poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+                poolInfo.queueFamilyIndex = context.GetQueueFamilies().computeFamily;
+                if (vkCreateCommandPool(mDevice, &poolInfo, nullptr, &mPool) != VK_SUCCESS) {
+                    throw std::runtime_error("Failed to create command pool");
+                }
+
+                VkCommandBufferAllocateInfo allocateInfo {};
+                allocateInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+                allocateInfo.commandPool        = mPool;
+                allocateInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                allocateInfo.commandBufferCount = 1;
+                if (vkAllocateCommandBuffers(mDevice, &allocateInfo, &mCommandBuffer) != VK_SUCCESS) {
+                    throw std::runtime_error("Failed to allocate command buffer");
+                }
+
+                VkFenceCreateInfo fenceInfo {};
+                fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+                if (vkCreateFence(mDevice, &fenceInfo, nullptr, &mFence) != VK_SUCCESS) {
+                    throw std::runtime_error("Failed to create fence");
+                }
+
+                mQueue = context.GetComputeQueue();
+            }
+
+            ~Submitter() {
+                vkDestroyFence(mDevice, mFence, nullptr);
+                vkDestroyCommandPool(mDevice, mPool, nullptr);
+            }
+
+            Submitter(const Submitter&)            = delete;
+            Submitter& operator=(const Submitter&) = delete;
+
+            VkCommandBuffer Begin() {
+                vkResetCommandPool(mDevice, mPool, 0);
+
+                VkCommandBufferBeginInfo beginInfo {};
+                beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                vkBeginCommandBuffer(mCommandBuffer, &beginInfo);
+                return mCommandBuffer;
+            }
+
+            void SubmitAndWait() {
+                // Make the dispatches' writes visible to the host readback
+                VkMemoryBarrier barrier {};
+                barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+                barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+                barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+                vkCmdPipelineBarrier(mCommandBuffer,
+                                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                     VK_PIPELINE_STAGE_HOST_BIT,
+                                     0,
+                                     1,
+                                     &barrier,
+                                     0,
+                                     nullptr,
+                                     0,
+                                     nullptr);
+                vkEndCommandBuffer(mCommandBuffer);
+
+                VkSubmitInfo submitInfo {};
+                submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                submitInfo.commandBufferCount = 1;
+                submitInfo.pCommandBuffers    = &mCommandBuffer;
+                if (vkQueueSubmit(mQueue, 1, &submitInfo, mFence) != VK_SUCCESS) {
+                    throw std::runtime_error("Failed to submit benchmark frame");
+                }
+
+                vkWaitForFences(mDevice, 1, &mFence, VK_TRUE, UINT64_MAX);
+                vkResetFences(mDevice, 1, &mFence);
+            }
+
+        private:
+            VkDevice mDevice {VK_NULL_HANDLE};
+            VkQueue mQueue {VK_NULL_HANDLE};
+            VkCommandPool mPool {VK_NULL_HANDLE};
+            VkCommandBuffer mCommandBuffer {VK_NULL_HANDLE};
+            VkFence mFence {VK_NULL_HANDLE};
+        };
+
+        Vulkano::Result<PathResult> RunPath(Vulkano::VulkanContext& context,
+                                            Vulkano::PipelineCompiler& pipelines,
+                                            Vulkano::DescriptorPath path,
+                                            u32 draws,
+                                            u32 frames) {
+            using namespace Vulkano;
+
+            // Single frame in flight: every frame is waited on before the next one reuses the ring
+            DescriptorStream::Config streamConfig;
+            streamConfig.bindings        = {{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+                                            {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT}};
+            streamConfig.preferredPath   = path;
+            streamConfig.framesInFlight  = 1;
+            streamConfig.maxSetsPerFrame = draws;
+
+            DescriptorStream stream;
+            if (auto result = stream.Initialize(&context, streamConfig); !result) {
+                return std::unexpected(result.error());
+            }
+            if (stream.GetPath() != path) { return std::unexpected("not supported on this device"); }
+
+            TransientRing ring;
+            const auto& limits = context.GetDeviceProperties().limits;
+            const VkDeviceSize uniformStride =
+              std::max<VkDeviceSize>(sizeof(Params), limits.minUniformBufferOffsetAlignment);
+            if (auto result = ring.Initialize(&context, uniformStride * draws, 1); !result) {
+                return std::unexpected(result.error());
+            }
+
+            Buffer output;
+            Buffer::Config outputConfig;
+            outputConfig.size        = sizeof(u32) * draws;
+            outputConfig.usage       = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+            outputConfig.hostVisible = true;
+            if (auto result = output.Initialize(&context, outputConfig); !result) {
+                return std::unexpected(result.error());
+            }
+
+            const VkDevice device                 = context.GetDevice();
+            const VkDescriptorSetLayout setLayout = stream.GetSetLayout();
+
+            VkPipelineLayoutCreateInfo layoutInfo {};
+            layoutInfo.sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            layoutInfo.setLayoutCount = 1;
+            layoutInfo.pSetLayouts    = &setLayout;
+
+            VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+            if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+                return std::unexpected("Failed to create pipeline layout");
+            }
+
+            const std::string layoutName = std::string("DescriptorBench.") + ToString(path);
+            pipelines.RegisterLayout(layoutName, pipelineLayout);
+
+            ComputePipelineDesc desc;
+            desc.stage.shader     = "DescriptorBench.comp";
+            desc.layout           = layoutName;
+            desc.descriptorBuffer = stream.UsesDescriptorBuffer();
+
+            auto pipelineResult = pipelines.Get(desc);
+            if (!pipelineResult) {
+                vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+                return std::unexpected(pipelineResult.error());
+            }
+
+            // Dispatches write distinct elements, so they need no barriers between them
+            Submitter submitter(context);
+            PathResult result;
+            result.verified = true;
+
+            double recordNs = 0.0;
+            double frameMs  = 0.0;
+            u32 timedFrames = 0;
+            for (u32 frame = 0; frame < frames; frame++) {
+                const auto frameStart = Clock::now();
+
+                stream.BeginFrame(0);
+                ring.BeginFrame(0);
+
+                VkCommandBuffer commandBuffer = submitter.Begin();
+                const auto recordStart        = Clock::now();
+
+                vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineResult.value());
+                stream.BindBuffers(commandBuffer);
+                for (u32 draw = 0; draw < draws; draw++) {
+                    const auto params = ring.Push(Params {draw, ExpectedValue(frame, draw)});
+                    const DescriptorWrite writes[] = {
+                      DescriptorWrite::ForBuffer(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, params),
+                      DescriptorWrite::ForBuffer(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, output),
+                    };
+                    if (auto bindResult =
+                          stream.Bind(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, writes);
+                        !bindResult) {
+                        vkEndCommandBuffer(commandBuffer);
+                        vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+                        return std::unexpected(bindResult.error());
+                    }
+                    vkCmdDispatch(commandBuffer, 1, 1, 1);
+                }
+
+                const auto recordEnd = Clock::now();
+                submitter.SubmitAndWait();
+                const auto frameEnd = Clock::now();
+
+                // Frame 0 warms up caches, lazy driver state and page faults in the mapped buffers
+                if (frame > 0) {
+                    recordNs += std::chrono::duration<double, std::nano>(recordEnd - recordStart).count();
+                    frameMs += std::chrono::duration<double, std::milli>(frameEnd - frameStart).count();
+                    timedFrames++;
+                }
+
+                const u32* values = static_cast<const u32*>(output.GetMapped());
+                for (u32 draw = 0; draw < draws && result.verified; draw++) {
+                    result.verified = values[draw] == ExpectedValue(frame, draw);
+                }
+            }
+
+            vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+
+            if (timedFrames > 0) {
+                result.recordNsPerDraw = recordNs / (static_cast<double>(timedFrames) * draws);
+                result.frameMs         = frameMs / timedFrames;
+            }
+            return result;
+        }
+    }  // namespace
+
+    int RunDescriptorBenchmark(std::span<char*> args) {
+        using namespace Vulkano;
+
+        const u32 draws  = ParseCount(args, 0, 10000);
+        const u32 frames = ParseCount(args, 1, 20) + 1;  // Plus one warm-up frame
+
+        VulkanContext context;
+        AssertResult(CreateHeadlessContext(context));
+
+        const std::filesystem::path shaderPath = std::filesystem::path("Shaders") / "DescriptorBench.comp.spv";
+        if (!std::filesystem::exists(shaderPath)) {
+            std::fprintf(stderr, "Missing %s (run from the build's bin directory)\n", shaderPath.string().c_str());
+            return EXIT_FAILURE;
+        }
+
+        JobSystem jobs;
+        ShaderLibrary shaders;
+        PipelineCompiler pipelines;
+        AssertResult(jobs.Initialize());
+        shaders.LoadAsync(jobs, "DescriptorBench.comp", shaderPath);
+        AssertResult(shaders.Initialize(&context));
+        AssertResult(pipelines.Initialize(&context, &jobs, &shaders));
+
+        const auto& capabilities = context.GetCapabilities();
+        std::printf("Device: %s\n", context.GetDeviceProperties().deviceName);
+        std::printf("Push descriptors: %s, descriptor buffer: %s\n",
+                    capabilities.pushDescriptors ? "yes" : "no",
+                    capabilities.descriptorBuffer ? "yes" : "no");
+        std::printf("%u dispatches per frame, %u timed frames, 1 UBO + 1 SSBO per dispatch\n\n", draws, frames - 1);
+        std::printf("  %-8s %14s %12s %10s\n", "Path", "ns/draw (CPU)", "frame (ms)", "verified");
+
+        int exitCode = EXIT_SUCCESS;
+        for (const DescriptorPath path : {DescriptorPath::Sets, DescriptorPath::Push, DescriptorPath::Buffer}) {
+            auto result = RunPath(context, pipelines, path, draws, frames);
+            if (!result) {
+                std::printf("  %-8s %s\n", ToString(path), result.error().c_str());
+                continue;
+            }
+
+            std::printf("  %-8s %14.1f %12.3f %10s\n",
+                        ToString(path),
+                        result->recordNsPerDraw,
+                        result->frameMs,
+                        result->verified ? "yes" : "NO");
+            if (!result->verified) { exitCode = EXIT_FAILURE; }
+        }
+
+        pipelines.Shutdown();
+        shaders.Shutdown();
+        context.Shutdown();
+        jobs.Shutdown();
+        return exitCode;
+    }
+}  // namespace Benchmarks
@@ -0,0 +1,173 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Benchmarks.hpp"
+
+#include <Vulkano/DebugDraw.hpp>
+#include <Vulkano/DynamicResolution.hpp>
+#include <Vulkano/FrameSynchronizer.hpp>
+#include <Vulkano/JobSystem.hpp>
+#include <Vulkano/PipelineCompiler.hpp>
+#include <Vulkano/ShaderLibrary.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+namespace Benchmarks {
+    namespace {
+        using Vulkano::f32;
+        using Vulkano::u32;
+
+        constexpr u32 kWidth {1920};
+        constexpr u32 kHeight {1080};
+        constexpr u32 kFramesInFlight {2};
+        constexpr f32 kBudgetFraction {0.6f};  // Target as a fraction of the measured full-resolution GPU time
+    }  // namespace
+
+    int RunDynamicResolutionBenchmark(std::span<char*> args) {
+        using namespace Vulkano;
+
+        const u32 layers = ParseCount(args, 0, 64);
+        const u32 frames = ParseCount(args, 1, 300);
+
+        VulkanContext context;
+        AssertResult(CreateHeadlessContext(context));
+
+        if (!context.GetDeviceProperties().limits.timestampComputeAndGraphics) {
+            std::fprintf(stderr, "Device doesn't support timestamps on graphics queues\n");
+            return EXIT_FAILURE;
+        }
+
+        JobSystem jobs;
+        ShaderLibrary shaders;
+        PipelineCompiler pipelines;
+        AssertResult(jobs.Initialize());
+        for (const char* name : {"Upscale.comp", "DebugDraw.vert", "DebugDraw.frag"}) {
+            const std::filesystem::path path = std::filesystem::path("Shaders") / (std::string(name) + ".spv");
+            if (!std::filesystem::exists(path)) {
+                std::fprintf(stderr, "Missing %s (run from the build's bin directory)\n", path.string().c_str());
+                return EXIT_FAILURE;
+            }
+            shaders.LoadAsync(jobs, name, path);
+        }
+        AssertResult(shaders.Initialize(&context));
+        AssertResult(pipelines.Initialize(&context, &jobs, &shaders));
+
+        FrameSynchronizer frameSync;
+        AssertResult(frameSync.Initialize(&context, kFramesInFlight));
+
+        // A huge budget pins the scale at maxScale while the full-resolution cost is measured
+        DynamicResolution resolution;
+        DynamicResolution::Config resolutionConfig;
+        resolutionConfig.outputExtent   = {kWidth, kHeight};
+        resolutionConfig.targetGpuMs    = 1.0e6f;
+        resolutionConfig.framesInFlight = kFramesInFlight;
+        AssertResult(resolution.Initialize(&context, &pipelines, resolutionConfig));
+
+        // Layers of fullscreen translucent quads make the load scale with the pixel count, like a fill-bound scene
+        DebugDraw load;
+        DebugDraw::Config loadConfig;
+        loadConfig.maxTriangleVertices = std::max(layers * 6, 6u);
+        loadConfig.framesInFlight      = kFramesInFlight;
+        loadConfig.colorFormat         = resolutionConfig.colorFormat;
+        AssertResult(load.Initialize(&context, &pipelines, loadConfig));
+
+        const auto runFrame = [&] {
+            AssertResult(frameSync.BeginFrame());
+            resolution.BeginFrame(frameSync);
+            load.BeginFrame(frameSync);
+
+            const VkExtent2D extent = resolution.GetRenderExtent();
+            for (u32 layer = 0; layer < layers; layer++) {
+                const auto shade = CAST<u8>(layer * 37);
+                const u32 color  = DebugDraw::Rgba(shade, 96, 160, 24);
+                load.Rect(0.0f, 0.0f, CAST<f32>(extent.width), CAST<f32>(extent.height), color);
+            }
+
+            const VkCommandBuffer commandBuffer = frameSync.GetCurrentCommandBuffer();
+            VkCommandBufferBeginInfo beginInfo {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+            resolution.BeginRendering(frameSync, VkClearColorValue {{0.0f, 0.0f, 0.0f, 1.0f}});
+            AssertResult(load.Flush(frameSync, Mat4 {}, extent));
+            resolution.EndRendering(frameSync);
+            AssertResult(resolution.Upscale(frameSync));
+            vkEndCommandBuffer(commandBuffer);
+
+            VkSubmitInfo submitInfo {};
+            submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers    = &commandBuffer;
+            if (vkQueueSubmit(context.GetGraphicsQueue(), 1, &submitInfo, frameSync.GetCurrentFence()) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to submit dynamic resolution frame");
+            }
+            frameSync.EndFrame();
+        };
+
+        double fullMs = 0.0;
+        for (u32 frame = 0; frame < frames; frame++) {
+            runFrame();
+            if (frame >= kFramesInFlight) { fullMs += resolution.GetStats().gpuMs; }
+        }
+        fullMs /= std::max(frames, kFramesInFlight + 1) - kFramesInFlight;
+
+        const f32 target = CAST<f32>(fullMs) * kBudgetFraction;
+        resolution.SetTargetGpuTime(target);
+
+        std::printf("Device: %s\n", context.GetDeviceProperties().deviceName);
+        std::printf("Output %ux%u, %u layers, %.3fms GPU at full resolution, target %.3fms\n",
+                    kWidth,
+                    kHeight,
+                    layers,
+                    fullMs,
+                    target);
+        std::printf("%8s %8s %12s %10s\n", "Frame", "Scale", "Render", "GPU ms");
+
+        const u32 reportEvery = std::max(frames / 10, 1u);
+        double settledMs      = 0.0;
+        u32 settledFrames     = 0;
+        for (u32 frame = 0; frame < frames; frame++) {
+            runFrame();
+
+            const DynamicResolution::Stats& stats = resolution.GetStats();
+            if (frame % reportEvery == 0 || frame + 1 == frames) {
+                std::printf("%8u %8.3f %5ux%-6u %10.3f\n",
+                            frame,
+                            stats.scale,
+                            stats.renderExtent.width,
+                            stats.renderExtent.height,
+                            stats.gpuMs);
+            }
+            if (frame >= frames / 2) {
+                settledMs += stats.gpuMs;
+                settledFrames++;
+            }
+        }
+        context.WaitIdle();
+
+        const DynamicResolution::Stats stats = resolution.GetStats();
+        settledMs /= std::max(settledFrames, 1u);
+        std::printf("%u resolution changes, settled at scale %.3f with %.3fms GPU (%.0f%% of target)\n",
+                    stats.changes,
+                    stats.scale,
+                    settledMs,
+                    target > 0.0f ? settledMs / target * 100.0 : 0.0);
+
+        load.Shutdown();
+        resolution.Shutdown();
+        frameSync.Shutdown();
+        pipelines.Shutdown();
+        shaders.Shutdown();
+        context.Shutdown();
+        jobs.Shutdown();
+
+        return stats.changes > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+}  // namespace Benchmarks
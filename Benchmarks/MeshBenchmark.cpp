@@ -0,0 +1,168 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Benchmarks.hpp"
+
+#include <Vulkano/MeshProcessing.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace Benchmarks {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+        using Vulkano::f32;
+        using Vulkano::SourceVertex;
+        using Vulkano::u32;
+
+        constexpr f32 kPi = 3.14159265f;
+
+        struct SampleMesh {
+            std::string_view name;
+            std::vector<SourceVertex> vertices;
+            std::vector<u32> indices;  // Empty for triangle soup
+        };
+
+        /// @brief Parametric surface on a (columns + 1) x (rows + 1) vertex grid, indexed row by row
+        template<typename Surface>
+        SampleMesh MakeSurface(std::string_view name, u32 columns, u32 rows, Surface surface) {
+            SampleMesh mesh {name, {}, {}};
+            for (u32 y = 0; y <= rows; y++) {
+                for (u32 x = 0; x <= columns; x++) {
+                    SourceVertex vertex;
+                    vertex.uv[0] = CAST<f32>(x) / CAST<f32>(columns);
+                    vertex.uv[1] = CAST<f32>(y) / CAST<f32>(rows);
+                    surface(vertex.uv[0], vertex.uv[1], vertex);
+                    mesh.vertices.push_back(vertex);
+                }
+            }
+            for (u32 y = 0; y < rows; y++) {
+                for (u32 x = 0; x < columns; x++) {
+                    const u32 a = y * (columns + 1) + x;
+                    const u32 c = a + columns + 1;
+                    mesh.indices.insert(mesh.indices.end(), {a, c, a + 1, a + 1, c, c + 1});
+                }
+            }
+            return mesh;
+        }
+
+        /// @brief Shuffle triangle order, as exporters that group by material or smoothing group tend to
+        void ShuffleTriangles(std::vector<u32>& indices, std::mt19937& random) {
+            std::vector<u32> order(indices.size() / 3);
+            for (u32 i = 0; i < order.size(); i++) {
+                order[i] = i;
+            }
+            std::shuffle(order.begin(), order.end(), random);
+
+            std::vector<u32> shuffled;
+            shuffled.reserve(indices.size());
+            for (const u32 triangle : order) {
+                shuffled.insert(shuffled.end(), indices.begin() + triangle * 3, indices.begin() + triangle * 3 + 3);
+            }
+            indices = std::move(shuffled);
+        }
+
+        std::vector<SampleMesh> MakeSamples() {
+            std::mt19937 random {42};
+            std::vector<SampleMesh> samples;
+
+            samples.push_back(MakeSurface("terrain grid", 256, 256, [](f32 u, f32 v, SourceVertex& out) {
+                out.position[0] = u * 100.0f;
+                out.position[1] = std::sin(u * 20.0f) * std::cos(v * 15.0f) * 2.0f;
+                out.position[2] = v * 100.0f;
+                out.normal[0]   = 0.0f;
+                out.normal[1]   = 1.0f;
+                out.normal[2]   = 0.0f;
+            }));
+
+            SampleMesh torus = MakeSurface("shuffled torus", 192, 96, [](f32 u, f32 v, SourceVertex& out) {
+                const f32 theta = u * 2.0f * kPi;
+                const f32 phi   = v * 2.0f * kPi;
+                out.normal[0]   = std::cos(theta) * std::cos(phi);
+                out.normal[1]   = std::sin(phi);
+                out.normal[2]   = std::sin(theta) * std::cos(phi);
+                out.position[0] = std::cos(theta) * 3.0f + out.normal[0];
+                out.position[1] = out.normal[1];
+                out.position[2] = std::sin(theta) * 3.0f + out.normal[2];
+            });
+            ShuffleTriangles(torus.indices, random);
+            samples.push_back(std::move(torus));
+
+            // Unindexed export: every triangle corner is its own vertex
+            SampleMesh sphere = MakeSurface("sphere soup", 128, 64, [](f32 u, f32 v, SourceVertex& out) {
+                const f32 theta = u * 2.0f * kPi;
+                const f32 phi   = v * kPi;
+                out.normal[0]   = std::sin(phi) * std::cos(theta);
+                out.normal[1]   = std::cos(phi);
+                out.normal[2]   = std::sin(phi) * std::sin(theta);
+                std::copy(out.normal, out.normal + 3, out.position);
+            });
+            ShuffleTriangles(sphere.indices, random);
+            std::vector<SourceVertex> soup;
+            soup.reserve(sphere.indices.size());
+            for (const u32 index : sphere.indices) {
+                soup.push_back(sphere.vertices[index]);
+            }
+            sphere.vertices = std::move(soup);
+            sphere.indices.clear();
+            samples.push_back(std::move(sphere));
+
+            return samples;
+        }
+    }  // namespace
+
+    int RunMeshBenchmark(std::span<char*> args) {
+        const u32 cacheSize = ParseCount(args, 0, 16);
+
+        Vulkano::MeshProcessOptions options;
+        options.simulatedCacheSize = cacheSize;
+
+        std::printf("Simulated post-transform cache: %u entries (FIFO)\n", cacheSize);
+        std::printf("%-16s %9s %17s %15s %17s %21s %8s\n",
+                    "Mesh",
+                    "Triangles",
+                    "Vertices",
+                    "ACMR",
+                    "VS invocations",
+                    "Bytes",
+                    "Time");
+
+        bool allReduced = true;
+        for (const auto& sample : MakeSamples()) {
+            const auto start  = Clock::now();
+            const auto result = Vulkano::ProcessMesh(sample.vertices, sample.indices, options);
+            const double ms   = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            Vulkano::AssertResult(result);
+
+            const Vulkano::MeshReport& report = result->report;
+            const f32 invocationSaving = 100.0f * (1.0f - CAST<f32>(report.invocationsAfter) /
+                                                            CAST<f32>(std::max(report.invocationsBefore, 1u)));
+            const f32 byteSaving =
+              100.0f * (1.0f - CAST<f32>(report.bytesAfter) / CAST<f32>(std::max<Vulkano::u64>(report.bytesBefore, 1)));
+            std::printf("%-16.*s %9u %8u -> %6u %6.3f -> %5.3f %7u (-%4.1f%%) %9llu (-%4.1f%%) %6.1fms\n",
+                        CAST<int>(sample.name.size()),
+                        sample.name.data(),
+                        report.triangles,
+                        report.sourceVertices,
+                        report.vertices,
+                        report.AcmrBefore(),
+                        report.AcmrAfter(),
+                        report.invocationsAfter,
+                        invocationSaving,
+                        CAST<unsigned long long>(report.bytesAfter),
+                        byteSaving,
+                        ms);
+
+            allReduced &= report.invocationsAfter <= report.invocationsBefore && report.bytesAfter < report.bytesBefore;
+        }
+
+        return allReduced ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+}  // namespace Benchmarks
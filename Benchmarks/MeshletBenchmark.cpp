@@ -0,0 +1,426 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Benchmarks.hpp"
+
+#include <Vulkano/FrameSynchronizer.hpp>
+#include <Vulkano/GeometryArena.hpp>
+#include <Vulkano/JobSystem.hpp>
+#include <Vulkano/MeshProcessing.hpp>
+#include <Vulkano/MeshletRenderer.hpp>
+#include <Vulkano/PipelineCompiler.hpp>
+#include <Vulkano/ShaderLibrary.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Benchmarks {
+    namespace {
+        using Vulkano::f32;
+        using Vulkano::u32;
+        using Vulkano::u64;
+
+        constexpr u32 kWidth {1920};
+        constexpr u32 kHeight {1080};
+        constexpr u32 kFramesInFlight {2};
+        constexpr VkFormat kColorFormat {VK_FORMAT_R8G8B8A8_UNORM};
+        constexpr VkFormat kDepthFormat {VK_FORMAT_D32_SFLOAT};
+        constexpr f32 kPi {3.14159265f};
+
+        /// @brief Camera at the origin looking down -Z, Y flipped for Vulkan so counter-clockwise stays front-facing
+        Vulkano::Mat4 Perspective(f32 fovY, f32 aspect, f32 zNear, f32 zFar) {
+            const f32 f = 1.0f / std::tan(fovY * 0.5f);
+
+            Vulkano::Mat4 m {};
+            m[0]  = f / aspect;
+            m[5]  = -f;
+            m[10] = zFar / (zNear - zFar);
+            m[11] = -1.0f;
+            m[14] = zNear * zFar / (zNear - zFar);
+            return m;
+        }
+
+        /// @brief Dense UV sphere with counter-clockwise outward faces
+        Vulkano::ProcessedMesh MakeSphere(u32 columns, u32 rows) {
+            std::vector<Vulkano::SourceVertex> vertices;
+            for (u32 y = 0; y <= rows; y++) {
+                for (u32 x = 0; x <= columns; x++) {
+                    const f32 theta = CAST<f32>(x) / CAST<f32>(columns) * 2.0f * kPi;
+                    const f32 phi   = CAST<f32>(y) / CAST<f32>(rows) * kPi;
+
+                    Vulkano::SourceVertex vertex;
+                    vertex.normal[0] = std::sin(phi) * std::cos(theta);
+                    vertex.normal[1] = std::cos(phi);
+                    vertex.normal[2] = std::sin(phi) * std::sin(theta);
+                    std::copy_n(vertex.normal, 3, vertex.position);
+                    vertex.uv[0] = CAST<f32>(x) / CAST<f32>(columns);
+                    vertex.uv[1] = CAST<f32>(y) / CAST<f32>(rows);
+                    vertices.push_back(vertex);
+                }
+            }
+
+            std::vector<u32> indices;
+            for (u32 y = 0; y < rows; y++) {
+                for (u32 x = 0; x < columns; x++) {
+                    const u32 a = y * (columns + 1) + x;
+                    const u32 c = a + columns + 1;
+                    indices.insert(indices.end(), {a, a + 1, c, a + 1, c + 1, c});
+                }
+            }
+
+            auto mesh = Vulkano::ProcessMesh(vertices, indices);
+            Vulkano::AssertResult(mesh);
+            return std::move(mesh.value());
+        }
+
+        /// @brief Offscreen color or depth attachment
+        struct Attachment {
+            VkImage image {VK_NULL_HANDLE};
+            VmaAllocation allocation {VK_NULL_HANDLE};
+            VkImageView view {VK_NULL_HANDLE};
+        };
+
+        Attachment CreateAttachment(Vulkano::VulkanContext& context, VkFormat format, VkImageUsageFlags usage) {
+            const VkImageAspectFlags aspect =
+              format == kDepthFormat ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+
+            VkImageCreateInfo imageInfo {};
+            imageInfo.sType       = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.imageType   = VK_IMAGE_TYPE_2D;
+            imageInfo.format      = format;
+            imageInfo.extent      = {kWidth, kHeight, 1};
+            imageInfo.mipLevels   = 1;
+            imageInfo.arrayLayers = 1;
+            imageInfo.samples     = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.tiling      = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.usage       = usage;
+
+            VmaAllocationCreateInfo allocationInfo {};
+            allocationInfo.usage = VMA_MEMORY_USAGE_AUTO;
+
+            Attachment attachment;
+            if (vmaCreateImage(context.GetAllocator(),
+                               &imageInfo,
+                               &allocationInfo,
+                               &attachment.image,
+                               &attachment.allocation,
+                               nullptr) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create attachment image");
+            }
+
+            VkImageViewCreateInfo viewInfo {};
+            viewInfo.sType                       = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.image                       = attachment.image;
+            viewInfo.viewType                    = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format                      = format;
+            viewInfo.subresourceRange.aspectMask = aspect;
+            viewInfo.subresourceRange.levelCount = 1;
+            viewInfo.subresourceRange.layerCount = 1;
+            if (vkCreateImageView(context.GetDevice(), &viewInfo, nullptr, &attachment.view) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create attachment view");
+            }
+            return attachment;
+        }
+
+        void DestroyAttachment(Vulkano::VulkanContext& context, Attachment& attachment) {
+            vkDestroyImageView(context.GetDevice(), attachment.view, nullptr);
+            vmaDestroyImage(context.GetAllocator(), attachment.image, attachment.allocation);
+            attachment = {};
+        }
+
+        /// @brief Discard both attachments' contents and make them writable for this frame's rendering
+        void PrepareAttachments(VkCommandBuffer commandBuffer, const Attachment& color, const Attachment& depth) {
+            VkImageMemoryBarrier barriers[2] {};
+            for (auto& barrier : barriers) {
+                barrier.sType                       = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+                barrier.oldLayout                   = VK_IMAGE_LAYOUT_UNDEFINED;
+                barrier.srcQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+                barrier.dstQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+                barrier.subresourceRange.levelCount = 1;
+                barrier.subresourceRange.layerCount = 1;
+            }
+            barriers[0].image                       = color.image;
+            barriers[0].newLayout                   = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            barriers[0].srcAccessMask               = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            barriers[0].dstAccessMask               = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            barriers[0].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            barriers[1].image                       = depth.image;
+            barriers[1].newLayout                   = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
+            barriers[1].srcAccessMask               = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            barriers[1].dstAccessMask =
+              VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            barriers[1].subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+
+            vkCmdPipelineBarrier(commandBuffer,
+                                 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                                   VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                                 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                                   VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
+                                 0,
+                                 0,
+                                 nullptr,
+                                 0,
+                                 nullptr,
+                                 2,
+                                 barriers);
+        }
+
+        struct PathResult {
+            double gpuMs {0.0};
+            u64 triangles {0};
+            u32 taskGroups {0};
+            u32 drawCommands {0};
+        };
+
+        /// @brief Render the instance grid for a number of frames with one renderer path and time the draws
+        PathResult RunPath(Vulkano::VulkanContext& context,
+                           Vulkano::PipelineCompiler& pipelines,
+                           const Vulkano::ProcessedMesh& mesh,
+                           const std::vector<Vulkano::MeshletInstance>& instances,
+                           const Vulkano::MeshletRenderer::View& view,
+                           bool meshShaders,
+                           u32 frames) {
+            using namespace Vulkano;
+
+            FrameSynchronizer frameSync;
+            GeometryArena arena;
+            MeshletRenderer renderer;
+            AssertResult(frameSync.Initialize(&context, kFramesInFlight));
+
+            GeometryArena::Config arenaConfig;
+            arenaConfig.vertexStride   = sizeof(PackedVertex);
+            arenaConfig.vertexCapacity = CAST<u32>(mesh.vertices.size());
+            arenaConfig.indexCapacity  = CAST<u32>(mesh.indices.size());
+            AssertResult(arena.Initialize(&context, arenaConfig));
+
+            MeshletRenderer::Config rendererConfig;
+            rendererConfig.maxMeshes        = 1;
+            rendererConfig.maxMeshlets      = CAST<u32>(mesh.meshlets.meshlets.size());
+            rendererConfig.maxInstances     = CAST<u32>(instances.size());
+            rendererConfig.framesInFlight   = kFramesInFlight;
+            rendererConfig.colorFormat      = kColorFormat;
+            rendererConfig.depthFormat      = kDepthFormat;
+            rendererConfig.allowMeshShaders = meshShaders;
+            AssertResult(renderer.Initialize(&context, &pipelines, &arena, rendererConfig));
+
+            Attachment color = CreateAttachment(context, kColorFormat, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT);
+            Attachment depth = CreateAttachment(context, kDepthFormat, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
+
+            VkQueryPoolCreateInfo queryInfo {};
+            queryInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            queryInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+            queryInfo.queryCount = frames * 2;
+            VkQueryPool queries  = VK_NULL_HANDLE;
+            if (vkCreateQueryPool(context.GetDevice(), &queryInfo, nullptr, &queries) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create timestamp query pool");
+            }
+
+            const MeshletRenderer::Batch batch {0, 0, CAST<u32>(instances.size())};
+            PathResult result;
+
+            // One extra frame up front uploads the mesh and instances and is not timed
+            for (u32 frame = 0; frame <= frames; frame++) {
+                AssertResult(frameSync.BeginFrame());
+                arena.BeginFrame(frameSync);
+                renderer.BeginFrame(frameSync);
+
+                if (frame == 0) {
+                    AssertResult(renderer.AddMesh(mesh));
+                    AssertResult(renderer.UpdateInstances(0, instances));
+                }
+
+                const VkCommandBuffer commandBuffer = frameSync.GetCurrentCommandBuffer();
+                VkCommandBufferBeginInfo beginInfo {};
+                beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                vkBeginCommandBuffer(commandBuffer, &beginInfo);
+                if (frame == 0) { vkCmdResetQueryPool(commandBuffer, queries, 0, frames * 2); }
+
+                arena.Flush(frameSync);
+                AssertResult(renderer.Prepare(frameSync, view));
+                PrepareAttachments(commandBuffer, color, depth);
+
+                VkRenderingAttachmentInfo colorAttachment {};
+                colorAttachment.sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+                colorAttachment.imageView   = color.view;
+                colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+                colorAttachment.loadOp      = VK_ATTACHMENT_LOAD_OP_CLEAR;
+                colorAttachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
+
+                VkRenderingAttachmentInfo depthAttachment {};
+                depthAttachment.sType                   = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+                depthAttachment.imageView               = depth.view;
+                depthAttachment.imageLayout             = VK_IMAGE_LAYOUT_DEPTH_ATTACHMENT_OPTIMAL;
+                depthAttachment.loadOp                  = VK_ATTACHMENT_LOAD_OP_CLEAR;
+                depthAttachment.storeOp                 = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+                depthAttachment.clearValue.depthStencil = {1.0f, 0};
+
+                VkRenderingInfo renderingInfo {};
+                renderingInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO;
+                renderingInfo.renderArea           = {{0, 0}, {kWidth, kHeight}};
+                renderingInfo.layerCount           = 1;
+                renderingInfo.colorAttachmentCount = 1;
+                renderingInfo.pColorAttachments    = &colorAttachment;
+                renderingInfo.pDepthAttachment     = &depthAttachment;
+
+                const VkViewport viewport {0.0f, 0.0f, CAST<f32>(kWidth), CAST<f32>(kHeight), 0.0f, 1.0f};
+                const VkRect2D scissor {{0, 0}, {kWidth, kHeight}};
+
+                vkCmdBeginRendering(commandBuffer, &renderingInfo);
+                vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+                vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+                const u32 query = (frame - 1) * 2;
+                if (frame > 0) {
+                    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queries, query);
+                }
+                AssertResult(renderer.Draw(frameSync, std::span(&batch, 1)));
+                if (frame > 0) {
+                    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queries, query + 1);
+                }
+                vkCmdEndRendering(commandBuffer);
+                vkEndCommandBuffer(commandBuffer);
+
+                VkSubmitInfo submitInfo {};
+                submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                submitInfo.commandBufferCount = 1;
+                submitInfo.pCommandBuffers    = &commandBuffer;
+                if (vkQueueSubmit(context.GetGraphicsQueue(), 1, &submitInfo, frameSync.GetCurrentFence()) !=
+                    VK_SUCCESS) {
+                    throw std::runtime_error("Failed to submit meshlet frame");
+                }
+                frameSync.EndFrame();
+            }
+            context.WaitIdle();
+
+            std::vector<u64> timestamps(frames * 2);
+            if (vkGetQueryPoolResults(context.GetDevice(),
+                                      queries,
+                                      0,
+                                      frames * 2,
+                                      timestamps.size() * sizeof(u64),
+                                      timestamps.data(),
+                                      sizeof(u64),
+                                      VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to read timestamps");
+            }
+
+            const f32 period = context.GetDeviceProperties().limits.timestampPeriod;
+            for (u32 frame = 0; frame < frames; frame++) {
+                result.gpuMs += CAST<double>(timestamps[frame * 2 + 1] - timestamps[frame * 2]) * period / 1.0e6;
+            }
+            result.gpuMs /= frames;
+
+            const MeshletRenderer::Stats& stats = renderer.GetStats();
+            result.triangles                    = stats.triangles;
+            result.taskGroups                   = stats.taskGroups;
+            result.drawCommands                 = stats.drawCommands;
+
+            vkDestroyQueryPool(context.GetDevice(), queries, nullptr);
+            DestroyAttachment(context, depth);
+            DestroyAttachment(context, color);
+            renderer.Shutdown();
+            arena.Shutdown();
+            frameSync.Shutdown();
+            return result;
+        }
+    }  // namespace
+
+    int RunMeshletBenchmark(std::span<char*> args) {
+        using namespace Vulkano;
+
+        const u32 gridSize = ParseCount(args, 0, 24);
+        const u32 frames   = ParseCount(args, 1, 50);
+
+        VulkanContext context;
+        AssertResult(CreateHeadlessContext(context));
+
+        if (!context.GetDeviceProperties().limits.timestampComputeAndGraphics) {
+            std::fprintf(stderr, "Device doesn't support timestamps on graphics queues\n");
+            return EXIT_FAILURE;
+        }
+
+        const bool meshShaders = context.GetCapabilities().meshShaders;
+        std::vector<const char*> shaderNames = {"MeshletFallback.vert", "Meshlet.frag"};
+        if (meshShaders) { shaderNames.insert(shaderNames.end(), {"Meshlet.task", "Meshlet.mesh"}); }
+
+        JobSystem jobs;
+        ShaderLibrary shaders;
+        PipelineCompiler pipelines;
+        AssertResult(jobs.Initialize());
+        for (const char* name : shaderNames) {
+            const std::filesystem::path path = std::filesystem::path("Shaders") / (std::string(name) + ".spv");
+            if (!std::filesystem::exists(path)) {
+                std::fprintf(stderr, "Missing %s (run from the build's bin directory)\n", path.string().c_str());
+                return EXIT_FAILURE;
+            }
+            shaders.LoadAsync(jobs, name, path);
+        }
+        AssertResult(shaders.Initialize(&context));
+        AssertResult(pipelines.Initialize(&context, &jobs, &shaders));
+
+        // A grid of dense spheres wider than the view, so frustum culling has work to do; half of every visible
+        // sphere faces away, which is what the normal cones catch
+        const ProcessedMesh sphere = MakeSphere(256, 128);
+        std::vector<MeshletInstance> instances;
+        for (u32 y = 0; y < gridSize; y++) {
+            for (u32 x = 0; x < gridSize; x++) {
+                MeshletInstance instance;
+                instance.position[0] = (CAST<f32>(x) - CAST<f32>(gridSize - 1) * 0.5f) * 3.0f;
+                instance.position[1] = (CAST<f32>(y) - CAST<f32>(gridSize - 1) * 0.5f) * 3.0f;
+                instance.position[2] = -CAST<f32>(gridSize) * 2.0f;
+                instances.push_back(instance);
+            }
+        }
+
+        MeshletRenderer::View view;
+        view.viewProjection = Perspective(1.0471976f, CAST<f32>(kWidth) / CAST<f32>(kHeight), 0.1f, 1000.0f);
+
+        std::printf("Device: %s\n", context.GetDeviceProperties().deviceName);
+        std::printf("Mesh shaders: %s\n", meshShaders ? "yes" : "no");
+        std::printf("Mesh: %u triangles in %u meshlets, %zu instances\n",
+                    sphere.report.triangles,
+                    sphere.report.meshlets,
+                    instances.size());
+        std::printf("%-22s %10s %12s %14s\n", "Path", "GPU time", "Scene tris", "Tris/second");
+
+        const auto print = [](const char* name, const PathResult& result) {
+            const double seconds   = result.gpuMs / 1000.0;
+            const double perSecond = seconds > 0.0 ? CAST<double>(result.triangles) / seconds : 0.0;
+            std::printf("%-22s %8.3fms %12llu %12.2fG\n",
+                        name,
+                        result.gpuMs,
+                        CAST<unsigned long long>(result.triangles),
+                        perSecond / 1.0e9);
+        };
+
+        const PathResult fallback = RunPath(context, pipelines, sphere, instances, view, false, frames);
+        print("Multi-draw indirect", fallback);
+
+        PathResult mesh;
+        if (meshShaders) {
+            mesh = RunPath(context, pipelines, sphere, instances, view, true, frames);
+            print("Mesh shader (culled)", mesh);
+
+            view.frustumCulling = false;
+            view.coneCulling    = false;
+            print("Mesh shader (no cull)", RunPath(context, pipelines, sphere, instances, view, true, frames));
+        }
+
+        pipelines.Shutdown();
+        shaders.Shutdown();
+        context.Shutdown();
+        jobs.Shutdown();
+
+        return fallback.triangles == CAST<u64>(sphere.report.triangles) * instances.size() &&
+                   (!meshShaders || mesh.triangles == fallback.triangles)
+                 ? EXIT_SUCCESS
+                 : EXIT_FAILURE;
+    }
+}  // namespace Benchmarks
@@ -0,0 +1,259 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Benchmarks.hpp"
+
+#include <Vulkano/FrameSynchronizer.hpp>
+#include <Vulkano/JobSystem.hpp>
+#include <Vulkano/PipelineCompiler.hpp>
+#include <Vulkano/RenderTarget.hpp>
+#include <Vulkano/ShaderLibrary.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Benchmarks {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+        using Vulkano::f32;
+        using Vulkano::u32;
+        using Vulkano::u64;
+
+        constexpr VkExtent2D kExtent {1024, 1024};
+        constexpr u32 kFramesInFlight {2};
+        constexpr u32 kMaxViews {6};
+
+        constexpr const char* kLayoutName {"MultiviewBench"};
+
+        /// @brief Multiview.vert push constants
+        struct Push {
+            f32 views[kMaxViews][4];  // xy offset, zw scale
+            f32 quad[4];              // xy corner, zw size
+            u32 viewBase;
+        };
+
+        struct ModeResult {
+            double recordMs {0.0};  // CPU time recording the passes, per frame
+            double gpuMs {0.0};
+            u32 passes {0};  // Render passes per frame
+            u32 drawCalls {0};
+        };
+    }  // namespace
+
+    int RunMultiviewBenchmark(std::span<char*> args) {
+        using namespace Vulkano;
+
+        const u32 views  = std::clamp(ParseCount(args, 0, 2), 1u, kMaxViews);
+        const u32 draws  = ParseCount(args, 1, 4000);
+        const u32 frames = ParseCount(args, 2, 200);
+
+        VulkanContext context;
+        AssertResult(CreateHeadlessContext(context));
+
+        if (!context.GetCapabilities().multiview) {
+            std::fprintf(stderr, "Device doesn't support multiview\n");
+            return EXIT_FAILURE;
+        }
+        if (!context.GetDeviceProperties().limits.timestampComputeAndGraphics) {
+            std::fprintf(stderr, "Device doesn't support timestamps on graphics queues\n");
+            return EXIT_FAILURE;
+        }
+
+        JobSystem jobs;
+        ShaderLibrary shaders;
+        PipelineCompiler pipelines;
+        AssertResult(jobs.Initialize());
+        for (const char* name : {"Multiview.vert", "Multiview.frag"}) {
+            const std::filesystem::path path = std::filesystem::path("Shaders") / (std::string(name) + ".spv");
+            if (!std::filesystem::exists(path)) {
+                std::fprintf(stderr, "Missing %s (run from the build's bin directory)\n", path.string().c_str());
+                return EXIT_FAILURE;
+            }
+            shaders.LoadAsync(jobs, name, path);
+        }
+        AssertResult(shaders.Initialize(&context));
+        AssertResult(pipelines.Initialize(&context, &jobs, &shaders));
+
+        FrameSynchronizer frameSync;
+        AssertResult(frameSync.Initialize(&context, kFramesInFlight));
+
+        RenderTarget target;
+        RenderTarget::Config targetConfig;
+        targetConfig.extent = kExtent;
+        targetConfig.layers = views;
+        AssertResult(target.Initialize(&context, targetConfig));
+
+        const VkDevice device = context.GetDevice();
+        const VkPushConstantRange pushRange {VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(Push)};
+
+        VkPipelineLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges    = &pushRange;
+        VkPipelineLayout pipelineLayout   = VK_NULL_HANDLE;
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create multiview pipeline layout");
+        }
+        pipelines.RegisterLayout(kLayoutName, pipelineLayout);
+
+        GraphicsPipelineDesc desc;
+        desc.layout   = kLayoutName;
+        desc.stages   = {{VK_SHADER_STAGE_VERTEX_BIT, "Multiview.vert", "main", {}},
+                         {VK_SHADER_STAGE_FRAGMENT_BIT, "Multiview.frag", "main", {}}};
+        desc.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+
+        target.ConfigurePipeline(desc, true);
+        const auto multiviewPipeline = pipelines.Get(desc);
+        target.ConfigurePipeline(desc, false);
+        const auto layerPipeline = pipelines.Get(desc);
+        if (!multiviewPipeline || !layerPipeline) {
+            throw std::runtime_error(!multiviewPipeline ? multiviewPipeline.error() : layerPipeline.error());
+        }
+
+        // Views are shifted copies of the same scene, like eyes or neighboring cascades
+        Push push {};
+        for (u32 view = 0; view < kMaxViews; view++) {
+            push.views[view][0] = CAST<f32>(view) * 0.04f;
+            push.views[view][1] = 0.0f;
+            push.views[view][2] = 1.0f - CAST<f32>(view) * 0.05f;
+            push.views[view][3] = 1.0f - CAST<f32>(view) * 0.05f;
+        }
+
+        const u32 grid       = CAST<u32>(std::ceil(std::sqrt(CAST<f32>(draws))));
+        const f32 cell       = 2.0f / CAST<f32>(grid);
+        const auto drawQuads = [&](VkCommandBuffer commandBuffer) {
+            for (u32 draw = 0; draw < draws; draw++) {
+                const f32 quad[4] = {-1.0f + CAST<f32>(draw % grid) * cell,
+                                     -1.0f + CAST<f32>(draw / grid) * cell,
+                                     cell * 0.8f,
+                                     cell * 0.8f};
+                vkCmdPushConstants(
+                  commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, offsetof(Push, quad), sizeof(quad), quad);
+                vkCmdDraw(commandBuffer, 4, 1, 0, 0);
+            }
+        };
+
+        VkQueryPoolCreateInfo queryInfo {};
+        queryInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+        queryInfo.queryCount = kFramesInFlight * 2;
+        VkQueryPool queries  = VK_NULL_HANDLE;
+        if (vkCreateQueryPool(device, &queryInfo, nullptr, &queries) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create timestamp query pool");
+        }
+        const double timestampPeriod = context.GetDeviceProperties().limits.timestampPeriod;
+
+        const auto runMode = [&](bool multiview) {
+            ModeResult result;
+            result.passes    = multiview ? 1 : views;
+            result.drawCalls = draws * result.passes;
+
+            std::vector<bool> pending(kFramesInFlight, false);
+            u32 timedFrames = 0;
+            for (u32 frame = 0; frame < frames; frame++) {
+                AssertResult(frameSync.BeginFrame());
+                const u32 slot = frameSync.GetCurrentFrameIndex();
+                if (pending[slot]) {
+                    u64 timestamps[2] = {};
+                    if (vkGetQueryPoolResults(device,
+                                              queries,
+                                              slot * 2,
+                                              2,
+                                              sizeof(timestamps),
+                                              timestamps,
+                                              sizeof(u64),
+                                              VK_QUERY_RESULT_64_BIT) == VK_SUCCESS) {
+                        result.gpuMs += CAST<double>(timestamps[1] - timestamps[0]) * timestampPeriod / 1.0e6;
+                        timedFrames++;
+                    }
+                }
+
+                const VkCommandBuffer commandBuffer = frameSync.GetCurrentCommandBuffer();
+                VkCommandBufferBeginInfo beginInfo {};
+                beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+                vkBeginCommandBuffer(commandBuffer, &beginInfo);
+                vkCmdResetQueryPool(commandBuffer, queries, slot * 2, 2);
+                vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queries, slot * 2);
+
+                const VkClearColorValue clearColor {{0.0f, 0.0f, 0.0f, 1.0f}};
+                const auto recordStart = Clock::now();
+                for (u32 pass = 0; pass < result.passes; pass++) {
+                    push.viewBase = multiview ? 0 : pass;
+                    AssertResult(
+                      target.BeginRendering(commandBuffer, clearColor, multiview ? RenderTarget::kAllLayers : pass));
+                    vkCmdBindPipeline(
+                      commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, multiview ? *multiviewPipeline : *layerPipeline);
+                    vkCmdPushConstants(
+                      commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(Push), &push);
+                    drawQuads(commandBuffer);
+                    target.EndRendering(commandBuffer);
+                }
+                result.recordMs += std::chrono::duration<double, std::milli>(Clock::now() - recordStart).count();
+
+                vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queries, slot * 2 + 1);
+                vkEndCommandBuffer(commandBuffer);
+
+                VkSubmitInfo submitInfo {};
+                submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                submitInfo.commandBufferCount = 1;
+                submitInfo.pCommandBuffers    = &commandBuffer;
+                if (vkQueueSubmit(context.GetGraphicsQueue(), 1, &submitInfo, frameSync.GetCurrentFence()) !=
+                    VK_SUCCESS) {
+                    throw std::runtime_error("Failed to submit multiview frame");
+                }
+                pending[slot] = true;
+                frameSync.EndFrame();
+            }
+            context.WaitIdle();
+
+            result.recordMs /= std::max(frames, 1u);
+            result.gpuMs /= std::max(timedFrames, 1u);
+            return result;
+        };
+
+        const ModeResult perLayer  = runMode(false);
+        const ModeResult multiview = runMode(true);
+
+        std::printf("Device: %s\n", context.GetDeviceProperties().deviceName);
+        std::printf("%u views of %ux%u, %u quads per view, %u frames\n",
+                    views,
+                    kExtent.width,
+                    kExtent.height,
+                    draws,
+                    frames);
+        std::printf("%-18s %8s %12s %12s %10s\n", "", "Passes", "Draw calls", "Record ms", "GPU ms");
+        for (const auto& [name, result] :
+             {std::pair {"Layer at a time", perLayer}, std::pair {"Multiview", multiview}}) {
+            std::printf("%-18s %8u %12u %12.3f %10.3f\n",
+                        name,
+                        result.passes,
+                        result.drawCalls,
+                        result.recordMs,
+                        result.gpuMs);
+        }
+        std::printf("Recording speedup: %.2fx\n",
+                    multiview.recordMs > 0.0 ? perLayer.recordMs / multiview.recordMs : 0.0);
+
+        vkDestroyQueryPool(device, queries, nullptr);
+        target.Shutdown();
+        frameSync.Shutdown();
+        pipelines.Shutdown();
+        vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+        shaders.Shutdown();
+        context.Shutdown();
+        jobs.Shutdown();
+
+        return EXIT_SUCCESS;
+    }
+}  // namespace Benchmarks
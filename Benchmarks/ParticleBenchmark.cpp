@@ -0,0 +1,301 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Benchmarks.hpp"
+
+#include <Vulkano/FrameSynchronizer.hpp>
+#include <Vulkano/JobSystem.hpp>
+#include <Vulkano/ParticleSystem.hpp>
+#include <Vulkano/PipelineCompiler.hpp>
+#include <Vulkano/ShaderLibrary.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Benchmarks {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+        using Vulkano::f32;
+        using Vulkano::u32;
+        using Vulkano::u64;
+
+        constexpr u32 kWidth {1920};
+        constexpr u32 kHeight {1080};
+        constexpr u32 kFramesInFlight {2};
+        constexpr f32 kDeltaTime {1.0f / 60.0f};
+        constexpr f32 kLifetime {2.0f};
+        constexpr VkFormat kFormat {VK_FORMAT_R8G8B8A8_UNORM};
+
+        /// @brief Looking down -z with the particle fountain in view (column-major, y flipped for Vulkan)
+        Vulkano::Mat4 MakeViewProjection() {
+            const f32 aspect = CAST<f32>(kWidth) / CAST<f32>(kHeight);
+            const f32 scale  = 0.1f;
+            return {scale / aspect, 0.0f, 0.0f, 0.0f, 0.0f, -scale, 0.0f, 0.0f,
+                    0.0f,           0.0f, 0.0f, 0.0f, 0.0f, 0.0f,   0.5f, 1.0f};
+        }
+    }  // namespace
+
+    int RunParticleBenchmark(std::span<char*> args) {
+        using namespace Vulkano;
+
+        const u32 particleCount = ParseCount(args, 0, 1u << 20);
+        const u32 frames        = ParseCount(args, 1, 300);
+
+        VulkanContext context;
+        AssertResult(CreateHeadlessContext(context));
+
+        if (!context.GetDeviceProperties().limits.timestampComputeAndGraphics) {
+            std::fprintf(stderr, "Device doesn't support timestamps on graphics queues\n");
+            return EXIT_FAILURE;
+        }
+
+        JobSystem jobs;
+        ShaderLibrary shaders;
+        PipelineCompiler pipelines;
+        AssertResult(jobs.Initialize());
+        for (const char* name : {"ParticleScan.comp",
+                                 "ParticleScanBlocks.comp",
+                                 "ParticleSimulate.comp",
+                                 "ParticleEmit.comp",
+                                 "Particle.vert",
+                                 "Particle.frag"}) {
+            const std::filesystem::path path = std::filesystem::path("Shaders") / (std::string(name) + ".spv");
+            if (!std::filesystem::exists(path)) {
+                std::fprintf(stderr, "Missing %s (run from the build's bin directory)\n", path.string().c_str());
+                return EXIT_FAILURE;
+            }
+            shaders.LoadAsync(jobs, name, path);
+        }
+        AssertResult(shaders.Initialize(&context));
+        AssertResult(pipelines.Initialize(&context, &jobs, &shaders));
+
+        FrameSynchronizer frameSync;
+        AssertResult(frameSync.Initialize(&context, kFramesInFlight));
+
+        ParticleSystem particles;
+        ParticleSystem::Config particleConfig;
+        particleConfig.maxParticles   = particleCount;
+        particleConfig.framesInFlight = kFramesInFlight;
+        particleConfig.colorFormat    = kFormat;
+        AssertResult(particles.Initialize(&context, &pipelines, particleConfig));
+
+        // Spawning capacity / lifetime particles per second keeps the system full once the first ones expire
+        ParticleEmitter emitter;
+        emitter.radius         = 0.5f;
+        emitter.velocity[1]    = 6.0f;
+        emitter.velocityJitter = 3.0f;
+        emitter.rate           = CAST<f32>(particleCount) / kLifetime;
+        emitter.lifetime[0]    = kLifetime;
+        emitter.lifetime[1]    = kLifetime;
+        emitter.color          = 0x80FFA040;
+
+        ParticleSystem::Simulation simulation;
+        simulation.deltaTime = kDeltaTime;
+        simulation.drag      = 0.1f;
+
+        ParticleSystem::View view;
+        view.viewProjection = MakeViewProjection();
+
+        VkImageCreateInfo imageInfo {};
+        imageInfo.sType       = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType   = VK_IMAGE_TYPE_2D;
+        imageInfo.format      = kFormat;
+        imageInfo.extent      = {kWidth, kHeight, 1};
+        imageInfo.mipLevels   = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.samples     = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling      = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage       = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+        VmaAllocationCreateInfo allocationInfo {};
+        allocationInfo.usage = VMA_MEMORY_USAGE_AUTO;
+
+        VkImage target                 = VK_NULL_HANDLE;
+        VmaAllocation targetAllocation = VK_NULL_HANDLE;
+        if (vmaCreateImage(context.GetAllocator(), &imageInfo, &allocationInfo, &target, &targetAllocation, nullptr) !=
+            VK_SUCCESS) {
+            throw std::runtime_error("Failed to create render target");
+        }
+
+        VkImageViewCreateInfo viewInfo {};
+        viewInfo.sType                       = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image                       = target;
+        viewInfo.viewType                    = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format                      = kFormat;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.layerCount = 1;
+        VkImageView targetView               = VK_NULL_HANDLE;
+        if (vkCreateImageView(context.GetDevice(), &viewInfo, nullptr, &targetView) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create render target view");
+        }
+
+        VkQueryPoolCreateInfo queryInfo {};
+        queryInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+        queryInfo.queryCount = frames * 2;
+        VkQueryPool queries  = VK_NULL_HANDLE;
+        if (vkCreateQueryPool(context.GetDevice(), &queryInfo, nullptr, &queries) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create timestamp query pool");
+        }
+
+        double simulateMs = 0.0;
+        double frameMs    = 0.0;
+
+        // Fill up to the steady state first (one lifetime), then time the requested number of frames
+        const u32 warmup = CAST<u32>(kLifetime / kDeltaTime) + kFramesInFlight;
+        for (u32 frame = 0; frame < warmup + frames; frame++) {
+            const bool timed      = frame >= warmup;
+            const u32 query       = (frame - warmup) * 2;
+            const auto frameStart = Clock::now();
+
+            AssertResult(frameSync.BeginFrame());
+
+            const auto simulateStart = Clock::now();
+            AssertResult(particles.Simulate(simulation, std::span(&emitter, 1)));
+            const auto simulateEnd = Clock::now();
+
+            const VkCommandBuffer commandBuffer = frameSync.GetCurrentCommandBuffer();
+            VkCommandBufferBeginInfo beginInfo {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(commandBuffer, &beginInfo);
+            if (frame == 0) { vkCmdResetQueryPool(commandBuffer, queries, 0, frames * 2); }
+
+            VkImageMemoryBarrier barrier {};
+            barrier.sType                       = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.oldLayout                   = VK_IMAGE_LAYOUT_UNDEFINED;
+            barrier.newLayout                   = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            barrier.srcAccessMask               = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            barrier.dstAccessMask               = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+            barrier.srcQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image                       = target;
+            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            barrier.subresourceRange.levelCount = 1;
+            barrier.subresourceRange.layerCount = 1;
+            vkCmdPipelineBarrier(commandBuffer,
+                                 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                 0,
+                                 0,
+                                 nullptr,
+                                 0,
+                                 nullptr,
+                                 1,
+                                 &barrier);
+
+            VkRenderingAttachmentInfo colorAttachment {};
+            colorAttachment.sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+            colorAttachment.imageView   = targetView;
+            colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            colorAttachment.loadOp      = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            colorAttachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
+
+            VkRenderingInfo renderingInfo {};
+            renderingInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO;
+            renderingInfo.renderArea           = {{0, 0}, {kWidth, kHeight}};
+            renderingInfo.layerCount           = 1;
+            renderingInfo.colorAttachmentCount = 1;
+            renderingInfo.pColorAttachments    = &colorAttachment;
+
+            const VkViewport viewport {0.0f, 0.0f, CAST<f32>(kWidth), CAST<f32>(kHeight), 0.0f, 1.0f};
+            const VkRect2D scissor {{0, 0}, {kWidth, kHeight}};
+
+            vkCmdBeginRendering(commandBuffer, &renderingInfo);
+            vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+            vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+            if (timed) { vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queries, query); }
+            particles.Draw(frameSync, view);
+            if (timed) {
+                vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queries, query + 1);
+            }
+            vkCmdEndRendering(commandBuffer);
+            vkEndCommandBuffer(commandBuffer);
+
+            // Wait for this frame's simulation and tell the next-but-one simulation when drawing is done
+            const ParticleSystem::GraphicsSync sync = particles.GetGraphicsSync();
+
+            VkTimelineSemaphoreSubmitInfo timelineInfo {};
+            timelineInfo.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+            timelineInfo.waitSemaphoreValueCount   = 1;
+            timelineInfo.pWaitSemaphoreValues      = &sync.waitValue;
+            timelineInfo.signalSemaphoreValueCount = 1;
+            timelineInfo.pSignalSemaphoreValues    = &sync.signalValue;
+
+            VkSubmitInfo submitInfo {};
+            submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.pNext                = &timelineInfo;
+            submitInfo.waitSemaphoreCount   = 1;
+            submitInfo.pWaitSemaphores      = &sync.waitSemaphore;
+            submitInfo.pWaitDstStageMask    = &sync.waitStage;
+            submitInfo.commandBufferCount   = 1;
+            submitInfo.pCommandBuffers      = &commandBuffer;
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores    = &sync.signalSemaphore;
+            if (vkQueueSubmit(context.GetGraphicsQueue(), 1, &submitInfo, frameSync.GetCurrentFence()) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to submit particle frame");
+            }
+            frameSync.EndFrame();
+
+            if (timed) {
+                simulateMs += std::chrono::duration<double, std::milli>(simulateEnd - simulateStart).count();
+                frameMs += std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+            }
+        }
+        context.WaitIdle();
+
+        std::vector<u64> timestamps(frames * 2);
+        if (vkGetQueryPoolResults(context.GetDevice(),
+                                  queries,
+                                  0,
+                                  frames * 2,
+                                  timestamps.size() * sizeof(u64),
+                                  timestamps.data(),
+                                  sizeof(u64),
+                                  VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to read timestamps");
+        }
+
+        const f32 period = context.GetDeviceProperties().limits.timestampPeriod;
+        double drawMs    = 0.0;
+        for (u32 frame = 0; frame < frames; frame++) {
+            drawMs += CAST<double>(timestamps[frame * 2 + 1] - timestamps[frame * 2]) * period / 1.0e6;
+        }
+        drawMs /= frames;
+        simulateMs /= frames;
+        frameMs /= frames;
+
+        const ParticleSystem::Stats stats = particles.GetStats();
+        std::printf("Device: %s\n", context.GetDeviceProperties().deviceName);
+        std::printf("Capacity %u particles, %u alive, %u emitted per frame, async compute: %s\n",
+                    particleCount,
+                    stats.alive,
+                    stats.emitted,
+                    context.GetQueueFamilies().hasDiscreteCompute ? "yes" : "no");
+        std::printf("%-24s %8.3fms\n", "CPU Simulate (submit)", simulateMs);
+        std::printf("%-24s %8.3fms\n", "GPU draw", drawMs);
+        std::printf("%-24s %8.3fms (%.1fM particles/s)\n",
+                    "Frame",
+                    frameMs,
+                    frameMs > 0.0 ? CAST<double>(stats.alive) / (frameMs * 1.0e3) : 0.0);
+
+        vkDestroyQueryPool(context.GetDevice(), queries, nullptr);
+        vkDestroyImageView(context.GetDevice(), targetView, nullptr);
+        vmaDestroyImage(context.GetAllocator(), target, targetAllocation);
+        particles.Shutdown();
+        frameSync.Shutdown();
+        pipelines.Shutdown();
+        shaders.Shutdown();
+        context.Shutdown();
+        jobs.Shutdown();
+
+        return stats.alive > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+}  // namespace Benchmarks
@@ -0,0 +1,105 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Benchmarks.hpp"
+
+#include <Vulkano/Breadcrumbs.hpp>
+#include <Vulkano/FrameSynchronizer.hpp>
+#include <Vulkano/SwapchainManager.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace Benchmarks {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+        using Vulkano::u32;
+
+        constexpr u32 kWidth {1280};
+        constexpr u32 kHeight {720};
+        constexpr u32 kFramesInFlight {2};
+    }  // namespace
+
+    int RunRecoveryBenchmark(std::span<char*> args) {
+        using namespace Vulkano;
+
+        const u32 iterations = ParseCount(args, 0, 20);
+
+        // What device loss used to cost: instance, device, allocator, swapchain and frame sync from scratch
+        std::vector<double> coldSamples;
+        for (u32 i = 0; i < iterations; i++) {
+            const auto start = Clock::now();
+
+            VulkanContext context;
+            auto surface = CreateHeadlessSurfaceContext(context);
+            if (!surface) {
+                std::fprintf(stderr, "%s\n", surface.error().c_str());
+                return EXIT_FAILURE;
+            }
+            SwapchainManager swapchain;
+            FrameSynchronizer frameSync;
+            AssertResult(swapchain.Initialize(&context, *surface, kWidth, kHeight));
+            AssertResult(frameSync.Initialize(&context, kFramesInFlight));
+
+            coldSamples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+            frameSync.Shutdown();
+            swapchain.Shutdown();
+            vkDestroySurfaceKHR(context.GetInstance(), *surface, nullptr);
+            context.Shutdown();
+        }
+
+        // The device isn't actually lost, but RecoverDevice takes the same path either way
+        VulkanContext context;
+        auto surface = CreateHeadlessSurfaceContext(context);
+        if (!surface) {
+            std::fprintf(stderr, "%s\n", surface.error().c_str());
+            return EXIT_FAILURE;
+        }
+
+        SwapchainManager swapchain;
+        FrameSynchronizer frameSync;
+        Breadcrumbs breadcrumbs;
+        AssertResult(swapchain.Initialize(&context, *surface, kWidth, kHeight));
+        AssertResult(frameSync.Initialize(&context, kFramesInFlight));
+        AssertResult(breadcrumbs.Initialize(&context, {}));
+
+        auto& resources             = context.GetResources();
+        const auto frameSyncEntry   = resources.Register("Frame synchronizer", RecoveryStage::Core, frameSync);
+        const auto swapchainEntry   = resources.Register("Swapchain", RecoveryStage::Core, swapchain);
+        const auto breadcrumbsEntry = resources.Register("Breadcrumbs", RecoveryStage::Core, breadcrumbs);
+
+        std::vector<double> recoverySamples;
+        for (u32 i = 0; i < iterations; i++) {
+            AssertResult(context.RecoverDevice());
+            recoverySamples.push_back(context.GetRecoveryStats().lastRecoveryMs);
+        }
+
+        std::printf("Device: %s\n", context.GetDeviceProperties().deviceName);
+        std::printf("%u iterations, %ux%u swapchain, %u frames in flight\n",
+                    iterations,
+                    kWidth,
+                    kHeight,
+                    kFramesInFlight);
+        std::printf("%-18s %10s %10s\n", "", "Mean ms", "Median ms");
+        const Timings cold     = Summarize(coldSamples);
+        const Timings recovery = Summarize(recoverySamples);
+        std::printf("%-18s %10.3f %10.3f\n", "Cold start", cold.mean, cold.median);
+        std::printf("%-18s %10.3f %10.3f\n", "RecoverDevice", recovery.mean, recovery.median);
+        std::printf("Speedup: %.2fx\n", recovery.mean > 0.0 ? cold.mean / recovery.mean : 0.0);
+
+        resources.Unregister(breadcrumbsEntry);
+        resources.Unregister(swapchainEntry);
+        resources.Unregister(frameSyncEntry);
+        breadcrumbs.Shutdown();
+        frameSync.Shutdown();
+        swapchain.Shutdown();
+        vkDestroySurfaceKHR(context.GetInstance(), *surface, nullptr);
+        context.Shutdown();
+
+        return EXIT_SUCCESS;
+    }
+}  // namespace Benchmarks
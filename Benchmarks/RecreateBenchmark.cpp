@@ -0,0 +1,124 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Benchmarks.hpp"
+
+#include <Vulkano/SwapchainManager.hpp>
+
+#include <VkBootstrap.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Benchmarks {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+        using Vulkano::u32;
+
+        constexpr VkExtent2D kExtents[] = {{1280, 720}, {1920, 1080}};  // Alternated so every recreate resizes
+
+        /// @brief What SwapchainManager::Recreate used to do: a full vk-bootstrap build (surface formats, present
+        /// modes and capabilities all queried again) plus fresh image and view vectors
+        std::vector<double> RunBuilderRecreates(Vulkano::VulkanContext& context, VkSurfaceKHR surface, u32 count) {
+            const Vulkano::SwapchainConfig config;
+            const auto build = [&](VkExtent2D extent, const vkb::Swapchain* old) {
+                vkb::SwapchainBuilder builder(context.GetPhysicalDevice(), context.GetDevice(), surface);
+                builder.set_desired_format({config.preferredFormat, config.preferredColorSpace})
+                  .set_desired_present_mode(config.preferredPresentMode)
+                  .set_desired_min_image_count(config.minImageCount)
+                  .set_desired_extent(extent.width, extent.height)
+                  .add_fallback_present_mode(VK_PRESENT_MODE_FIFO_KHR)
+                  .add_fallback_format({VK_FORMAT_B8G8R8A8_SRGB, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR})
+                  .add_fallback_format({VK_FORMAT_R8G8B8A8_SRGB, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR});
+                if (old) { builder.set_old_swapchain(*old); }
+
+                auto result = builder.build();
+                if (!result) { throw std::runtime_error("Failed to build swapchain: " + result.error().message()); }
+                return result.value();
+            };
+
+            vkb::Swapchain swapchain       = build(kExtents[0], nullptr);
+            std::vector<VkImageView> views = swapchain.get_image_views().value();
+            std::vector<double> samples;
+            for (u32 i = 0; i < count; i++) {
+                const auto start = Clock::now();
+
+                context.WaitIdle();
+                swapchain.destroy_image_views(views);
+                vkb::Swapchain recreated = build(kExtents[(i + 1) % 2], &swapchain);
+                vkb::destroy_swapchain(swapchain);
+                swapchain = recreated;
+
+                const std::vector<VkImage> images = swapchain.get_images().value();
+                views                             = swapchain.get_image_views().value();
+
+                samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+                if (images.empty()) { throw std::runtime_error("Swapchain has no images"); }
+            }
+
+            swapchain.destroy_image_views(views);
+            vkb::destroy_swapchain(swapchain);
+            return samples;
+        }
+
+        std::vector<double> RunManagerRecreates(Vulkano::VulkanContext& context, VkSurfaceKHR surface, u32 count) {
+            Vulkano::SwapchainManager swapchain;
+            Vulkano::AssertResult(swapchain.Initialize(&context, surface, kExtents[0].width, kExtents[0].height));
+
+            std::vector<double> samples;
+            for (u32 i = 0; i < count; i++) {
+                const VkExtent2D extent = kExtents[(i + 1) % 2];
+                const auto start        = Clock::now();
+                Vulkano::AssertResult(swapchain.Recreate(extent.width, extent.height));
+                samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+            }
+
+            swapchain.Shutdown();
+            return samples;
+        }
+    }  // namespace
+
+    int RunRecreateBenchmark(std::span<char*> args) {
+        using namespace Vulkano;
+
+        const u32 iterations = ParseCount(args, 0, 200);
+
+        VulkanContext context;
+        const auto created = CreateHeadlessSurfaceContext(context);
+        if (!created) {
+            std::fprintf(stderr, "%s\n", created.error().c_str());
+            return EXIT_FAILURE;
+        }
+        const VkSurfaceKHR surface = *created;
+
+        std::vector<double> builder = RunBuilderRecreates(context, surface, iterations);
+        std::vector<double> manager = RunManagerRecreates(context, surface, iterations);
+
+        const Timings before = Summarize(builder);
+        const Timings after  = Summarize(manager);
+        std::printf("Device: %s\n", context.GetDeviceProperties().deviceName);
+        std::printf("%u recreates alternating %ux%u and %ux%u on a headless surface\n",
+                    iterations,
+                    kExtents[0].width,
+                    kExtents[0].height,
+                    kExtents[1].width,
+                    kExtents[1].height);
+        std::printf("%-28s %10s %10s %10s\n", "", "Mean", "Median", "Max");
+        for (const auto& [name, timings] : {std::pair {"vk-bootstrap rebuild", before},
+                                            std::pair {"SwapchainManager::Recreate", after}}) {
+            std::printf("%-28s %8.3fms %8.3fms %8.3fms\n", name, timings.mean, timings.median, timings.max);
+        }
+        std::printf("Speedup (median): %.2fx\n", after.median > 0.0 ? before.median / after.median : 0.0);
+
+        vkDestroySurfaceKHR(context.GetInstance(), surface, nullptr);
+        context.Shutdown();
+
+        return EXIT_SUCCESS;
+    }
+}  // namespace Benchmarks
@@ -0,0 +1,361 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Benchmarks.hpp"
+
+#include <Vulkano/FrameSynchronizer.hpp>
+#include <Vulkano/JobSystem.hpp>
+#include <Vulkano/PipelineCompiler.hpp>
+#include <Vulkano/ShaderLibrary.hpp>
+#include <Vulkano/SpriteBatcher.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Benchmarks {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+        using Vulkano::f32;
+        using Vulkano::u32;
+        using Vulkano::u64;
+
+        constexpr u32 kWidth {1920};
+        constexpr u32 kHeight {1080};
+        constexpr u32 kFramesInFlight {2};
+        constexpr u32 kTextureCount {64};
+        constexpr u32 kTextureSize {16};
+        constexpr u32 kLayerCount {8};
+        constexpr VkFormat kFormat {VK_FORMAT_R8G8B8A8_UNORM};
+
+        struct Image {
+            VkImage image {VK_NULL_HANDLE};
+            VmaAllocation allocation {VK_NULL_HANDLE};
+            VkImageView view {VK_NULL_HANDLE};
+        };
+
+        Image CreateImage(Vulkano::VulkanContext& context, u32 width, u32 height, VkImageUsageFlags usage) {
+            VkImageCreateInfo imageInfo {};
+            imageInfo.sType       = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+            imageInfo.imageType   = VK_IMAGE_TYPE_2D;
+            imageInfo.format      = kFormat;
+            imageInfo.extent      = {width, height, 1};
+            imageInfo.mipLevels   = 1;
+            imageInfo.arrayLayers = 1;
+            imageInfo.samples     = VK_SAMPLE_COUNT_1_BIT;
+            imageInfo.tiling      = VK_IMAGE_TILING_OPTIMAL;
+            imageInfo.usage       = usage;
+
+            VmaAllocationCreateInfo allocationInfo {};
+            allocationInfo.usage = VMA_MEMORY_USAGE_AUTO;
+
+            Image image;
+            if (vmaCreateImage(context.GetAllocator(),
+                               &imageInfo,
+                               &allocationInfo,
+                               &image.image,
+                               &image.allocation,
+                               nullptr) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create image");
+            }
+
+            VkImageViewCreateInfo viewInfo {};
+            viewInfo.sType                       = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+            viewInfo.image                       = image.image;
+            viewInfo.viewType                    = VK_IMAGE_VIEW_TYPE_2D;
+            viewInfo.format                      = kFormat;
+            viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            viewInfo.subresourceRange.levelCount = 1;
+            viewInfo.subresourceRange.layerCount = 1;
+            if (vkCreateImageView(context.GetDevice(), &viewInfo, nullptr, &image.view) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create image view");
+            }
+            return image;
+        }
+
+        void DestroyImage(Vulkano::VulkanContext& context, Image& image) {
+            vkDestroyImageView(context.GetDevice(), image.view, nullptr);
+            vmaDestroyImage(context.GetAllocator(), image.image, image.allocation);
+            image = {};
+        }
+
+        void Transition(VkCommandBuffer commandBuffer,
+                        VkImage image,
+                        VkImageLayout oldLayout,
+                        VkImageLayout newLayout,
+                        VkAccessFlags srcAccess,
+                        VkAccessFlags dstAccess,
+                        VkPipelineStageFlags srcStage,
+                        VkPipelineStageFlags dstStage) {
+            VkImageMemoryBarrier barrier {};
+            barrier.sType                       = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.oldLayout                   = oldLayout;
+            barrier.newLayout                   = newLayout;
+            barrier.srcAccessMask               = srcAccess;
+            barrier.dstAccessMask               = dstAccess;
+            barrier.srcQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex         = VK_QUEUE_FAMILY_IGNORED;
+            barrier.image                       = image;
+            barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            barrier.subresourceRange.levelCount = 1;
+            barrier.subresourceRange.layerCount = 1;
+
+            vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+        }
+
+        /// @brief Fill each texture with its own solid color and leave it ready for sampling
+        void ClearTextures(VkCommandBuffer commandBuffer, const std::vector<Image>& textures) {
+            const VkImageSubresourceRange range {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+            for (u32 i = 0; i < textures.size(); i++) {
+                const VkImage image = textures[i].image;
+                Transition(commandBuffer,
+                           image,
+                           VK_IMAGE_LAYOUT_UNDEFINED,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           0,
+                           VK_ACCESS_TRANSFER_WRITE_BIT,
+                           VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+                const VkClearColorValue color {{CAST<f32>(i % 4) / 3.0f,
+                                                CAST<f32>(i / 4 % 4) / 3.0f,
+                                                CAST<f32>(i / 16 % 4) / 3.0f,
+                                                1.0f}};
+                vkCmdClearColorImage(commandBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &color, 1, &range);
+
+                Transition(commandBuffer,
+                           image,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                           VK_ACCESS_TRANSFER_WRITE_BIT,
+                           VK_ACCESS_SHADER_READ_BIT,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT,
+                           VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+            }
+        }
+
+        std::vector<Vulkano::Sprite> MakeSprites(u32 count) {
+            std::mt19937 random {7};
+            std::uniform_real_distribution<f32> x(0.0f, CAST<f32>(kWidth));
+            std::uniform_real_distribution<f32> y(0.0f, CAST<f32>(kHeight));
+            std::uniform_real_distribution<f32> size(4.0f, 24.0f);
+            std::uniform_real_distribution<f32> angle(0.0f, 6.2831853f);
+
+            std::vector<Vulkano::Sprite> sprites(count);
+            for (auto& sprite : sprites) {
+                sprite.position[0] = x(random);
+                sprite.position[1] = y(random);
+                sprite.size[0]     = size(random);
+                sprite.size[1]     = sprite.size[0];
+                sprite.rotation    = angle(random);
+                sprite.color       = 0xC0FFFFFF;
+                sprite.texture     = random() % kTextureCount;
+                sprite.layer       = CAST<Vulkano::u16>(random() % kLayerCount);
+            }
+            return sprites;
+        }
+    }  // namespace
+
+    int RunSpriteBenchmark(std::span<char*> args) {
+        using namespace Vulkano;
+
+        const u32 spriteCount = ParseCount(args, 0, 200000);
+        const u32 frames      = ParseCount(args, 1, 50);
+
+        VulkanContext context;
+        AssertResult(CreateHeadlessContext(context));
+
+        if (!context.GetDeviceProperties().limits.timestampComputeAndGraphics) {
+            std::fprintf(stderr, "Device doesn't support timestamps on graphics queues\n");
+            return EXIT_FAILURE;
+        }
+        if (!context.GetCapabilities().bindlessTextures) {
+            std::fprintf(stderr, "Device doesn't support descriptor indexing for bindless textures\n");
+            return EXIT_FAILURE;
+        }
+
+        JobSystem jobs;
+        ShaderLibrary shaders;
+        PipelineCompiler pipelines;
+        AssertResult(jobs.Initialize());
+        for (const char* name : {"Sprite.vert", "Sprite.frag"}) {
+            const std::filesystem::path path = std::filesystem::path("Shaders") / (std::string(name) + ".spv");
+            if (!std::filesystem::exists(path)) {
+                std::fprintf(stderr, "Missing %s (run from the build's bin directory)\n", path.string().c_str());
+                return EXIT_FAILURE;
+            }
+            shaders.LoadAsync(jobs, name, path);
+        }
+        AssertResult(shaders.Initialize(&context));
+        AssertResult(pipelines.Initialize(&context, &jobs, &shaders));
+
+        FrameSynchronizer frameSync;
+        AssertResult(frameSync.Initialize(&context, kFramesInFlight));
+
+        SpriteBatcher batcher;
+        SpriteBatcher::Config batcherConfig;
+        batcherConfig.maxSprites     = spriteCount;
+        batcherConfig.maxTextures    = kTextureCount;
+        batcherConfig.framesInFlight = kFramesInFlight;
+        batcherConfig.colorFormat    = kFormat;
+        AssertResult(batcher.Initialize(&context, &pipelines, batcherConfig));
+
+        std::vector<Image> textures;
+        constexpr VkImageUsageFlags kTextureUsage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+        for (u32 i = 0; i < kTextureCount; i++) {
+            textures.push_back(CreateImage(context, kTextureSize, kTextureSize, kTextureUsage));
+            AssertResult(batcher.RegisterTexture(textures.back().view));
+        }
+        Image target = CreateImage(context, kWidth, kHeight, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT);
+
+        VkQueryPoolCreateInfo queryInfo {};
+        queryInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queryInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+        queryInfo.queryCount = frames * 2;
+        VkQueryPool queries  = VK_NULL_HANDLE;
+        if (vkCreateQueryPool(context.GetDevice(), &queryInfo, nullptr, &queries) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create timestamp query pool");
+        }
+
+        const std::vector<Sprite> sprites = MakeSprites(spriteCount);
+        double addMs                      = 0.0;
+        double flushMs                    = 0.0;
+
+        // Frame 0 clears the textures and warms up; it is not timed
+        for (u32 frame = 0; frame <= frames; frame++) {
+            AssertResult(frameSync.BeginFrame());
+            batcher.BeginFrame(frameSync);
+
+            const VkCommandBuffer commandBuffer = frameSync.GetCurrentCommandBuffer();
+            VkCommandBufferBeginInfo beginInfo {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(commandBuffer, &beginInfo);
+            if (frame == 0) {
+                vkCmdResetQueryPool(commandBuffer, queries, 0, frames * 2);
+                ClearTextures(commandBuffer, textures);
+            }
+
+            Transition(commandBuffer,
+                       target.image,
+                       VK_IMAGE_LAYOUT_UNDEFINED,
+                       VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                       VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                       VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+
+            VkRenderingAttachmentInfo colorAttachment {};
+            colorAttachment.sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+            colorAttachment.imageView   = target.view;
+            colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+            colorAttachment.loadOp      = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            colorAttachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
+
+            VkRenderingInfo renderingInfo {};
+            renderingInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO;
+            renderingInfo.renderArea           = {{0, 0}, {kWidth, kHeight}};
+            renderingInfo.layerCount           = 1;
+            renderingInfo.colorAttachmentCount = 1;
+            renderingInfo.pColorAttachments    = &colorAttachment;
+
+            const VkViewport viewport {0.0f, 0.0f, CAST<f32>(kWidth), CAST<f32>(kHeight), 0.0f, 1.0f};
+            const VkRect2D scissor {{0, 0}, {kWidth, kHeight}};
+
+            vkCmdBeginRendering(commandBuffer, &renderingInfo);
+            vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+            vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+            const u32 query = (frame - 1) * 2;
+            if (frame > 0) { vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queries, query); }
+
+            const auto addStart = Clock::now();
+            for (const Sprite& sprite : sprites) {
+                batcher.Add(sprite);
+            }
+            const auto flushStart = Clock::now();
+            AssertResult(batcher.Flush(frameSync, {}, {kWidth, kHeight}));
+            const auto flushEnd = Clock::now();
+            if (frame > 0) {
+                addMs += std::chrono::duration<double, std::milli>(flushStart - addStart).count();
+                flushMs += std::chrono::duration<double, std::milli>(flushEnd - flushStart).count();
+            }
+
+            if (frame > 0) {
+                vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queries, query + 1);
+            }
+            vkCmdEndRendering(commandBuffer);
+            vkEndCommandBuffer(commandBuffer);
+
+            VkSubmitInfo submitInfo {};
+            submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers    = &commandBuffer;
+            if (vkQueueSubmit(context.GetGraphicsQueue(), 1, &submitInfo, frameSync.GetCurrentFence()) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to submit sprite frame");
+            }
+            frameSync.EndFrame();
+        }
+        context.WaitIdle();
+
+        std::vector<u64> timestamps(frames * 2);
+        if (vkGetQueryPoolResults(context.GetDevice(),
+                                  queries,
+                                  0,
+                                  frames * 2,
+                                  timestamps.size() * sizeof(u64),
+                                  timestamps.data(),
+                                  sizeof(u64),
+                                  VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to read timestamps");
+        }
+
+        const f32 period = context.GetDeviceProperties().limits.timestampPeriod;
+        double gpuMs     = 0.0;
+        for (u32 frame = 0; frame < frames; frame++) {
+            gpuMs += CAST<double>(timestamps[frame * 2 + 1] - timestamps[frame * 2]) * period / 1.0e6;
+        }
+        gpuMs /= frames;
+        addMs /= frames;
+        flushMs /= frames;
+
+        const SpriteBatcher::Stats stats = batcher.GetStats();
+        const double cpuMs               = addMs + flushMs;
+        std::printf("Device: %s\n", context.GetDeviceProperties().deviceName);
+        std::printf("%u sprites, %u textures, %u layers, %ux%u target\n",
+                    spriteCount,
+                    kTextureCount,
+                    kLayerCount,
+                    kWidth,
+                    kHeight);
+        std::printf("Draws per frame: %u, radix passes: %u\n", stats.draws, stats.sortPasses);
+        std::printf("%-18s %10s %16s\n", "Stage", "Time", "Sprites/ms");
+        const auto print = [spriteCount](const char* name, double ms) {
+            std::printf("%-18s %8.3fms %16.0f\n", name, ms, ms > 0.0 ? CAST<double>(spriteCount) / ms : 0.0);
+        };
+        print("CPU add", addMs);
+        print("CPU sort+pack", flushMs);
+        print("CPU total", cpuMs);
+        print("GPU", gpuMs);
+
+        vkDestroyQueryPool(context.GetDevice(), queries, nullptr);
+        DestroyImage(context, target);
+        for (Image& texture : textures) {
+            DestroyImage(context, texture);
+        }
+        batcher.Shutdown();
+        frameSync.Shutdown();
+        pipelines.Shutdown();
+        shaders.Shutdown();
+        context.Shutdown();
+        jobs.Shutdown();
+
+        return stats.sprites == spriteCount && stats.droppedSprites == 0 && stats.draws == 1 ? EXIT_SUCCESS
+                                                                                            : EXIT_FAILURE;
+    }
+}  // namespace Benchmarks
@@ -0,0 +1,120 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Benchmarks.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace Benchmarks {
+    Vulkano::Result<void> CreateHeadlessContext(Vulkano::VulkanContext& context) {
+        Vulkano::VulkanContext::Config config;
+        config.instance.applicationName  = "VulkanoBenchmarks";
+        config.instance.enableValidation = false;
+        return context.Initialize(config);
+    }
+
+    Vulkano::Result<VkSurfaceKHR> CreateHeadlessSurfaceContext(Vulkano::VulkanContext& context) {
+        Vulkano::VulkanContext::InstanceConfig instanceConfig;
+        instanceConfig.applicationName    = "VulkanoBenchmarks";
+        instanceConfig.enableValidation   = false;
+        instanceConfig.instanceExtensions = {VK_KHR_SURFACE_EXTENSION_NAME, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME};
+        if (auto result = context.CreateInstance(instanceConfig); !result) {
+            return std::unexpected(result.error() + " (is VK_EXT_headless_surface available?)");
+        }
+
+        const auto createHeadlessSurface = RCAST<PFN_vkCreateHeadlessSurfaceEXT>(
+          vkGetInstanceProcAddr(context.GetInstance(), "vkCreateHeadlessSurfaceEXT"));
+        VkHeadlessSurfaceCreateInfoEXT surfaceInfo {};
+        surfaceInfo.sType    = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+        VkSurfaceKHR surface = VK_NULL_HANDLE;
+        if (!createHeadlessSurface ||
+            createHeadlessSurface(context.GetInstance(), &surfaceInfo, nullptr, &surface) != VK_SUCCESS) {
+            return std::unexpected("Failed to create headless surface");
+        }
+
+        Vulkano::VulkanContext::DeviceConfig deviceConfig;
+        deviceConfig.surface = surface;
+        if (auto result = context.CreateDevice(deviceConfig); !result) {
+            vkDestroySurfaceKHR(context.GetInstance(), surface, nullptr);
+            return std::unexpected(result.error());
+        }
+        return surface;
+    }
+
+    unsigned ParseCount(std::span<char*> args, size_t index, unsigned fallback) {
+        if (index >= args.size()) { return fallback; }
+        const unsigned long value = std::strtoul(args[index], nullptr, 10);
+        return value > 0 ? static_cast<unsigned>(value) : fallback;
+    }
+
+    Timings Summarize(std::vector<double>& samples) {
+        Timings timings;
+        if (samples.empty()) { return timings; }
+
+        std::ranges::sort(samples);
+        for (const double sample : samples) {
+            timings.mean += sample;
+        }
+        timings.mean /= static_cast<double>(samples.size());
+        timings.median = samples[samples.size() / 2];
+        timings.max    = samples.back();
+        return timings;
+    }
+}  // namespace Benchmarks
+
+namespace {
+    struct BenchmarkEntry {
+        std::string_view name;
+        std::string_view usage;
+        int (*run)(std::span<char*> args);
+    };
+
+    constexpr BenchmarkEntry kBenchmarks[] = {
+      {"descriptors", "[draws per frame] [frames]", Benchmarks::RunDescriptorBenchmark},
+      {"culling", "[instances] [frames]", Benchmarks::RunCullingBenchmark},
+      {"cpu-culling", "[instances] [frames]", Benchmarks::RunCpuCullingBenchmark},
+      {"mesh", "[cache size]", Benchmarks::RunMeshBenchmark},
+      {"meshlets", "[grid size] [frames]", Benchmarks::RunMeshletBenchmark},
+      {"sprites", "[sprites] [frames]", Benchmarks::RunSpriteBenchmark},
+      {"particles", "[particles] [frames]", Benchmarks::RunParticleBenchmark},
+      {"dynres", "[layers] [frames]", Benchmarks::RunDynamicResolutionBenchmark},
+      {"recreate", "[iterations]", Benchmarks::RunRecreateBenchmark},
+      {"compute-present", "[frames]", Benchmarks::RunComputePresentBenchmark},
+      {"multiview", "[views] [draws] [frames]", Benchmarks::RunMultiviewBenchmark},
+      {"breadcrumbs", "[passes] [frames]", Benchmarks::RunBreadcrumbBenchmark},
+      {"recovery", "[iterations]", Benchmarks::RunRecoveryBenchmark},
+    };
+
+    void PrintUsage() {
+        std::cout << "Usage: VulkanoBenchmarks <benchmark> [args]\n";
+        for (const auto& benchmark : kBenchmarks) {
+            std::cout << "  " << benchmark.name << ' ' << benchmark.usage << '\n';
+        }
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    const std::string_view name {argv[1]};
+    for (const auto& benchmark : kBenchmarks) {
+        if (benchmark.name != name) { continue; }
+        try {
+            return benchmark.run(std::span(argv + 2, static_cast<size_t>(argc - 2)));
+        } catch (const std::exception& e) {
+            std::cerr << name << ": " << e.what() << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+
+    PrintUsage();
+    return EXIT_FAILURE;
+}
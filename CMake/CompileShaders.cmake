@@ -0,0 +1,36 @@
+project(Vulkano)
+
+# Compiles the GLSL sources in Shaders/ to SPIR-V at bin/Shaders/<file>.spv.
+# glslc is optional: without it the library still builds and samples skip features whose shaders are missing.
+find_program(GLSLC_EXECUTABLE glslc HINTS $ENV{VULKAN_SDK}/bin $ENV{VULKAN_SDK}/Bin)
+
+file(GLOB VULKANO_SHADER_SOURCES
+    ${CMAKE_SOURCE_DIR}/Shaders/*.vert
+    ${CMAKE_SOURCE_DIR}/Shaders/*.frag
+    ${CMAKE_SOURCE_DIR}/Shaders/*.comp
+    ${CMAKE_SOURCE_DIR}/Shaders/*.task
+    ${CMAKE_SOURCE_DIR}/Shaders/*.mesh
+)
+
+set(VULKANO_SHADER_OUTPUT_DIR ${CMAKE_RUNTIME_OUTPUT_DIRECTORY}/Shaders)
+set(VULKANO_SPIRV_FILES)
+
+if (GLSLC_EXECUTABLE)
+    foreach (SHADER_SOURCE ${VULKANO_SHADER_SOURCES})
+        get_filename_component(SHADER_NAME ${SHADER_SOURCE} NAME)
+        set(SPIRV_FILE ${VULKANO_SHADER_OUTPUT_DIR}/${SHADER_NAME}.spv)
+
+        add_custom_command(
+            OUTPUT ${SPIRV_FILE}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${VULKANO_SHADER_OUTPUT_DIR}
+            COMMAND ${GLSLC_EXECUTABLE} --target-env=vulkan1.3 -O -I ${CMAKE_SOURCE_DIR}/Shaders -o ${SPIRV_FILE} ${SHADER_SOURCE}
+            DEPENDS ${SHADER_SOURCE}
+            COMMENT "Compiling shader ${SHADER_NAME}"
+        )
+        list(APPEND VULKANO_SPIRV_FILES ${SPIRV_FILE})
+    endforeach ()
+else ()
+    message(WARNING "glslc not found, shaders in Shaders/ will not be compiled")
+endif ()
+
+add_custom_target(VulkanoShaders ALL DEPENDS ${VULKANO_SPIRV_FILES})
@@ -0,0 +1,150 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+
+#include <vk_mem_alloc.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Vulkano {
+    class VulkanContext;
+
+    /// @brief GPU hang breadcrumbs: at pass boundaries each queue writes the pass it started and the pass it finished
+    /// into a small host-visible buffer, so after a fence timeout or device loss the last pass the GPU got through is
+    /// known. Markers are a single 4-byte write each.
+    ///
+    /// With VK_AMD_buffer_marker the writes are pipelined: "started" lands when the pass reaches the top of the pipe,
+    /// "completed" once everything recorded before it has finished. Otherwise they are vkCmdFillBuffer writes, which
+    /// only mean the queue got that far through the command stream (Config::preciseFallback puts a barrier in front
+    /// of the "completed" fill to make it exact), and must be recorded outside rendering. NVIDIA's diagnostic
+    /// checkpoints add per-stage checkpoints, and VK_EXT_device_fault a driver fault report on device loss.
+    class Breadcrumbs {
+    public:
+        /// @brief Most passes that can be registered
+        static constexpr u32 kMaxPasses {4095};
+
+        /// @brief GetQueueState pass for a queue that hasn't started or completed anything
+        static constexpr u32 kNoPass {UINT32_MAX};
+
+        /// @brief Configuration for breadcrumb setup
+        struct Config {
+            bool preciseFallback {false};  // Wait for prior work before fill-buffer "completed" markers
+        };
+
+        /// @brief Last pass a queue started and completed, as read from the marker buffer
+        struct QueueState {
+            u32 startedPass {kNoPass};
+            u64 startedFrame {0};
+            u32 completedPass {kNoPass};
+            u64 completedFrame {0};
+        };
+
+        Breadcrumbs() = default;
+        ~Breadcrumbs();
+
+        Breadcrumbs(const Breadcrumbs&)            = delete;
+        Breadcrumbs& operator=(const Breadcrumbs&) = delete;
+        Breadcrumbs(Breadcrumbs&&)                 = delete;
+        Breadcrumbs& operator=(Breadcrumbs&&)      = delete;
+
+        /// @brief Create the marker buffer, with a slot for each distinct queue of the context (graphics, compute,
+        /// transfer, present)
+        /// @param context Vulkan context with a created device
+        /// @param config Breadcrumb configuration
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context, const Config& config);
+
+        void Shutdown();
+
+        /// @brief Destroy the marker buffer for VulkanContext::RecoverDevice (see ResourceRegistry). Read the report
+        /// with Describe first; it goes with the buffer.
+        void ReleaseDeviceObjects();
+
+        /// @brief Create the marker buffer again for the recovered device's queues, keeping the registered passes
+        /// @return Result containing success or error message
+        Result<void> RecreateDeviceObjects();
+
+        /// @brief Name a pass. Call during setup, not while other threads record markers.
+        /// @return Result containing the pass ID for BeginPass and EndPass, or error message
+        Result<u32> RegisterPass(std::string_view name);
+
+        /// @brief Advance the frame number stamped into markers, so a report tells this frame's passes from
+        /// the previous ones
+        void BeginFrame() {
+            mFrame++;
+        }
+
+        /// @brief Record that a pass started. Outside rendering unless HasBufferMarkers().
+        /// @param commandBuffer Command buffer that will be submitted to queue
+        /// @param queue Queue of the context the command buffer is submitted to
+        /// @param pass Pass ID from RegisterPass
+        void BeginPass(VkCommandBuffer commandBuffer, VkQueue queue, u32 pass) const;
+
+        /// @brief Record that a pass finished. Outside rendering unless HasBufferMarkers().
+        void EndPass(VkCommandBuffer commandBuffer, VkQueue queue, u32 pass) const;
+
+        /// @brief Last started and completed pass of a queue (nothing for queues the context doesn't own)
+        V_ND QueueState GetQueueState(VkQueue queue) const;
+
+        /// @brief Registered name of a pass ID
+        V_ND std::string_view GetPassName(u32 pass) const;
+
+        /// @brief Human-readable report: last started and completed pass per queue, checkpoints and, after device
+        /// loss, the driver's fault report
+        /// @param deviceLost Whether a call returned VK_ERROR_DEVICE_LOST (fault info is only valid then)
+        V_ND std::string Describe(bool deviceLost) const;
+
+        /// @brief Markers are pipelined (VK_AMD_buffer_marker) and may be recorded inside rendering
+        V_ND bool HasBufferMarkers() const {
+            return mBufferMarkers;
+        }
+
+        V_ND bool IsInitialized() const {
+            return mContext != nullptr;
+        }
+
+    private:
+        struct TrackedQueue {
+            VkQueue queue {VK_NULL_HANDLE};
+            std::string name;
+        };
+
+        /// @brief Track the context's distinct queues and create the zeroed marker buffer for them
+        Result<void> CreateBuffer(VulkanContext* context);
+
+        void DestroyBuffer();
+
+        /// @brief Slot of a queue in the marker buffer, or kNoPass when it isn't tracked
+        V_ND u32 FindQueue(VkQueue queue) const;
+
+        /// @brief Write a marker through whichever mechanism the device supports
+        void WriteMarker(VkCommandBuffer commandBuffer, u32 slot, u32 pass, bool completed) const;
+
+        /// @brief Pack a pass and the low bits of the current frame; 0 is never a valid marker
+        V_ND u32 EncodeMarker(u32 pass) const;
+
+        /// @brief Unpack a marker into a pass and the most recent frame with matching low bits
+        void DecodeMarker(u32 marker, u32& pass, u64& frame) const;
+
+        V_ND std::string DescribeCheckpoints() const;
+        V_ND std::string DescribeFault() const;
+
+        VulkanContext* mContext {nullptr};
+        Config mConfig {};
+        bool mBufferMarkers {false};
+
+        VkBuffer mBuffer {VK_NULL_HANDLE};
+        VmaAllocation mAllocation {VK_NULL_HANDLE};
+        const volatile u32* mMarkers {nullptr};  // Two per queue: started, completed
+
+        std::vector<TrackedQueue> mQueues;
+        std::vector<std::string> mPassNames;
+        u64 mFrame {0};
+    };
+}  // namespace Vulkano
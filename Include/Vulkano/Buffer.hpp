@@ -0,0 +1,73 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+
+#include <vk_mem_alloc.h>
+
+namespace Vulkano {
+    class VulkanContext;
+
+    /// @brief A VkBuffer with its VMA allocation
+    class Buffer {
+    public:
+        /// @brief Configuration for buffer creation
+        struct Config {
+            VkDeviceSize size {0};
+            VkBufferUsageFlags usage {0};
+            bool hostVisible {false};  // Persistently mapped, host-coherent memory written sequentially by the CPU
+            bool concurrent {false};   // Shared by the graphics and compute families without ownership transfers
+        };
+
+        Buffer() = default;
+        ~Buffer();
+
+        Buffer(const Buffer&)            = delete;
+        Buffer& operator=(const Buffer&) = delete;
+        Buffer(Buffer&&)                 = delete;
+        Buffer& operator=(Buffer&&)      = delete;
+
+        /// @brief Create the buffer
+        /// @param context Vulkan context with a created device
+        /// @param config Buffer configuration
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context, const Config& config);
+
+        /// @brief Destroy the buffer (the caller makes sure the GPU is done with it)
+        void Shutdown();
+
+        V_ND VkBuffer GetBuffer() const {
+            return mBuffer;
+        }
+
+        V_ND VkDeviceSize GetSize() const {
+            return mSize;
+        }
+
+        /// @brief Mapped pointer (null unless created host-visible)
+        V_ND void* GetMapped() const {
+            return mMapped;
+        }
+
+        /// @brief Device address (0 unless created with VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT)
+        V_ND VkDeviceAddress GetDeviceAddress() const {
+            return mDeviceAddress;
+        }
+
+        V_ND bool IsInitialized() const {
+            return mBuffer != VK_NULL_HANDLE;
+        }
+
+    private:
+        VulkanContext* mContext {nullptr};
+        VkBuffer mBuffer {VK_NULL_HANDLE};
+        VmaAllocation mAllocation {VK_NULL_HANDLE};
+        VkDeviceSize mSize {0};
+        void* mMapped {nullptr};
+        VkDeviceAddress mDeviceAddress {0};
+    };
+}  // namespace Vulkano
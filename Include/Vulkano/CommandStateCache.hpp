@@ -0,0 +1,119 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "Pipeline.hpp"
+#include "VulkanContext.hpp"
+
+namespace Vulkano {
+    /// @brief Shadows the bound pipeline and dynamic state of one command buffer and drops vkCmdBind/vkCmdSet calls
+    /// that would not change anything. Pipelines must be bound through the cache so it knows which state the
+    /// pipeline overwrites; state a pipeline bakes in is forgotten on bind and set again on the next call.
+    class CommandStateCache {
+    public:
+        /// @brief Number of calls forwarded to and dropped before the command buffer since Begin
+        struct Stats {
+            u32 issued {0};
+            u32 skipped {0};
+        };
+
+        explicit CommandStateCache(const VulkanContext& context);
+
+        CommandStateCache(const CommandStateCache&)            = delete;
+        CommandStateCache& operator=(const CommandStateCache&) = delete;
+        CommandStateCache(CommandStateCache&&)                 = delete;
+        CommandStateCache& operator=(CommandStateCache&&)      = delete;
+
+        /// @brief Start tracking a command buffer in the recording state; nothing is assumed to be set
+        void Begin(VkCommandBuffer commandBuffer);
+
+        /// @brief Bind a pipeline
+        /// @param bindPoint Graphics or compute
+        /// @param pipeline Pipeline to bind
+        /// @param dynamicState The dynamicState the pipeline was created with (ignored for compute)
+        void BindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline, DynamicStateFlags dynamicState = 0);
+
+        /// @brief Set every state the description leaves dynamic to the description's values, so the draw looks
+        /// the same as with a fully baked pipeline
+        void ApplyDynamicState(const GraphicsPipelineDesc& desc);
+
+        void SetViewport(const VkViewport& viewport);
+        void SetScissor(const VkRect2D& scissor);
+        void SetCullMode(VkCullModeFlags cullMode);
+        void SetFrontFace(VkFrontFace frontFace);
+        void SetPrimitiveTopology(VkPrimitiveTopology topology);
+        void SetDepthTestEnable(bool enable);
+        void SetDepthWriteEnable(bool enable);
+        void SetDepthCompareOp(VkCompareOp compareOp);
+
+        // Only forwarded when the device supports the matching VK_EXT_extended_dynamic_state3 feature. The same
+        // value is applied to the first attachmentCount color attachments (at most 8).
+        void SetPolygonMode(VkPolygonMode polygonMode);
+        void SetColorBlendEnable(bool enable, u32 attachmentCount = 1);
+        void SetColorBlendEquation(const VkColorBlendEquationEXT& equation, u32 attachmentCount = 1);
+        void SetColorWriteMask(VkColorComponentFlags writeMask, u32 attachmentCount = 1);
+
+        V_ND VkCommandBuffer GetCommandBuffer() const {
+            return mCommandBuffer;
+        }
+
+        V_ND const Stats& GetStats() const {
+            return mStats;
+        }
+
+        /// @brief Dynamic state this device can set
+        V_ND DynamicStateFlags GetSupportedDynamicState() const {
+            return mSupported;
+        }
+
+    private:
+        static constexpr u32 kMaxColorAttachments {8};
+
+        /// @brief One bit per cached value
+        enum StateBit : u32 {
+            kViewport      = 1u << 0,
+            kScissor       = 1u << 1,
+            kCullMode      = 1u << 2,
+            kFrontFace     = 1u << 3,
+            kTopology      = 1u << 4,
+            kDepthTest     = 1u << 5,
+            kDepthWrite    = 1u << 6,
+            kDepthCompare  = 1u << 7,
+            kPolygonMode   = 1u << 8,
+            kBlendEnable   = 1u << 9,
+            kBlendEquation = 1u << 10,
+            kWriteMask     = 1u << 11,
+        };
+
+        /// @brief Returns true if the value is already set; otherwise records it as set and counts an issued call
+        bool IsCurrent(StateBit bit, bool equal);
+
+        const VulkanContext::Dispatch& mDispatch;
+        DynamicStateFlags mSupported {kDynamicStateCore};
+        VkCommandBuffer mCommandBuffer {VK_NULL_HANDLE};
+
+        VkPipeline mPipelines[2] {VK_NULL_HANDLE, VK_NULL_HANDLE};  // Graphics, compute
+        u32 mValid {0};
+        Stats mStats {};
+
+        VkViewport mViewport {};
+        VkRect2D mScissor {};
+        VkCullModeFlags mCullMode {0};
+        VkFrontFace mFrontFace {VK_FRONT_FACE_COUNTER_CLOCKWISE};
+        VkPrimitiveTopology mTopology {VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST};
+        bool mDepthTest {false};
+        bool mDepthWrite {false};
+        VkCompareOp mDepthCompareOp {VK_COMPARE_OP_NEVER};
+        VkPolygonMode mPolygonMode {VK_POLYGON_MODE_FILL};
+        bool mBlendEnable {false};
+        VkColorBlendEquationEXT mBlendEquation {};
+        VkColorComponentFlags mWriteMask {0};
+        u32 mBlendEnableCount {0};
+        u32 mBlendEquationCount {0};
+        u32 mWriteMaskCount {0};
+    };
+}  // namespace Vulkano
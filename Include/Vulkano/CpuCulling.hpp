@@ -0,0 +1,179 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "Frustum.hpp"
+#include "TransientRing.hpp"
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace Vulkano {
+    class JobSystem;
+
+    /// @brief Bounding volumes stored structure-of-arrays so the culler can load 8 instances per stream at once.
+    /// Every instance has a sphere (used for sphere tests and LOD) and box half-extents (used for box tests).
+    /// Streams are padded to a multiple of 8 so SIMD loads never read past the end.
+    class CullingBounds {
+    public:
+        static constexpr u32 kLaneCount = 8;
+
+        /// @brief Resize every stream; new instances are zero-sized spheres at the origin
+        void Resize(u32 count);
+
+        /// @brief Remove every instance
+        void Clear() {
+            Resize(0);
+        }
+
+        /// @brief Append an instance and return its index
+        u32 Add();
+
+        /// @brief Set an instance's bounds from a sphere; its box is the sphere's enclosing cube
+        void SetSphere(u32 index, f32 x, f32 y, f32 z, f32 radius);
+
+        /// @brief Set an instance's bounds from a box; its sphere is the box's enclosing sphere
+        void SetBox(u32 index, f32 x, f32 y, f32 z, f32 extentX, f32 extentY, f32 extentZ);
+
+        V_ND u32 Size() const {
+            return mCount;
+        }
+
+        V_ND const f32* CenterX() const {
+            return mCenterX.data();
+        }
+
+        V_ND const f32* CenterY() const {
+            return mCenterY.data();
+        }
+
+        V_ND const f32* CenterZ() const {
+            return mCenterZ.data();
+        }
+
+        V_ND const f32* Radius() const {
+            return mRadius.data();
+        }
+
+        V_ND const f32* ExtentX() const {
+            return mExtentX.data();
+        }
+
+        V_ND const f32* ExtentY() const {
+            return mExtentY.data();
+        }
+
+        V_ND const f32* ExtentZ() const {
+            return mExtentZ.data();
+        }
+
+    private:
+        u32 mCount {0};
+        std::vector<f32> mCenterX;
+        std::vector<f32> mCenterY;
+        std::vector<f32> mCenterZ;
+        std::vector<f32> mRadius;
+        std::vector<f32> mExtentX;
+        std::vector<f32> mExtentY;
+        std::vector<f32> mExtentZ;
+    };
+
+    /// @brief Frustum culling and LOD selection on the CPU, for draw paths that can't use GpuCulling. Instances
+    /// are tested 8 at a time (AVX2 when the build enables it, otherwise two 4-wide SSE or NEON halves, otherwise
+    /// scalar), chunks are spread over the job system, and the survivors are written as one compact, ascending
+    /// u32 index list per LOD into a TransientRing, ready to bind as a storage buffer or walk on the host.
+    class CpuCulling {
+    public:
+        static constexpr u32 kMaxLods = 8;
+
+        /// @brief Configuration for culling setup
+        struct Config {
+            u32 chunkSize {16384};  // Instances per job; rounded up to a multiple of 8
+            bool useSimd {true};    // False forces the scalar path (for comparison)
+        };
+
+        /// @brief Which bounding volume to test against the frustum
+        enum class Shape : u8 { Sphere, Box };
+
+        /// @brief What to cull against
+        struct View {
+            Mat4 viewProjection {};
+            f32 cameraPosition[3] {0.0f, 0.0f, 0.0f};
+            f32 projectionScale {1.0f};  // Projection[1][1], i.e. 1 / tan(fovY / 2)
+            Shape shape {Shape::Sphere};
+
+            /// @brief Projected-radius thresholds (fraction of half the viewport height), descending. An instance
+            /// whose projected radius is below thresholds[i] uses LOD i + 1 or coarser; empty means LOD 0 only.
+            std::span<const f32> lodThresholds {};
+
+            /// @brief Instances whose projected radius is below this are culled (0 disables)
+            f32 minProjectedSize {0.0f};
+        };
+
+        /// @brief Visible instances at one LOD
+        struct VisibleList {
+            TransientRing::Allocation allocation {};  // u32 indices; empty when count is 0
+            u32 count {0};
+
+            V_ND const u32* Indices() const {
+                return static_cast<const u32*>(allocation.mapped);
+            }
+        };
+
+        /// @brief Output of one Cull call
+        struct Output {
+            std::array<VisibleList, kMaxLods> lods {};
+            u32 lodCount {0};
+            u32 tested {0};
+            u32 visible {0};
+        };
+
+        CpuCulling() = default;
+        ~CpuCulling();
+
+        CpuCulling(const CpuCulling&)            = delete;
+        CpuCulling& operator=(const CpuCulling&) = delete;
+        CpuCulling(CpuCulling&&)                 = delete;
+        CpuCulling& operator=(CpuCulling&&)      = delete;
+
+        /// @brief Set up the culler
+        /// @param jobs Job system to spread chunks over (nullptr culls on the calling thread)
+        /// @param config Culling configuration
+        /// @return Result containing success or error message
+        Result<void> Initialize(JobSystem* jobs, const Config& config);
+
+        void Shutdown();
+
+        /// @brief Cull every instance in bounds and write the visible index lists into arena. Not thread-safe;
+        /// the culler owns scratch memory reused between calls.
+        /// @param bounds Instance bounds
+        /// @param view Camera, test shape and LOD thresholds
+        /// @param arena Current frame's transient ring
+        /// @return The visible lists, or an error if the arena is full or the view is invalid
+        Result<Output> Cull(const CullingBounds& bounds, const View& view, TransientRing& arena);
+
+        /// @brief Name of the SIMD path compiled in ("AVX2", "SSE", "NEON" or "Scalar")
+        static const char* GetSimdPath();
+
+        V_ND bool IsInitialized() const {
+            return mInitialized;
+        }
+
+    private:
+        /// @brief Per-chunk visible counts per LOD, filled by the test pass and turned into offsets for the scatter
+        using LodCounts = std::array<u32, kMaxLods>;
+
+        JobSystem* mJobs {nullptr};
+        Config mConfig {};
+        bool mInitialized {false};
+
+        std::vector<u32> mScratchIndices;  // Visible indices, packed at the start of each chunk's range
+        std::vector<u8> mScratchLods;      // LOD of each entry in mScratchIndices
+        std::vector<LodCounts> mChunkCounts;
+    };
+}  // namespace Vulkano
@@ -0,0 +1,162 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "Frustum.hpp"
+#include "TransientRing.hpp"
+
+#include <array>
+#include <atomic>
+#include <span>
+#include <string_view>
+
+namespace Vulkano {
+    class VulkanContext;
+    class PipelineCompiler;
+    class FrameSynchronizer;
+
+    /// @brief DebugDraw.vert vertex input
+    struct DebugVertex {
+        f32 position[3];  // World units, or pixels from the top-left corner for screen-space vertices
+        u32 color;        // RGBA8, red in the lowest byte
+        u32 screenSpace;  // Non-zero skips the view-projection
+    };
+
+    /// @brief Immediate-mode lines, boxes, text and graphs for debugging and HUDs. Calls append vertices straight
+    /// into this frame's region of a TransientRing through a lock-free bump counter per pipeline (lines and
+    /// triangles), so they can come from any thread and never allocate. Flush then issues one draw per pipeline:
+    /// triangles first, then lines on top. Nothing is depth-tested unless Config::depthTest is set, and screen-space
+    /// vertices always pass (they sit on the near plane).
+    ///
+    /// Needs DebugDraw.vert and DebugDraw.frag in the compiler's ShaderLibrary. Per frame, after
+    /// FrameSynchronizer::BeginFrame: BeginFrame, any number of draw calls, then Flush inside rendering once every
+    /// thread that draws has finished. Anything past the configured capacity is dropped and counted in Stats.
+    class DebugDraw {
+    public:
+        using Float3 = std::array<f32, 3>;
+
+        /// @brief Built-in font cell in pixels at scale 1 (5x7 glyphs plus spacing)
+        static constexpr f32 kGlyphWidth {6.0f};
+        static constexpr f32 kGlyphHeight {8.0f};
+
+        /// @brief Configuration for debug draw setup
+        struct Config {
+            u32 maxLineVertices {1u << 16};  // Per frame
+            u32 maxTriangleVertices {1u << 16};
+            u32 framesInFlight {2};
+            VkFormat colorFormat {VK_FORMAT_B8G8R8A8_SRGB};
+            VkFormat depthFormat {VK_FORMAT_UNDEFINED};  // Must match the rendering pass Flush is recorded in
+            bool depthTest {false};                      // Hide world-space shapes behind scene geometry
+        };
+
+        /// @brief What the last Flush drew
+        struct Stats {
+            u32 lineVertices {0};
+            u32 triangleVertices {0};
+            u32 droppedVertices {0};
+            u32 draws {0};
+        };
+
+        /// @brief Pack a color the way DebugVertex expects it
+        static constexpr u32 Rgba(u8 r, u8 g, u8 b, u8 a = 255) {
+            return CAST<u32>(r) | CAST<u32>(g) << 8 | CAST<u32>(b) << 16 | CAST<u32>(a) << 24;
+        }
+
+        DebugDraw() = default;
+        ~DebugDraw();
+
+        DebugDraw(const DebugDraw&)            = delete;
+        DebugDraw& operator=(const DebugDraw&) = delete;
+        DebugDraw(DebugDraw&&)                 = delete;
+        DebugDraw& operator=(DebugDraw&&)      = delete;
+
+        /// @brief Create the vertex ring and both pipelines
+        /// @param context Vulkan context with a created device
+        /// @param compiler Pipeline compiler to build the shaders with
+        /// @param config Debug draw configuration
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context, PipelineCompiler* compiler, const Config& config);
+
+        void Shutdown();
+
+        /// @brief Start a frame: recycle its vertex space. Call after FrameSynchronizer::BeginFrame has waited on
+        /// the frame's fence, and before any thread draws.
+        void BeginFrame(const FrameSynchronizer& frames);
+
+        // World space. All draw calls are safe to call from several threads at once.
+
+        void Line(const Float3& from, const Float3& to, u32 color);
+
+        /// @brief Wireframe axis-aligned box
+        void Box(const Float3& min, const Float3& max, u32 color);
+
+        // Screen space, in pixels from the top-left corner of the viewport
+
+        void ScreenLine(f32 x0, f32 y0, f32 x1, f32 y1, u32 color);
+
+        /// @brief Filled rectangle
+        void Rect(f32 x, f32 y, f32 width, f32 height, u32 color);
+
+        /// @brief Printable ASCII in the built-in 5x7 font; '\n' starts a new line, other characters draw nothing
+        void Text(f32 x, f32 y, std::string_view text, u32 color, f32 scale = 1.0f);
+
+        /// @brief Line graph over a translucent background, oldest value on the left
+        /// @param values Samples, drawn evenly spaced across the width
+        /// @param maxValue Value at the top edge; 0 uses the largest sample
+        void Graph(f32 x, f32 y, f32 width, f32 height, std::span<const f32> values, f32 maxValue, u32 color);
+
+        /// @brief Graph of FrameSynchronizer's recent frame times with a 60 Hz budget line and an average/max label
+        void FrameTimeGraph(const FrameSynchronizer& frames, f32 x, f32 y, f32 width, f32 height);
+
+        /// @brief Record this frame's draws inside rendering. Viewport and scissor must already be set.
+        /// @param frames Frame synchronizer whose current command buffer is rendering
+        /// @param viewProjection Camera for world-space vertices
+        /// @param extent Viewport size that screen-space coordinates refer to
+        /// @return Result containing success or error message
+        Result<void> Flush(const FrameSynchronizer& frames, const Mat4& viewProjection, VkExtent2D extent);
+
+        V_ND const Stats& GetStats() const {
+            return mStats;
+        }
+
+        V_ND bool IsInitialized() const {
+            return mLinePipeline != VK_NULL_HANDLE;
+        }
+
+    private:
+        /// @brief DebugDraw.vert push constants
+        struct Constants {
+            Mat4 viewProjection;
+            f32 pixelToNdc[4];  // xy scale, zw offset
+        };
+
+        /// @brief One pipeline's vertices for the current frame
+        struct Stream {
+            DebugVertex* vertices {nullptr};
+            VkDeviceSize offset {0};
+            u32 capacity {0};
+            std::atomic<u32> count {0};
+        };
+
+        /// @brief Claim count contiguous vertices, or null (and count them as dropped) if the stream is full
+        DebugVertex* Reserve(Stream& stream, u32 count);
+
+        VulkanContext* mContext {nullptr};
+        Config mConfig {};
+
+        TransientRing mVertices;
+        Stream mLines;
+        Stream mTriangles;
+        std::atomic<u32> mDropped {0};
+
+        VkPipelineLayout mPipelineLayout {VK_NULL_HANDLE};
+        VkPipeline mLinePipeline {VK_NULL_HANDLE};  // Owned by the compiler, like the one below
+        VkPipeline mTrianglePipeline {VK_NULL_HANDLE};
+
+        Stats mStats {};
+    };
+}  // namespace Vulkano
@@ -0,0 +1,93 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "DescriptorStream.hpp"
+
+#include <vk_mem_alloc.h>
+#include <vector>
+
+namespace Vulkano {
+    class VulkanContext;
+    class PipelineCompiler;
+
+    /// @brief Hierarchical depth buffer for occlusion culling: a full mip chain where every texel holds the
+    /// farthest depth (standard [0 near, 1 far] depth) of the texels it covers. Level 0 is the depth buffer's size
+    /// rounded down to a power of two. Built with DepthReduce.comp, which must be in the compiler's ShaderLibrary.
+    class DepthPyramid {
+    public:
+        DepthPyramid() = default;
+        ~DepthPyramid();
+
+        DepthPyramid(const DepthPyramid&)            = delete;
+        DepthPyramid& operator=(const DepthPyramid&) = delete;
+        DepthPyramid(DepthPyramid&&)                 = delete;
+        DepthPyramid& operator=(DepthPyramid&&)      = delete;
+
+        /// @brief Create the pyramid image and reduction pipeline
+        /// @param context Vulkan context with a created device
+        /// @param compiler Pipeline compiler to build DepthReduce.comp with
+        /// @param depthWidth Width of the depth buffer the pyramid is built from
+        /// @param depthHeight Height of the depth buffer the pyramid is built from
+        /// @param framesInFlight Number of frames recorded concurrently
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context,
+                                PipelineCompiler* compiler,
+                                u32 depthWidth,
+                                u32 depthHeight,
+                                u32 framesInFlight = 2);
+
+        /// @brief Destroy the pyramid (call again with Initialize after a resize)
+        void Shutdown();
+
+        /// @brief Record the reduction. The depth view must be sampleable in depthLayout and its writes visible to
+        /// compute shaders. Leaves the pyramid in VK_IMAGE_LAYOUT_GENERAL, readable by compute shaders.
+        /// @param commandBuffer Command buffer in the recording state, outside rendering
+        /// @param frameIndex Frame in flight being recorded
+        /// @param depthView View of the depth buffer (depth aspect only)
+        /// @param depthLayout Layout the depth buffer is in
+        void Build(VkCommandBuffer commandBuffer, u32 frameIndex, VkImageView depthView, VkImageLayout depthLayout);
+
+        V_ND VkImageView GetView() const {
+            return mView;
+        }
+
+        V_ND VkSampler GetSampler() const {
+            return mSampler;
+        }
+
+        V_ND u32 GetWidth() const {
+            return mWidth;
+        }
+
+        V_ND u32 GetHeight() const {
+            return mHeight;
+        }
+
+        V_ND u32 GetMipCount() const {
+            return CAST<u32>(mMipViews.size());
+        }
+
+        V_ND bool IsInitialized() const {
+            return mImage != VK_NULL_HANDLE;
+        }
+
+    private:
+        VulkanContext* mContext {nullptr};
+        VkImage mImage {VK_NULL_HANDLE};
+        VmaAllocation mAllocation {VK_NULL_HANDLE};
+        VkImageView mView {VK_NULL_HANDLE};
+        std::vector<VkImageView> mMipViews;
+        VkSampler mSampler {VK_NULL_HANDLE};
+        u32 mWidth {0};
+        u32 mHeight {0};
+
+        DescriptorStream mDescriptors;
+        VkPipelineLayout mPipelineLayout {VK_NULL_HANDLE};
+        VkPipeline mPipeline {VK_NULL_HANDLE};  // Owned by the compiler
+    };
+}  // namespace Vulkano
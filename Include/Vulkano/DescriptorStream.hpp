@@ -0,0 +1,169 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "TransientRing.hpp"
+
+#include <span>
+#include <vector>
+
+namespace Vulkano {
+    class VulkanContext;
+
+    /// @brief How a DescriptorStream gets descriptors to the GPU
+    enum class DescriptorPath : u8 {
+        Sets,    // Classic pooled descriptor sets: allocate, update, bind
+        Push,    // vkCmdPushDescriptorSetKHR: descriptors are recorded into the command buffer
+        Buffer,  // VK_EXT_descriptor_buffer: descriptors are written into mapped memory, binding is an offset
+    };
+
+    V_ND const char* ToString(DescriptorPath path);
+
+    /// @brief One descriptor to bind. Use the helpers to fill it in.
+    struct DescriptorWrite {
+        u32 binding {0};
+        VkDescriptorType type {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER};
+        VkDescriptorBufferInfo buffer {};
+        VkDeviceAddress address {0};  // Start of the range; required for buffers on the descriptor buffer path
+        VkDescriptorImageInfo image {};
+
+        /// @brief A uniform or storage buffer range from a transient ring allocation
+        static DescriptorWrite ForBuffer(u32 binding, VkDescriptorType type, const TransientRing::Allocation& range);
+
+        /// @brief A uniform or storage buffer range (address is 0 unless the buffer has device address usage)
+        static DescriptorWrite ForBuffer(u32 binding,
+                                         VkDescriptorType type,
+                                         const Buffer& buffer,
+                                         VkDeviceSize offset = 0,
+                                         VkDeviceSize range  = VK_WHOLE_SIZE);
+
+        /// @brief A sampled image, storage image or combined image sampler
+        static DescriptorWrite ForImage(u32 binding,
+                                        VkDescriptorType type,
+                                        VkImageView view,
+                                        VkImageLayout layout,
+                                        VkSampler sampler = VK_NULL_HANDLE);
+    };
+
+    /// @brief Binds one descriptor set layout's worth of per-draw descriptors through the fastest path the device
+    /// supports. Falls back from descriptor buffers to push descriptors to pooled sets, so callers record the same
+    /// Bind calls everywhere; pipelines using the stream's layout must set descriptorBuffer = UsesDescriptorBuffer().
+    /// Not thread-safe: use one stream per recording thread.
+    class DescriptorStream {
+    public:
+        /// @brief One binding of the set layout (descriptorCount is always 1)
+        struct Binding {
+            u32 binding {0};
+            VkDescriptorType type {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER};
+            VkShaderStageFlags stages {VK_SHADER_STAGE_ALL};
+        };
+
+        /// @brief Configuration for stream creation
+        struct Config {
+            std::vector<Binding> bindings;
+            DescriptorPath preferredPath {DescriptorPath::Buffer};
+            u32 framesInFlight {2};
+            u32 maxSetsPerFrame {1024};  // Bind calls per frame on the Sets and Buffer paths
+        };
+
+        /// @brief Bind calls recorded since the last BeginFrame
+        struct Stats {
+            u32 binds {0};
+            u32 failed {0};  // Pool or ring exhausted
+        };
+
+        DescriptorStream() = default;
+        ~DescriptorStream();
+
+        DescriptorStream(const DescriptorStream&)            = delete;
+        DescriptorStream& operator=(const DescriptorStream&) = delete;
+        DescriptorStream(DescriptorStream&&)                 = delete;
+        DescriptorStream& operator=(DescriptorStream&&)      = delete;
+
+        /// @brief Create the set layout and per-frame storage for the chosen path
+        /// @param context Vulkan context with a created device
+        /// @param config Stream configuration
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context, const Config& config);
+
+        void Shutdown();
+
+        /// @brief Recycle the descriptors written the last time this frame index was used
+        void BeginFrame(u32 frameIndex);
+
+        /// @brief Bind the descriptor buffer to a command buffer. Required once per command buffer before Bind on
+        /// the Buffer path; a no-op on the others.
+        void BindBuffers(VkCommandBuffer commandBuffer) const;
+
+        /// @brief Write and bind a complete set
+        /// @param commandBuffer Command buffer in the recording state
+        /// @param bindPoint Graphics or compute
+        /// @param pipelineLayout Layout created with GetSetLayout() at index set
+        /// @param set Set index
+        /// @param writes One write per binding in the layout
+        /// @return Result containing success or error message
+        Result<void> Bind(VkCommandBuffer commandBuffer,
+                          VkPipelineBindPoint bindPoint,
+                          VkPipelineLayout pipelineLayout,
+                          u32 set,
+                          std::span<const DescriptorWrite> writes);
+
+        V_ND VkDescriptorSetLayout GetSetLayout() const {
+            return mSetLayout;
+        }
+
+        V_ND DescriptorPath GetPath() const {
+            return mPath;
+        }
+
+        V_ND bool UsesDescriptorBuffer() const {
+            return mPath == DescriptorPath::Buffer;
+        }
+
+        V_ND const Stats& GetStats() const {
+            return mStats;
+        }
+
+        V_ND bool IsInitialized() const {
+            return mSetLayout != VK_NULL_HANDLE;
+        }
+
+    private:
+        static constexpr u32 kMaxWrites {16};
+
+        V_ND DescriptorPath ChoosePath(const Config& config) const;
+
+        Result<void> BindSet(VkCommandBuffer commandBuffer,
+                             VkPipelineBindPoint bindPoint,
+                             VkPipelineLayout pipelineLayout,
+                             u32 set,
+                             std::span<const DescriptorWrite> writes);
+
+        Result<void> BindBuffer(VkCommandBuffer commandBuffer,
+                                VkPipelineBindPoint bindPoint,
+                                VkPipelineLayout pipelineLayout,
+                                u32 set,
+                                std::span<const DescriptorWrite> writes);
+
+        V_ND size_t GetDescriptorSize(VkDescriptorType type) const;
+
+        VulkanContext* mContext {nullptr};
+        DescriptorPath mPath {DescriptorPath::Sets};
+        std::vector<Binding> mBindings;
+        VkDescriptorSetLayout mSetLayout {VK_NULL_HANDLE};
+        Stats mStats {};
+
+        // Sets path
+        std::vector<VkDescriptorPool> mPools;  // One per frame in flight
+        u32 mFrameIndex {0};
+
+        // Buffer path
+        TransientRing mRing;
+        VkDeviceSize mSetSize {0};
+        std::vector<VkDeviceSize> mBindingOffsets;  // Parallel to mBindings
+    };
+}  // namespace Vulkano
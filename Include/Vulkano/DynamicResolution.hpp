@@ -0,0 +1,183 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "DescriptorStream.hpp"
+
+#include <vk_mem_alloc.h>
+#include <vector>
+
+namespace Vulkano {
+    class VulkanContext;
+    class PipelineCompiler;
+    class FrameSynchronizer;
+
+    /// @brief Trades render resolution for frame rate. The scene is rendered into the top-left corner of a color
+    /// (and optional depth) target allocated once at the largest allowed size, then a compute pass upscales that
+    /// corner to the output extent. A controller fed by GPU timestamps around scene and upscale moves the render
+    /// extent between the configured scale bounds to keep GPU time near a target, so a resolution change is only
+    /// a different viewport and never a reallocation.
+    ///
+    /// Needs Upscale.comp in the compiler's ShaderLibrary. Per frame, after FrameSynchronizer::BeginFrame:
+    /// BeginFrame, then in the command buffer BeginRendering, scene draws, EndRendering and Upscale. The output is
+    /// then in TRANSFER_SRC_OPTIMAL, ready to be copied or blitted to the swapchain image.
+    class DynamicResolution {
+    public:
+        /// @brief Upscale output format (what Upscale.comp writes)
+        static constexpr VkFormat kOutputFormat {VK_FORMAT_R8G8B8A8_UNORM};
+
+        enum class Filter : u8 {
+            Bilinear,
+            Sharpen,  // Bilinear followed by contrast-adaptive sharpening in the style of FSR1's RCAS
+        };
+
+        /// @brief Configuration for dynamic resolution setup
+        struct Config {
+            VkExtent2D outputExtent {0, 0};  // Usually SwapchainManager::GetExtent()
+            f32 minScale {0.5f};             // Per-axis fraction of the output extent
+            f32 maxScale {1.0f};             // At most 1; sizes the render targets
+            f32 targetGpuMs {14.0f};         // GPU time budget for scene plus upscale
+            u32 framesInFlight {2};
+            VkFormat colorFormat {VK_FORMAT_R8G8B8A8_UNORM};  // Must support color attachment and linear sampling
+            VkFormat depthFormat {VK_FORMAT_UNDEFINED};       // UNDEFINED for no depth target
+            Filter filter {Filter::Sharpen};
+            f32 sharpness {0.5f};  // 0 to 1, for Filter::Sharpen
+        };
+
+        struct Stats {
+            f32 gpuMs {0.0f};          // Most recent measured frame
+            f32 smoothedGpuMs {0.0f};  // What the controller acts on
+            f32 scale {1.0f};
+            VkExtent2D renderExtent {0, 0};
+            u32 changes {0};  // Resolution changes so far
+        };
+
+        DynamicResolution() = default;
+        ~DynamicResolution();
+
+        DynamicResolution(const DynamicResolution&)            = delete;
+        DynamicResolution& operator=(const DynamicResolution&) = delete;
+        DynamicResolution(DynamicResolution&&)                 = delete;
+        DynamicResolution& operator=(DynamicResolution&&)      = delete;
+
+        /// @brief Create the render targets at maxScale, the output image, the timestamp queries and the upscale
+        /// pipeline
+        /// @param context Vulkan context with a created device
+        /// @param compiler Pipeline compiler to build the shader with
+        /// @param config Dynamic resolution configuration
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context, PipelineCompiler* compiler, const Config& config);
+
+        void Shutdown();
+
+        /// @brief Recreate the images for a new output extent, e.g. after a swapchain resize. The caller makes sure
+        /// the GPU is done with the old ones. This is the only path that reallocates.
+        /// @return Result containing success or error message
+        Result<void> Resize(VkExtent2D outputExtent);
+
+        void SetTargetGpuTime(f32 milliseconds) {
+            mConfig.targetGpuMs = milliseconds;
+        }
+
+        /// @brief Read the timestamps of the frame that last used this slot and pick this frame's render extent.
+        /// Call after FrameSynchronizer::BeginFrame has waited on the frame's fence.
+        void BeginFrame(const FrameSynchronizer& frames);
+
+        /// @brief Start the GPU timer, transition the render targets and begin rendering at the render extent, with
+        /// viewport and scissor set to it. Depth is cleared to 1.
+        /// @param frames Frame synchronizer whose current command buffer is recording, outside rendering
+        /// @param clearColor Color the render target is cleared to
+        void BeginRendering(const FrameSynchronizer& frames, const VkClearColorValue& clearColor);
+
+        void EndRendering(const FrameSynchronizer& frames) const;
+
+        /// @brief Upscale the rendered area to the output image and stop the GPU timer
+        /// @param frames Frame synchronizer whose current command buffer is recording, outside rendering
+        /// @return Result containing success or error message
+        Result<void> Upscale(const FrameSynchronizer& frames);
+
+        /// @brief Extent scene rendering covers this frame (top-left corner of the render targets)
+        V_ND VkExtent2D GetRenderExtent() const {
+            return mRenderExtent;
+        }
+
+        V_ND VkExtent2D GetOutputExtent() const {
+            return mConfig.outputExtent;
+        }
+
+        V_ND VkImage GetOutputImage() const {
+            return mOutput.image;
+        }
+
+        V_ND VkImageView GetOutputView() const {
+            return mOutput.view;
+        }
+
+        V_ND VkImageView GetColorView() const {
+            return mColor.view;
+        }
+
+        V_ND VkImageView GetDepthView() const {
+            return mDepth.view;
+        }
+
+        V_ND const Stats& GetStats() const {
+            return mStats;
+        }
+
+        V_ND bool IsInitialized() const {
+            return mPipeline != VK_NULL_HANDLE;
+        }
+
+    private:
+        struct Image {
+            VkImage image {VK_NULL_HANDLE};
+            VmaAllocation allocation {VK_NULL_HANDLE};
+            VkImageView view {VK_NULL_HANDLE};
+        };
+
+        /// @brief Upscale.comp push constants
+        struct UpscalePush {
+            f32 uvScale[2];  // Output pixel to render target UV
+            f32 uvMax[2];    // Last rendered texel center, in UV
+            f32 texel[2];    // Render target texel size, in UV
+            f32 outputSize[2];
+            f32 sharpness;  // 0 disables sharpening
+        };
+
+        Result<void> CreateImages();
+        void DestroyImages();
+        Result<void> CreateImage(Image& image, VkExtent2D extent, VkFormat format, VkImageUsageFlags usage);
+        void DestroyImage(Image& image) const;
+
+        /// @brief Move the scale toward the target using the smoothed GPU time
+        void UpdateScale();
+
+        VulkanContext* mContext {nullptr};
+        Config mConfig {};
+
+        Image mColor;
+        Image mDepth;
+        Image mOutput;
+        VkExtent2D mTargetExtent {0, 0};  // Allocated size of the render targets
+        VkExtent2D mRenderExtent {0, 0};
+        VkSampler mSampler {VK_NULL_HANDLE};
+
+        VkQueryPool mQueries {VK_NULL_HANDLE};  // Start and end timestamp per frame in flight
+        std::vector<bool> mPending;             // Slot has timestamps not read back yet
+        f64 mTimestampPeriod {0.0};             // Nanoseconds per tick; 0 without timestamp support
+        f32 mScale {1.0f};
+        u32 mCooldown {0};  // Frames until measurements reflect the current scale again
+        u32 mFrameSlot {0};
+
+        DescriptorStream mDescriptors;
+        VkPipelineLayout mPipelineLayout {VK_NULL_HANDLE};
+        VkPipeline mPipeline {VK_NULL_HANDLE};  // Owned by the compiler
+
+        Stats mStats {};
+    };
+}  // namespace Vulkano
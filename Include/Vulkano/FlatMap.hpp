@@ -0,0 +1,114 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "Hash.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+#include <vector>
+
+namespace Vulkano {
+    /// @brief Open-addressing hash table from u64 keys to values. Linear probing over a power-of-two slot array
+    /// kept at most 3/4 full; a lookup is one MixHash and a short scan of adjacent slots with no allocation.
+    /// Entries can be added but not removed individually. Not thread-safe.
+    template<typename Value>
+    class FlatMap {
+    public:
+        FlatMap() = default;
+
+        explicit FlatMap(size_t capacity) {
+            Reserve(capacity);
+        }
+
+        /// @brief Find the value for a key
+        /// @return Pointer to the value, or nullptr if absent (invalidated by the next insert)
+        V_ND Value* Find(u64 key) {
+            return const_cast<Value*>(std::as_const(*this).Find(key));
+        }
+
+        V_ND const Value* Find(u64 key) const {
+            if (mSize == 0) { return nullptr; }
+
+            const size_t mask = mSlots.size() - 1;
+            for (size_t i = MixHash(key) & mask;; i = (i + 1) & mask) {
+                const Slot& slot = mSlots[i];
+                if (!slot.occupied) { return nullptr; }
+                if (slot.key == key) { return &slot.value; }
+            }
+        }
+
+        /// @brief Insert a value unless the key is already present
+        /// @return The stored value and whether it was inserted
+        std::pair<Value*, bool> Insert(u64 key, Value value) {
+            if ((mSize + 1) * 4 > mSlots.size() * 3) { Rehash(mSlots.empty() ? kMinCapacity : mSlots.size() * 2); }
+
+            const size_t mask = mSlots.size() - 1;
+            for (size_t i = MixHash(key) & mask;; i = (i + 1) & mask) {
+                Slot& slot = mSlots[i];
+                if (slot.occupied) {
+                    if (slot.key == key) { return {&slot.value, false}; }
+                    continue;
+                }
+
+                slot.key      = key;
+                slot.value    = std::move(value);
+                slot.occupied = true;
+                mSize++;
+                return {&slot.value, true};
+            }
+        }
+
+        /// @brief Make room for at least the given number of entries without rehashing
+        void Reserve(size_t count) {
+            const size_t required = std::bit_ceil(std::max<size_t>(kMinCapacity, (count * 4 + 2) / 3));
+            if (required > mSlots.size()) { Rehash(required); }
+        }
+
+        void Clear() {
+            mSlots.assign(mSlots.size(), Slot {});
+            mSize = 0;
+        }
+
+        /// @brief Visit every entry as (key, value)
+        template<typename Fn>
+        void ForEach(Fn&& fn) {
+            for (Slot& slot : mSlots) {
+                if (slot.occupied) { fn(slot.key, slot.value); }
+            }
+        }
+
+        V_ND size_t GetSize() const {
+            return mSize;
+        }
+
+        V_ND size_t GetCapacity() const {
+            return mSlots.size();
+        }
+
+    private:
+        static constexpr size_t kMinCapacity {16};
+
+        struct Slot {
+            u64 key {0};
+            Value value {};
+            bool occupied {false};
+        };
+
+        void Rehash(size_t capacity) {
+            std::vector<Slot> old = std::exchange(mSlots, std::vector<Slot>(capacity));
+            mSize                 = 0;
+            for (Slot& slot : old) {
+                if (slot.occupied) { Insert(slot.key, std::move(slot.value)); }
+            }
+        }
+
+        std::vector<Slot> mSlots;
+        size_t mSize {0};
+    };
+}  // namespace Vulkano
@@ -0,0 +1,347 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "CommandStateCache.hpp"
+#include "Pipeline.hpp"
+#include "Serialization.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Vulkano {
+    class VulkanContext;
+    class ShaderLibrary;
+    class PipelineCompiler;
+    class RenderTarget;
+
+    /// @brief Records Vulkano-level work into a compact binary stream that Tools/Replay re-executes on any device:
+    /// the shaders, layouts, pipelines, buffers (with their contents) and render targets a frame uses, the commands
+    /// of each command buffer and every submit with its CPU timestamp.
+    ///
+    /// Commands go through the capture's methods, which always issue the Vulkan call and, only while frames are
+    /// being captured, append it to the command buffer's stream. Pipeline binds and viewport/scissor go through a
+    /// CommandStateCache, and binding a pipeline applies its description's dynamic state, exactly as Replay does.
+    /// Anything recorded straight into the command buffer (including DebugDraw) is not captured, and neither are
+    /// descriptor sets or images other than render targets: layouts are replayed with push constants only, so
+    /// captured shaders should reach their data through buffer device addresses (PushBufferAddress).
+    ///
+    /// Registration is cheap and always on; capturing starts at the BeginFrame after Request, waits for the device
+    /// once to snapshot the registered buffers, and saves the file at the BeginFrame after the last frame. Record
+    /// one command buffer at a time, from one thread.
+    class FrameCapture {
+    public:
+        /// @brief "VKCP"
+        static constexpr u32 kMagic {0x50434B56};
+        static constexpr u32 kVersion {1};
+
+        /// @brief ID of a registered buffer, pipeline or render target in the stream; 0 is never used
+        using ResourceId = u32;
+        static constexpr ResourceId kNoResource {0};
+
+        /// @brief Top-level records of a capture file, each followed by its payload
+        enum class Record : u8 { Shader, Layout, Pipeline, Buffer, Target, Frame, Submit, End };
+
+        /// @brief Commands inside a command buffer stream
+        enum class Command : u8 {
+            BeginRendering,
+            EndRendering,
+            BindPipeline,
+            SetViewport,
+            SetScissor,
+            PushConstants,
+            PushBufferAddress,
+            BindVertexBuffer,
+            BindIndexBuffer,
+            Draw,
+            DrawIndexed,
+            DrawIndirect,
+            DrawIndexedIndirect,
+            Dispatch,
+            DispatchIndirect,
+            FillBuffer,
+            CopyBuffer,
+            Barrier,
+        };
+
+        /// @brief Which description follows a pipeline record
+        enum class PipelineKind : u8 { Graphics, Compute };
+
+        /// @brief Queue a submit went to (Replay puts everything on the graphics queue, in capture order)
+        enum class QueueKind : u8 { Graphics, Compute, Transfer, Other };
+
+        /// @brief Totals of the capture in progress, or the last one
+        struct Stats {
+            u32 frames {0};
+            u32 submits {0};
+            u32 commands {0};
+            u32 unreadableBuffers {0};  // Device-local without TRANSFER_SRC; captured as zeros
+            u64 bytes {0};
+        };
+
+        FrameCapture() = default;
+        ~FrameCapture();
+
+        FrameCapture(const FrameCapture&)            = delete;
+        FrameCapture& operator=(const FrameCapture&) = delete;
+        FrameCapture(FrameCapture&&)                 = delete;
+        FrameCapture& operator=(FrameCapture&&)      = delete;
+
+        /// @brief Initialize the capture
+        /// @param context Vulkan context with a created device
+        /// @param shaders Shader library the captured pipelines' stages refer to
+        /// @param compiler Optional compiler to look up descriptions of pipelines bound without RegisterPipeline
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context, ShaderLibrary* shaders, PipelineCompiler* compiler = nullptr);
+
+        void Shutdown();
+
+        /// @brief Forget every handle-keyed registration and abandon a capture in progress, for
+        /// VulkanContext::RecoverDevice (see ResourceRegistry). Buffers, layouts and pipelines have to be registered
+        /// again on the new device; render target IDs stay valid.
+        void ReleaseDeviceObjects();
+
+        /// @brief Nothing to create; here so the capture can be registered like everything else
+        /// @return Result containing success
+        Result<void> RecreateDeviceObjects();
+
+        /// @brief Capture the next frames, starting at the next BeginFrame
+        /// @param path File the capture is saved to
+        /// @param frames Number of frames to capture
+        void Request(const std::filesystem::path& path, u32 frames);
+
+        /// @brief Frame boundary: starts a requested capture, or saves a finished one
+        /// @return Result containing success or error message (from snapshotting buffers or saving the file)
+        Result<void> BeginFrame();
+
+        V_ND bool IsCapturing() const {
+            return mCapturing;
+        }
+
+        V_ND const Stats& GetStats() const {
+            return mStats;
+        }
+
+        /// @brief Name a pipeline layout and its push constant ranges (Replay creates it from exactly these)
+        void RegisterLayout(const std::string& name,
+                            VkPipelineLayout layout,
+                            std::span<const VkPushConstantRange> ranges);
+
+        /// @brief Remember the description a pipeline was built from
+        void RegisterPipeline(VkPipeline pipeline, const PipelineDesc& desc);
+
+        /// @brief Track a buffer. Its contents are captured when a capture starts: copied from mapped memory, read
+        /// back through a staging copy with TRANSFER_SRC usage, and zeros otherwise.
+        /// @param buffer Buffer to track
+        /// @param size Size of the buffer
+        /// @param usage Usage the buffer was created with (Replay adds TRANSFER_SRC and TRANSFER_DST)
+        /// @param mapped Persistently mapped memory of host-visible buffers, or null
+        /// @return ID of the buffer in capture files
+        ResourceId RegisterBuffer(VkBuffer buffer, VkDeviceSize size, VkBufferUsageFlags usage, void* mapped = nullptr);
+
+        void UnregisterBuffer(VkBuffer buffer);
+
+        /// @brief Track a render target by its configuration (Replay creates one just like it)
+        /// @return ID to pass to BeginRendering
+        ResourceId RegisterTarget(const RenderTarget& target);
+
+        /// @brief Track an attachment Vulkano doesn't own, such as a swapchain image, as a single-layer target
+        /// @return ID to pass to BeginRendering
+        ResourceId RegisterTarget(VkExtent2D extent, VkFormat colorFormat, VkFormat depthFormat = VK_FORMAT_UNDEFINED);
+
+        /// @brief Write to a registered host-visible buffer; while capturing, the write is replayed as an upload in
+        /// front of the next submit
+        /// @return Result containing success or error message
+        Result<void> WriteBuffer(VkBuffer buffer, VkDeviceSize offset, std::span<const u8> data);
+
+        /// @brief Start a command buffer's stream (after vkBeginCommandBuffer) and point the state cache at it
+        void Begin(VkCommandBuffer commandBuffer);
+
+        /// @brief Begin rendering into a render target (see RenderTarget::BeginRendering), registering it on first
+        /// use. Viewport, scissor and pipeline have to be set again afterwards.
+        /// @return The target's error, with nothing recorded or captured, if layer is out of range
+        Result<void> BeginRendering(VkCommandBuffer commandBuffer,
+                                    RenderTarget& target,
+                                    const VkClearColorValue& clearColor,
+                                    u32 layer = UINT32_MAX);
+
+        /// @brief Begin rendering into attachments registered with the extent overload of RegisterTarget. Replay
+        /// clears the color to the first attachment's clear value whatever its load op.
+        void BeginRendering(VkCommandBuffer commandBuffer, const VkRenderingInfo& info, ResourceId target);
+
+        void EndRendering(VkCommandBuffer commandBuffer);
+
+        /// @brief Bind a pipeline and, for graphics pipelines, set its description's dynamic state
+        void BindPipeline(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipeline pipeline);
+
+        void SetViewport(VkCommandBuffer commandBuffer, const VkViewport& viewport);
+        void SetScissor(VkCommandBuffer commandBuffer, const VkRect2D& scissor);
+
+        /// @brief Push constants through a layout registered with RegisterLayout
+        void PushConstants(VkCommandBuffer commandBuffer,
+                           VkPipelineLayout layout,
+                           VkShaderStageFlags stages,
+                           u32 offset,
+                           std::span<const u8> data);
+
+        /// @brief Push a registered buffer's device address; Replay pushes its own buffer's address instead
+        void PushBufferAddress(VkCommandBuffer commandBuffer,
+                               VkPipelineLayout layout,
+                               VkShaderStageFlags stages,
+                               u32 offset,
+                               VkBuffer buffer,
+                               VkDeviceSize bufferOffset = 0);
+
+        void BindVertexBuffer(VkCommandBuffer commandBuffer, u32 binding, VkBuffer buffer, VkDeviceSize offset);
+        void BindIndexBuffer(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset, VkIndexType type);
+
+        void Draw(VkCommandBuffer commandBuffer,
+                  u32 vertexCount,
+                  u32 instanceCount,
+                  u32 firstVertex,
+                  u32 firstInstance);
+        void DrawIndexed(VkCommandBuffer commandBuffer,
+                         u32 indexCount,
+                         u32 instanceCount,
+                         u32 firstIndex,
+                         i32 vertexOffset,
+                         u32 firstInstance);
+        void DrawIndirect(VkCommandBuffer commandBuffer,
+                          VkBuffer buffer,
+                          VkDeviceSize offset,
+                          u32 drawCount,
+                          u32 stride);
+        void DrawIndexedIndirect(VkCommandBuffer commandBuffer,
+                                 VkBuffer buffer,
+                                 VkDeviceSize offset,
+                                 u32 drawCount,
+                                 u32 stride);
+        void Dispatch(VkCommandBuffer commandBuffer, u32 groupsX, u32 groupsY, u32 groupsZ);
+        void DispatchIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset);
+
+        void FillBuffer(VkCommandBuffer commandBuffer,
+                        VkBuffer buffer,
+                        VkDeviceSize offset,
+                        VkDeviceSize size,
+                        u32 value);
+        void CopyBuffer(VkCommandBuffer commandBuffer,
+                        VkBuffer source,
+                        VkBuffer destination,
+                        const VkBufferCopy& region);
+
+        /// @brief Global memory barrier
+        void Barrier(VkCommandBuffer commandBuffer,
+                     VkPipelineStageFlags2 srcStage,
+                     VkAccessFlags2 srcAccess,
+                     VkPipelineStageFlags2 dstStage,
+                     VkAccessFlags2 dstAccess);
+
+        /// @brief Submit, and while capturing record the submit with its command buffers' streams
+        /// @return Result containing success or error message (device loss is flagged on the context)
+        Result<void> Submit(VkQueue queue, const VkSubmitInfo& info, VkFence fence);
+
+        V_ND bool IsInitialized() const {
+            return mContext != nullptr;
+        }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct LayoutInfo {
+            std::string name;
+            std::vector<VkPushConstantRange> ranges;
+        };
+
+        struct BufferInfo {
+            ResourceId id {kNoResource};
+            VkDeviceSize size {0};
+            VkBufferUsageFlags usage {0};
+            void* mapped {nullptr};
+            VkDeviceAddress address {0};
+        };
+
+        struct TargetInfo {
+            VkExtent2D extent {0, 0};
+            u32 layers {1};
+            VkFormat colorFormat {VK_FORMAT_UNDEFINED};
+            VkFormat depthFormat {VK_FORMAT_UNDEFINED};
+            bool multiview {false};
+        };
+
+        struct PipelineInfo {
+            ResourceId id {kNoResource};
+            PipelineDesc desc;
+        };
+
+        struct Upload {
+            ResourceId buffer {kNoResource};
+            VkDeviceSize offset {0};
+            std::vector<u8> data;
+        };
+
+        /// @brief Write the header and everything registered so far, with buffer contents
+        Result<void> Start();
+
+        /// @brief Write the end record and save the file
+        Result<void> Finish();
+
+        /// @brief Copy a device-local buffer into host memory through a staging buffer (the device must be idle)
+        V_ND Result<std::vector<u8>> ReadBack(VkBuffer buffer, VkDeviceSize size) const;
+
+        void WriteLayout(const LayoutInfo& layout);
+        void WriteTarget(ResourceId id, const TargetInfo& target);
+        void WriteBufferRecord(const BufferInfo& buffer, const std::vector<u8>& data);
+
+        /// @brief Write a pipeline record, preceded by the shaders it uses that aren't in the file yet
+        void WritePipeline(const PipelineInfo& pipeline);
+
+        /// @brief Registered description of a pipeline, falling back to the compiler's (null if unknown)
+        const PipelineInfo* Describe(VkPipeline pipeline);
+
+        V_ND ResourceId FindBuffer(VkBuffer buffer) const;
+        V_ND u32 FindLayout(VkPipelineLayout layout) const;
+
+        /// @brief Stream of the command buffer for the next command, or null when not capturing
+        BinaryWriter* Stream(VkCommandBuffer commandBuffer);
+
+        /// @brief Nanoseconds since the capture started
+        V_ND i64 Timestamp() const;
+
+        VulkanContext* mContext {nullptr};
+        ShaderLibrary* mShaders {nullptr};
+        PipelineCompiler* mCompiler {nullptr};
+        std::unique_ptr<CommandStateCache> mStateCache;
+
+        std::vector<LayoutInfo> mLayouts;  // Indexed by the order they appear in the file
+        std::unordered_map<VkPipelineLayout, u32> mLayoutIndices;
+        std::unordered_map<VkPipeline, PipelineInfo> mPipelines;
+        std::unordered_map<VkBuffer, BufferInfo> mBuffers;
+        std::vector<TargetInfo> mTargets;  // ID - 1
+        std::unordered_map<const RenderTarget*, ResourceId> mTargetIds;
+        ResourceId mNextId {1};  // Buffers and pipelines
+
+        RenderTarget* mActiveTarget {nullptr};  // Of the rendering pass in progress
+
+        std::filesystem::path mPath;
+        u32 mRequestedFrames {0};
+        u32 mFramesLeft {0};
+        bool mCapturing {false};
+        Clock::time_point mStart {};
+        BinaryWriter mWriter;
+        std::unordered_map<VkCommandBuffer, BinaryWriter> mStreams;
+        std::vector<Upload> mUploads;  // Attached to the next submit
+        std::unordered_set<std::string> mWrittenShaders;
+        std::unordered_set<ResourceId> mWrittenPipelines;
+        Stats mStats {};
+    };
+}  // namespace Vulkano
@@ -7,11 +7,16 @@
 #include "Types.hpp"
 #include "Macros.hpp"
 
+#include <array>
+#include <chrono>
+#include <span>
 #include <vector>
 #include <vulkan/vulkan.h>
 
 namespace Vulkano {
     class VulkanContext;
+    class SwapchainManager;
+    class Breadcrumbs;
 
     /// @brief Represents synchronization primitives for a single frame in flight
     struct FrameContext {
@@ -20,11 +25,31 @@ namespace Vulkano {
         VkSemaphore renderFinishedSemaphore {VK_NULL_HANDLE};
         VkCommandPool commandPool {VK_NULL_HANDLE};
         VkCommandBuffer commandBuffer {VK_NULL_HANDLE};
+        std::vector<VkSemaphore> windowSemaphores;  // Image available semaphores of windows 1 and up
     };
 
     /// @brief Manages frame-in-flight synchronization and resources
     class FrameSynchronizer {
     public:
+        /// @brief Number of recent frame times kept for GetFrameTime
+        static constexpr u32 kFrameTimeHistory {240};
+
+        /// @brief AcquireImages result for a window whose swapchain is out of date
+        static constexpr u32 kNoImage {UINT32_MAX};
+
+        /// @brief Frame rate limiter timing, in milliseconds
+        struct LimiterStats {
+            f32 targetMs {0.0f};            // 1000 / limit, 0 when unlimited
+            f32 periodMs {0.0f};            // Pacing period in use; a multiple of the present interval when aligned
+            f32 presentIntervalMs {0.0f};   // Smoothed interval between reported presents, 0 without present timing
+            f32 sleepMarginMs {0.0f};       // How long before the deadline sleeping stops and spinning starts
+            f32 averageWakeErrorMs {0.0f};  // How late frames were released, over the recent history
+            f32 maxWakeErrorMs {0.0f};
+            f32 jitterMs {0.0f};            // Standard deviation of the recorded frame times
+            u64 missedDeadlines {0};        // Frames that were already past their deadline at EndFrame
+            bool presentAligned {false};
+        };
+
         FrameSynchronizer() = default;
         ~FrameSynchronizer();
 
@@ -36,19 +61,48 @@ namespace Vulkano {
         /// @brief Initialize frame synchronization
         /// @param context Vulkan context
         /// @param framesInFlight Number of frames to allow in flight (2-3 recommended)
+        /// @param queueFamily Family the command buffers are submitted to; VK_QUEUE_FAMILY_IGNORED for graphics. A
+        /// frame loop that ends in compute and presents from it passes the compute family.
         /// @return Result containing success or error message
-        Result<void> Initialize(VulkanContext* context, u32 framesInFlight = 2);
+        Result<void> Initialize(VulkanContext* context,
+                                u32 framesInFlight = 2,
+                                u32 queueFamily    = VK_QUEUE_FAMILY_IGNORED);
 
         /// @brief Shutdown and cleanup all synchronization resources
         void Shutdown();
 
+        /// @brief Destroy the frame contexts for VulkanContext::RecoverDevice (see ResourceRegistry)
+        void ReleaseDeviceObjects();
+
+        /// @brief Create the frame contexts and window semaphores again on the recovered device
+        /// @return Result containing success or error message
+        Result<void> RecreateDeviceObjects();
+
         /// @brief Begin a new frame (waits on fence, resets command buffer)
         /// @return Result containing success or error message
         Result<void> BeginFrame() const;
 
-        /// @brief End current frame (advances to next frame)
+        /// @brief End current frame (advances to next frame, waits out the frame rate limit if one is set and
+        /// records the time since the previous EndFrame)
         void EndFrame();
 
+        /// @brief Cap the frame rate. EndFrame sleeps with an absolute-deadline clock_nanosleep until a margin
+        /// before the frame's deadline, calibrated from how late past wakeups were, then yields in a spin loop for
+        /// the rest, so the CPU neither burns a core nor oversleeps.
+        /// @param framesPerSecond Frame rate cap, 0 to disable
+        void SetFrameRateLimit(f32 framesPerSecond);
+
+        /// @brief Feed the time an image actually reached the display (from present timing, e.g.
+        /// VK_GOOGLE_display_timing or VK_KHR_present_wait). Once the interval between presents is steady the
+        /// limiter rounds its period to a whole number of intervals and keeps deadlines in phase with presents.
+        void ReportPresentTime(std::chrono::steady_clock::time_point presentTime);
+
+        /// @brief Attach breadcrumbs whose report is appended to WaitForFrame's error on timeout or device loss
+        /// @param breadcrumbs Initialized breadcrumbs, or null to detach
+        void SetBreadcrumbs(const Breadcrumbs* breadcrumbs) {
+            mBreadcrumbs = breadcrumbs;
+        }
+
         /// @brief Wait for current frame's fence
         /// @param timeout Timeout in nanoseconds
         /// @return Result containing success or error message
@@ -57,6 +111,24 @@ namespace Vulkano {
         /// @brief Reset current frame's fence
         void ResetFence() const;
 
+        /// @brief Set how many windows each frame acquires an image for, creating an image available semaphore per
+        /// window and frame. Shrinking waits for the device to go idle.
+        /// @param windows Window count, at least 1
+        /// @return Result containing success or error message
+        Result<void> SetWindowCount(u32 windows);
+
+        /// @brief Acquire the next image of every window's swapchain for the current frame, each signaling
+        /// GetCurrentImageAvailableSemaphore(window). Windows whose acquire fails (out of date, usually) get
+        /// kNoImage and their semaphore is left unsignaled; the rest are still acquired, so one minimized window
+        /// doesn't stall the others.
+        /// @param swapchains One swapchain per window, at most the window count
+        /// @param imageIndices Receives each window's image index
+        /// @param timeout Timeout in nanoseconds for each acquire
+        /// @return Result containing the number of windows that got an image, or error message
+        Result<u32> AcquireImages(std::span<SwapchainManager* const> swapchains,
+                                  std::span<u32> imageIndices,
+                                  u64 timeout = UINT64_MAX) const;
+
         // Getters for current frame
         V_ND FrameContext& GetCurrentFrame() {
             return mFrames[mCurrentFrameIndex];
@@ -74,6 +146,18 @@ namespace Vulkano {
             return mFrames[mCurrentFrameIndex].imageAvailableSemaphore;
         }
 
+        /// @brief Image available semaphore of one window; window 0 is GetCurrentImageAvailableSemaphore()
+        V_ND VkSemaphore GetCurrentImageAvailableSemaphore(u32 window) const {
+            const FrameContext& frame = mFrames[mCurrentFrameIndex];
+            return window == 0 ? frame.imageAvailableSemaphore : frame.windowSemaphores[window - 1];
+        }
+
+        V_ND u32 GetWindowCount() const {
+            return mWindowCount;
+        }
+
+        /// @brief Per-frame semaphore for submit-to-submit ordering. Don't present with it: the presentation engine
+        /// may still hold it when the frame slot comes around again; use SwapchainManager::GetPresentSemaphore.
         V_ND VkSemaphore GetCurrentRenderFinishedSemaphore() const {
             return mFrames[mCurrentFrameIndex].renderFinishedSemaphore;
         }
@@ -86,10 +170,29 @@ namespace Vulkano {
             return mCurrentFrameIndex;
         }
 
+        V_ND u32 GetQueueFamily() const {
+            return mQueueFamily;
+        }
+
         V_ND u32 GetFramesInFlight() const {
             return static_cast<u32>(mFrames.size());
         }
 
+        /// @brief CPU time between consecutive EndFrame calls, in milliseconds
+        /// @param framesAgo 0 for the most recent frame, up to GetFrameTimeCount() - 1
+        V_ND f32 GetFrameTime(u32 framesAgo = 0) const;
+
+        /// @brief Number of frame times recorded so far, capped at kFrameTimeHistory
+        V_ND u32 GetFrameTimeCount() const {
+            return mFrameTimeCount;
+        }
+
+        /// @brief Mean and maximum over the recorded history, in milliseconds (0 before the second EndFrame)
+        V_ND f32 GetAverageFrameTime() const;
+        V_ND f32 GetMaxFrameTime() const;
+
+        V_ND LimiterStats GetLimiterStats() const;
+
         V_ND bool IsInitialized() const {
             return mContext != nullptr && !mFrames.empty();
         }
@@ -101,8 +204,39 @@ namespace Vulkano {
         /// @brief Destroy synchronization objects for a single frame
         void DestroyFrameContext(FrameContext& frame) const;
 
+        /// @brief Block until the current frame's deadline and schedule the next one
+        void WaitForDeadline();
+
+        /// @brief Presents have been steady long enough to pace against them
+        V_ND bool IsPresentAligned() const;
+
+        /// @brief Pacing period in milliseconds: the target, or whole present intervals once presents are steady
+        V_ND f32 GetPacingPeriod() const;
+
         VulkanContext* mContext {nullptr};
+        const Breadcrumbs* mBreadcrumbs {nullptr};
         std::vector<FrameContext> mFrames;
         u32 mCurrentFrameIndex {0};
+        u32 mWindowCount {1};
+        u32 mQueueFamily {0};
+
+        std::array<f32, kFrameTimeHistory> mFrameTimes {};
+        u32 mFrameTimeCursor {0};  // Next slot to write
+        u32 mFrameTimeCount {0};
+        std::chrono::steady_clock::time_point mLastFrameEnd {};
+
+        f32 mTargetPeriodMs {0.0f};  // 0 when unlimited
+        f32 mSleepMarginMs {0.0f};
+        f32 mOversleepMeanMs {0.0f};  // Smoothed lateness of clock_nanosleep wakeups and its deviation
+        f32 mOversleepDeviationMs {0.0f};
+        std::chrono::steady_clock::time_point mNextDeadline {};
+        std::array<f32, kFrameTimeHistory> mWakeErrors {};
+        u32 mWakeErrorCursor {0};
+        u32 mWakeErrorCount {0};
+        u64 mMissedDeadlines {0};
+
+        f32 mPresentIntervalMs {0.0f};
+        u32 mSteadyPresents {0};  // Consecutive presents close to the smoothed interval
+        std::chrono::steady_clock::time_point mLastPresent {};
     };
 }  // namespace Vulkano
\ No newline at end of file
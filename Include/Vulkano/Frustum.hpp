@@ -0,0 +1,72 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+
+#include <array>
+#include <cmath>
+
+namespace Vulkano {
+    /// @brief Column-major 4x4 matrix, laid out like a GLSL mat4
+    using Mat4 = std::array<f32, 16>;
+
+    /// @brief Plane as (normal, distance); a point p is inside when dot(normal, p) + distance >= 0
+    struct Plane {
+        f32 x {0.0f};
+        f32 y {0.0f};
+        f32 z {0.0f};
+        f32 w {0.0f};
+
+        V_ND constexpr f32 Distance(f32 px, f32 py, f32 pz) const {
+            return x * px + y * py + z * pz + w;
+        }
+    };
+
+    /// @brief View frustum for culling, extracted from a Vulkan view-projection matrix (depth range [0, 1])
+    struct Frustum {
+        enum Side : u32 { kLeft, kRight, kBottom, kTop, kNear, kFar, kCount };
+
+        std::array<Plane, kCount> planes {};
+
+        /// @brief Extract normalized planes from a column-major view-projection matrix (Gribb/Hartmann)
+        static Frustum FromViewProjection(const Mat4& m) {
+            // Row i of the matrix is (m[i], m[4 + i], m[8 + i], m[12 + i])
+            const auto row = [&m](u32 i) { return Plane {m[i], m[4 + i], m[8 + i], m[12 + i]}; };
+            const Plane r0 = row(0);
+            const Plane r1 = row(1);
+            const Plane r2 = row(2);
+            const Plane r3 = row(3);
+
+            Frustum frustum;
+            frustum.planes[kLeft]   = {r3.x + r0.x, r3.y + r0.y, r3.z + r0.z, r3.w + r0.w};
+            frustum.planes[kRight]  = {r3.x - r0.x, r3.y - r0.y, r3.z - r0.z, r3.w - r0.w};
+            frustum.planes[kBottom] = {r3.x + r1.x, r3.y + r1.y, r3.z + r1.z, r3.w + r1.w};
+            frustum.planes[kTop]    = {r3.x - r1.x, r3.y - r1.y, r3.z - r1.z, r3.w - r1.w};
+            frustum.planes[kNear]   = r2;  // 0 <= z, not -w <= z as in OpenGL
+            frustum.planes[kFar]    = {r3.x - r2.x, r3.y - r2.y, r3.z - r2.z, r3.w - r2.w};
+
+            for (Plane& plane : frustum.planes) {
+                const f32 length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+                if (length > 0.0f) {
+                    plane.x /= length;
+                    plane.y /= length;
+                    plane.z /= length;
+                    plane.w /= length;
+                }
+            }
+            return frustum;
+        }
+
+        /// @brief True if a sphere is at least partially inside
+        V_ND bool IntersectsSphere(f32 x, f32 y, f32 z, f32 radius) const {
+            for (const Plane& plane : planes) {
+                if (plane.Distance(x, y, z) < -radius) { return false; }
+            }
+            return true;
+        }
+    };
+}  // namespace Vulkano
@@ -0,0 +1,184 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "Buffer.hpp"
+#include "TlsfAllocator.hpp"
+#include "TransientRing.hpp"
+
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace Vulkano {
+    class VulkanContext;
+    class FrameSynchronizer;
+
+    /// @brief Handle to a mesh in a GeometryArena. Stays valid across compaction.
+    using MeshId = u32;
+
+    inline constexpr MeshId kInvalidMesh = ~0u;
+
+    /// @brief Where a mesh lives in the arena's shared buffers, in vertices and indices (not bytes)
+    struct MeshRange {
+        u32 vertexOffset {0};
+        u32 vertexCount {0};
+        u32 firstIndex {0};
+        u32 indexCount {0};
+
+        /// @brief Indexed draw of this mesh; indices are mesh-local and vertexOffset rebases them
+        V_ND VkDrawIndexedIndirectCommand ToDrawCommand(u32 instanceCount = 1, u32 firstInstance = 0) const {
+            return {indexCount, instanceCount, firstIndex, CAST<i32>(vertexOffset), firstInstance};
+        }
+    };
+
+    /// @brief Static geometry packed into one large device-local vertex buffer and one u32 index buffer, each
+    /// suballocated with a TlsfAllocator. Every mesh is an (offset, count) range in both, so one bind covers all
+    /// of them and a multi-draw indirect can render many meshes at once. Uploads go through a per-frame staging
+    /// ring and are recorded by Flush; freed ranges are recycled once the frames that could still read them have
+    /// finished. Compact repacks live meshes into fresh buffers (optionally resized) when fragmentation builds up.
+    ///
+    /// Per frame, after FrameSynchronizer::BeginFrame: BeginFrame, any Upload/Free calls, then Flush (or Compact)
+    /// outside rendering before drawing.
+    class GeometryArena {
+    public:
+        /// @brief Configuration for arena setup
+        struct Config {
+            u32 vertexStride {32};                         // Bytes per vertex; every mesh shares the layout
+            u32 vertexCapacity {1u << 20};                 // Vertices
+            u32 indexCapacity {1u << 22};                  // Indices
+            u32 framesInFlight {2};                        // Match the FrameSynchronizer
+            VkDeviceSize uploadBytesPerFrame {16u << 20};  // Staging space for Upload calls
+        };
+
+        /// @brief Occupancy of both buffers
+        struct Stats {
+            u32 meshCount {0};
+            u32 vertexUsed {0};
+            u32 vertexCapacity {0};
+            u32 vertexLargestFree {0};
+            u32 indexUsed {0};
+            u32 indexCapacity {0};
+            u32 indexLargestFree {0};
+        };
+
+        GeometryArena() = default;
+        ~GeometryArena();
+
+        GeometryArena(const GeometryArena&)            = delete;
+        GeometryArena& operator=(const GeometryArena&) = delete;
+        GeometryArena(GeometryArena&&)                 = delete;
+        GeometryArena& operator=(GeometryArena&&)      = delete;
+
+        /// @brief Create the vertex, index and staging buffers
+        /// @param context Vulkan context with a created device
+        /// @param config Arena configuration
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context, const Config& config);
+
+        void Shutdown();
+
+        /// @brief Start a frame: recycle staging space and release ranges and buffers the GPU is done with. Call
+        /// after FrameSynchronizer::BeginFrame has waited on the frame's fence.
+        void BeginFrame(const FrameSynchronizer& frames);
+
+        /// @brief Allocate space for a mesh and stage its data; the copy is recorded by the next Flush
+        /// @param vertices Raw vertex data, a whole number of vertexStride-sized vertices
+        /// @param indices Mesh-local indices
+        /// @return The mesh handle, or an error if the arena or this frame's staging space is full
+        Result<MeshId> Upload(std::span<const std::byte> vertices, std::span<const u32> indices);
+
+        template<typename Vertex>
+            requires std::is_trivially_copyable_v<Vertex>
+        Result<MeshId> Upload(std::span<const Vertex> vertices, std::span<const u32> indices) {
+            if (sizeof(Vertex) != mConfig.vertexStride) { return std::unexpected("Vertex size doesn't match stride"); }
+            return Upload(std::as_bytes(vertices), indices);
+        }
+
+        /// @brief Release a mesh. Its ranges are reused once in-flight frames have finished.
+        void Free(MeshId mesh);
+
+        /// @brief Record this frame's staged copies and make them visible to vertex input and shaders
+        /// @param frames Frame synchronizer whose current command buffer is recording, outside rendering
+        void Flush(const FrameSynchronizer& frames);
+
+        /// @brief Flush, then repack every live mesh contiguously into new buffers. Ranges change (see
+        /// GetGeneration), so refresh anything built from GetMesh, e.g. indirect commands.
+        /// @param frames Frame synchronizer whose current command buffer is recording, outside rendering
+        /// @param vertexCapacity New vertex capacity (0 keeps the current one)
+        /// @param indexCapacity New index capacity (0 keeps the current one)
+        /// @return Result containing success or error message
+        Result<void> Compact(const FrameSynchronizer& frames, u32 vertexCapacity = 0, u32 indexCapacity = 0);
+
+        /// @brief Bind the vertex buffer at binding 0 and the index buffer
+        void Bind(VkCommandBuffer commandBuffer) const;
+
+        /// @brief Current ranges of a mesh
+        /// @return Pointer to the ranges, or nullptr for a freed or invalid handle
+        V_ND const MeshRange* GetMesh(MeshId mesh) const;
+
+        V_ND Stats GetStats() const;
+
+        /// @brief Incremented by every Compact; mesh ranges from an older generation are stale
+        V_ND u32 GetGeneration() const {
+            return mGeneration;
+        }
+
+        V_ND const Buffer& GetVertexBuffer() const {
+            return *mVertices;
+        }
+
+        V_ND const Buffer& GetIndexBuffer() const {
+            return *mIndices;
+        }
+
+        V_ND bool IsInitialized() const {
+            return mVertices != nullptr;
+        }
+
+    private:
+        struct MeshSlot {
+            MeshRange range {};
+            TlsfAllocator::Allocation vertices {};
+            TlsfAllocator::Allocation indices {};
+            bool live {false};
+        };
+
+        struct PendingCopy {
+            VkBuffer destination;
+            VkBufferCopy region;
+        };
+
+        /// @brief Ranges and buffers released while frames in flight may still read them
+        struct Deferred {
+            std::vector<TlsfAllocator::Allocation> vertices;
+            std::vector<TlsfAllocator::Allocation> indices;
+            std::vector<std::unique_ptr<Buffer>> buffers;
+        };
+
+        Result<std::unique_ptr<Buffer>> CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage) const;
+        void RecordPendingCopies(VkCommandBuffer commandBuffer);
+
+        VulkanContext* mContext {nullptr};
+        Config mConfig {};
+        u32 mFrameSlot {0};
+        u32 mGeneration {0};
+
+        std::unique_ptr<Buffer> mVertices;
+        std::unique_ptr<Buffer> mIndices;
+        TlsfAllocator mVertexAllocator;
+        TlsfAllocator mIndexAllocator;
+
+        std::vector<MeshSlot> mMeshes;
+        std::vector<MeshId> mFreeIds;
+
+        TransientRing mUploads;
+        std::vector<PendingCopy> mPendingCopies;
+        std::vector<Deferred> mDeferred;  // One per frame in flight
+    };
+}  // namespace Vulkano
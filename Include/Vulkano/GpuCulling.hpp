@@ -0,0 +1,163 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "Buffer.hpp"
+#include "DescriptorStream.hpp"
+#include "Frustum.hpp"
+#include "TransientRing.hpp"
+
+#include <span>
+#include <vector>
+
+namespace Vulkano {
+    class VulkanContext;
+    class PipelineCompiler;
+    class FrameSynchronizer;
+    class DepthPyramid;
+
+    /// @brief One culled object. Matches CullCommon.glsl (std430).
+    struct GpuInstance {
+        f32 center[3] {0.0f, 0.0f, 0.0f};  // World-space bounding sphere
+        f32 radius {0.0f};
+        u32 meshIndex {0};
+        u32 reserved[3] {};
+    };
+
+    /// @brief Index range of a mesh in the bound index/vertex buffers. Matches CullCommon.glsl (std430).
+    struct GpuMeshDraw {
+        u32 indexCount {0};
+        u32 firstIndex {0};
+        i32 vertexOffset {0};
+        u32 reserved {0};
+    };
+
+    /// @brief GPU-driven draw submission: a compute pass frustum-culls (and optionally Hi-Z occlusion-culls) a
+    /// persistent instance buffer, writes one VkDrawIndexedIndirectCommand per visible instance and a count, and
+    /// the draw consumes both with vkCmdDrawIndexedIndirectCount. Each command's firstInstance is the instance
+    /// index, so vertex shaders can fetch per-instance data with gl_InstanceIndex.
+    ///
+    /// Needs CullInstances.comp (and CullInstancesHiZ.comp with occlusion) in the compiler's ShaderLibrary.
+    /// Per frame, after FrameSynchronizer::BeginFrame: BeginFrame, any Update calls, Cull outside rendering, then
+    /// Draw inside rendering.
+    class GpuCulling {
+    public:
+        /// @brief Configuration for culling setup
+        struct Config {
+            u32 maxInstances {65536};
+            u32 maxMeshes {4096};
+            u32 framesInFlight {2};
+            bool occlusion {false};                      // Hi-Z test against a DepthPyramid
+            VkDeviceSize uploadBytesPerFrame {1u << 20};  // Staging space for Update calls
+        };
+
+        /// @brief What to cull against this frame
+        struct View {
+            Mat4 viewProjection {};
+            u32 instanceCount {0};                 // Instances [0, instanceCount) are considered
+            const DepthPyramid* pyramid {nullptr};  // Built from the previous frame's depth; ignored without occlusion
+        };
+
+        /// @brief Draw counts of the most recently completed frame
+        struct Stats {
+            u32 submitted {0};  // Before culling
+            u32 visible {0};    // After culling
+        };
+
+        GpuCulling() = default;
+        ~GpuCulling();
+
+        GpuCulling(const GpuCulling&)            = delete;
+        GpuCulling& operator=(const GpuCulling&) = delete;
+        GpuCulling(GpuCulling&&)                 = delete;
+        GpuCulling& operator=(GpuCulling&&)      = delete;
+
+        /// @brief Create the instance, mesh, command and count buffers and the culling pipeline
+        /// @param context Vulkan context with a created device
+        /// @param compiler Pipeline compiler to build the culling shader with
+        /// @param config Culling configuration
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context, PipelineCompiler* compiler, const Config& config);
+
+        void Shutdown();
+
+        /// @brief Start a frame: collect the finished frame's draw counts and recycle its staging space. Call after
+        /// FrameSynchronizer::BeginFrame has waited on the frame's fence.
+        void BeginFrame(const FrameSynchronizer& frames);
+
+        /// @brief Stage instance data; copied into the persistent buffer at the start of this frame's Cull
+        /// @return Result containing success or error message
+        Result<void> UpdateInstances(u32 first, std::span<const GpuInstance> instances);
+
+        /// @brief Stage mesh ranges; copied into the persistent buffer at the start of this frame's Cull
+        /// @return Result containing success or error message
+        Result<void> UpdateMeshes(u32 first, std::span<const GpuMeshDraw> meshes);
+
+        /// @brief Record pending uploads and the culling dispatch into the current frame's command buffer
+        /// @param frames Frame synchronizer whose current command buffer is recording, outside rendering
+        /// @param view Camera and instance range to cull
+        /// @return Result containing success or error message
+        Result<void> Cull(const FrameSynchronizer& frames, const View& view);
+
+        /// @brief Record the indirect draw. The graphics pipeline, vertex and index buffers must already be bound.
+        void Draw(const FrameSynchronizer& frames) const;
+
+        /// @brief Instance buffer, for vertex shaders that read per-instance data
+        V_ND const Buffer& GetInstanceBuffer() const {
+            return mInstances;
+        }
+
+        V_ND const Stats& GetStats() const {
+            return mStats;
+        }
+
+        V_ND bool IsInitialized() const {
+            return mPipeline != VK_NULL_HANDLE;
+        }
+
+    private:
+        /// @brief CullCommon.glsl uniform block (std140)
+        struct CullParams {
+            Mat4 viewProjection;
+            Plane planes[Frustum::kCount];
+            f32 pyramidSize[2];
+            u32 instanceCount;
+            u32 frameSlot;
+            u32 commandOffset;
+            u32 compact;
+            u32 reserved[2];
+        };
+
+        struct PendingCopy {
+            VkBuffer destination;
+            VkBufferCopy region;
+        };
+
+        Result<void> Stage(const Buffer& destination, VkDeviceSize offset, const void* data, VkDeviceSize size);
+
+        VulkanContext* mContext {nullptr};
+        Config mConfig {};
+        bool mDrawCount {false};  // vkCmdDrawIndexedIndirectCount available; otherwise culled slots draw nothing
+        bool mMultiDraw {false};  // One vkCmdDrawIndexedIndirect for all slots; otherwise one per slot
+
+        Buffer mInstances;
+        Buffer mMeshes;
+        Buffer mCommands;  // framesInFlight * maxInstances commands
+        Buffer mCounts;    // One u32 per frame in flight
+        Buffer mReadback;  // Host copy of mCounts
+
+        TransientRing mUploads;
+        std::vector<PendingCopy> mPendingCopies;
+        std::vector<u32> mSubmitted;  // Instance count culled by each frame in flight
+
+        DescriptorStream mDescriptors;
+        VkPipelineLayout mPipelineLayout {VK_NULL_HANDLE};
+        VkPipeline mPipeline {VK_NULL_HANDLE};  // Owned by the compiler
+
+        Stats mStats {};
+    };
+}  // namespace Vulkano
@@ -0,0 +1,83 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+
+#include <functional>
+#include <string_view>
+#include <type_traits>
+
+namespace Vulkano {
+    /// @brief Incremental 64-bit FNV-1a hasher. Stable across runs and platforms, so hashes can be written to disk.
+    class Hasher {
+    public:
+        static constexpr u64 kOffsetBasis = 0xcbf29ce484222325ull;
+        static constexpr u64 kPrime       = 0x100000001b3ull;
+
+        constexpr Hasher& Bytes(const void* data, size_t size) {
+            const auto* bytes = static_cast<const u8*>(data);
+            for (size_t i = 0; i < size; i++) {
+                mState = (mState ^ bytes[i]) * kPrime;
+            }
+            return *this;
+        }
+
+        /// @brief Hash an integral or enum value byte by byte (little-endian order regardless of platform)
+        template<typename T>
+            requires std::is_integral_v<T> || std::is_enum_v<T>
+        constexpr Hasher& Value(T value) {
+            if constexpr (std::is_same_v<T, bool>) {
+                return Value(static_cast<u8>(value ? 1 : 0));
+            } else {
+                using I =
+                  typename std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::type_identity<T>>::type;
+                using U     = std::make_unsigned_t<I>;
+                const U raw = static_cast<U>(value);
+                for (size_t i = 0; i < sizeof(U); i++) {
+                    mState = (mState ^ static_cast<u8>(raw >> (i * 8))) * kPrime;
+                }
+                return *this;
+            }
+        }
+
+        /// @brief Hash a string including its length, so ("ab", "c") and ("a", "bc") differ
+        constexpr Hasher& String(std::string_view str) {
+            Value(static_cast<u64>(str.size()));
+            for (const char c : str) {
+                mState = (mState ^ static_cast<u8>(c)) * kPrime;
+            }
+            return *this;
+        }
+
+        V_ND constexpr u64 Get() const {
+            return mState;
+        }
+
+    private:
+        u64 mState {kOffsetBasis};
+    };
+
+    /// @brief Finalizer that spreads entropy across all bits (from MurmurHash3); use before masking to a table size
+    constexpr u64 MixHash(u64 value) {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdull;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ull;
+        value ^= value >> 33;
+        return value;
+    }
+
+    /// @brief Transparent hash for string-keyed unordered maps, so lookups by std::string_view don't build a
+    /// temporary std::string. Pair with std::equal_to<>.
+    struct StringHash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view str) const {
+            return std::hash<std::string_view> {}(str);
+        }
+    };
+}  // namespace Vulkano
@@ -0,0 +1,76 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Vulkano {
+    /// @brief Handle to a submitted job; becomes ready once the job has run
+    using JobHandle = std::shared_future<void>;
+
+    /// @brief Fixed-size worker pool for file loading, pipeline compilation and data-parallel loops
+    class JobSystem {
+    public:
+        JobSystem() = default;
+        ~JobSystem();
+
+        JobSystem(const JobSystem&)            = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+        JobSystem(JobSystem&&)                 = delete;
+        JobSystem& operator=(JobSystem&&)      = delete;
+
+        /// @brief Start the worker threads
+        /// @param threadCount Number of workers (0 = hardware concurrency minus the calling thread)
+        /// @return Result containing success or error message
+        Result<void> Initialize(u32 threadCount = 0);
+
+        /// @brief Finish all queued jobs and join the workers
+        void Shutdown();
+
+        /// @brief Queue a job. Runs inline when the system has no workers.
+        /// @param job Work to run on a worker thread
+        /// @return Handle that can be waited on
+        JobHandle Submit(std::function<void()> job);
+
+        /// @brief Split [0, count) into chunks and process them across the workers and the calling thread.
+        /// Blocks until every chunk has been processed. Safe to call from inside a job.
+        /// @param count Number of items
+        /// @param chunkSize Items per chunk
+        /// @param fn Callback receiving the [begin, end) range of a chunk
+        void ParallelFor(u32 count, u32 chunkSize, const std::function<void(u32 begin, u32 end)>& fn);
+
+        /// @brief Block until the queue is empty and no job is running
+        void WaitIdle();
+
+        V_ND u32 GetThreadCount() const {
+            return CAST<u32>(mWorkers.size());
+        }
+
+        V_ND bool IsInitialized() const {
+            return !mWorkers.empty();
+        }
+
+    private:
+        /// @brief Worker thread main loop
+        void WorkerLoop();
+
+        std::vector<std::thread> mWorkers;
+        std::deque<std::packaged_task<void()>> mQueue;
+        std::mutex mMutex;
+        std::condition_variable mWorkAvailable;
+        std::condition_variable mIdle;
+        u32 mActiveJobs {0};
+        bool mStopping {false};
+    };
+}  // namespace Vulkano
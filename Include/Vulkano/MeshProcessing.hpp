@@ -0,0 +1,178 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "GeometryArena.hpp"
+
+#include <array>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace Vulkano {
+    /// @brief Uncompressed vertex as meshes arrive from content tools (32 bytes)
+    struct SourceVertex {
+        f32 position[3] {0.0f, 0.0f, 0.0f};
+        f32 normal[3] {0.0f, 0.0f, 1.0f};
+        f32 uv[2] {0.0f, 0.0f};
+    };
+
+    /// @brief Quantized GPU vertex (16 bytes). Positions are SNORM16 relative to the mesh bounds (decode with
+    /// ProcessedMesh::positionOffset + value * positionScale), normals are octahedral SNORM16 and UVs half floats.
+    struct PackedVertex {
+        i16 position[4] {0, 0, 0, 0};  // w is padding
+        i16 normal[2] {0, 0};
+        u16 uv[2] {0, 0};
+
+        /// @brief Vertex attributes at locations 0 (position), 1 (normal) and 2 (uv)
+        static std::array<VkVertexInputAttributeDescription, 3> GetAttributes(u32 binding = 0);
+    };
+
+    static_assert(sizeof(PackedVertex) == 16);
+
+    /// @brief Meshlet size limits (the common VK_EXT_mesh_shader sweet spot; 124 keeps the primitive indices of a
+    /// meshlet within 372 bytes, padded to 4)
+    inline constexpr u32 kMaxMeshletVertices  = 64;
+    inline constexpr u32 kMaxMeshletTriangles = 124;
+
+    /// @brief A cluster of triangles sharing at most kMaxMeshletVertices vertices. Matches MeshletCommon.glsl (std430).
+    struct Meshlet {
+        u32 vertexOffset {0};    // First entry in MeshletData::vertices
+        u32 triangleOffset {0};  // First byte in MeshletData::triangles (always a multiple of 4)
+        u32 vertexCount {0};
+        u32 triangleCount {0};
+    };
+
+    /// @brief Mesh-space culling bounds of a meshlet. Matches MeshletCommon.glsl (std430).
+    ///
+    /// The meshlet faces away from a camera at position p (and can be skipped) when
+    /// dot(center - p, coneAxis) >= coneCutoff * length(center - p) + radius. A cutoff of 1 never passes.
+    struct MeshletBounds {
+        f32 center[3] {0.0f, 0.0f, 0.0f};
+        f32 radius {0.0f};
+        f32 coneAxis[3] {0.0f, 0.0f, 1.0f};  // Average of the counter-clockwise triangle normals
+        f32 coneCutoff {1.0f};              // Sine of the normal cone's half angle
+    };
+
+    /// @brief Meshlets of one mesh. Vertex entries index the mesh's vertices; each triangle is three bytes indexing
+    /// the meshlet's vertex entries.
+    struct MeshletData {
+        std::vector<Meshlet> meshlets;
+        std::vector<MeshletBounds> bounds;  // One per meshlet
+        std::vector<u32> vertices;
+        std::vector<u8> triangles;
+    };
+
+    /// @brief Which steps ProcessMesh runs
+    struct MeshProcessOptions {
+        bool weld {true};           // Merge bit-identical vertices (builds indices for unindexed input)
+        bool optimizeCache {true};  // Reorder triangles for post-transform cache hits
+        bool optimizeFetch {true};  // Reorder vertices into first-use order and drop unused ones
+        bool buildMeshlets {true};  // Split the optimized triangle order into meshlets for mesh shading
+        u32 simulatedCacheSize {16};
+    };
+
+    /// @brief Before/after numbers for one processed mesh
+    struct MeshReport {
+        u32 triangles {0};
+        u32 sourceVertices {0};
+        u32 vertices {0};
+        u32 meshlets {0};
+        u32 invocationsBefore {0};  // Vertex shader runs with a simulated FIFO post-transform cache
+        u32 invocationsAfter {0};
+        u64 bytesBefore {0};  // Vertex and index data
+        u64 bytesAfter {0};
+
+        /// @brief Average cache miss ratio: vertex shader runs per triangle (0.5 is ideal for grids, 3 is worst)
+        V_ND f32 AcmrBefore() const {
+            return triangles > 0 ? CAST<f32>(invocationsBefore) / CAST<f32>(triangles) : 0.0f;
+        }
+
+        V_ND f32 AcmrAfter() const {
+            return triangles > 0 ? CAST<f32>(invocationsAfter) / CAST<f32>(triangles) : 0.0f;
+        }
+    };
+
+    /// @brief GPU-ready mesh: quantized vertices, optimized u32 indices and (optionally) meshlets over the same
+    /// triangles in the same order
+    struct ProcessedMesh {
+        std::vector<PackedVertex> vertices;
+        std::vector<u32> indices;
+        MeshletData meshlets;
+        f32 positionOffset[3] {0.0f, 0.0f, 0.0f};
+        f32 positionScale[3] {1.0f, 1.0f, 1.0f};
+        MeshReport report {};
+
+        /// @brief Stage the streams into an arena created with vertexStride = sizeof(PackedVertex)
+        /// @return The mesh handle, or an error from the arena
+        Result<MeshId> Upload(GeometryArena& arena) const {
+            return arena.Upload<PackedVertex>(vertices, indices);
+        }
+
+        /// @brief Write the mesh in the baked .vmesh format
+        /// @param path Output file
+        /// @return Result containing success or error message
+        Result<void> Save(const std::filesystem::path& path) const;
+
+        /// @brief Read a baked .vmesh file (the report is not stored)
+        /// @param path Input file
+        /// @return The mesh, or an error if the file is missing or malformed
+        static Result<ProcessedMesh> Load(const std::filesystem::path& path);
+
+    private:
+        static constexpr u32 kMagic {0x534D4B56};  // "VKMS"
+        static constexpr u32 kVersion {2};
+    };
+
+    /// @brief Run the ingest pipeline: weld, optimize triangle order, optimize vertex order, build meshlets, quantize
+    /// @param vertices Source vertices
+    /// @param indices Triangle list indices, or empty if vertices is already a triangle list
+    /// @param options Steps to run
+    /// @return The processed mesh, or an error for malformed input
+    Result<ProcessedMesh> ProcessMesh(std::span<const SourceVertex> vertices,
+                                      std::span<const u32> indices,
+                                      const MeshProcessOptions& options = MeshProcessOptions {});
+
+    /// @brief Merge bit-identical vertices
+    /// @param vertices Source vertices
+    /// @param indices Triangle list indices, or empty for an unindexed triangle list
+    /// @param outVertices Unique vertices in first-seen order
+    /// @param outIndices Indices into outVertices
+    void WeldVertices(std::span<const SourceVertex> vertices,
+                      std::span<const u32> indices,
+                      std::vector<SourceVertex>& outVertices,
+                      std::vector<u32>& outIndices);
+
+    /// @brief Reorder triangles for post-transform vertex cache locality (Forsyth's linear-speed algorithm)
+    /// @param indices Triangle list indices, reordered in place
+    /// @param vertexCount Number of vertices the indices refer to
+    void OptimizeVertexCache(std::span<u32> indices, u32 vertexCount);
+
+    /// @brief Reorder vertices into the order the indices first reference them, dropping unreferenced ones
+    /// @param indices Triangle list indices, remapped in place
+    /// @param vertices Vertices, reordered in place and resized to the referenced count
+    void OptimizeVertexFetch(std::span<u32> indices, std::vector<SourceVertex>& vertices);
+
+    /// @brief Split a triangle list into meshlets, keeping the triangle order (run after OptimizeVertexCache so
+    /// neighbouring triangles, which share vertices, land in the same meshlet)
+    /// @param indices Triangle list indices
+    /// @param vertices Vertices the indices refer to; positions and winding give the culling bounds
+    /// @return Meshlets of at most kMaxMeshletVertices vertices and kMaxMeshletTriangles triangles
+    MeshletData BuildMeshlets(std::span<const u32> indices, std::span<const SourceVertex> vertices);
+
+    /// @brief Count vertex shader invocations for an index buffer through a FIFO post-transform cache
+    /// @param indices Triangle list indices
+    /// @param cacheSize Cache entries
+    /// @return Number of cache misses
+    u32 SimulateVertexCache(std::span<const u32> indices, u32 cacheSize = 16);
+
+    /// @brief Encode a unit vector as two octahedral SNORM16 values
+    void EncodeOctahedral(const f32 normal[3], i16 out[2]);
+
+    /// @brief Convert to IEEE half precision (round to nearest even)
+    u16 FloatToHalf(f32 value);
+}  // namespace Vulkano
@@ -0,0 +1,214 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "Buffer.hpp"
+#include "DescriptorStream.hpp"
+#include "Frustum.hpp"
+#include "GeometryArena.hpp"
+#include "MeshProcessing.hpp"
+#include "TransientRing.hpp"
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace Vulkano {
+    class VulkanContext;
+    class PipelineCompiler;
+    class FrameSynchronizer;
+
+    /// @brief One drawn copy of a MeshletRenderer mesh: uniform scale, then translation. Matches
+    /// MeshletCommon.glsl (std430).
+    struct MeshletInstance {
+        f32 position[3] {0.0f, 0.0f, 0.0f};
+        f32 scale {1.0f};
+        u32 mesh {0};  // Index returned by MeshletRenderer::AddMesh
+        u32 reserved[3] {};
+    };
+
+    /// @brief Draws processed meshes (ProcessedMesh with meshlets) whose vertices and indices live in a
+    /// GeometryArena. With VK_EXT_mesh_shader, a task shader frustum- and normal-cone-culls every meshlet of every
+    /// instance and a mesh shader expands the survivors. Without it, each batch becomes one indexed indirect command
+    /// over the mesh's whole index range, all issued by a single multi-draw indirect; only hardware backface culling
+    /// applies there.
+    ///
+    /// Needs Meshlet.task, Meshlet.mesh and Meshlet.frag (mesh shader path) or MeshletFallback.vert and Meshlet.frag
+    /// (fallback) in the compiler's ShaderLibrary, and an arena created with vertexStride = sizeof(PackedVertex).
+    /// Per frame, after FrameSynchronizer::BeginFrame: BeginFrame, any AddMesh and UpdateInstances calls,
+    /// GeometryArena::Flush, Prepare outside rendering, then Draw inside rendering.
+    class MeshletRenderer {
+    public:
+        enum class Path : u8 {
+            MeshShader,
+            MultiDrawIndirect,
+        };
+
+        /// @brief Configuration for renderer setup
+        struct Config {
+            u32 maxMeshes {256};
+            u32 maxMeshlets {1u << 16};  // Across all meshes; vertex and triangle space is sized for full meshlets
+            u32 maxInstances {65536};
+            u32 framesInFlight {2};
+            VkFormat colorFormat {VK_FORMAT_B8G8R8A8_SRGB};
+            VkFormat depthFormat {VK_FORMAT_D32_SFLOAT};
+            VkFrontFace frontFace {VK_FRONT_FACE_COUNTER_CLOCKWISE};  // Cone culling assumes counter-clockwise meshes
+            bool allowMeshShaders {true};                            // False forces the multi-draw indirect path
+            VkDeviceSize uploadBytesPerFrame {16u << 20};            // Staging space for AddMesh/UpdateInstances
+        };
+
+        /// @brief Camera for this frame's Draw calls
+        struct View {
+            Mat4 viewProjection {};
+            f32 cameraPosition[3] {0.0f, 0.0f, 0.0f};  // World space, for cone culling
+            bool frustumCulling {true};                // Mesh shader path only
+            bool coneCulling {true};                   // Mesh shader path only
+        };
+
+        /// @brief Instances [firstInstance, firstInstance + instanceCount) of one mesh; their MeshletInstance::mesh
+        /// must match
+        struct Batch {
+            u32 mesh {0};
+            u32 firstInstance {0};
+            u32 instanceCount {0};
+        };
+
+        /// @brief Resident data and the work recorded by the last Draw
+        struct Stats {
+            u32 meshes {0};
+            u32 meshlets {0};
+            u64 triangles {0};     // Triangles of every drawn instance, before any culling
+            u32 taskGroups {0};    // Mesh shader path
+            u32 drawCommands {0};  // Multi-draw indirect path
+        };
+
+        MeshletRenderer() = default;
+        ~MeshletRenderer();
+
+        MeshletRenderer(const MeshletRenderer&)            = delete;
+        MeshletRenderer& operator=(const MeshletRenderer&) = delete;
+        MeshletRenderer(MeshletRenderer&&)                 = delete;
+        MeshletRenderer& operator=(MeshletRenderer&&)      = delete;
+
+        /// @brief Create the meshlet and instance buffers and the pipeline of whichever path the device supports
+        /// @param context Vulkan context with a created device
+        /// @param compiler Pipeline compiler to build the shaders with
+        /// @param arena Geometry arena holding the vertices and indices of added meshes
+        /// @param config Renderer configuration
+        /// @return Result containing success or error message
+        Result<void>
+        Initialize(VulkanContext* context, PipelineCompiler* compiler, GeometryArena* arena, const Config& config);
+
+        void Shutdown();
+
+        /// @brief Start a frame: recycle its staging space. Call after FrameSynchronizer::BeginFrame has waited on
+        /// the frame's fence.
+        void BeginFrame(const FrameSynchronizer& frames);
+
+        /// @brief Upload a mesh's geometry to the arena and stage its meshlets
+        /// @param mesh Mesh processed with MeshProcessOptions::buildMeshlets
+        /// @return Index to reference from MeshletInstance::mesh and Batch::mesh, or an error if space ran out
+        Result<u32> AddMesh(const ProcessedMesh& mesh);
+
+        /// @brief Stage instance data; copied into the persistent buffer by this frame's Prepare
+        /// @return Result containing success or error message
+        Result<void> UpdateInstances(u32 first, std::span<const MeshletInstance> instances);
+
+        /// @brief Record pending uploads and set the camera. Call outside rendering, after GeometryArena::Flush.
+        /// @param frames Frame synchronizer whose current command buffer is recording
+        /// @param view Camera for this frame's draws
+        /// @return Result containing success or error message
+        Result<void> Prepare(const FrameSynchronizer& frames, const View& view);
+
+        /// @brief Record the draws inside rendering. Viewport and scissor must already be set.
+        /// @param frames Frame synchronizer whose current command buffer is rendering
+        /// @param batches Meshes and instance ranges to draw
+        /// @return Result containing success or error message
+        Result<void> Draw(const FrameSynchronizer& frames, std::span<const Batch> batches);
+
+        V_ND Path GetPath() const {
+            return mPath;
+        }
+
+        V_ND const Stats& GetStats() const {
+            return mStats;
+        }
+
+        V_ND bool IsInitialized() const {
+            return mPipeline != VK_NULL_HANDLE;
+        }
+
+    private:
+        /// @brief MeshletCommon.glsl uniform block (std140)
+        struct Params {
+            Mat4 viewProjection;
+            Plane planes[Frustum::kCount];
+            f32 cameraPosition[3];
+            u32 cullFlags;
+        };
+
+        /// @brief MeshletCommon.glsl MeshInfo (std430)
+        struct GpuMesh {
+            u32 meshletOffset;
+            u32 meshletCount;
+            u32 vertexOffset;
+            u32 reserved;
+            std::array<f32, 4> positionOffset;  // w unused
+            std::array<f32, 4> positionScale;
+        };
+
+        struct MeshSlot {
+            MeshId arenaMesh;
+            u32 triangles;
+            GpuMesh gpu;
+        };
+
+        struct DrawConstants {
+            u32 mesh;
+            u32 firstInstance;
+        };
+
+        struct PendingCopy {
+            VkBuffer destination;
+            VkBufferCopy region;
+        };
+
+        Result<void> Stage(const Buffer& destination, VkDeviceSize offset, const void* data, VkDeviceSize size);
+        Result<void> StageMesh(u32 mesh);
+        Result<void> CreatePipeline(PipelineCompiler* compiler);
+
+        VulkanContext* mContext {nullptr};
+        GeometryArena* mArena {nullptr};
+        Config mConfig {};
+        Path mPath {Path::MultiDrawIndirect};
+        bool mMultiDraw {false};  // One vkCmdDrawIndexedIndirect for all batches; otherwise one per batch
+        VkShaderStageFlags mStages {0};
+
+        Buffer mInstances;
+        Buffer mMeshes;
+        Buffer mMeshlets;  // Mesh shader path only, like the three below
+        Buffer mBounds;
+        Buffer mMeshletVertices;
+        Buffer mMeshletTriangles;
+
+        std::vector<MeshSlot> mSlots;
+        u32 mMeshletCount {0};
+        u32 mMeshletVertexCount {0};
+        u32 mMeshletTriangleBytes {0};
+        u32 mArenaGeneration {0};
+
+        TransientRing mUploads;  // Staging, uniforms and fallback draw commands
+        std::vector<PendingCopy> mPendingCopies;
+        TransientRing::Allocation mParams {};
+
+        DescriptorStream mDescriptors;
+        VkPipelineLayout mPipelineLayout {VK_NULL_HANDLE};
+        VkPipeline mPipeline {VK_NULL_HANDLE};  // Owned by the compiler
+
+        Stats mStats {};
+    };
+}  // namespace Vulkano
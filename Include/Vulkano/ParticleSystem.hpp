@@ -0,0 +1,224 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "Buffer.hpp"
+#include "DescriptorStream.hpp"
+#include "Frustum.hpp"
+#include "TransientRing.hpp"
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace Vulkano {
+    class VulkanContext;
+    class PipelineCompiler;
+    class FrameSynchronizer;
+
+    /// @brief One simulated particle. Matches ParticleCommon.glsl (std430) and Particle.vert's instance input.
+    struct GpuParticle {
+        f32 position[3];
+        f32 life;  // Seconds left
+        f32 velocity[3];
+        u32 color;  // RGBA8, red in the lowest byte
+    };
+
+    /// @brief Continuous particle source. Emitters are matched to their fractional spawn remainder by their position
+    /// in the span given to ParticleSystem::Simulate, so keep the order stable between frames.
+    struct ParticleEmitter {
+        f32 position[3] {0.0f, 0.0f, 0.0f};
+        f32 radius {0.0f};  // Particles spawn uniformly inside this sphere
+        f32 velocity[3] {0.0f, 0.0f, 0.0f};
+        f32 velocityJitter {0.0f};     // Random velocity of up to this length added to each particle
+        f32 rate {0.0f};               // Particles per second
+        u32 burst {0};                 // Extra particles this frame
+        f32 lifetime[2] {1.0f, 1.0f};  // Seconds, min and max
+        u32 color {0xFFFFFFFF};        // RGBA8, red in the lowest byte
+    };
+
+    /// @brief Compute-driven particles that never touch the CPU. Particle state lives in two persistent GPU buffers
+    /// used ping-pong: every Simulate flags the survivors of the previous frame's buffer, prefix-scans the flags
+    /// (per workgroup, then across workgroups) and scatters the integrated survivors densely into the other buffer,
+    /// then appends newly emitted particles behind them. The alive list is therefore always [0, count), and the
+    /// same pass writes the next frame's indirect dispatch and this frame's indirect draw, so particle counts never
+    /// round-trip through the host.
+    ///
+    /// Simulation is recorded and submitted on the compute queue (the async compute family when the device has
+    /// one) and ordered against the graphics queue with two timeline semaphores: the graphics submit waits for
+    /// this frame's simulation, and a simulation waits for the graphics frame that last drew from the buffer it is
+    /// about to overwrite, two frames back. Compute and rendering of consecutive frames can therefore overlap.
+    ///
+    /// Needs ParticleScan.comp, ParticleScanBlocks.comp, ParticleSimulate.comp, ParticleEmit.comp, Particle.vert and
+    /// Particle.frag in the compiler's ShaderLibrary. Per frame: Simulate, then Draw inside rendering, then submit
+    /// the graphics command buffer with GetGraphicsSync's wait and signal. Every Simulate must be followed by
+    /// exactly one such graphics submit, drawn or not, or the next simulations wait forever.
+    class ParticleSystem {
+    public:
+        static constexpr u32 kMaxEmitters {16};  // Per Simulate call
+
+        /// @brief Configuration for particle system setup
+        struct Config {
+            u32 maxParticles {1u << 20};  // At most 65535 * 256
+            u32 framesInFlight {2};
+            VkFormat colorFormat {VK_FORMAT_B8G8R8A8_SRGB};
+            VkFormat depthFormat {VK_FORMAT_UNDEFINED};  // Must match the rendering pass Draw is recorded in
+        };
+
+        /// @brief Forces applied by one Simulate
+        struct Simulation {
+            f32 deltaTime {1.0f / 60.0f};
+            f32 gravity[3] {0.0f, -9.81f, 0.0f};
+            f32 drag {0.0f};  // Fraction of velocity lost per second
+        };
+
+        /// @brief Camera and look for Draw
+        struct View {
+            Mat4 viewProjection {};
+            f32 right[3] {1.0f, 0.0f, 0.0f};  // World-space camera axes the billboards are built from
+            f32 up[3] {0.0f, 1.0f, 0.0f};
+            f32 size {0.05f};     // Billboard width in world units
+            f32 fadeTime {0.5f};  // Particles fade out over their last fadeTime seconds
+        };
+
+        /// @brief Semaphores to add to the graphics submit of the frame that called Simulate. With vkQueueSubmit,
+        /// chain a VkTimelineSemaphoreSubmitInfo carrying the two values (binary semaphores in the same submit take
+        /// any value).
+        struct GraphicsSync {
+            VkSemaphore waitSemaphore {VK_NULL_HANDLE};
+            u64 waitValue {0};
+            VkPipelineStageFlags waitStage {0};
+            VkSemaphore signalSemaphore {VK_NULL_HANDLE};
+            u64 signalValue {0};
+        };
+
+        struct Stats {
+            u32 alive {0};    // Particle count of the most recently completed simulation
+            u32 emitted {0};  // Particles requested by the last Simulate
+            u64 frames {0};   // Simulate calls so far
+        };
+
+        ParticleSystem() = default;
+        ~ParticleSystem();
+
+        ParticleSystem(const ParticleSystem&)            = delete;
+        ParticleSystem& operator=(const ParticleSystem&) = delete;
+        ParticleSystem(ParticleSystem&&)                 = delete;
+        ParticleSystem& operator=(ParticleSystem&&)      = delete;
+
+        /// @brief Create the particle, scan and counter buffers, the compute command buffers, the timeline
+        /// semaphores and all pipelines
+        /// @param context Vulkan context with a created device
+        /// @param compiler Pipeline compiler to build the shaders with
+        /// @param config Particle system configuration
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context, PipelineCompiler* compiler, const Config& config);
+
+        /// @brief Wait for the last simulation and destroy everything (the caller makes sure the graphics queue is
+        /// done drawing)
+        void Shutdown();
+
+        /// @brief Advance every particle by one step and emit new ones, then submit the work to the compute queue.
+        /// Blocks only if the simulation framesInFlight steps back has not finished.
+        /// @param simulation Time step and forces
+        /// @param emitters At most kMaxEmitters sources
+        /// @return Result containing success or error message
+        Result<void> Simulate(const Simulation& simulation, std::span<const ParticleEmitter> emitters);
+
+        /// @brief Wait and signal for the graphics submit that follows the last Simulate
+        V_ND GraphicsSync GetGraphicsSync() const;
+
+        /// @brief Record the indirect billboard draw of the last Simulate inside rendering. Viewport and scissor must
+        /// already be set.
+        /// @param frames Frame synchronizer whose current command buffer is rendering
+        /// @param view Camera and particle look
+        void Draw(const FrameSynchronizer& frames, const View& view) const;
+
+        V_ND const Stats& GetStats() const {
+            return mStats;
+        }
+
+        V_ND bool IsInitialized() const {
+            return mDrawPipeline != VK_NULL_HANDLE;
+        }
+
+    private:
+        /// @brief ParticleCommon.glsl emitter (std140)
+        struct GpuEmitter {
+            f32 positionRadius[4];
+            f32 velocityJitter[4];
+            f32 lifetime[2];
+            u32 color;
+            u32 firstParticle;  // Offset of this emitter's particles among the frame's emitted ones
+        };
+
+        /// @brief ParticleCommon.glsl uniform block (std140)
+        struct SimulateParams {
+            f32 gravityDrag[4];
+            f32 deltaTime;
+            u32 emitterCount;
+            u32 emitCount;
+            u32 maxParticles;
+            u32 source;  // Which half of the counters and which particle buffer survivors are read from
+            u32 seed;
+            u32 reserved[2];
+            GpuEmitter emitters[kMaxEmitters];
+        };
+
+        /// @brief ParticleCommon.glsl counters (std430). Index [i] belongs to particle buffer i.
+        struct Counters {
+            u32 count[2];
+            u32 survivors;  // Of the current simulation; emitted particles are appended behind them
+            u32 reserved;
+            VkDispatchIndirectCommand dispatch[2];  // One thread per particle
+            VkDrawIndirectCommand draw[2];          // Four-vertex strip per particle
+        };
+
+        /// @brief Particle.vert push constants
+        struct DrawConstants {
+            Mat4 viewProjection;
+            f32 rightSize[4];
+            f32 upFade[4];
+        };
+
+        Result<void> CreateSync();
+        Result<void> CreatePipelines(PipelineCompiler* compiler);
+        Result<void> RecordSimulation(VkCommandBuffer commandBuffer,
+                                      u64 frame,
+                                      u32 emitCount,
+                                      const TransientRing::Allocation& params);
+
+        VulkanContext* mContext {nullptr};
+        Config mConfig {};
+
+        std::array<Buffer, 2> mParticles;  // Ping-pong state; simulation N writes buffer N % 2
+        Buffer mScan;                      // Survivor offset of each particle within its workgroup
+        Buffer mBlockSums;                 // Survivors per workgroup, then their exclusive scan
+        Buffer mCounters;
+        Buffer mReadback;  // Host copy of each frame in flight's alive count
+
+        TransientRing mUploads;
+        DescriptorStream mDescriptors;
+        std::array<f32, kMaxEmitters> mEmitRemainder {};
+
+        VkCommandPool mCommandPool {VK_NULL_HANDLE};  // On the compute family
+        std::vector<VkCommandBuffer> mCommandBuffers;
+        VkSemaphore mComputeTimeline {VK_NULL_HANDLE};   // Simulation N signals N
+        VkSemaphore mGraphicsTimeline {VK_NULL_HANDLE};  // The graphics submit after simulation N signals N
+        u64 mFrame {0};
+
+        VkPipelineLayout mComputeLayout {VK_NULL_HANDLE};
+        VkPipelineLayout mDrawLayout {VK_NULL_HANDLE};
+        VkPipeline mScanPipeline {VK_NULL_HANDLE};  // All owned by the compiler
+        VkPipeline mScanBlocksPipeline {VK_NULL_HANDLE};
+        VkPipeline mSimulatePipeline {VK_NULL_HANDLE};
+        VkPipeline mEmitPipeline {VK_NULL_HANDLE};
+        VkPipeline mDrawPipeline {VK_NULL_HANDLE};
+
+        Stats mStats {};
+    };
+}  // namespace Vulkano
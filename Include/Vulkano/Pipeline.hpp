@@ -0,0 +1,145 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace Vulkano {
+    class ShaderLibrary;
+    class BinaryWriter;
+    class BinaryReader;
+
+    /// @brief Graphics state that can be left dynamic and set while recording instead of being baked into the
+    /// pipeline. Descriptions that only differ in dynamic state hash to the same pipeline.
+    enum DynamicStateFlagBits : u32 {
+        kDynamicCullMode    = 1u << 0,
+        kDynamicFrontFace   = 1u << 1,
+        kDynamicTopology    = 1u << 2,  // Any topology of the same class (points, lines, triangles, patches)
+        kDynamicDepth       = 1u << 3,  // Depth test enable, write enable and compare op
+        kDynamicPolygonMode = 1u << 4,  // Needs VK_EXT_extended_dynamic_state3
+        kDynamicColorBlend  = 1u << 5,  // Blend enable, equation and write mask; needs VK_EXT_extended_dynamic_state3
+    };
+    using DynamicStateFlags = u32;
+
+    /// @brief Everything Vulkan 1.3 supports without extensions
+    inline constexpr DynamicStateFlags kDynamicStateCore =
+      kDynamicCullMode | kDynamicFrontFace | kDynamicTopology | kDynamicDepth;
+    inline constexpr DynamicStateFlags kDynamicStateAll = kDynamicStateCore | kDynamicPolygonMode | kDynamicColorBlend;
+
+    /// @brief A 32-bit specialization constant (bool, int, uint or the bit pattern of a float)
+    struct SpecializationConstant {
+        u32 id {0};
+        u32 value {0};
+    };
+
+    /// @brief One shader stage, referring to a module in the ShaderLibrary by name
+    struct ShaderStageDesc {
+        VkShaderStageFlagBits stage {VK_SHADER_STAGE_VERTEX_BIT};
+        std::string shader;
+        std::string entryPoint {"main"};
+        std::vector<SpecializationConstant> specialization;
+    };
+
+    /// @brief Plain-data description of a graphics pipeline for dynamic rendering. Everything is referenced by
+    /// name or value so descriptions can be hashed, queued for compilation and stored on disk.
+    struct GraphicsPipelineDesc {
+        std::vector<ShaderStageDesc> stages;
+        std::string layout;  // Name registered with PipelineCompiler::RegisterLayout
+
+        std::vector<VkVertexInputBindingDescription> vertexBindings;
+        std::vector<VkVertexInputAttributeDescription> vertexAttributes;
+
+        VkPrimitiveTopology topology {VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST};
+        VkPolygonMode polygonMode {VK_POLYGON_MODE_FILL};
+        VkCullModeFlags cullMode {VK_CULL_MODE_NONE};
+        VkFrontFace frontFace {VK_FRONT_FACE_COUNTER_CLOCKWISE};
+
+        bool depthTest {false};
+        bool depthWrite {false};
+        VkCompareOp depthCompareOp {VK_COMPARE_OP_LESS_OR_EQUAL};
+
+        bool alphaBlend {false};
+
+        std::vector<VkFormat> colorFormats;
+        VkFormat depthFormat {VK_FORMAT_UNDEFINED};
+        u32 viewMask {0};  // Multiview passes this pipeline draws in (RenderTarget::GetViewMask), 0 without multiview
+
+        /// @brief State to leave dynamic. The fields above still describe the initial values, but are ignored by
+        /// Hash. PipelineCompiler drops bits the device does not support, and topology for mesh shading pipelines.
+        DynamicStateFlags dynamicState {0};
+
+        /// @brief Set when the layout's descriptor sets are bound from descriptor buffers (DescriptorPath::Buffer)
+        bool descriptorBuffer {false};
+
+        /// @brief Stable 64-bit key identifying this pipeline
+        V_ND u64 Hash() const;
+
+        void Serialize(BinaryWriter& writer) const;
+        bool Deserialize(BinaryReader& reader);
+    };
+
+    /// @brief Plain-data description of a compute pipeline
+    struct ComputePipelineDesc {
+        ShaderStageDesc stage {VK_SHADER_STAGE_COMPUTE_BIT, {}, "main", {}};
+        std::string layout;
+
+        /// @brief Set when the layout's descriptor sets are bound from descriptor buffers (DescriptorPath::Buffer)
+        bool descriptorBuffer {false};
+
+        /// @brief Stable 64-bit key identifying this pipeline
+        V_ND u64 Hash() const;
+
+        void Serialize(BinaryWriter& writer) const;
+        bool Deserialize(BinaryReader& reader);
+    };
+
+    /// @brief Color attachment blend state used for every attachment (straight alpha blending, or none)
+    V_ND VkPipelineColorBlendAttachmentState MakeBlendAttachment(bool alphaBlend);
+
+    /// @brief Either kind of pipeline description
+    using PipelineDesc = std::variant<GraphicsPipelineDesc, ComputePipelineDesc>;
+
+    /// @brief Turns pipeline descriptions into VkPipeline objects. Stateless apart from the handles it was
+    /// constructed with, so it can be used from several threads at once.
+    class PipelineBuilder {
+    public:
+        PipelineBuilder(VkDevice device, VkPipelineCache cache, const ShaderLibrary& shaders)
+            : mDevice(device), mCache(cache), mShaders(shaders) {}
+
+        /// @brief Create a graphics pipeline (viewport and scissor are always dynamic)
+        /// @param desc Pipeline description
+        /// @param layout Pipeline layout to use
+        /// @return Result containing the pipeline or error message
+        V_ND Result<VkPipeline> Build(const GraphicsPipelineDesc& desc, VkPipelineLayout layout) const;
+
+        /// @brief Create a compute pipeline
+        /// @param desc Pipeline description
+        /// @param layout Pipeline layout to use
+        /// @return Result containing the pipeline or error message
+        V_ND Result<VkPipeline> Build(const ComputePipelineDesc& desc, VkPipelineLayout layout) const;
+
+    private:
+        /// @brief Specialization data for one stage; must stay in place until the pipeline is created
+        struct StageSpecialization {
+            std::vector<VkSpecializationMapEntry> entries;
+            VkSpecializationInfo info {};
+        };
+
+        /// @brief Resolve a stage description into a create-info, looking the module up by name
+        /// @param stage Stage description (its constants are referenced, not copied)
+        /// @param specialization Storage the create-info's specialization pointer refers to
+        V_ND Result<VkPipelineShaderStageCreateInfo> ResolveStage(const ShaderStageDesc& stage,
+                                                                  StageSpecialization& specialization) const;
+
+        VkDevice mDevice;
+        VkPipelineCache mCache;
+        const ShaderLibrary& mShaders;
+    };
+}  // namespace Vulkano
@@ -0,0 +1,84 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "JobSystem.hpp"
+
+#include <filesystem>
+#include <vector>
+
+namespace Vulkano {
+    class VulkanContext;
+
+    /// @brief Persistent VkPipelineCache backed by a file on disk. The file can be read on a worker thread while
+    /// the device is still being created; Initialize then seeds the cache if the data matches the device.
+    class PipelineCache {
+    public:
+        PipelineCache() = default;
+        ~PipelineCache();
+
+        PipelineCache(const PipelineCache&)            = delete;
+        PipelineCache& operator=(const PipelineCache&) = delete;
+        PipelineCache(PipelineCache&&)                 = delete;
+        PipelineCache& operator=(PipelineCache&&)      = delete;
+
+        /// @brief Start reading the cache file on the job system (does not need a device)
+        /// @param jobs Job system to run the read on
+        /// @param path Cache file location, also used by Save
+        void LoadAsync(JobSystem& jobs, const std::filesystem::path& path);
+
+        /// @brief Create the pipeline cache, waiting for a pending LoadAsync and seeding it if compatible
+        /// @param context Vulkan context with a created device
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context);
+
+        /// @brief Write the current cache contents to the path given to LoadAsync (or SetPath)
+        /// @return Result containing success or error message
+        Result<void> Save() const;
+
+        /// @brief Destroy the pipeline cache (does not save)
+        void Shutdown();
+
+        /// @brief Keep the cache contents on the host and destroy the cache for VulkanContext::RecoverDevice (see
+        /// ResourceRegistry)
+        void ReleaseDeviceObjects();
+
+        /// @brief Create the cache again, seeded with the contents kept by ReleaseDeviceObjects
+        /// @return Result containing success or error message
+        Result<void> RecreateDeviceObjects();
+
+        /// @brief Set the file used by Save without loading anything
+        void SetPath(const std::filesystem::path& path) {
+            mPath = path;
+        }
+
+        V_ND VkPipelineCache GetCache() const {
+            return mCache;
+        }
+
+        /// @brief True if the cache was created from previously saved data
+        V_ND bool WasSeeded() const {
+            return mSeeded;
+        }
+
+        V_ND bool IsInitialized() const {
+            return mCache != VK_NULL_HANDLE;
+        }
+
+    private:
+        /// @brief Check the cache header against the current physical device
+        V_ND bool IsCompatible(const std::vector<u8>& data) const;
+
+        VulkanContext* mContext {nullptr};
+        VkPipelineCache mCache {VK_NULL_HANDLE};
+        std::filesystem::path mPath;
+
+        std::vector<u8> mInitialData;
+        JobHandle mLoadJob;
+        bool mSeeded {false};
+    };
+}  // namespace Vulkano
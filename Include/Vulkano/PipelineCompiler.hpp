@@ -0,0 +1,195 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "Pipeline.hpp"
+#include "PipelineManifest.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace Vulkano {
+    class VulkanContext;
+    class JobSystem;
+    class ShaderLibrary;
+    class PipelineCache;
+
+    /// @brief Parallel pipeline compile service. Descriptions are queued and built on the job system through the
+    /// shared pipeline cache; results are looked up by the description's hash.
+    ///
+    /// Pipelines from a previous run's usage manifest are compiled speculatively, in first-use order, on a single
+    /// low-priority thread so they never compete with the job system. A frame that acquires one of them before it
+    /// is ready moves it onto the job system instead of waiting.
+    class PipelineCompiler {
+    public:
+        /// @brief Compile statistics
+        struct Stats {
+            u32 compiled {0};
+            u32 failed {0};
+            u32 pending {0};
+            u32 warmedUp {0};  // Compiled from the manifest before anything asked for them
+            u32 boosted {0};   // Acquired while still queued for warm-up
+            f64 totalCompileMs {0.0};
+        };
+
+        PipelineCompiler() = default;
+        ~PipelineCompiler();
+
+        PipelineCompiler(const PipelineCompiler&)            = delete;
+        PipelineCompiler& operator=(const PipelineCompiler&) = delete;
+        PipelineCompiler(PipelineCompiler&&)                 = delete;
+        PipelineCompiler& operator=(PipelineCompiler&&)      = delete;
+
+        /// @brief Initialize the compiler
+        /// @param context Vulkan context with a created device
+        /// @param jobs Job system used for background compiles
+        /// @param shaders Shader library that stage descriptions refer to
+        /// @param cache Optional pipeline cache shared by all compiles
+        /// @return Result containing success or error message
+        Result<void>
+        Initialize(VulkanContext* context, JobSystem* jobs, ShaderLibrary* shaders, PipelineCache* cache = nullptr);
+
+        /// @brief Drop queued compiles, stop the warm-up thread, wait for running compiles and destroy all pipelines
+        void Shutdown();
+
+        /// @brief Destroy every pipeline for VulkanContext::RecoverDevice (see ResourceRegistry). Queued compiles are
+        /// dropped and registered layouts forgotten; descriptions and keys are kept, and every entry (failed ones
+        /// included) is compiled again by RecreateDeviceObjects.
+        void ReleaseDeviceObjects();
+
+        /// @brief Queue every known description again under its old key, so keys held by callers stay valid.
+        /// Pipeline handles do not: anything that cached one must look it up again once the generation has changed
+        /// (PipelineVariants does this itself). Layouts have to be registered again first, by an entry of an earlier
+        /// stage.
+        /// @return Result containing success or error message
+        Result<void> RecreateDeviceObjects();
+
+        /// @brief Make a pipeline layout available to descriptions under the given name (not owned)
+        void RegisterLayout(const std::string& name, VkPipelineLayout layout);
+
+        /// @brief Queue a compile on the job system (no-op if already known). Dynamic state the device does not
+        /// support is baked instead, so the returned key may differ from desc.Hash().
+        /// @return Key to look the pipeline up with
+        u64 CompileAsync(const GraphicsPipelineDesc& desc);
+        u64 CompileAsync(const ComputePipelineDesc& desc);
+
+        /// @brief Return the pipeline, compiling it on the calling thread if it has not started yet
+        /// @return Result containing the pipeline or error message
+        Result<VkPipeline> Get(const GraphicsPipelineDesc& desc);
+        Result<VkPipeline> Get(const ComputePipelineDesc& desc);
+
+        /// @brief Queue every pipeline in a manifest for background compilation, in manifest order. Layouts and
+        /// shaders they refer to should be registered first; entries that fail to build are forgotten so a later
+        /// CompileAsync can retry them.
+        /// @param manifest Usage manifest from a previous run
+        void WarmUp(const PipelineManifest& manifest);
+
+        /// @brief Non-blocking lookup
+        /// @return The pipeline, or VK_NULL_HANDLE if it is not ready (or failed)
+        V_ND VkPipeline Find(u64 key) const;
+
+        /// @brief Description a ready pipeline was built from (a linear search, meant for tooling like FrameCapture)
+        V_ND std::optional<PipelineDesc> FindDesc(VkPipeline pipeline) const;
+
+        /// @brief Non-blocking lookup for a pipeline that is about to be used. Records the first use in the usage
+        /// manifest, and if the pipeline is still waiting for warm-up, moves it onto the job system.
+        /// @return The pipeline, or VK_NULL_HANDLE if it is not ready (or failed)
+        VkPipeline Acquire(u64 key);
+
+        /// @brief Pipelines acquired during this run, in first-use order (save this and pass it to WarmUp next run)
+        V_ND const PipelineManifest& GetUsage() const {
+            return mUsage;
+        }
+
+        /// @brief Block until every queued compile, including warm-up, has finished
+        void WaitIdle();
+
+        V_ND Stats GetStats() const;
+
+        /// @brief Bumped by ReleaseDeviceObjects; pipeline handles from an older generation are destroyed
+        V_ND u32 GetGeneration() const {
+            return mGeneration.load(std::memory_order_acquire);
+        }
+
+        /// @brief Dynamic state graphics pipelines can use on this device
+        V_ND DynamicStateFlags GetSupportedDynamicState() const {
+            return mSupportedDynamicState;
+        }
+
+        V_ND bool IsInitialized() const {
+            return mContext != nullptr;
+        }
+
+    private:
+        using Desc = PipelineDesc;
+
+        enum class State { Pending, Compiling, Ready, Failed };
+
+        struct Entry {
+            State state {State::Pending};
+            VkPipeline pipeline {VK_NULL_HANDLE};
+            std::string error;
+            Desc desc;
+            bool speculative {false};  // Only queued by WarmUp; nothing has asked for it yet
+        };
+
+        struct Request {
+            u64 key;
+            Desc desc;
+        };
+
+        /// @brief Drop dynamic state bits the device cannot honor, and topology from mesh shading pipelines
+        V_ND GraphicsPipelineDesc Normalize(GraphicsPipelineDesc desc) const;
+
+        /// @brief Queue a description under its key
+        u64 Enqueue(u64 key, Desc desc);
+
+        /// @brief Blocking lookup shared by both Get overloads
+        Result<VkPipeline> GetOrCompile(u64 key, const Desc& desc);
+
+        /// @brief Mark an entry as wanted and move it from the warm-up queue to the job queue (lock held)
+        /// @return True if a job must be submitted for it
+        bool Promote(u64 key, Entry& entry);
+
+        /// @brief Job body: compile whatever is at the front of the queue
+        void CompileNext();
+
+        /// @brief Warm-up thread body: compile the warm-up queue front to back
+        void WarmUpLoop();
+
+        /// @brief Build a pipeline and publish the result (called without the lock held)
+        void Compile(u64 key, const Desc& desc);
+
+        VulkanContext* mContext {nullptr};
+        JobSystem* mJobs {nullptr};
+        ShaderLibrary* mShaders {nullptr};
+        PipelineCache* mCache {nullptr};
+        DynamicStateFlags mSupportedDynamicState {kDynamicStateCore};
+
+        mutable std::mutex mMutex;
+        std::condition_variable mStateChanged;
+        std::unordered_map<u64, Entry> mEntries;
+        std::unordered_map<std::string, VkPipelineLayout> mLayouts;
+        std::deque<Request> mPending;
+        std::deque<Request> mWarmUpQueue;
+        u32 mOutstandingJobs {0};
+        Stats mStats {};
+        PipelineManifest mUsage;
+        std::atomic<u32> mGeneration {0};
+
+        std::thread mWarmUpThread;
+        std::condition_variable mWarmUpSignal;
+        bool mWarmUpBusy {false};
+        bool mStopWarmUp {false};
+    };
+}  // namespace Vulkano
@@ -0,0 +1,63 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "Pipeline.hpp"
+
+#include <filesystem>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace Vulkano {
+    /// @brief Ordered list of pipelines in the order they were first used. Recorded while the application runs and
+    /// saved on exit, so the next run can compile the same pipelines in the same order before they are needed.
+    class PipelineManifest {
+    public:
+        PipelineManifest() = default;
+
+        PipelineManifest(const PipelineManifest&)            = delete;
+        PipelineManifest& operator=(const PipelineManifest&) = delete;
+        PipelineManifest(PipelineManifest&&)                 = delete;
+        PipelineManifest& operator=(PipelineManifest&&)      = delete;
+
+        /// @brief Append a pipeline unless it has been recorded before
+        /// @param key Hash of the description
+        /// @param desc Pipeline description
+        /// @return True if this was the first use
+        bool RecordUse(u64 key, const PipelineDesc& desc);
+
+        /// @brief Replace the contents with a manifest from disk
+        /// @param path Manifest file
+        /// @return Result containing success or error message
+        Result<void> Load(const std::filesystem::path& path);
+
+        /// @brief Write the manifest to disk
+        /// @param path Manifest file
+        /// @return Result containing success or error message
+        Result<void> Save(const std::filesystem::path& path) const;
+
+        void Clear();
+
+        /// @brief Snapshot of all recorded descriptions in first-use order
+        V_ND std::vector<PipelineDesc> GetEntries() const;
+
+        V_ND bool Contains(u64 key) const;
+
+        V_ND size_t GetSize() const;
+
+    private:
+        static constexpr u32 kMagic {0x4D504B56};  // "VKPM"
+        static constexpr u32 kVersion {4};
+
+        enum class Kind : u8 { Graphics, Compute };
+
+        mutable std::mutex mMutex;
+        std::vector<PipelineDesc> mEntries;
+        std::unordered_set<u64> mKeys;
+    };
+}  // namespace Vulkano
@@ -0,0 +1,194 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "Pipeline.hpp"
+#include "PipelineCompiler.hpp"
+#include "FlatMap.hpp"
+
+#include <array>
+#include <type_traits>
+
+namespace Vulkano {
+    /// @brief One option of a permutation: the specialization constant it drives and how many bits its value needs
+    struct PermutationOption {
+        u32 constantId {0};
+        u32 bits {1};
+    };
+
+    /// @brief Compile-time bitfield of specialization options. Each option occupies `bits` bits, packed in
+    /// declaration order, so the whole permutation is a single u64 that doubles as the variant's table key.
+    ///
+    /// @code
+    /// using MaterialKey = PermutationKey<PermutationOption {0, 1},   // Alpha test
+    ///                                    PermutationOption {1, 2}>;  // Light count (0-3)
+    /// constexpr auto key = MaterialKey {}.With<0>(1).With<1>(3);
+    /// @endcode
+    template<PermutationOption... Options>
+    class PermutationKey {
+    public:
+        static constexpr u32 kOptionCount = sizeof...(Options);
+        static constexpr u32 kTotalBits   = (Options.bits + ... + 0);
+
+        static_assert(kOptionCount > 0, "A permutation needs at least one option");
+        static_assert(((Options.bits > 0 && Options.bits <= 32) && ...), "Options must be 1-32 bits wide");
+        static_assert(kTotalBits <= 64, "A permutation must fit in 64 bits");
+
+        static constexpr std::array<PermutationOption, kOptionCount> kOptions {Options...};
+
+        constexpr PermutationKey() = default;
+
+        constexpr explicit PermutationKey(u64 bits) : mBits(bits & kKeyMask) {}
+
+        /// @brief Set an option's value (truncated to the option's width)
+        template<u32 Index>
+        constexpr PermutationKey& Set(u32 value) {
+            static_assert(Index < kOptionCount, "Option index out of range");
+            constexpr u64 mask  = OptionMask(Index);
+            constexpr u32 shift = kShifts[Index];
+            mBits               = (mBits & ~(mask << shift)) | ((CAST<u64>(value) & mask) << shift);
+            return *this;
+        }
+
+        /// @brief Copy of this key with one option changed
+        template<u32 Index>
+        V_ND constexpr PermutationKey With(u32 value) const {
+            PermutationKey key = *this;
+            return key.template Set<Index>(value);
+        }
+
+        template<u32 Index>
+        V_ND constexpr u32 Get() const {
+            static_assert(Index < kOptionCount, "Option index out of range");
+            return CAST<u32>((mBits >> kShifts[Index]) & OptionMask(Index));
+        }
+
+        V_ND constexpr u64 GetBits() const {
+            return mBits;
+        }
+
+        /// @brief One specialization constant per option, in declaration order
+        V_ND constexpr std::array<SpecializationConstant, kOptionCount> ToConstants() const {
+            std::array<SpecializationConstant, kOptionCount> constants {};
+            for (u32 i = 0; i < kOptionCount; i++) {
+                constants[i] = {kOptions[i].constantId, CAST<u32>((mBits >> kShifts[i]) & OptionMask(i))};
+            }
+            return constants;
+        }
+
+        friend constexpr bool operator==(const PermutationKey&, const PermutationKey&) = default;
+
+    private:
+        static constexpr u64 OptionMask(u32 index) {
+            return (1ull << kOptions[index].bits) - 1;
+        }
+
+        static constexpr std::array<u32, kOptionCount> kShifts = [] {
+            std::array<u32, kOptionCount> shifts {};
+            u32 shift = 0;
+            for (u32 i = 0; i < kOptionCount; i++) {
+                shifts[i] = shift;
+                shift += kOptions[i].bits;
+            }
+            return shifts;
+        }();
+
+        static constexpr u64 kKeyMask = kTotalBits == 64 ? ~0ull : (1ull << kTotalBits) - 1;
+
+        u64 mBits {0};
+    };
+
+    /// @brief All specialization variants of one base pipeline. Variants are requested from the PipelineCompiler
+    /// the first time they are asked for and build on the job system; once a variant is ready, Get is a hash and
+    /// a probe into a flat table with no locking or allocation.
+    ///
+    /// Meant to be used from one thread (usually the render thread). The pipelines belong to the compiler, so the
+    /// variant set must not be used after the compiler has been shut down. Handles cached before a device recovery
+    /// are dropped on the next Get, and the variants are acquired again under their old compile keys.
+    template<typename Key, typename Desc = GraphicsPipelineDesc>
+    class PipelineVariants {
+    public:
+        static_assert(std::is_same_v<Desc, GraphicsPipelineDesc> || std::is_same_v<Desc, ComputePipelineDesc>,
+                      "Variants are built from graphics or compute pipeline descriptions");
+
+        PipelineVariants(PipelineCompiler& compiler, Desc base)
+            : mCompiler(compiler), mBase(std::move(base)), mGeneration(compiler.GetGeneration()) {}
+
+        PipelineVariants(const PipelineVariants&)            = delete;
+        PipelineVariants& operator=(const PipelineVariants&) = delete;
+        PipelineVariants(PipelineVariants&&)                 = delete;
+        PipelineVariants& operator=(PipelineVariants&&)      = delete;
+
+        /// @brief Look a variant up, requesting its compile on first use
+        /// @return The pipeline, or VK_NULL_HANDLE while it is still compiling (or if it failed)
+        VkPipeline Get(Key key) {
+            if (mGeneration != mCompiler.GetGeneration()) { Invalidate(); }
+
+            Variant* variant = mVariants.Find(key.GetBits());
+            if (variant && variant->pipeline != VK_NULL_HANDLE) { return variant->pipeline; }
+
+            if (!variant) { variant = Request(key); }
+            variant->pipeline = mCompiler.Acquire(variant->compileKey);
+            return variant->pipeline;
+        }
+
+        /// @brief Queue a variant's compile ahead of its first use
+        void Prepare(Key key) {
+            if (!mVariants.Find(key.GetBits())) { Request(key); }
+        }
+
+        /// @brief The full pipeline description of a variant: the base with the key's constants added to every
+        /// stage (stages that do not declare a constant ignore it)
+        V_ND Desc MakeDesc(Key key) const {
+            Desc desc            = mBase;
+            const auto constants = key.ToConstants();
+            if constexpr (std::is_same_v<Desc, GraphicsPipelineDesc>) {
+                for (auto& stage : desc.stages) {
+                    stage.specialization.insert(stage.specialization.end(), constants.begin(), constants.end());
+                }
+            } else {
+                desc.stage.specialization.insert(desc.stage.specialization.end(), constants.begin(), constants.end());
+            }
+            return desc;
+        }
+
+        /// @brief Forget all variants (the compiler keeps the pipelines)
+        void Clear() {
+            mVariants.Clear();
+        }
+
+        V_ND size_t GetVariantCount() const {
+            return mVariants.GetSize();
+        }
+
+        V_ND const Desc& GetBase() const {
+            return mBase;
+        }
+
+    private:
+        struct Variant {
+            u64 compileKey {0};
+            VkPipeline pipeline {VK_NULL_HANDLE};
+        };
+
+        /// @brief Drop handles the compiler destroyed in ReleaseDeviceObjects; compile keys stay valid
+        void Invalidate() {
+            mVariants.ForEach([](u64, Variant& variant) { variant.pipeline = VK_NULL_HANDLE; });
+            mGeneration = mCompiler.GetGeneration();
+        }
+
+        Variant* Request(Key key) {
+            const u64 compileKey = mCompiler.CompileAsync(MakeDesc(key));
+            return mVariants.Insert(key.GetBits(), {compileKey, VK_NULL_HANDLE}).first;
+        }
+
+        PipelineCompiler& mCompiler;
+        Desc mBase;
+        FlatMap<Variant> mVariants;
+        u32 mGeneration {0};
+    };
+}  // namespace Vulkano
@@ -0,0 +1,81 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+
+#include <span>
+#include <vector>
+
+namespace Vulkano {
+    class VulkanContext;
+    class SwapchainManager;
+
+    /// @brief Presents the images of several swapchains (one per window or monitor) with a single
+    /// vkQueuePresentKHR. The present engine then waits once on the union of the semaphores instead of once per
+    /// window, and each swapchain still reports its own result, so one out-of-date window doesn't hide the others.
+    ///
+    /// Per frame: Add every acquired image (FrameSynchronizer::AcquireImages acquires them all), then Present.
+    /// A submit rendering several windows signals each one's SwapchainManager::GetPresentSemaphore.
+    class PresentBatcher {
+    public:
+        PresentBatcher() = default;
+        ~PresentBatcher();
+
+        PresentBatcher(const PresentBatcher&)            = delete;
+        PresentBatcher& operator=(const PresentBatcher&) = delete;
+        PresentBatcher(PresentBatcher&&)                 = delete;
+        PresentBatcher& operator=(PresentBatcher&&)      = delete;
+
+        /// @brief Initialize the batcher
+        /// @param context Vulkan context with a created device and present queue
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context);
+
+        void Shutdown();
+
+        /// @brief Queue a swapchain image for the next Present. Each swapchain may be added once per batch, and all of
+        /// them must present on the same queue (see SwapchainManager::GetPresentQueue).
+        /// @param swapchain Swapchain the image was acquired from
+        /// @param imageIndex Index returned by the acquire
+        /// @param waitSemaphore Semaphore signaled when rendering to the image is done; duplicates are waited once
+        /// @return Result containing success or error message
+        Result<void> Add(const SwapchainManager& swapchain, u32 imageIndex, VkSemaphore waitSemaphore);
+
+        /// @brief Present everything added since the last Present and clear the batch. Out-of-date and suboptimal
+        /// swapchains are not errors; check NeedsRecreate for each of them.
+        /// @return Result containing success or error message
+        Result<void> Present();
+
+        /// @brief Per-swapchain results of the last Present, in the order the images were added
+        V_ND std::span<const VkResult> GetResults() const {
+            return mResults;
+        }
+
+        /// @brief Whether the last Present reported the entry's swapchain as out of date or suboptimal
+        /// @param entry Position of the swapchain in the last batch
+        V_ND bool NeedsRecreate(u32 entry) const;
+
+        V_ND u32 GetPendingCount() const {
+            return CAST<u32>(mSwapchains.size());
+        }
+
+        V_ND bool IsInitialized() const {
+            return mContext != nullptr;
+        }
+
+    private:
+        VulkanContext* mContext {nullptr};
+
+        // The pending batch, as parallel arrays ready to be pointed at by VkPresentInfoKHR
+        VkQueue mQueue {VK_NULL_HANDLE};
+        std::vector<VkSwapchainKHR> mSwapchains;
+        std::vector<u32> mImageIndices;
+        std::vector<VkSemaphore> mWaitSemaphores;
+
+        std::vector<VkResult> mResults;  // Of the last Present
+    };
+}  // namespace Vulkano
@@ -0,0 +1,175 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+
+#include <vk_mem_alloc.h>
+#include <vector>
+
+namespace Vulkano {
+    class VulkanContext;
+    struct GraphicsPipelineDesc;
+
+    /// @brief Offscreen color and optional depth target for dynamic rendering, sized independently of the swapchain.
+    /// With more than one layer it is a layered target: stereo eyes, cube faces or shadow cascades. With multiview a
+    /// single BeginRendering covers every layer through a view mask, so one recorded draw stream renders all views;
+    /// vertex shaders pick per-view data with gl_ViewIndex (GL_EXT_multiview). Without it, each layer is rendered
+    /// on its own.
+    ///
+    /// Attachments with no usage beyond being rendered to are transient: lazily allocated where the device offers
+    /// such memory (tilers keep them on chip) and never stored.
+    class RenderTarget {
+    public:
+        /// @brief BeginRendering layer that renders all layers at once with the view mask
+        static constexpr u32 kAllLayers {UINT32_MAX};
+
+        /// @brief Configuration for render target setup
+        struct Config {
+            VkExtent2D extent {0, 0};
+            u32 layers {1};                                             // One view per layer with multiview
+            VkFormat colorFormat {VK_FORMAT_R8G8B8A8_UNORM};            // UNDEFINED for depth only (shadow maps)
+            VkFormat depthFormat {VK_FORMAT_UNDEFINED};                 // UNDEFINED for no depth
+            VkImageUsageFlags colorUsage {VK_IMAGE_USAGE_SAMPLED_BIT};  // On top of COLOR_ATTACHMENT; 0 is transient
+            VkImageUsageFlags depthUsage {0};  // On top of DEPTH_STENCIL_ATTACHMENT; 0 is transient
+            bool multiview {true};             // Needs VulkanContext::Capabilities::multiview when layers > 1
+            bool cube {false};                 // 6 square layers, with a cube view for sampling
+        };
+
+        RenderTarget() = default;
+        ~RenderTarget();
+
+        RenderTarget(const RenderTarget&)            = delete;
+        RenderTarget& operator=(const RenderTarget&) = delete;
+        RenderTarget(RenderTarget&&)                 = delete;
+        RenderTarget& operator=(RenderTarget&&)      = delete;
+
+        /// @brief Create the layered images and their views
+        /// @param context Vulkan context with a created device
+        /// @param config Render target configuration
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context, const Config& config);
+
+        void Shutdown();
+
+        /// @brief Recreate the images at a new extent. The caller makes sure the GPU is done with the old ones.
+        /// @return Result containing success or error message
+        Result<void> Resize(VkExtent2D extent);
+
+        /// @brief Transition the rendered layers to attachment layouts (discarding their contents) and begin rendering
+        /// with viewport and scissor covering the target. Color is cleared to clearColor and depth to 1.
+        /// @param commandBuffer Command buffer recording outside rendering
+        /// @param clearColor Color the layers are cleared to
+        /// @param layer kAllLayers to render every layer through the view mask (without multiview this is a layered
+        /// pass, where shaders route primitives with gl_Layer), otherwise the one layer to render
+        /// @return An error, with nothing recorded, if layer is out of range
+        Result<void>
+        BeginRendering(VkCommandBuffer commandBuffer, const VkClearColorValue& clearColor, u32 layer = kAllLayers);
+
+        /// @brief End rendering and move the stored attachments of the rendered layers to SHADER_READ_ONLY_OPTIMAL
+        /// for fragment and compute shaders, if they were created with sampled usage
+        void EndRendering(VkCommandBuffer commandBuffer) const;
+
+        /// @brief Fill in the attachment formats and view mask a pipeline drawing into this target needs
+        /// @param desc Pipeline description to update
+        /// @param allLayers Whether the pipeline draws in kAllLayers passes (view mask) or single-layer ones
+        void ConfigurePipeline(GraphicsPipelineDesc& desc, bool allLayers = true) const;
+
+        /// @brief View mask of kAllLayers passes: one bit per layer with multiview, 0 otherwise
+        V_ND u32 GetViewMask() const {
+            if (!mMultiview) { return 0; }
+            return mConfig.layers >= 32 ? ~0u : (1u << mConfig.layers) - 1;
+        }
+
+        V_ND bool IsMultiview() const {
+            return mMultiview;
+        }
+
+        V_ND VkExtent2D GetExtent() const {
+            return mConfig.extent;
+        }
+
+        V_ND u32 GetLayerCount() const {
+            return mConfig.layers;
+        }
+
+        V_ND VkFormat GetColorFormat() const {
+            return mConfig.colorFormat;
+        }
+
+        V_ND VkFormat GetDepthFormat() const {
+            return mConfig.depthFormat;
+        }
+
+        V_ND VkImage GetColorImage() const {
+            return mColor.image;
+        }
+
+        /// @brief 2D array view over every layer
+        V_ND VkImageView GetColorView() const {
+            return mColor.view;
+        }
+
+        V_ND VkImageView GetColorLayerView(u32 layer) const {
+            return layer < mColor.layerViews.size() ? mColor.layerViews[layer] : VK_NULL_HANDLE;
+        }
+
+        /// @brief Cube view of a Config::cube target's color image
+        V_ND VkImageView GetColorCubeView() const {
+            return mColor.cubeView;
+        }
+
+        V_ND VkImage GetDepthImage() const {
+            return mDepth.image;
+        }
+
+        V_ND VkImageView GetDepthView() const {
+            return mDepth.view;
+        }
+
+        V_ND VkImageView GetDepthLayerView(u32 layer) const {
+            return layer < mDepth.layerViews.size() ? mDepth.layerViews[layer] : VK_NULL_HANDLE;
+        }
+
+        V_ND VkImageView GetDepthCubeView() const {
+            return mDepth.cubeView;
+        }
+
+        V_ND bool IsInitialized() const {
+            return mContext != nullptr;
+        }
+
+    private:
+        struct Image {
+            VkImage image {VK_NULL_HANDLE};
+            VmaAllocation allocation {VK_NULL_HANDLE};
+            VkImageView view {VK_NULL_HANDLE};  // 2D array over all layers
+            std::vector<VkImageView> layerViews;
+            VkImageView cubeView {VK_NULL_HANDLE};
+            VkImageAspectFlags aspect {0};
+            bool transient {false};
+        };
+
+        Result<void> CreateImages();
+        void DestroyImages();
+        Result<void> CreateImage(Image& image, VkFormat format, VkImageUsageFlags usage, VkImageUsageFlags extraUsage);
+        Result<void> CreateView(const Image& image,
+                                VkFormat format,
+                                VkImageViewType type,
+                                u32 baseLayer,
+                                u32 layers,
+                                VkImageView& view) const;
+        void DestroyImage(Image& image) const;
+
+        VulkanContext* mContext {nullptr};
+        Config mConfig {};
+        bool mMultiview {false};
+
+        Image mColor;
+        Image mDepth;
+        u32 mRenderedLayer {kAllLayers};  // Of the pass in progress, for EndRendering's transitions
+    };
+}  // namespace Vulkano
@@ -0,0 +1,85 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Vulkano {
+    /// @brief Order device objects are recreated in after device loss; later stages may depend on earlier ones
+    enum class RecoveryStage : u8 {
+        Core,       // Swapchain, frame synchronization, per-frame buffers
+        Resources,  // Shader modules, layouts, buffers and images rebuilt from retained CPU data
+        Pipelines,  // Pipelines, which need the shaders and layouts above
+    };
+
+    /// @brief Objects that own device handles and can rebuild them after VulkanContext::RecoverDevice. Each entry
+    /// has a release callback, run while the lost device still exists so its handles can be destroyed, and a recreate
+    /// callback, run on the new device from whatever create-infos and CPU-side data the object kept.
+    ///
+    /// Releases run in reverse stage and registration order, recreates in stage and registration order. The
+    /// registry doesn't own anything: whoever registers an object unregisters it before the object goes away.
+    /// Anything left unregistered has to be shut down and reinitialized by the application.
+    class ResourceRegistry {
+    public:
+        using Handle = u32;
+
+        /// @brief Handle that is never returned by Register
+        static constexpr Handle kInvalidHandle {0};
+
+        /// @brief Add an entry
+        /// @param name Shown in recovery errors
+        /// @param stage When the entry is recreated relative to the others
+        /// @param release Destroy the entry's device objects (the device is lost, nothing has to be waited for)
+        /// @param recreate Create them again on the new device
+        /// @return Handle for Unregister
+        Handle Register(std::string_view name,
+                        RecoveryStage stage,
+                        std::function<void()> release,
+                        std::function<Result<void>()> recreate);
+
+        /// @brief Register an object with ReleaseDeviceObjects and RecreateDeviceObjects members
+        template<typename T>
+        Handle Register(std::string_view name, RecoveryStage stage, T& object) {
+            return Register(name,
+                            stage,
+                            [&object] { object.ReleaseDeviceObjects(); },
+                            [&object] { return object.RecreateDeviceObjects(); });
+        }
+
+        void Unregister(Handle handle);
+
+        /// @brief Run every release callback, last stage first
+        void ReleaseAll();
+
+        /// @brief Run every recreate callback, first stage first, stopping at the first failure
+        /// @return Result containing success or error message naming the entry that failed
+        Result<void> RecreateAll();
+
+        V_ND size_t GetCount() const;
+
+    private:
+        struct Entry {
+            Handle handle {kInvalidHandle};
+            std::string name;
+            RecoveryStage stage {RecoveryStage::Core};
+            std::function<void()> release;
+            std::function<Result<void>()> recreate;
+        };
+
+        /// @brief Copy of the entries in recreate order, so callbacks run without the lock held
+        V_ND std::vector<Entry> Snapshot() const;
+
+        mutable std::mutex mMutex;
+        std::vector<Entry> mEntries;
+        Handle mNextHandle {1};
+    };
+}  // namespace Vulkano
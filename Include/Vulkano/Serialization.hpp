@@ -0,0 +1,128 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Vulkano {
+    /// @brief Appends values to a growable byte buffer in native byte order
+    class BinaryWriter {
+    public:
+        void WriteBytes(const void* data, size_t size) {
+            const auto* bytes = CAST<const u8*>(data);
+            mData.insert(mData.end(), bytes, bytes + size);
+        }
+
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        void Write(const T& value) {
+            WriteBytes(&value, sizeof(T));
+        }
+
+        void WriteString(std::string_view str) {
+            Write(CAST<u32>(str.size()));
+            WriteBytes(str.data(), str.size());
+        }
+
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        void WriteVector(const std::vector<T>& values) {
+            Write(CAST<u32>(values.size()));
+            WriteBytes(values.data(), values.size() * sizeof(T));
+        }
+
+        V_ND const std::vector<u8>& GetData() const {
+            return mData;
+        }
+
+        V_ND size_t GetSize() const {
+            return mData.size();
+        }
+
+        void Clear() {
+            mData.clear();
+        }
+
+        /// @brief Write the buffer to disk via a temporary file, so readers never see a partial file
+        Result<void> SaveToFile(const std::filesystem::path& path) const;
+
+    private:
+        std::vector<u8> mData;
+    };
+
+    /// @brief Reads values written by BinaryWriter. Every read is bounds-checked; once a read fails the reader stays
+    /// failed and all further reads return false.
+    class BinaryReader {
+    public:
+        explicit BinaryReader(std::span<const u8> data) : mData(data) {}
+
+        /// @brief Read a whole file into memory
+        static Result<std::vector<u8>> LoadFile(const std::filesystem::path& path);
+
+        bool ReadBytes(void* out, size_t size) {
+            if (mFailed || size > mData.size() - mOffset) {
+                mFailed = true;
+                return false;
+            }
+            if (size > 0) { std::memcpy(out, mData.data() + mOffset, size); }
+            mOffset += size;
+            return true;
+        }
+
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        bool Read(T& value) {
+            return ReadBytes(&value, sizeof(T));
+        }
+
+        bool ReadString(std::string& str) {
+            u32 size = 0;
+            if (!Read(size) || size > mData.size() - mOffset) { return Fail(); }
+            str.assign(RCAST<const char*>(mData.data() + mOffset), size);
+            mOffset += size;
+            return true;
+        }
+
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        bool ReadVector(std::vector<T>& values) {
+            u32 count = 0;
+            if (!Read(count) || CAST<size_t>(count) * sizeof(T) > mData.size() - mOffset) { return Fail(); }
+            values.resize(count);
+            return ReadBytes(values.data(), count * sizeof(T));
+        }
+
+        V_ND bool AtEnd() const {
+            return mOffset == mData.size();
+        }
+
+        V_ND bool HasFailed() const {
+            return mFailed;
+        }
+
+        V_ND size_t GetOffset() const {
+            return mOffset;
+        }
+
+    private:
+        bool Fail() {
+            mFailed = true;
+            return false;
+        }
+
+        std::span<const u8> mData;
+        size_t mOffset {0};
+        bool mFailed {false};
+    };
+}  // namespace Vulkano
@@ -0,0 +1,90 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "JobSystem.hpp"
+#include "Hash.hpp"
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Vulkano {
+    class VulkanContext;
+
+    /// @brief Named collection of SPIR-V shader modules. Files can be read on the job system before the device
+    /// exists; the modules are created once Initialize is called with a ready context.
+    class ShaderLibrary {
+    public:
+        ShaderLibrary() = default;
+        ~ShaderLibrary();
+
+        ShaderLibrary(const ShaderLibrary&)            = delete;
+        ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+        ShaderLibrary(ShaderLibrary&&)                 = delete;
+        ShaderLibrary& operator=(ShaderLibrary&&)      = delete;
+
+        /// @brief Start reading a SPIR-V file on the job system (ignored if the name is already known)
+        /// @param jobs Job system to run the read on
+        /// @param name Name the shader is looked up by
+        /// @param path SPIR-V file
+        void LoadAsync(JobSystem& jobs, std::string name, const std::filesystem::path& path);
+
+        /// @brief Add SPIR-V that is already in memory (e.g. embedded in the binary)
+        /// @param name Name the shader is looked up by
+        /// @param code SPIR-V words
+        /// @return Result containing success or error message
+        Result<void> Add(std::string name, std::vector<u32> code);
+
+        /// @brief Wait for pending loads and create shader modules for everything added so far
+        /// @param context Vulkan context with a created device
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context);
+
+        /// @brief Destroy all shader modules and drop loaded code
+        void Shutdown();
+
+        /// @brief Destroy the shader modules for VulkanContext::RecoverDevice (see ResourceRegistry), keeping the code
+        void ReleaseDeviceObjects();
+
+        /// @brief Create the modules again from the retained SPIR-V
+        /// @return Result containing success or error message
+        Result<void> RecreateDeviceObjects();
+
+        /// @brief Find a shader module by name
+        /// @return The module, or VK_NULL_HANDLE if unknown or not yet created
+        V_ND VkShaderModule GetModule(std::string_view name) const;
+
+        /// @brief SPIR-V words for a shader, waiting for a pending load (empty if unknown or failed)
+        V_ND std::vector<u32> GetCode(std::string_view name) const;
+
+        V_ND bool Contains(std::string_view name) const;
+
+        V_ND bool IsInitialized() const {
+            return mContext != nullptr;
+        }
+
+    private:
+        struct Entry {
+            std::vector<u32> code;
+            std::string error;
+            JobHandle loadJob;
+            VkShaderModule module {VK_NULL_HANDLE};
+        };
+
+        /// @brief Create the module for one entry (caller holds the lock and has waited for its load)
+        Result<void> CreateModule(const std::string& name, Entry& entry) const;
+
+        VulkanContext* mContext {nullptr};
+
+        mutable std::mutex mMutex;
+        std::unordered_map<std::string, Entry, StringHash, std::equal_to<>> mEntries;
+    };
+}  // namespace Vulkano
@@ -0,0 +1,147 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "TransientRing.hpp"
+
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace Vulkano {
+    class VulkanContext;
+    class PipelineCompiler;
+    class FrameSynchronizer;
+
+    /// @brief One textured quad, in world pixels with y pointing down
+    struct Sprite {
+        f32 position[2] {0.0f, 0.0f};            // Center
+        f32 size[2] {1.0f, 1.0f};                // Width and height
+        f32 rotation {0.0f};                     // Radians, clockwise on screen
+        f32 uvRect[4] {0.0f, 0.0f, 1.0f, 1.0f};  // u0, v0, u1, v1
+        u32 color {0xFFFFFFFF};                  // RGBA8 tint, red in the lowest byte
+        u32 texture {0};                         // Index returned by SpriteBatcher::RegisterTexture
+        u16 layer {0};                           // Higher layers draw on top; equal layers keep submission order
+    };
+
+    /// @brief Draws any number of sprites with a single instanced draw. Every texture sits in one bindless
+    /// (descriptor indexing) sampled image array, so sprites index their texture per instance instead of being split
+    /// into per-texture draws. Flush radix-sorts the frame's sprites by layer, then texture, and packs them into a
+    /// structure-of-arrays instance stream in this frame's region of a TransientRing: one tightly packed array per
+    /// attribute, each bound as its own per-instance vertex buffer.
+    ///
+    /// Needs Capabilities::bindlessTextures, and Sprite.vert and Sprite.frag in the compiler's ShaderLibrary.
+    /// Per frame, after FrameSynchronizer::BeginFrame: BeginFrame, any number of Add calls, then Flush inside
+    /// rendering.
+    class SpriteBatcher {
+    public:
+        /// @brief Configuration for batcher setup
+        struct Config {
+            u32 maxSprites {1u << 18};  // Per frame; further sprites are dropped
+            u32 maxTextures {4096};     // At most 65536 and Capabilities::maxBindlessTextures
+            u32 framesInFlight {2};
+            VkFormat colorFormat {VK_FORMAT_B8G8R8A8_SRGB};
+            VkFilter filter {VK_FILTER_LINEAR};
+        };
+
+        /// @brief 2D camera for Flush
+        struct View {
+            f32 position[2] {0.0f, 0.0f};  // World point at the top-left corner of the viewport
+            f32 zoom {1.0f};               // Screen pixels per world pixel
+        };
+
+        /// @brief What the last Flush did
+        struct Stats {
+            u32 sprites {0};
+            u32 droppedSprites {0};  // Over maxSprites, or with an unregistered texture index
+            u32 sortPasses {0};      // 8-bit radix passes that were not skipped (at most 4)
+            u32 draws {0};
+        };
+
+        SpriteBatcher() = default;
+        ~SpriteBatcher();
+
+        SpriteBatcher(const SpriteBatcher&)            = delete;
+        SpriteBatcher& operator=(const SpriteBatcher&) = delete;
+        SpriteBatcher(SpriteBatcher&&)                 = delete;
+        SpriteBatcher& operator=(SpriteBatcher&&)      = delete;
+
+        /// @brief Create the texture table, the instance ring and the pipeline
+        /// @param context Vulkan context with a created device
+        /// @param compiler Pipeline compiler to build the shaders with
+        /// @param config Batcher configuration
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context, PipelineCompiler* compiler, const Config& config);
+
+        void Shutdown();
+
+        /// @brief Put an image view in the texture table. It must be in SHADER_READ_ONLY_OPTIMAL whenever a frame
+        /// that draws it executes.
+        /// @return Index to use in Sprite::texture, or an error if the table is full
+        Result<u32> RegisterTexture(VkImageView view);
+
+        /// @brief Free a texture index. It is reused once every frame in flight that might draw it has finished.
+        void ReleaseTexture(u32 texture);
+
+        /// @brief Start a frame: recycle its instance space and clear the sprite list. Call after
+        /// FrameSynchronizer::BeginFrame has waited on the frame's fence.
+        void BeginFrame(const FrameSynchronizer& frames);
+
+        void Add(const Sprite& sprite);
+        void Add(std::span<const Sprite> sprites);
+
+        /// @brief Sort and pack this frame's sprites and record their draw inside rendering. Viewport and scissor
+        /// must already be set.
+        /// @param frames Frame synchronizer whose current command buffer is rendering
+        /// @param view Camera
+        /// @param extent Viewport size in pixels
+        /// @return Result containing success or error message
+        Result<void> Flush(const FrameSynchronizer& frames, const View& view, VkExtent2D extent);
+
+        V_ND const Stats& GetStats() const {
+            return mStats;
+        }
+
+        V_ND bool IsInitialized() const {
+            return mPipeline != VK_NULL_HANDLE;
+        }
+
+    private:
+        /// @brief Sprite.vert push constants
+        struct Constants {
+            f32 worldToNdc[4];  // xy scale, zw offset
+        };
+
+        Result<void> CreateTextureTable();
+
+        VulkanContext* mContext {nullptr};
+        Config mConfig {};
+
+        VkSampler mSampler {VK_NULL_HANDLE};
+        VkDescriptorSetLayout mSetLayout {VK_NULL_HANDLE};
+        VkDescriptorPool mPool {VK_NULL_HANDLE};
+        VkDescriptorSet mTextureSet {VK_NULL_HANDLE};
+        std::vector<bool> mTextureUsed;
+        std::vector<u32> mFreeTextures;
+        std::vector<std::pair<u32, u64>> mRetiredTextures;  // Index and the frame it was released in
+        u32 mTextureCount {0};                              // High-water mark of handed-out indices
+        u64 mFrameNumber {0};
+
+        std::vector<Sprite> mSprites;
+        std::vector<u32> mKeys;  // Sort scratch, sized once to maxSprites
+        std::vector<u32> mOrder;
+        std::vector<u32> mScratchKeys;
+        std::vector<u32> mScratchOrder;
+        u32 mDropped {0};
+
+        TransientRing mInstances;
+        VkPipelineLayout mPipelineLayout {VK_NULL_HANDLE};
+        VkPipeline mPipeline {VK_NULL_HANDLE};  // Owned by the compiler
+
+        Stats mStats {};
+    };
+}  // namespace Vulkano
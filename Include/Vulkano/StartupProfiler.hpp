@@ -0,0 +1,95 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Vulkano {
+    /// @brief Records the duration of each bring-up phase (instance, device, allocator, swapchain, ...) and the
+    /// time until the first frame was presented. Thread-safe so phases running on worker threads can report too.
+    class StartupProfiler {
+    public:
+        using Clock     = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+
+        /// @brief A single measured phase, in milliseconds relative to the profiler origin
+        struct Phase {
+            std::string name;
+            f64 startMs {0.0};
+            f64 durationMs {0.0};
+        };
+
+        /// @brief RAII helper that records a phase when it goes out of scope
+        class Scope {
+        public:
+            Scope(StartupProfiler* profiler, std::string_view name)
+                : mProfiler(profiler), mName(name), mStart(Clock::now()) {}
+
+            ~Scope() {
+                Stop();
+            }
+
+            /// @brief Record the phase now instead of at the end of the scope
+            void Stop() {
+                if (mProfiler) { mProfiler->Record(mName, mStart, Clock::now()); }
+                mProfiler = nullptr;
+            }
+
+            Scope(const Scope&)            = delete;
+            Scope& operator=(const Scope&) = delete;
+            Scope(Scope&&)                 = delete;
+            Scope& operator=(Scope&&)      = delete;
+
+        private:
+            StartupProfiler* mProfiler;
+            std::string mName;
+            TimePoint mStart;
+        };
+
+        StartupProfiler() : mOrigin(Clock::now()) {}
+
+        /// @brief Clear all phases and restart the clock (call as early as possible in main)
+        void Reset();
+
+        /// @brief Measure a phase for the lifetime of the returned scope
+        V_ND Scope Measure(std::string_view name) {
+            return Scope(this, name);
+        }
+
+        /// @brief Record a phase from explicit start and end times
+        void Record(std::string_view name, TimePoint start, TimePoint end);
+
+        /// @brief Mark the first frame as presented. Only the first call is recorded.
+        void MarkFirstFrame();
+
+        /// @brief Time from the profiler origin until MarkFirstFrame was called
+        V_ND std::optional<f64> GetTimeToFirstFrame() const;
+
+        /// @brief Duration of the named phase in milliseconds (summed if recorded more than once)
+        V_ND f64 GetPhaseDuration(std::string_view name) const;
+
+        /// @brief Snapshot of all recorded phases in recording order
+        V_ND std::vector<Phase> GetPhases() const;
+
+        /// @brief Human-readable summary of all phases and the time-to-first-frame metric
+        V_ND std::string Report() const;
+
+    private:
+        V_ND f64 ToMilliseconds(TimePoint time) const;
+
+        mutable std::mutex mMutex;
+        TimePoint mOrigin;
+        std::vector<Phase> mPhases;
+        std::optional<f64> mTimeToFirstFrame;
+    };
+}  // namespace Vulkano
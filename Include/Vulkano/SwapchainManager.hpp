@@ -7,6 +7,9 @@
 #include "Types.hpp"
 #include "Macros.hpp"
 
+#include <array>
+#include <chrono>
+#include <functional>
 #include <vector>
 #include <memory>
 
@@ -16,6 +19,43 @@ namespace Vulkano {
     /// @brief Manages swapchain creation, recreation, and presentation
     class SwapchainManager {
     public:
+        /// @brief Outcome of a single acquire attempt
+        enum class AcquireStatus : u8 {
+            Acquired,
+            Suboptimal,  // Image acquired, but the swapchain should be recreated soon
+            NotReady,    // No image was released within the timeout; try again later
+            OutOfDate,   // Recreate before acquiring again
+            Failed,
+        };
+
+        struct AcquireResult {
+            AcquireStatus status {AcquireStatus::Failed};
+            u32 imageIndex {0};  // Valid for Acquired and Suboptimal
+
+            V_ND bool HasImage() const {
+                return status == AcquireStatus::Acquired || status == AcquireStatus::Suboptimal;
+            }
+        };
+
+        /// @brief How long frames waited for an image. Long acquire waits with short frame fence waits mean the
+        /// compositor or display is the bottleneck rather than the GPU.
+        struct AcquireStats {
+            static constexpr u32 kBuckets {12};
+
+            /// @brief Upper bound of a histogram bucket in milliseconds; the last bucket is open-ended
+            static constexpr f32 GetBucketLimit(u32 bucket) {
+                return 0.05f * CAST<f32>(1u << bucket);
+            }
+
+            std::array<u32, kBuckets> waitHistogram {};  // Time from the first attempt until an image arrived
+            u64 acquired {0};
+            u64 notReadyPolls {0};    // Attempts that came back NotReady
+            u64 missedDeadlines {0};  // PollNextImage calls that ran out of time
+            f64 totalWaitMs {0.0};
+            f64 blockedMs {0.0};  // Part of the wait spent blocked in vkAcquireNextImageKHR
+            f32 maxWaitMs {0.0f};
+        };
+
         SwapchainManager();
         ~SwapchainManager();
 
@@ -39,19 +79,56 @@ namespace Vulkano {
             return Initialize(context, surface, width, height, SwapchainConfig {});
         }
 
-        /// @brief Recreate swapchain (e.g., after window resize)
+        /// @brief Recreate swapchain (e.g., after window resize). Only the surface capabilities are queried again;
+        /// format, color space, present mode and usage carry over from Initialize.
         /// @param width New width
         /// @param height New height
         /// @return Result containing success or error message
         Result<void> Recreate(u32 width, u32 height);
 
+        /// @brief Switch present mode (checked against the cached list) and recreate
+        /// @return Result containing success or error message
+        Result<void> SetPresentMode(VkPresentModeKHR presentMode);
+
+        V_ND bool SupportsPresentMode(VkPresentModeKHR presentMode) const;
+
         /// @brief Acquire next swapchain image
         /// @param signalSemaphore Semaphore to signal when image is acquired
         /// @param timeout Timeout in nanoseconds
         /// @return Result containing image index or error message
-        Result<u32> AcquireNextImage(VkSemaphore signalSemaphore, uint64_t timeout = UINT64_MAX) const;
+        Result<u32> AcquireNextImage(VkSemaphore signalSemaphore, uint64_t timeout = UINT64_MAX);
+
+        /// @brief Acquire without treating "not yet" as an error. With the default timeout of 0 this never blocks.
+        /// @param signalSemaphore Semaphore to signal when image is acquired
+        /// @param timeout Timeout in nanoseconds
+        V_ND AcquireResult TryAcquireNextImage(VkSemaphore signalSemaphore, u64 timeout = 0);
+
+        /// @brief Poll for an image until a deadline, running idleWork (uploads, culling for the next frame) between
+        /// attempts instead of blocking. Once idleWork returns false (nothing left to do) the rest of the time is
+        /// spent in a single blocking acquire. Returns NotReady if the deadline passes without an image.
+        /// @param signalSemaphore Semaphore to signal when image is acquired
+        /// @param deadline Latest time to wait until
+        /// @param idleWork Runs one small unit of work; returns whether there is more
+        V_ND AcquireResult PollNextImage(VkSemaphore signalSemaphore,
+                                         std::chrono::steady_clock::time_point deadline,
+                                         const std::function<bool()>& idleWork = {});
+
+        V_ND const AcquireStats& GetAcquireStats() const {
+            return mAcquireStats;
+        }
 
-        /// @brief Present swapchain image
+        void ResetAcquireStats() {
+            mAcquireStats = {};
+        }
+
+        /// @brief With SwapchainConfig::acquireFences, block until the presentation engine has actually released
+        /// the image (the acquire only hands out the index). Returns immediately otherwise.
+        /// @param imageIndex Index returned by AcquireNextImage
+        /// @param timeout Timeout in nanoseconds
+        /// @return Result containing success or error message
+        Result<void> WaitForImage(u32 imageIndex, u64 timeout = UINT64_MAX) const;
+
+        /// @brief Present swapchain image on GetPresentQueue()
         /// @param imageIndex Index of image to present
         /// @param waitSemaphore Semaphore to wait on before presenting
         /// @return Result containing success or error message
@@ -60,6 +137,13 @@ namespace Vulkano {
         /// @brief Cleanup swapchain resources
         void Shutdown();
 
+        /// @brief Destroy the swapchain for VulkanContext::RecoverDevice (see ResourceRegistry). The surface is kept.
+        void ReleaseDeviceObjects();
+
+        /// @brief Create the swapchain again on the recovered device with the last extent, format and present mode
+        /// @return Result containing success or error message
+        Result<void> RecreateDeviceObjects();
+
         // Getters
         V_ND VkSwapchainKHR GetSwapchain() const {
             return mSwapchain;
@@ -81,6 +165,42 @@ namespace Vulkano {
             return mPresentMode;
         }
 
+        /// @brief COLOR_ATTACHMENT plus whatever of SwapchainConfig::imageUsage the surface and format allow
+        V_ND VkImageUsageFlags GetImageUsage() const {
+            return mImageUsage;
+        }
+
+        /// @brief Whether compute can write the images directly. Swapchain formats have no GLSL format
+        /// qualifier equivalent in general (BGRA), so shaders need shaderStorageImageWriteWithoutFormat.
+        V_ND bool HasStorageUsage() const {
+            return (mImageUsage & VK_IMAGE_USAGE_STORAGE_BIT) != 0;
+        }
+
+        /// @brief Whether the compute queue's family can present to this surface
+        V_ND bool CanPresentFromCompute() const {
+            return mComputeCanPresent;
+        }
+
+        /// @brief Whether Present uses the compute queue (SwapchainConfig::presentFromCompute and supported)
+        V_ND bool IsPresentingFromCompute() const {
+            return mPresentFromCompute;
+        }
+
+        /// @brief Queue Present submits to. The frame's last submit should go to a queue of GetPresentFamily(); from
+        /// any other family the images need an ownership transfer first.
+        V_ND VkQueue GetPresentQueue() const;
+
+        V_ND u32 GetPresentFamily() const;
+
+        /// @brief Surface formats and present modes, queried once at Initialize
+        V_ND const std::vector<VkSurfaceFormatKHR>& GetSurfaceFormats() const {
+            return mSurfaceFormats;
+        }
+
+        V_ND const std::vector<VkPresentModeKHR>& GetPresentModes() const {
+            return mPresentModes;
+        }
+
         V_ND u32 GetImageCount() const {
             return CAST<u32>(mImages.size());
         }
@@ -97,17 +217,48 @@ namespace Vulkano {
             return mImageViews[index];
         }
 
+        /// @brief Semaphore the submit rendering to an image signals and its present waits on. Indexed by image,
+        /// not frame in flight: the presentation engine holds it until the image comes back, which is exactly when
+        /// the index can be acquired (and the semaphore signaled) again.
+        V_ND VkSemaphore GetPresentSemaphore(u32 imageIndex) const {
+            return mPresentSemaphores[imageIndex];
+        }
+
         V_ND bool IsInitialized() const {
             return mSwapchain != VK_NULL_HANDLE;
         }
 
     private:
+        /// @brief Query the surface's formats and present modes
+        Result<void> CacheSurfaceSupport();
+
+        /// @brief Requested usage limited to what the surface supports. Falls back to a surface format with storage
+        /// support in the same color space when storage is requested and the preferred format lacks it.
+        V_ND VkImageUsageFlags ChooseImageUsage(const VkSurfaceCapabilitiesKHR& capabilities,
+                                                VkSurfaceFormatKHR& format) const;
+
+        V_ND bool SupportsStorage(VkFormat format) const;
+
+        /// @brief Get the swapchain's images into mImages
+        Result<void> FetchImages();
+
         /// @brief Create image views for swapchain images
         Result<void> CreateImageViews();
 
         /// @brief Destroy image views
         void DestroyImageViews();
 
+        /// @brief Create the per-image present semaphores and, if enabled, the acquire fences
+        Result<void> CreateSyncObjects();
+
+        void DestroySyncObjects();
+
+        /// @brief One acquire attempt, without statistics
+        AcquireResult Acquire(VkSemaphore signalSemaphore, u64 timeout);
+
+        /// @brief Add a finished wait to the acquire statistics
+        void RecordAcquireWait(f64 waitMs, f64 blockedMs);
+
         VulkanContext* mContext {nullptr};
         VkSurfaceKHR mSurface {VK_NULL_HANDLE};
         VkSwapchainKHR mSwapchain {VK_NULL_HANDLE};
@@ -116,9 +267,24 @@ namespace Vulkano {
         VkColorSpaceKHR mColorSpace {VK_COLOR_SPACE_SRGB_NONLINEAR_KHR};
         VkExtent2D mExtent {0, 0};
         VkPresentModeKHR mPresentMode {VK_PRESENT_MODE_FIFO_KHR};
+        VkImageUsageFlags mImageUsage {0};
+
+        std::vector<VkSurfaceFormatKHR> mSurfaceFormats;
+        std::vector<VkPresentModeKHR> mPresentModes;
+        bool mComputeCanPresent {false};
+        bool mPresentFromCompute {false};
 
         std::vector<VkImage> mImages;
         std::vector<VkImageView> mImageViews;
+        std::vector<VkSemaphore> mPresentSemaphores;  // One per image
+
+        // Acquire fences are used round-robin; each remembers whether an acquire will still signal it
+        std::vector<VkFence> mAcquireFences;
+        std::vector<bool> mAcquireFencePending;
+        std::vector<VkFence> mImageFences;  // Fence of the last acquire that returned each image
+        u32 mAcquireSlot {0};
+
+        AcquireStats mAcquireStats {};
 
         SwapchainConfig mConfig {};
 
@@ -0,0 +1,95 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+
+#include <vector>
+
+namespace Vulkano {
+    /// @brief Two-level segregated fit allocator over an abstract range [0, capacity) of units (bytes, vertices,
+    /// indices...). Free blocks are binned by size into 32 power-of-two classes of 16 linear subclasses each, and
+    /// two bitmaps locate a fitting bin in O(1); freed blocks merge with free neighbours immediately. Owns no
+    /// memory itself, only the bookkeeping. Not thread-safe.
+    class TlsfAllocator {
+    public:
+        static constexpr u32 kInvalid = ~0u;
+
+        /// @brief A range handed out by Allocate
+        struct Allocation {
+            u32 offset {kInvalid};
+            u32 size {0};
+            u32 block {kInvalid};  // Internal block index, needed to free
+
+            explicit operator bool() const {
+                return block != kInvalid;
+            }
+        };
+
+        /// @brief Discard every allocation and manage a new range
+        /// @param capacity Number of units in the range
+        void Reset(u32 capacity);
+
+        /// @brief Allocate a range
+        /// @param size Number of units (greater than zero)
+        /// @return The allocation, or an invalid one if no free block is large enough
+        Allocation Allocate(u32 size);
+
+        /// @brief Return a range to the free pool
+        void Free(const Allocation& allocation);
+
+        V_ND u32 GetCapacity() const {
+            return mCapacity;
+        }
+
+        V_ND u32 GetUsed() const {
+            return mUsed;
+        }
+
+        V_ND u32 GetAllocationCount() const {
+            return mAllocationCount;
+        }
+
+        /// @brief Size of the largest free block, i.e. the biggest allocation guaranteed to succeed
+        V_ND u32 GetLargestFree() const;
+
+    private:
+        static constexpr u32 kSecondLevelBits  = 4;
+        static constexpr u32 kSecondLevelCount = 1u << kSecondLevelBits;
+        static constexpr u32 kFirstLevelCount  = 32;
+
+        struct Block {
+            u32 offset {0};
+            u32 size {0};
+            u32 prevPhysical {kInvalid};  // Neighbours in address order
+            u32 nextPhysical {kInvalid};
+            u32 prevFree {kInvalid};  // Neighbours in the same size bin
+            u32 nextFree {kInvalid};
+            bool free {false};
+        };
+
+        /// @brief Size class of a block of the given size
+        static void Mapping(u32 size, u32& firstLevel, u32& secondLevel);
+
+        /// @brief Free block of at least size units, or kInvalid
+        V_ND u32 FindFree(u32 size) const;
+
+        u32 NewBlock();
+        void ReleaseBlock(u32 block);
+        void InsertFree(u32 block);
+        void RemoveFree(u32 block);
+
+        std::vector<Block> mBlocks;
+        std::vector<u32> mUnusedBlocks;  // Recycled entries of mBlocks
+        u32 mFreeHeads[kFirstLevelCount][kSecondLevelCount] {};
+        u32 mFirstLevelBitmap {0};
+        u32 mSecondLevelBitmaps[kFirstLevelCount] {};
+
+        u32 mCapacity {0};
+        u32 mUsed {0};
+        u32 mAllocationCount {0};
+    };
+}  // namespace Vulkano
@@ -0,0 +1,119 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+#include "Macros.hpp"
+#include "Buffer.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+namespace Vulkano {
+    class VulkanContext;
+
+    /// @brief Per-frame linear allocator over one persistently mapped buffer. The buffer is split into one region
+    /// per frame in flight; allocations bump an atomic head inside the current region and the whole region is
+    /// recycled when its frame index comes around again. Used for data that lives for a single frame: uniforms,
+    /// per-draw constants, descriptor buffer contents.
+    class TransientRing {
+    public:
+        /// @brief A slice of the ring. Invalid (null mapped pointer) when the frame's region is full.
+        struct Allocation {
+            VkBuffer buffer {VK_NULL_HANDLE};
+            VkDeviceSize offset {0};  // From the start of the buffer
+            VkDeviceSize size {0};
+            void* mapped {nullptr};
+            VkDeviceAddress address {0};  // 0 unless the ring was created with device address usage
+
+            explicit operator bool() const {
+                return mapped != nullptr;
+            }
+        };
+
+        TransientRing() = default;
+        ~TransientRing();
+
+        TransientRing(const TransientRing&)            = delete;
+        TransientRing& operator=(const TransientRing&) = delete;
+        TransientRing(TransientRing&&)                 = delete;
+        TransientRing& operator=(TransientRing&&)      = delete;
+
+        /// @brief Create the ring buffer
+        /// @param context Vulkan context with a created device
+        /// @param bytesPerFrame Size of each frame's region
+        /// @param framesInFlight Number of regions (match the FrameSynchronizer)
+        /// @param usage Buffer usage; device address usage is added automatically
+        /// @return Result containing success or error message
+        Result<void> Initialize(VulkanContext* context,
+                                VkDeviceSize bytesPerFrame,
+                                u32 framesInFlight,
+                                VkBufferUsageFlags usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+                                                           VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+
+        void Shutdown();
+
+        /// @brief Switch to a frame's region and discard everything allocated in it. Call once the GPU has finished
+        /// the frame that last used this index (i.e. after FrameSynchronizer::BeginFrame).
+        void BeginFrame(u32 frameIndex);
+
+        /// @brief Allocate from the current frame's region. Safe to call from several threads.
+        /// @param size Bytes to allocate
+        /// @param alignment Power-of-two alignment; raised to the device's buffer offset alignment
+        /// @return The allocation, or an invalid one if the region is full
+        Allocation Allocate(VkDeviceSize size, VkDeviceSize alignment = 0);
+
+        /// @brief Allocate and copy a value into the ring
+        template<typename T>
+            requires std::is_trivially_copyable_v<T>
+        Allocation Push(const T& value, VkDeviceSize alignment = 0) {
+            Allocation allocation = Allocate(sizeof(T), alignment);
+            if (allocation) { std::memcpy(allocation.mapped, &value, sizeof(T)); }
+            return allocation;
+        }
+
+        V_ND VkBuffer GetBuffer() const {
+            return mBuffer.GetBuffer();
+        }
+
+        V_ND VkDeviceAddress GetDeviceAddress() const {
+            return mBuffer.GetDeviceAddress();
+        }
+
+        V_ND VkBufferUsageFlags GetUsage() const {
+            return mUsage;
+        }
+
+        V_ND VkDeviceSize GetBytesPerFrame() const {
+            return mBytesPerFrame;
+        }
+
+        /// @brief Bytes used in the current frame so far
+        V_ND VkDeviceSize GetUsedBytes() const {
+            return mHead.load(std::memory_order_relaxed);
+        }
+
+        /// @brief Most bytes used by any frame since Initialize (useful for sizing bytesPerFrame)
+        V_ND VkDeviceSize GetHighWaterMark() const {
+            return mHighWaterMark;
+        }
+
+        V_ND bool IsInitialized() const {
+            return mBuffer.IsInitialized();
+        }
+
+    private:
+        Buffer mBuffer;
+        VkBufferUsageFlags mUsage {0};
+        VkDeviceSize mBytesPerFrame {0};
+        VkDeviceSize mMinAlignment {16};
+        u32 mFramesInFlight {0};
+        u32 mFrameIndex {0};
+        std::atomic<VkDeviceSize> mHead {0};
+        VkDeviceSize mHighWaterMark {0};
+        u8* mMapped {nullptr};
+    };
+}  // namespace Vulkano
@@ -51,5 +51,12 @@ namespace Vulkano {
         VkFormat preferredFormat {VK_FORMAT_B8G8R8A8_UNORM};
         VkColorSpaceKHR preferredColorSpace {VK_COLOR_SPACE_SRGB_NONLINEAR_KHR};
         u32 minImageCount {3};
+        bool acquireFences {false};  // Signal a fence per acquire so the CPU can wait for an image (WaitForImage)
+        // Usage on top of COLOR_ATTACHMENT, e.g. STORAGE or TRANSFER_SRC/DST. Flags the surface doesn't support are
+        // dropped; check SwapchainManager::GetImageUsage.
+        VkImageUsageFlags imageUsage {0};
+        // Present on the compute queue when its family supports the surface, so frames that end in compute skip the
+        // semaphore hop and ownership transfer to the graphics queue. Check SwapchainManager::IsPresentingFromCompute.
+        bool presentFromCompute {false};
     };
 }  // namespace Vulkano
\ No newline at end of file
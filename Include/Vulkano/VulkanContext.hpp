@@ -6,8 +6,11 @@
 
 #include "Types.hpp"
 #include "Macros.hpp"
+#include "StartupProfiler.hpp"
+#include "ResourceRegistry.hpp"
 
 #include <vk_mem_alloc.h>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -29,6 +32,64 @@ namespace Vulkano {
         struct DeviceConfig {
             std::vector<const char*> deviceExtensions {};
             VkSurfaceKHR surface {VK_NULL_HANDLE};  // Optional, for presentation support
+            bool enableExtendedDynamicState3 {true};  // Enabled only if the device supports it
+            bool enablePushDescriptors {true};        // VK_KHR_push_descriptor, if supported
+            bool enableDescriptorBuffer {true};       // VK_EXT_descriptor_buffer, if supported
+            bool enableMeshShaders {true};            // VK_EXT_mesh_shader task and mesh stages, if supported
+            bool enableBindlessTextures {true};       // Descriptor indexing for sampled image arrays, if supported
+            bool enableMultiview {true};              // Vulkan 1.1 multiview, if supported
+            bool enableCrashDiagnostics {true};       // Buffer markers, checkpoints and fault reports, if supported
+        };
+
+        /// @brief Optional device features that were found and enabled at device creation
+        struct Capabilities {
+            bool dynamicPolygonMode {false};  // extendedDynamicState3PolygonMode
+            bool dynamicColorBlend {false};   // extendedDynamicState3ColorBlendEnable/Equation/WriteMask
+            bool pushDescriptors {false};     // VK_KHR_push_descriptor
+            u32 maxPushDescriptors {0};
+            bool descriptorBuffer {false};  // VK_EXT_descriptor_buffer
+            VkPhysicalDeviceDescriptorBufferPropertiesEXT descriptorBufferProperties {};
+            bool drawIndirectCount {false};          // Vulkan 1.2 drawIndirectCount
+            bool multiDrawIndirect {false};          // drawCount > 1 in indirect draws
+            bool drawIndirectFirstInstance {false};  // firstInstance != 0 in indirect draws
+            bool meshShaders {false};                // VK_EXT_mesh_shader with both task and mesh shaders
+            VkPhysicalDeviceMeshShaderPropertiesEXT meshShaderProperties {};
+            bool bindlessTextures {false};  // Partially bound, update-after-bind, non-uniformly indexed image arrays
+            u32 maxBindlessTextures {0};    // Update-after-bind sampled images per stage and per set
+            bool multiview {false};         // View masks in dynamic rendering and pipelines (Vulkan 1.1 multiview)
+            u32 maxMultiviewViewCount {0};
+            bool bufferMarkers {false};            // VK_AMD_buffer_marker (with synchronization2)
+            bool diagnosticCheckpoints {false};    // VK_NV_device_diagnostic_checkpoints
+            bool deviceFault {false};              // VK_EXT_device_fault
+            bool deviceFaultVendorBinary {false};  // Vendor crash dumps in device fault reports
+        };
+
+        /// @brief Entry points of optional device extensions (null unless the matching capability is enabled)
+        struct Dispatch {
+            PFN_vkCmdSetPolygonModeEXT cmdSetPolygonMode {nullptr};
+            PFN_vkCmdSetColorBlendEnableEXT cmdSetColorBlendEnable {nullptr};
+            PFN_vkCmdSetColorBlendEquationEXT cmdSetColorBlendEquation {nullptr};
+            PFN_vkCmdSetColorWriteMaskEXT cmdSetColorWriteMask {nullptr};
+            PFN_vkCmdPushDescriptorSetKHR cmdPushDescriptorSet {nullptr};
+            PFN_vkGetDescriptorSetLayoutSizeEXT getDescriptorSetLayoutSize {nullptr};
+            PFN_vkGetDescriptorSetLayoutBindingOffsetEXT getDescriptorSetLayoutBindingOffset {nullptr};
+            PFN_vkGetDescriptorEXT getDescriptor {nullptr};
+            PFN_vkCmdBindDescriptorBuffersEXT cmdBindDescriptorBuffers {nullptr};
+            PFN_vkCmdSetDescriptorBufferOffsetsEXT cmdSetDescriptorBufferOffsets {nullptr};
+            PFN_vkCmdDrawMeshTasksEXT cmdDrawMeshTasks {nullptr};
+            PFN_vkCmdDrawMeshTasksIndirectEXT cmdDrawMeshTasksIndirect {nullptr};
+            PFN_vkCmdDrawMeshTasksIndirectCountEXT cmdDrawMeshTasksIndirectCount {nullptr};  // With drawIndirectCount
+            PFN_vkCmdWriteBufferMarker2AMD cmdWriteBufferMarker2 {nullptr};
+            PFN_vkCmdSetCheckpointNV cmdSetCheckpoint {nullptr};
+            PFN_vkGetQueueCheckpointDataNV getQueueCheckpointData {nullptr};
+            PFN_vkGetDeviceFaultInfoEXT getDeviceFaultInfo {nullptr};
+        };
+
+        /// @brief Device-lost recoveries so far and how long they took
+        struct RecoveryStats {
+            u32 recoveries {0};
+            f64 lastRecoveryMs {0.0};  // Device loss handled to resources recreated
+            f64 totalRecoveryMs {0.0};
         };
 
         /// @brief Full configuration (for convenience method)
@@ -66,6 +127,32 @@ namespace Vulkano {
         /// @brief Wait for all device operations to complete
         void WaitIdle() const;
 
+        /// @brief Note a VK_ERROR_DEVICE_LOST result. Vulkano calls this on the results of its waits, acquires and
+        /// presents; applications pass their own submit results through it.
+        /// @param result Result of a Vulkan call on this context's device
+        /// @return Whether the result was VK_ERROR_DEVICE_LOST
+        bool CheckDeviceLost(VkResult result) const;
+
+        /// @brief A call returned VK_ERROR_DEVICE_LOST since the device was created or last recovered
+        V_ND bool IsDeviceLost() const {
+            return mDeviceLost.load(std::memory_order_acquire);
+        }
+
+        /// @brief Replace a lost device without restarting: release every registered resource, destroy the allocator
+        /// and device, create them again on the same physical device (instance, surface and enabled features are
+        /// kept), then recreate the registered resources. Nothing may be using the device from other threads.
+        /// @return Result containing success or error message
+        Result<void> RecoverDevice();
+
+        /// @brief Objects rebuilt by RecoverDevice
+        V_ND ResourceRegistry& GetResources() {
+            return mResources;
+        }
+
+        V_ND const RecoveryStats& GetRecoveryStats() const {
+            return mRecoveryStats;
+        }
+
         // State queries
         V_ND bool HasInstance() const {
             return mInstance != VK_NULL_HANDLE;
@@ -124,10 +211,39 @@ namespace Vulkano {
             return mDeviceFeatures;
         }
 
+        V_ND const Capabilities& GetCapabilities() const {
+            return mCapabilities;
+        }
+
+        V_ND const Dispatch& GetDispatch() const {
+            return mDispatch;
+        }
+
+        /// @brief Bring-up timings (instance, device, allocator, swapchain, ...) and time-to-first-frame
+        V_ND StartupProfiler& GetStartupProfiler() {
+            return mStartupProfiler;
+        }
+
+        V_ND const StartupProfiler& GetStartupProfiler() const {
+            return mStartupProfiler;
+        }
+
     private:
         /// @brief Initialize VMA allocator
         Result<void> InitializeAllocator();
 
+        /// @brief Create the logical device on the selected physical device, then fetch queues and entry points
+        Result<void> BuildDevice();
+
+        /// @brief Destroy the allocator and logical device, keeping the physical device and instance
+        void DestroyDevice();
+
+        /// @brief Enable the optional extensions and features requested in the config that the device supports
+        void EnableOptionalFeatures(const DeviceConfig& config);
+
+        /// @brief Resolve extension entry points for the enabled capabilities
+        void LoadDispatch();
+
         VkInstance mInstance {VK_NULL_HANDLE};
         VkPhysicalDevice mPhysicalDevice {VK_NULL_HANDLE};
         VkDevice mDevice {VK_NULL_HANDLE};
@@ -141,11 +257,19 @@ namespace Vulkano {
         QueueFamilyIndices mQueueFamilies {};
         VkPhysicalDeviceProperties mDeviceProperties {};
         VkPhysicalDeviceFeatures mDeviceFeatures {};
+        Capabilities mCapabilities {};
+        Dispatch mDispatch {};
 
         // Pimpl for vk-bootstrap objects
         struct Impl;
         std::unique_ptr<Impl> mImpl;
 
         bool mValidationEnabled {false};
+        bool mHasSurface {false};  // Whether CreateDevice was given a surface, for the present queue
+        mutable std::atomic<bool> mDeviceLost {false};
+
+        ResourceRegistry mResources;
+        RecoveryStats mRecoveryStats {};
+        StartupProfiler mStartupProfiler;
     };
 }  // namespace Vulkano
\ No newline at end of file
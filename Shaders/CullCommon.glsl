@@ -0,0 +1,126 @@
+// Shared body of CullInstances.comp and CullInstancesHiZ.comp (the latter defines CULL_HIZ). Layouts match
+// GpuCulling.hpp.
+
+layout(local_size_x = 64) in;
+
+struct Instance {
+    vec4 sphere;  // World-space center, radius
+    uint meshIndex;
+    uint reserved0;
+    uint reserved1;
+    uint reserved2;
+};
+
+struct MeshDraw {
+    uint indexCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint reserved;
+};
+
+struct DrawCommand {
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+};
+
+layout(set = 0, binding = 0) uniform CullParams {
+    mat4 viewProjection;
+    vec4 planes[6];
+    vec2 pyramidSize;
+    uint instanceCount;
+    uint frameSlot;
+    uint commandOffset;
+    uint compact;  // 0 without drawIndirectCount: every instance keeps its slot, culled ones draw 0 instances
+} params;
+
+layout(set = 0, binding = 1) readonly buffer Instances {
+    Instance instances[];
+};
+
+layout(set = 0, binding = 2) readonly buffer Meshes {
+    MeshDraw meshes[];
+};
+
+layout(set = 0, binding = 3) writeonly buffer Commands {
+    DrawCommand commands[];
+};
+
+layout(set = 0, binding = 4) buffer Counts {
+    uint counts[];
+};
+
+#ifdef CULL_HIZ
+layout(set = 0, binding = 5) uniform sampler2D depthPyramid;
+
+// Conservative screen rectangle and nearest depth of the sphere's bounding box. Returns false if the box crosses
+// the near plane, in which case the instance is kept.
+bool ProjectBounds(vec4 sphere, out vec4 rect, out float nearestDepth) {
+    rect         = vec4(1.0, 1.0, 0.0, 0.0);
+    nearestDepth = 1.0;
+    for (int i = 0; i < 8; i++) {
+        vec3 corner = sphere.xyz + sphere.w * vec3((i & 1) != 0 ? 1.0 : -1.0,
+                                                   (i & 2) != 0 ? 1.0 : -1.0,
+                                                   (i & 4) != 0 ? 1.0 : -1.0);
+        vec4 clip = params.viewProjection * vec4(corner, 1.0);
+        if (clip.w <= 0.0) { return false; }
+
+        vec3 ndc     = clip.xyz / clip.w;
+        vec2 uv      = clamp(ndc.xy * 0.5 + 0.5, 0.0, 1.0);
+        rect.xy      = min(rect.xy, uv);
+        rect.zw      = max(rect.zw, uv);
+        nearestDepth = min(nearestDepth, ndc.z);
+    }
+    return true;
+}
+
+bool IsOccluded(vec4 sphere) {
+    vec4 rect;
+    float nearestDepth;
+    if (!ProjectBounds(sphere, rect, nearestDepth)) { return false; }
+
+    // Level where the rectangle spans at most 2x2 texels, so four samples cover it
+    vec2 size   = (rect.zw - rect.xy) * params.pyramidSize;
+    float level = ceil(log2(max(max(size.x, size.y), 1.0)));
+
+    float farthest = max(max(textureLod(depthPyramid, rect.xy, level).r, textureLod(depthPyramid, rect.zy, level).r),
+                         max(textureLod(depthPyramid, rect.xw, level).r, textureLod(depthPyramid, rect.zw, level).r));
+    return nearestDepth > farthest;
+}
+#endif
+
+void main() {
+    uint index = gl_GlobalInvocationID.x;
+    if (index >= params.instanceCount) { return; }
+
+    Instance instance = instances[index];
+
+    bool visible = true;
+    for (int i = 0; i < 6 && visible; i++) {
+        visible = dot(params.planes[i].xyz, instance.sphere.xyz) + params.planes[i].w >= -instance.sphere.w;
+    }
+
+#ifdef CULL_HIZ
+    if (visible) { visible = !IsOccluded(instance.sphere); }
+#endif
+
+    uint slot = index;
+    if (visible) {
+        uint compacted = atomicAdd(counts[params.frameSlot], 1);
+        if (params.compact != 0) { slot = compacted; }
+    } else if (params.compact != 0) {
+        return;
+    }
+
+    MeshDraw mesh = meshes[instance.meshIndex];
+
+    DrawCommand command;
+    command.indexCount    = mesh.indexCount;
+    command.instanceCount = visible ? 1 : 0;
+    command.firstIndex    = mesh.firstIndex;
+    command.vertexOffset  = mesh.vertexOffset;
+    command.firstInstance = index;
+    commands[params.commandOffset + slot] = command;
+}
@@ -0,0 +1,21 @@
+#version 450
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec4 inColor;
+layout(location = 2) in uint inScreenSpace;
+
+layout(location = 0) out vec4 outColor;
+
+layout(push_constant) uniform Constants {
+    mat4 viewProjection;
+    vec4 pixelToNdc;  // xy scale, zw offset
+} constants;
+
+void main() {
+    if (inScreenSpace != 0u) {
+        gl_Position = vec4(inPosition.xy * constants.pixelToNdc.xy + constants.pixelToNdc.zw, 0.0, 1.0);
+    } else {
+        gl_Position = constants.viewProjection * vec4(inPosition, 1.0);
+    }
+    outColor = inColor;
+}
@@ -0,0 +1,10 @@
+#version 450
+
+// Shared by both MeshletRenderer paths: two-sided lambert against a fixed light
+layout(location = 0) in vec3 inNormal;
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    float light = abs(dot(normalize(inNormal), normalize(vec3(0.4, 0.8, 0.45))));
+    outColor    = vec4(vec3(0.15 + 0.85 * light), 1.0);
+}
@@ -0,0 +1,99 @@
+// Shared declarations of the MeshletRenderer shaders. Layouts match MeshletRenderer.hpp and MeshProcessing.hpp.
+
+struct Instance {
+    vec3 position;
+    float scale;
+    uint mesh;
+    uint reserved0;
+    uint reserved1;
+    uint reserved2;
+};
+
+struct MeshInfo {
+    uint meshletOffset;  // First meshlet in the shared meshlet buffers
+    uint meshletCount;
+    uint vertexOffset;  // First vertex in the geometry arena
+    uint reserved;
+    vec4 positionOffset;  // Dequantization: positionOffset.xyz + snorm * positionScale.xyz
+    vec4 positionScale;
+};
+
+layout(set = 0, binding = 0) uniform MeshletParams {
+    mat4 viewProjection;
+    vec4 planes[6];
+    vec3 cameraPosition;
+    uint cullFlags;
+} params;
+
+layout(set = 0, binding = 1) readonly buffer Instances {
+    Instance instances[];
+};
+
+layout(set = 0, binding = 2) readonly buffer Meshes {
+    MeshInfo meshes[];
+};
+
+const uint kCullFrustum = 1u;
+const uint kCullCone    = 2u;
+
+// Inverse of EncodeOctahedral in MeshProcessing.cpp
+vec3 DecodeOctahedral(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) { n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0); }
+    return normalize(n);
+}
+
+vec3 ToWorld(Instance instance, MeshInfo mesh, vec3 snorm) {
+    return instance.position + instance.scale * (mesh.positionOffset.xyz + snorm * mesh.positionScale.xyz);
+}
+
+#ifdef MESHLET_STAGES
+// Task and mesh shaders: one task workgroup tests kTaskGroupSize meshlets of one instance and emits a mesh
+// workgroup per survivor
+const uint kTaskGroupSize = 32;
+
+struct Meshlet {
+    uint vertexOffset;
+    uint triangleOffset;  // In bytes
+    uint vertexCount;
+    uint triangleCount;
+};
+
+struct MeshletBounds {
+    vec3 center;
+    float radius;
+    vec3 coneAxis;
+    float coneCutoff;
+};
+
+struct TaskPayload {
+    uint instance;
+    uint mesh;
+    uint meshlets[kTaskGroupSize];
+};
+
+layout(set = 0, binding = 3) readonly buffer Meshlets {
+    Meshlet meshlets[];
+};
+
+layout(set = 0, binding = 4) readonly buffer Bounds {
+    MeshletBounds bounds[];
+};
+
+layout(set = 0, binding = 5) readonly buffer MeshletVertices {
+    uint meshletVertices[];
+};
+
+layout(set = 0, binding = 6) readonly buffer MeshletTriangles {
+    uint meshletTriangles[];  // Three bytes per triangle, packed
+};
+
+layout(set = 0, binding = 7) readonly buffer Vertices {
+    uvec4 vertices[];  // PackedVertex: SNORM16 xyzw, octahedral SNORM16 normal, half uv
+};
+
+layout(push_constant) uniform DrawConstants {
+    uint mesh;
+    uint firstInstance;
+} draw;
+#endif
@@ -0,0 +1,18 @@
+#version 450
+
+// Multi-draw indirect path of MeshletRenderer: each command draws one mesh's index range for a run of instances
+#include "MeshletCommon.glsl"
+
+layout(location = 0) in vec4 inPosition;  // SNORM16, w unused
+layout(location = 1) in vec2 inNormal;    // Octahedral SNORM16
+layout(location = 2) in vec2 inUv;
+
+layout(location = 0) out vec3 outNormal;
+
+void main() {
+    Instance instance = instances[gl_InstanceIndex];
+    vec3 world        = ToWorld(instance, meshes[instance.mesh], inPosition.xyz);
+
+    gl_Position = params.viewProjection * vec4(world, 1.0);
+    outNormal   = DecodeOctahedral(inNormal);
+}
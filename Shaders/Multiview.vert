@@ -0,0 +1,22 @@
+#version 450
+#extension GL_EXT_multiview : require
+
+// Multiview benchmark: one small quad per draw (a 4-vertex strip), placed per view so every layer differs.
+// gl_ViewIndex is 0 outside multiview passes, where viewBase selects the layer being rendered instead.
+
+layout(push_constant) uniform Push {
+    vec4 views[6];  // Per view: xy offset, zw scale
+    vec4 quad;      // xy corner, zw size, in NDC
+    uint viewBase;
+} push;
+
+layout(location = 0) out vec3 outColor;
+
+void main() {
+    uint view = uint(gl_ViewIndex) + push.viewBase;
+    vec2 corner = vec2(gl_VertexIndex & 1, (gl_VertexIndex >> 1) & 1);
+    vec4 transform = push.views[view];
+
+    gl_Position = vec4((push.quad.xy + corner * push.quad.zw) * transform.zw + transform.xy, 0.0, 1.0);
+    outColor = vec3(corner, float(view + 1u) / 6.0);
+}
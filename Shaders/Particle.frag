@@ -0,0 +1,13 @@
+#version 450
+
+layout(location = 0) in vec2 inUv;
+layout(location = 1) in vec4 inColor;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    // Soft round sprite
+    const float falloff = 1.0 - smoothstep(0.5, 1.0, length(inUv));
+    if (falloff <= 0.0) { discard; }
+    outColor = vec4(inColor.rgb, inColor.a * falloff);
+}
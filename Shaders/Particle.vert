@@ -0,0 +1,25 @@
+#version 450
+
+// ParticleSystem: one camera-facing quad per alive particle, read straight from the simulation's output
+layout(location = 0) in vec4 inPositionLife;
+layout(location = 1) in vec4 inColor;
+
+layout(location = 0) out vec2 outUv;
+layout(location = 1) out vec4 outColor;
+
+layout(push_constant) uniform Constants {
+    mat4 viewProjection;
+    vec4 rightSize;  // Camera right, billboard size
+    vec4 upFade;     // Camera up, fade-out time
+} constants;
+
+void main() {
+    // Triangle strip over the corners (0, 0), (1, 0), (0, 1), (1, 1)
+    const vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+    const vec2 local  = (corner - 0.5) * constants.rightSize.w;
+    const vec3 world  = inPositionLife.xyz + constants.rightSize.xyz * local.x + constants.upFade.xyz * local.y;
+
+    gl_Position = constants.viewProjection * vec4(world, 1.0);
+    outUv       = corner * 2.0 - 1.0;
+    outColor    = vec4(inColor.rgb, inColor.a * clamp(inPositionLife.w / constants.upFade.w, 0.0, 1.0));
+}
@@ -0,0 +1,80 @@
+// Shared declarations of the ParticleSystem compute passes. Layouts match ParticleSystem.hpp. ParticleScan.comp and
+// ParticleScanBlocks.comp define PARTICLE_SCAN for the workgroup scan.
+
+layout(local_size_x = 256) in;
+
+const uint kGroupSize = 256;
+
+struct Particle {
+    vec3 position;
+    float life;  // Seconds left
+    vec3 velocity;
+    uint color;
+};
+
+struct Emitter {
+    vec4 positionRadius;
+    vec4 velocityJitter;
+    vec2 lifetime;
+    uint color;
+    uint firstParticle;
+};
+
+layout(set = 0, binding = 0) uniform ParticleParams {
+    vec4 gravityDrag;
+    float deltaTime;
+    uint emitterCount;
+    uint emitCount;
+    uint maxParticles;
+    uint source;  // Counter index of the source buffer; the destination is the other one
+    uint seed;
+    Emitter emitters[16];
+} params;
+
+layout(set = 0, binding = 1) readonly buffer SourceParticles {
+    Particle sourceParticles[];
+};
+
+layout(set = 0, binding = 2) writeonly buffer DestinationParticles {
+    Particle destinationParticles[];
+};
+
+layout(set = 0, binding = 3) buffer Scan {
+    uint scan[];  // Exclusive survivor offset within the workgroup
+};
+
+layout(set = 0, binding = 4) buffer BlockSums {
+    uint blockSums[];  // Survivors per workgroup, replaced by their exclusive scan
+};
+
+layout(set = 0, binding = 5) buffer Counters {
+    uint count[2];
+    uint survivors;
+    uint reserved;
+    uint dispatchArgs[6];  // VkDispatchIndirectCommand per buffer
+    uint drawArgs[8];      // VkDrawIndirectCommand per buffer
+} counters;
+
+// Scan and simulation must agree exactly on who survives
+bool Survives(Particle particle) {
+    return particle.life > params.deltaTime;
+}
+
+#ifdef PARTICLE_SCAN
+shared uint scanShared[kGroupSize];
+
+// Inclusive scan across the workgroup (Hillis-Steele); every invocation must call it
+uint WorkgroupInclusiveScan(uint value) {
+    const uint local  = gl_LocalInvocationID.x;
+    scanShared[local] = value;
+    barrier();
+
+    for (uint offset = 1; offset < kGroupSize; offset <<= 1) {
+        const uint previous = local >= offset ? scanShared[local - offset] : 0u;
+        barrier();
+        scanShared[local] += previous;
+        barrier();
+    }
+    return scanShared[local];
+}
+#endif
@@ -0,0 +1,16 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) in vec2 inUv;
+layout(location = 1) in vec4 inColor;
+layout(location = 2) flat in uint inTexture;
+
+layout(location = 0) out vec4 outColor;
+
+layout(set = 0, binding = 0) uniform sampler spriteSampler;
+layout(set = 0, binding = 1) uniform texture2D textures[];
+
+void main() {
+    // The index differs between instances of the same draw, hence nonuniformEXT
+    outColor = texture(sampler2D(textures[nonuniformEXT(inTexture)], spriteSampler), inUv) * inColor;
+}
@@ -0,0 +1,31 @@
+#version 450
+
+// SpriteBatcher: one instance per sprite, each attribute from its own tightly packed stream
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec2 inSize;
+layout(location = 2) in float inRotation;
+layout(location = 3) in vec4 inUvRect;
+layout(location = 4) in vec4 inColor;
+layout(location = 5) in uint inTexture;
+
+layout(location = 0) out vec2 outUv;
+layout(location = 1) out vec4 outColor;
+layout(location = 2) flat out uint outTexture;
+
+layout(push_constant) uniform Constants {
+    vec4 worldToNdc;  // xy scale, zw offset
+} constants;
+
+void main() {
+    // Triangle strip over the corners (0, 0), (1, 0), (0, 1), (1, 1)
+    const vec2 corner = vec2(gl_VertexIndex & 1, gl_VertexIndex >> 1);
+    const vec2 local  = (corner - 0.5) * inSize;
+    const float s     = sin(inRotation);
+    const float c     = cos(inRotation);
+    const vec2 world  = inPosition + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+
+    gl_Position = vec4(world * constants.worldToNdc.xy + constants.worldToNdc.zw, 0.0, 1.0);
+    outUv       = mix(inUvRect.xy, inUvRect.zw, corner);
+    outColor    = inColor;
+    outTexture  = inTexture;
+}
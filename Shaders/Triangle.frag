@@ -0,0 +1,12 @@
+#version 450
+
+layout(constant_id = 0) const bool kGrayscale = false;
+
+layout(location = 0) in vec3 inColor;
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    vec3 color = inColor;
+    if (kGrayscale) { color = vec3(dot(color, vec3(0.2126, 0.7152, 0.0722))); }
+    outColor = vec4(color, 1.0);
+}
@@ -0,0 +1,341 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Breadcrumbs.hpp"
+#include "VulkanContext.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+namespace Vulkano {
+    namespace {
+        constexpr u32 kPassBits {12};
+        constexpr u32 kPassMask {(1u << kPassBits) - 1};
+        constexpr u64 kFrameMask {(1ull << (32 - kPassBits)) - 1};
+
+        /// @brief VkDeviceFaultAddressTypeEXT values, in order
+        constexpr const char* kAddressTypes[] = {"none",
+                                                 "invalid read",
+                                                 "invalid write",
+                                                 "invalid execute",
+                                                 "unknown instruction pointer",
+                                                 "invalid instruction pointer",
+                                                 "faulting instruction pointer"};
+
+        template<typename... Args>
+        void Append(std::string& out, const char* format, Args... args) {
+            char line[512];
+            std::snprintf(line, sizeof(line), format, args...);
+            out += line;
+        }
+    }  // namespace
+
+    Breadcrumbs::~Breadcrumbs() {
+        Shutdown();
+    }
+
+    Result<void> Breadcrumbs::Initialize(VulkanContext* context, const Config& config) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (IsInitialized()) { return std::unexpected("Breadcrumbs already initialized"); }
+
+        if (auto result = CreateBuffer(context); !result) { return result; }
+
+        mContext       = context;
+        mConfig        = config;
+        mBufferMarkers = context->GetDispatch().cmdWriteBufferMarker2 != nullptr;
+        mFrame         = 0;
+        return {};
+    }
+
+    void Breadcrumbs::Shutdown() {
+        if (!mContext) { return; }
+
+        DestroyBuffer();
+
+        mPassNames.clear();
+        mContext       = nullptr;
+        mBufferMarkers = false;
+        mFrame         = 0;
+    }
+
+    void Breadcrumbs::ReleaseDeviceObjects() {
+        if (mContext) { DestroyBuffer(); }
+    }
+
+    Result<void> Breadcrumbs::RecreateDeviceObjects() {
+        if (!mContext) { return std::unexpected("Breadcrumbs not initialized"); }
+
+        // Queue handles belong to the new device; pass names and the frame count carry over
+        return CreateBuffer(mContext);
+    }
+
+    Result<void> Breadcrumbs::CreateBuffer(VulkanContext* context) {
+        const std::pair<VkQueue, const char*> queues[] = {{context->GetGraphicsQueue(), "graphics"},
+                                                          {context->GetComputeQueue(), "compute"},
+                                                          {context->GetTransferQueue(), "transfer"},
+                                                          {context->GetPresentQueue(), "present"}};
+        for (const auto& [queue, name] : queues) {
+            if (queue != VK_NULL_HANDLE && FindQueue(queue) == kNoPass) { mQueues.push_back({queue, name}); }
+        }
+
+        // Written by every queue family without ownership transfers
+        const auto& families = context->GetQueueFamilies();
+        std::vector<u32> familyIndices;
+        for (const u32 family : {families.graphicsFamily, families.computeFamily, families.transferFamily}) {
+            if (std::ranges::find(familyIndices, family) == familyIndices.end()) { familyIndices.push_back(family); }
+        }
+
+        VkBufferCreateInfo bufferInfo {};
+        bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size        = mQueues.size() * 2 * sizeof(u32);
+        bufferInfo.usage       = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        if (familyIndices.size() > 1) {
+            bufferInfo.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+            bufferInfo.queueFamilyIndexCount = CAST<u32>(familyIndices.size());
+            bufferInfo.pQueueFamilyIndices   = familyIndices.data();
+        }
+
+        // System memory read back by the CPU: it outlives a lost device, where device-local memory may not
+        VmaAllocationCreateInfo allocationInfo {};
+        allocationInfo.usage         = VMA_MEMORY_USAGE_AUTO_PREFER_HOST;
+        allocationInfo.flags         = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        allocationInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+        VmaAllocationInfo allocationResult {};
+        if (vmaCreateBuffer(context->GetAllocator(),
+                            &bufferInfo,
+                            &allocationInfo,
+                            &mBuffer,
+                            &mAllocation,
+                            &allocationResult) != VK_SUCCESS) {
+            mQueues.clear();
+            return std::unexpected("Failed to create breadcrumb buffer");
+        }
+        std::memset(allocationResult.pMappedData, 0, bufferInfo.size);
+
+        mMarkers = RCAST<const volatile u32*>(allocationResult.pMappedData);
+        return {};
+    }
+
+    void Breadcrumbs::DestroyBuffer() {
+        if (mBuffer != VK_NULL_HANDLE) { vmaDestroyBuffer(mContext->GetAllocator(), mBuffer, mAllocation); }
+        mBuffer     = VK_NULL_HANDLE;
+        mAllocation = VK_NULL_HANDLE;
+        mMarkers    = nullptr;
+        mQueues.clear();
+    }
+
+    Result<u32> Breadcrumbs::RegisterPass(std::string_view name) {
+        if (mPassNames.size() >= kMaxPasses) { return std::unexpected("Too many breadcrumb passes"); }
+
+        mPassNames.emplace_back(name);
+        return CAST<u32>(mPassNames.size() - 1);
+    }
+
+    void Breadcrumbs::BeginPass(VkCommandBuffer commandBuffer, VkQueue queue, u32 pass) const {
+        const u32 slot = FindQueue(queue);
+        if (slot != kNoPass) { WriteMarker(commandBuffer, slot, pass, false); }
+    }
+
+    void Breadcrumbs::EndPass(VkCommandBuffer commandBuffer, VkQueue queue, u32 pass) const {
+        const u32 slot = FindQueue(queue);
+        if (slot != kNoPass) { WriteMarker(commandBuffer, slot, pass, true); }
+    }
+
+    Breadcrumbs::QueueState Breadcrumbs::GetQueueState(VkQueue queue) const {
+        QueueState state;
+        const u32 slot = FindQueue(queue);
+        if (slot == kNoPass) { return state; }
+
+        DecodeMarker(mMarkers[slot * 2], state.startedPass, state.startedFrame);
+        DecodeMarker(mMarkers[slot * 2 + 1], state.completedPass, state.completedFrame);
+        return state;
+    }
+
+    std::string_view Breadcrumbs::GetPassName(u32 pass) const {
+        return pass < mPassNames.size() ? std::string_view(mPassNames[pass]) : std::string_view("<unknown>");
+    }
+
+    std::string Breadcrumbs::Describe(bool deviceLost) const {
+        if (!IsInitialized()) { return "Breadcrumbs not initialized\n"; }
+
+        std::string report;
+        Append(report,
+               "GPU breadcrumbs (%s, frame %" PRIu64 "):\n",
+               mBufferMarkers ? "buffer markers" : "fill buffer",
+               mFrame);
+        for (const TrackedQueue& tracked : mQueues) {
+            const QueueState state = GetQueueState(tracked.queue);
+            std::string completed  = "nothing";
+            std::string started    = "nothing";
+            if (state.completedPass != kNoPass) {
+                completed = std::string(GetPassName(state.completedPass)) + " (frame " +
+                            std::to_string(state.completedFrame) + ")";
+            }
+            if (state.startedPass != kNoPass) {
+                started =
+                  std::string(GetPassName(state.startedPass)) + " (frame " + std::to_string(state.startedFrame) + ")";
+            }
+            Append(report,
+                   "  %-8s last completed %s, last started %s\n",
+                   tracked.name.c_str(),
+                   completed.c_str(),
+                   started.c_str());
+        }
+
+        report += DescribeCheckpoints();
+        if (deviceLost) { report += DescribeFault(); }
+        return report;
+    }
+
+    u32 Breadcrumbs::FindQueue(VkQueue queue) const {
+        for (u32 i = 0; i < mQueues.size(); i++) {
+            if (mQueues[i].queue == queue) { return i; }
+        }
+        return kNoPass;
+    }
+
+    void Breadcrumbs::WriteMarker(VkCommandBuffer commandBuffer, u32 slot, u32 pass, bool completed) const {
+        const VkDeviceSize offset = (slot * 2 + (completed ? 1 : 0)) * sizeof(u32);
+        const u32 marker          = EncodeMarker(pass);
+        const auto& dispatch      = mContext->GetDispatch();
+
+        if (mBufferMarkers) {
+            // All prior commands finished for "completed"; the pass merely reaching the pipe for "started"
+            const VkPipelineStageFlags2 stage =
+              completed ? VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT : VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT;
+            dispatch.cmdWriteBufferMarker2(commandBuffer, stage, mBuffer, offset, marker);
+        } else {
+            if (completed && mConfig.preciseFallback) {
+                VkMemoryBarrier barrier {};
+                barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+                barrier.srcAccessMask = 0;
+                barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+                vkCmdPipelineBarrier(commandBuffer,
+                                     VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                     0,
+                                     1,
+                                     &barrier,
+                                     0,
+                                     nullptr,
+                                     0,
+                                     nullptr);
+            }
+            vkCmdFillBuffer(commandBuffer, mBuffer, offset, sizeof(u32), marker);
+        }
+
+        if (dispatch.cmdSetCheckpoint) {
+            // Checkpoint markers are opaque pointers; the low bit tells completed from started
+            const uintptr_t checkpoint = (CAST<uintptr_t>(marker) << 1) | (completed ? 1 : 0);
+            dispatch.cmdSetCheckpoint(commandBuffer, RCAST<const void*>(checkpoint));
+        }
+    }
+
+    u32 Breadcrumbs::EncodeMarker(u32 pass) const {
+        return CAST<u32>((mFrame & kFrameMask) << kPassBits) | ((pass + 1) & kPassMask);
+    }
+
+    void Breadcrumbs::DecodeMarker(u32 marker, u32& pass, u64& frame) const {
+        if ((marker & kPassMask) == 0) {
+            pass  = kNoPass;
+            frame = 0;
+            return;
+        }
+
+        pass                = (marker & kPassMask) - 1;
+        const u64 lowFrame  = marker >> kPassBits;
+        const u64 framesAgo = (mFrame - lowFrame) & kFrameMask;
+        frame               = mFrame - std::min(framesAgo, mFrame);
+    }
+
+    std::string Breadcrumbs::DescribeCheckpoints() const {
+        const auto& dispatch = mContext->GetDispatch();
+        if (!dispatch.getQueueCheckpointData) { return {}; }
+
+        std::string report = "Diagnostic checkpoints:\n";
+        for (const TrackedQueue& tracked : mQueues) {
+            u32 count = 0;
+            dispatch.getQueueCheckpointData(tracked.queue, &count, nullptr);
+
+            std::vector<VkCheckpointDataNV> checkpoints(count);
+            for (auto& checkpoint : checkpoints) {
+                checkpoint.sType = VK_STRUCTURE_TYPE_CHECKPOINT_DATA_NV;
+            }
+            dispatch.getQueueCheckpointData(tracked.queue, &count, checkpoints.data());
+
+            for (u32 i = 0; i < count; i++) {
+                const uintptr_t checkpoint = RCAST<uintptr_t>(checkpoints[i].pCheckpointMarker);
+                u32 pass                   = kNoPass;
+                u64 frame                  = 0;
+                DecodeMarker(CAST<u32>(checkpoint >> 1), pass, frame);
+                if (pass == kNoPass) { continue; }
+
+                Append(report,
+                       "  %-8s stage 0x%x passed the %s of %s (frame %" PRIu64 ")\n",
+                       tracked.name.c_str(),
+                       CAST<u32>(checkpoints[i].stage),
+                       (checkpoint & 1) ? "end" : "start",
+                       std::string(GetPassName(pass)).c_str(),
+                       frame);
+            }
+        }
+        return report;
+    }
+
+    std::string Breadcrumbs::DescribeFault() const {
+        const auto& dispatch = mContext->GetDispatch();
+        if (!dispatch.getDeviceFaultInfo) { return {}; }
+
+        const VkDevice device = mContext->GetDevice();
+        VkDeviceFaultCountsEXT counts {};
+        counts.sType = VK_STRUCTURE_TYPE_DEVICE_FAULT_COUNTS_EXT;
+        if (dispatch.getDeviceFaultInfo(device, &counts, nullptr) != VK_SUCCESS) {
+            return "Device fault: no report available\n";
+        }
+
+        std::vector<VkDeviceFaultAddressInfoEXT> addresses(counts.addressInfoCount);
+        std::vector<VkDeviceFaultVendorInfoEXT> vendorInfos(counts.vendorInfoCount);
+        const VkDeviceSize vendorBinarySize = counts.vendorBinarySize;
+        counts.vendorBinarySize             = 0;  // The vendor binary is only useful to vendor tools; report its size
+
+        VkDeviceFaultInfoEXT info {};
+        info.sType         = VK_STRUCTURE_TYPE_DEVICE_FAULT_INFO_EXT;
+        info.pAddressInfos = addresses.data();
+        info.pVendorInfos  = vendorInfos.data();
+        const VkResult result = dispatch.getDeviceFaultInfo(device, &counts, &info);
+        if (result != VK_SUCCESS && result != VK_INCOMPLETE) { return "Device fault: no report available\n"; }
+
+        std::string report;
+        Append(report, "Device fault: %s\n", info.description);
+        for (u32 i = 0; i < counts.addressInfoCount; i++) {
+            const VkDeviceFaultAddressInfoEXT& address = addresses[i];
+            const u32 type                             = CAST<u32>(address.addressType);
+            Append(report,
+                   "  %s at 0x%" PRIx64 " (+/- 0x%" PRIx64 ")\n",
+                   type < std::size(kAddressTypes) ? kAddressTypes[type] : "unknown",
+                   CAST<u64>(address.reportedAddress),
+                   CAST<u64>(address.addressPrecision));
+        }
+        for (u32 i = 0; i < counts.vendorInfoCount; i++) {
+            const VkDeviceFaultVendorInfoEXT& vendor = vendorInfos[i];
+            Append(report,
+                   "  %s (code 0x%" PRIx64 ", data 0x%" PRIx64 ")\n",
+                   vendor.description,
+                   CAST<u64>(vendor.vendorFaultCode),
+                   CAST<u64>(vendor.vendorFaultData));
+        }
+        if (vendorBinarySize > 0) {
+            Append(report, "  Vendor crash dump: %" PRIu64 " bytes\n", CAST<u64>(vendorBinarySize));
+        }
+        return report;
+    }
+}  // namespace Vulkano
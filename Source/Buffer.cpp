@@ -0,0 +1,79 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Buffer.hpp"
+#include "VulkanContext.hpp"
+
+namespace Vulkano {
+    Buffer::~Buffer() {
+        Shutdown();
+    }
+
+    Result<void> Buffer::Initialize(VulkanContext* context, const Config& config) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (IsInitialized()) { return std::unexpected("Buffer already created"); }
+
+        if (config.size == 0) { return std::unexpected("Buffer size must be greater than zero"); }
+
+        VkBufferCreateInfo bufferInfo {};
+        bufferInfo.sType       = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        bufferInfo.size        = config.size;
+        bufferInfo.usage       = config.usage;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        const auto& families       = context->GetQueueFamilies();
+        const u32 sharedIndices[2] = {families.graphicsFamily, families.computeFamily};
+        if (config.concurrent && families.graphicsFamily != families.computeFamily) {
+            bufferInfo.sharingMode           = VK_SHARING_MODE_CONCURRENT;
+            bufferInfo.queueFamilyIndexCount = 2;
+            bufferInfo.pQueueFamilyIndices   = sharedIndices;
+        }
+
+        VmaAllocationCreateInfo allocationInfo {};
+        allocationInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        if (config.hostVisible) {
+            // Coherent so callers never have to flush what they write
+            allocationInfo.flags =
+              VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+            allocationInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        }
+
+        VmaAllocationInfo allocationResult {};
+        if (vmaCreateBuffer(context->GetAllocator(),
+                            &bufferInfo,
+                            &allocationInfo,
+                            &mBuffer,
+                            &mAllocation,
+                            &allocationResult) != VK_SUCCESS) {
+            return std::unexpected("Failed to create buffer");
+        }
+
+        mContext = context;
+        mSize    = config.size;
+        mMapped  = allocationResult.pMappedData;
+
+        if (config.usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) {
+            VkBufferDeviceAddressInfo addressInfo {};
+            addressInfo.sType  = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+            addressInfo.buffer = mBuffer;
+            mDeviceAddress     = vkGetBufferDeviceAddress(context->GetDevice(), &addressInfo);
+        }
+
+        return {};
+    }
+
+    void Buffer::Shutdown() {
+        if (!mContext) { return; }
+
+        vmaDestroyBuffer(mContext->GetAllocator(), mBuffer, mAllocation);
+
+        mBuffer        = VK_NULL_HANDLE;
+        mAllocation    = VK_NULL_HANDLE;
+        mSize          = 0;
+        mMapped        = nullptr;
+        mDeviceAddress = 0;
+        mContext       = nullptr;
+    }
+}  // namespace Vulkano
@@ -0,0 +1,196 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "CommandStateCache.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Vulkano {
+    namespace {
+        template<typename T>
+        bool BytesEqual(const T& a, const T& b) {
+            return std::memcmp(&a, &b, sizeof(T)) == 0;
+        }
+
+        VkBool32 ToVkBool(bool value) {
+            return value ? VK_TRUE : VK_FALSE;
+        }
+    }  // namespace
+
+    CommandStateCache::CommandStateCache(const VulkanContext& context) : mDispatch(context.GetDispatch()) {
+        if (mDispatch.cmdSetPolygonMode) { mSupported |= kDynamicPolygonMode; }
+        if (mDispatch.cmdSetColorBlendEnable && mDispatch.cmdSetColorBlendEquation && mDispatch.cmdSetColorWriteMask) {
+            mSupported |= kDynamicColorBlend;
+        }
+    }
+
+    void CommandStateCache::Begin(VkCommandBuffer commandBuffer) {
+        mCommandBuffer = commandBuffer;
+        mPipelines[0]  = VK_NULL_HANDLE;
+        mPipelines[1]  = VK_NULL_HANDLE;
+        mValid         = 0;
+        mStats         = {};
+    }
+
+    void CommandStateCache::BindPipeline(VkPipelineBindPoint bindPoint,
+                                         VkPipeline pipeline,
+                                         DynamicStateFlags dynamicState) {
+        const bool graphics = bindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS;
+        VkPipeline& bound   = mPipelines[graphics ? 0 : 1];
+        if (bound == pipeline) {
+            mStats.skipped++;
+            return;
+        }
+
+        vkCmdBindPipeline(mCommandBuffer, bindPoint, pipeline);
+        bound = pipeline;
+        mStats.issued++;
+
+        if (!graphics) { return; }
+
+        // Binding a pipeline overwrites everything it bakes in; viewport and scissor are always dynamic
+        dynamicState &= mSupported;
+        if (!(dynamicState & kDynamicCullMode)) { mValid &= ~kCullMode; }
+        if (!(dynamicState & kDynamicFrontFace)) { mValid &= ~kFrontFace; }
+        if (!(dynamicState & kDynamicTopology)) { mValid &= ~kTopology; }
+        if (!(dynamicState & kDynamicDepth)) { mValid &= ~(kDepthTest | kDepthWrite | kDepthCompare); }
+        if (!(dynamicState & kDynamicPolygonMode)) { mValid &= ~kPolygonMode; }
+        if (!(dynamicState & kDynamicColorBlend)) { mValid &= ~(kBlendEnable | kBlendEquation | kWriteMask); }
+    }
+
+    void CommandStateCache::ApplyDynamicState(const GraphicsPipelineDesc& desc) {
+        const DynamicStateFlags dynamicState = desc.dynamicState & mSupported;
+
+        if (dynamicState & kDynamicCullMode) { SetCullMode(desc.cullMode); }
+        if (dynamicState & kDynamicFrontFace) { SetFrontFace(desc.frontFace); }
+        if (dynamicState & kDynamicTopology) { SetPrimitiveTopology(desc.topology); }
+        if (dynamicState & kDynamicDepth) {
+            SetDepthTestEnable(desc.depthTest);
+            SetDepthWriteEnable(desc.depthWrite);
+            SetDepthCompareOp(desc.depthCompareOp);
+        }
+        if (dynamicState & kDynamicPolygonMode) { SetPolygonMode(desc.polygonMode); }
+        if ((dynamicState & kDynamicColorBlend) && !desc.colorFormats.empty()) {
+            const auto attachmentCount = CAST<u32>(desc.colorFormats.size());
+            const auto blend           = MakeBlendAttachment(desc.alphaBlend);
+
+            const VkColorBlendEquationEXT equation {blend.srcColorBlendFactor,
+                                                    blend.dstColorBlendFactor,
+                                                    blend.colorBlendOp,
+                                                    blend.srcAlphaBlendFactor,
+                                                    blend.dstAlphaBlendFactor,
+                                                    blend.alphaBlendOp};
+
+            SetColorBlendEnable(blend.blendEnable == VK_TRUE, attachmentCount);
+            SetColorBlendEquation(equation, attachmentCount);
+            SetColorWriteMask(blend.colorWriteMask, attachmentCount);
+        }
+    }
+
+    void CommandStateCache::SetViewport(const VkViewport& viewport) {
+        if (IsCurrent(kViewport, BytesEqual(mViewport, viewport))) { return; }
+        mViewport = viewport;
+        vkCmdSetViewport(mCommandBuffer, 0, 1, &viewport);
+    }
+
+    void CommandStateCache::SetScissor(const VkRect2D& scissor) {
+        if (IsCurrent(kScissor, BytesEqual(mScissor, scissor))) { return; }
+        mScissor = scissor;
+        vkCmdSetScissor(mCommandBuffer, 0, 1, &scissor);
+    }
+
+    void CommandStateCache::SetCullMode(VkCullModeFlags cullMode) {
+        if (IsCurrent(kCullMode, mCullMode == cullMode)) { return; }
+        mCullMode = cullMode;
+        vkCmdSetCullMode(mCommandBuffer, cullMode);
+    }
+
+    void CommandStateCache::SetFrontFace(VkFrontFace frontFace) {
+        if (IsCurrent(kFrontFace, mFrontFace == frontFace)) { return; }
+        mFrontFace = frontFace;
+        vkCmdSetFrontFace(mCommandBuffer, frontFace);
+    }
+
+    void CommandStateCache::SetPrimitiveTopology(VkPrimitiveTopology topology) {
+        if (IsCurrent(kTopology, mTopology == topology)) { return; }
+        mTopology = topology;
+        vkCmdSetPrimitiveTopology(mCommandBuffer, topology);
+    }
+
+    void CommandStateCache::SetDepthTestEnable(bool enable) {
+        if (IsCurrent(kDepthTest, mDepthTest == enable)) { return; }
+        mDepthTest = enable;
+        vkCmdSetDepthTestEnable(mCommandBuffer, ToVkBool(enable));
+    }
+
+    void CommandStateCache::SetDepthWriteEnable(bool enable) {
+        if (IsCurrent(kDepthWrite, mDepthWrite == enable)) { return; }
+        mDepthWrite = enable;
+        vkCmdSetDepthWriteEnable(mCommandBuffer, ToVkBool(enable));
+    }
+
+    void CommandStateCache::SetDepthCompareOp(VkCompareOp compareOp) {
+        if (IsCurrent(kDepthCompare, mDepthCompareOp == compareOp)) { return; }
+        mDepthCompareOp = compareOp;
+        vkCmdSetDepthCompareOp(mCommandBuffer, compareOp);
+    }
+
+    void CommandStateCache::SetPolygonMode(VkPolygonMode polygonMode) {
+        if (!mDispatch.cmdSetPolygonMode) { return; }
+        if (IsCurrent(kPolygonMode, mPolygonMode == polygonMode)) { return; }
+        mPolygonMode = polygonMode;
+        mDispatch.cmdSetPolygonMode(mCommandBuffer, polygonMode);
+    }
+
+    void CommandStateCache::SetColorBlendEnable(bool enable, u32 attachmentCount) {
+        if (!mDispatch.cmdSetColorBlendEnable || attachmentCount == 0) { return; }
+        attachmentCount = std::min(attachmentCount, kMaxColorAttachments);
+        if (IsCurrent(kBlendEnable, mBlendEnable == enable && mBlendEnableCount == attachmentCount)) { return; }
+        mBlendEnable      = enable;
+        mBlendEnableCount = attachmentCount;
+
+        VkBool32 values[kMaxColorAttachments];
+        std::fill_n(values, attachmentCount, ToVkBool(enable));
+        mDispatch.cmdSetColorBlendEnable(mCommandBuffer, 0, attachmentCount, values);
+    }
+
+    void CommandStateCache::SetColorBlendEquation(const VkColorBlendEquationEXT& equation, u32 attachmentCount) {
+        if (!mDispatch.cmdSetColorBlendEquation || attachmentCount == 0) { return; }
+        attachmentCount = std::min(attachmentCount, kMaxColorAttachments);
+        if (IsCurrent(kBlendEquation,
+                      BytesEqual(mBlendEquation, equation) && mBlendEquationCount == attachmentCount)) {
+            return;
+        }
+        mBlendEquation      = equation;
+        mBlendEquationCount = attachmentCount;
+
+        VkColorBlendEquationEXT values[kMaxColorAttachments];
+        std::fill_n(values, attachmentCount, equation);
+        mDispatch.cmdSetColorBlendEquation(mCommandBuffer, 0, attachmentCount, values);
+    }
+
+    void CommandStateCache::SetColorWriteMask(VkColorComponentFlags writeMask, u32 attachmentCount) {
+        if (!mDispatch.cmdSetColorWriteMask || attachmentCount == 0) { return; }
+        attachmentCount = std::min(attachmentCount, kMaxColorAttachments);
+        if (IsCurrent(kWriteMask, mWriteMask == writeMask && mWriteMaskCount == attachmentCount)) { return; }
+        mWriteMask      = writeMask;
+        mWriteMaskCount = attachmentCount;
+
+        VkColorComponentFlags values[kMaxColorAttachments];
+        std::fill_n(values, attachmentCount, writeMask);
+        mDispatch.cmdSetColorWriteMask(mCommandBuffer, 0, attachmentCount, values);
+    }
+
+    bool CommandStateCache::IsCurrent(StateBit bit, bool equal) {
+        if ((mValid & bit) && equal) {
+            mStats.skipped++;
+            return true;
+        }
+
+        mValid |= bit;
+        mStats.issued++;
+        return false;
+    }
+}  // namespace Vulkano
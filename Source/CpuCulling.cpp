@@ -0,0 +1,518 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "CpuCulling.hpp"
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define VULKANO_CULL_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define VULKANO_CULL_SSE
+#elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+    #include <arm_neon.h>
+    #define VULKANO_CULL_NEON
+#endif
+
+namespace Vulkano {
+    namespace {
+        // 8 lanes of f32 and the handful of operations the plane tests need. Comparisons return an 8-bit lane mask.
+#if defined(VULKANO_CULL_AVX2)
+        struct Lanes {
+            __m256 v;
+        };
+
+        inline Lanes Load(const f32* p) {
+            return {_mm256_loadu_ps(p)};
+        }
+
+        inline Lanes Splat(f32 x) {
+            return {_mm256_set1_ps(x)};
+        }
+
+        inline Lanes operator+(Lanes a, Lanes b) {
+            return {_mm256_add_ps(a.v, b.v)};
+        }
+
+        inline Lanes operator-(Lanes a, Lanes b) {
+            return {_mm256_sub_ps(a.v, b.v)};
+        }
+
+        inline Lanes operator*(Lanes a, Lanes b) {
+            return {_mm256_mul_ps(a.v, b.v)};
+        }
+
+        inline u32 GreaterEqual(Lanes a, Lanes b) {
+            return CAST<u32>(_mm256_movemask_ps(_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)));
+        }
+
+        inline u32 Less(Lanes a, Lanes b) {
+            return CAST<u32>(_mm256_movemask_ps(_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)));
+        }
+#elif defined(VULKANO_CULL_SSE)
+        struct Lanes {
+            __m128 lo;
+            __m128 hi;
+        };
+
+        inline Lanes Load(const f32* p) {
+            return {_mm_loadu_ps(p), _mm_loadu_ps(p + 4)};
+        }
+
+        inline Lanes Splat(f32 x) {
+            const __m128 v = _mm_set1_ps(x);
+            return {v, v};
+        }
+
+        inline Lanes operator+(Lanes a, Lanes b) {
+            return {_mm_add_ps(a.lo, b.lo), _mm_add_ps(a.hi, b.hi)};
+        }
+
+        inline Lanes operator-(Lanes a, Lanes b) {
+            return {_mm_sub_ps(a.lo, b.lo), _mm_sub_ps(a.hi, b.hi)};
+        }
+
+        inline Lanes operator*(Lanes a, Lanes b) {
+            return {_mm_mul_ps(a.lo, b.lo), _mm_mul_ps(a.hi, b.hi)};
+        }
+
+        inline u32 GreaterEqual(Lanes a, Lanes b) {
+            return CAST<u32>(_mm_movemask_ps(_mm_cmpge_ps(a.lo, b.lo)) |
+                             (_mm_movemask_ps(_mm_cmpge_ps(a.hi, b.hi)) << 4));
+        }
+
+        inline u32 Less(Lanes a, Lanes b) {
+            return CAST<u32>(_mm_movemask_ps(_mm_cmplt_ps(a.lo, b.lo)) |
+                             (_mm_movemask_ps(_mm_cmplt_ps(a.hi, b.hi)) << 4));
+        }
+#elif defined(VULKANO_CULL_NEON)
+        struct Lanes {
+            float32x4_t lo;
+            float32x4_t hi;
+        };
+
+        inline Lanes Load(const f32* p) {
+            return {vld1q_f32(p), vld1q_f32(p + 4)};
+        }
+
+        inline Lanes Splat(f32 x) {
+            const float32x4_t v = vdupq_n_f32(x);
+            return {v, v};
+        }
+
+        inline Lanes operator+(Lanes a, Lanes b) {
+            return {vaddq_f32(a.lo, b.lo), vaddq_f32(a.hi, b.hi)};
+        }
+
+        inline Lanes operator-(Lanes a, Lanes b) {
+            return {vsubq_f32(a.lo, b.lo), vsubq_f32(a.hi, b.hi)};
+        }
+
+        inline Lanes operator*(Lanes a, Lanes b) {
+            return {vmulq_f32(a.lo, b.lo), vmulq_f32(a.hi, b.hi)};
+        }
+
+        inline u32 MoveMask(uint32x4_t lo, uint32x4_t hi) {
+            static const uint32x4_t kLoBits = {1, 2, 4, 8};
+            static const uint32x4_t kHiBits = {16, 32, 64, 128};
+            return vaddvq_u32(vandq_u32(lo, kLoBits)) | vaddvq_u32(vandq_u32(hi, kHiBits));
+        }
+
+        inline u32 GreaterEqual(Lanes a, Lanes b) {
+            return MoveMask(vcgeq_f32(a.lo, b.lo), vcgeq_f32(a.hi, b.hi));
+        }
+
+        inline u32 Less(Lanes a, Lanes b) {
+            return MoveMask(vcltq_f32(a.lo, b.lo), vcltq_f32(a.hi, b.hi));
+        }
+#else
+        struct Lanes {
+            f32 v[8];
+        };
+
+        inline Lanes Load(const f32* p) {
+            Lanes r;
+            std::memcpy(r.v, p, sizeof(r.v));
+            return r;
+        }
+
+        inline Lanes Splat(f32 x) {
+            Lanes r;
+            std::fill(std::begin(r.v), std::end(r.v), x);
+            return r;
+        }
+
+        template<typename Op>
+        inline Lanes Apply(Lanes a, Lanes b, Op op) {
+            Lanes r;
+            for (u32 i = 0; i < 8; i++) {
+                r.v[i] = op(a.v[i], b.v[i]);
+            }
+            return r;
+        }
+
+        inline Lanes operator+(Lanes a, Lanes b) {
+            return Apply(a, b, [](f32 x, f32 y) { return x + y; });
+        }
+
+        inline Lanes operator-(Lanes a, Lanes b) {
+            return Apply(a, b, [](f32 x, f32 y) { return x - y; });
+        }
+
+        inline Lanes operator*(Lanes a, Lanes b) {
+            return Apply(a, b, [](f32 x, f32 y) { return x * y; });
+        }
+
+        inline u32 GreaterEqual(Lanes a, Lanes b) {
+            u32 mask = 0;
+            for (u32 i = 0; i < 8; i++) {
+                mask |= (a.v[i] >= b.v[i] ? 1u : 0u) << i;
+            }
+            return mask;
+        }
+
+        inline u32 Less(Lanes a, Lanes b) {
+            u32 mask = 0;
+            for (u32 i = 0; i < 8; i++) {
+                mask |= (a.v[i] < b.v[i] ? 1u : 0u) << i;
+            }
+            return mask;
+        }
+#endif
+
+        /// @brief Everything a chunk needs, precomputed once per Cull
+        struct CullSetup {
+            Frustum frustum;
+            f32 camera[3];
+            f32 scale2;          // projectionScale^2
+            f32 minSize2;        // minProjectedSize^2
+            f32 thresholds2[CpuCulling::kMaxLods - 1];
+            u32 thresholdCount;
+            bool box;
+        };
+
+        /// @brief Reference path: one instance at a time. Returns the LOD, or -1 if culled.
+        i32 TestInstance(const CullingBounds& bounds, const CullSetup& setup, u32 i) {
+            const f32 x = bounds.CenterX()[i];
+            const f32 y = bounds.CenterY()[i];
+            const f32 z = bounds.CenterZ()[i];
+            const f32 r = bounds.Radius()[i];
+
+            // Same operation order as the SIMD path so both produce identical lists
+            for (const Plane& plane : setup.frustum.planes) {
+                const f32 distance = plane.Distance(x, y, z);
+                if (setup.box) {
+                    const f32 reach = std::abs(plane.x) * bounds.ExtentX()[i] +
+                                      std::abs(plane.y) * bounds.ExtentY()[i] +
+                                      std::abs(plane.z) * bounds.ExtentZ()[i];
+                    if (distance + reach < 0.0f) { return -1; }
+                } else if (distance < -r) {
+                    return -1;
+                }
+            }
+
+            // Projected radius r * scale / distance, compared squared to avoid the sqrt and divide
+            const f32 dx      = x - setup.camera[0];
+            const f32 dy      = y - setup.camera[1];
+            const f32 dz      = z - setup.camera[2];
+            const f32 dist2   = dx * dx + dy * dy + dz * dz;
+            const f32 radius2 = r * r * setup.scale2;
+            if (radius2 < dist2 * setup.minSize2) { return -1; }
+
+            i32 lod = 0;
+            for (u32 t = 0; t < setup.thresholdCount; t++) {
+                if (radius2 < dist2 * setup.thresholds2[t]) { lod++; }
+            }
+            return lod;
+        }
+
+        /// @brief Cull [begin, end) one instance at a time, packing survivors at out
+        void CullChunkScalar(const CullingBounds& bounds,
+                             const CullSetup& setup,
+                             u32 begin,
+                             u32 end,
+                             u32* outIndices,
+                             u8* outLods,
+                             std::array<u32, CpuCulling::kMaxLods>& counts) {
+            u32 written = 0;
+            for (u32 i = begin; i < end; i++) {
+                const i32 lod = TestInstance(bounds, setup, i);
+                if (lod < 0) { continue; }
+                outIndices[written] = i;
+                outLods[written]    = CAST<u8>(lod);
+                written++;
+                counts[CAST<u32>(lod)]++;
+            }
+        }
+
+        /// @brief Cull [begin, end) eight instances at a time, packing survivors at out. begin is a multiple of 8.
+        void CullChunkSimd(const CullingBounds& bounds,
+                           const CullSetup& setup,
+                           u32 begin,
+                           u32 end,
+                           u32* outIndices,
+                           u8* outLods,
+                           std::array<u32, CpuCulling::kMaxLods>& counts) {
+            Lanes planeX[Frustum::kCount];
+            Lanes planeY[Frustum::kCount];
+            Lanes planeZ[Frustum::kCount];
+            Lanes planeW[Frustum::kCount];
+            Lanes absX[Frustum::kCount];
+            Lanes absY[Frustum::kCount];
+            Lanes absZ[Frustum::kCount];
+            for (u32 p = 0; p < Frustum::kCount; p++) {
+                const Plane& plane = setup.frustum.planes[p];
+                planeX[p]          = Splat(plane.x);
+                planeY[p]          = Splat(plane.y);
+                planeZ[p]          = Splat(plane.z);
+                planeW[p]          = Splat(plane.w);
+                absX[p]            = Splat(std::abs(plane.x));
+                absY[p]            = Splat(std::abs(plane.y));
+                absZ[p]            = Splat(std::abs(plane.z));
+            }
+
+            const Lanes zero     = Splat(0.0f);
+            const Lanes cameraX  = Splat(setup.camera[0]);
+            const Lanes cameraY  = Splat(setup.camera[1]);
+            const Lanes cameraZ  = Splat(setup.camera[2]);
+            const Lanes scale2   = Splat(setup.scale2);
+            const Lanes minSize2 = Splat(setup.minSize2);
+            Lanes thresholds2[CpuCulling::kMaxLods - 1];
+            for (u32 t = 0; t < setup.thresholdCount; t++) {
+                thresholds2[t] = Splat(setup.thresholds2[t]);
+            }
+
+            u32 written = 0;
+            for (u32 base = begin; base < end; base += CullingBounds::kLaneCount) {
+                u32 mask = end - base < CullingBounds::kLaneCount ? (1u << (end - base)) - 1u : 0xFFu;
+
+                const Lanes x = Load(bounds.CenterX() + base);
+                const Lanes y = Load(bounds.CenterY() + base);
+                const Lanes z = Load(bounds.CenterZ() + base);
+                const Lanes r = Load(bounds.Radius() + base);
+
+                if (setup.box) {
+                    const Lanes ex = Load(bounds.ExtentX() + base);
+                    const Lanes ey = Load(bounds.ExtentY() + base);
+                    const Lanes ez = Load(bounds.ExtentZ() + base);
+                    for (u32 p = 0; p < Frustum::kCount && mask != 0; p++) {
+                        const Lanes distance = planeX[p] * x + planeY[p] * y + planeZ[p] * z + planeW[p];
+                        const Lanes reach    = absX[p] * ex + absY[p] * ey + absZ[p] * ez;
+                        mask &= GreaterEqual(distance + reach, zero);
+                    }
+                } else {
+                    const Lanes negRadius = zero - r;
+                    for (u32 p = 0; p < Frustum::kCount && mask != 0; p++) {
+                        const Lanes distance = planeX[p] * x + planeY[p] * y + planeZ[p] * z + planeW[p];
+                        mask &= GreaterEqual(distance, negRadius);
+                    }
+                }
+                if (mask == 0) { continue; }
+
+                const Lanes dx      = x - cameraX;
+                const Lanes dy      = y - cameraY;
+                const Lanes dz      = z - cameraZ;
+                const Lanes dist2   = dx * dx + dy * dy + dz * dz;
+                const Lanes radius2 = r * r * scale2;
+                mask &= GreaterEqual(radius2, dist2 * minSize2);
+                if (mask == 0) { continue; }
+
+                u32 lodMasks[CpuCulling::kMaxLods - 1];
+                for (u32 t = 0; t < setup.thresholdCount; t++) {
+                    lodMasks[t] = Less(radius2, dist2 * thresholds2[t]);
+                }
+
+                while (mask != 0) {
+                    const u32 lane = CAST<u32>(std::countr_zero(mask));
+                    mask &= mask - 1;
+
+                    u32 lod = 0;
+                    for (u32 t = 0; t < setup.thresholdCount; t++) {
+                        lod += (lodMasks[t] >> lane) & 1u;
+                    }
+                    outIndices[written] = base + lane;
+                    outLods[written]    = CAST<u8>(lod);
+                    written++;
+                    counts[lod]++;
+                }
+            }
+        }
+    }  // namespace
+
+    void CullingBounds::Resize(u32 count) {
+        // Round the streams up so the last group of 8 can always be loaded
+        const size_t padded = (CAST<size_t>(count) + kLaneCount - 1) / kLaneCount * kLaneCount;
+        for (auto* stream : {&mCenterX, &mCenterY, &mCenterZ, &mRadius, &mExtentX, &mExtentY, &mExtentZ}) {
+            stream->resize(padded, 0.0f);
+        }
+        mCount = count;
+    }
+
+    u32 CullingBounds::Add() {
+        const u32 index = mCount;
+        Resize(mCount + 1);
+        return index;
+    }
+
+    void CullingBounds::SetSphere(u32 index, f32 x, f32 y, f32 z, f32 radius) {
+        mCenterX[index] = x;
+        mCenterY[index] = y;
+        mCenterZ[index] = z;
+        mRadius[index]  = radius;
+        mExtentX[index] = radius;
+        mExtentY[index] = radius;
+        mExtentZ[index] = radius;
+    }
+
+    void CullingBounds::SetBox(u32 index, f32 x, f32 y, f32 z, f32 extentX, f32 extentY, f32 extentZ) {
+        mCenterX[index] = x;
+        mCenterY[index] = y;
+        mCenterZ[index] = z;
+        mRadius[index]  = std::sqrt(extentX * extentX + extentY * extentY + extentZ * extentZ);
+        mExtentX[index] = extentX;
+        mExtentY[index] = extentY;
+        mExtentZ[index] = extentZ;
+    }
+
+    CpuCulling::~CpuCulling() {
+        Shutdown();
+    }
+
+    Result<void> CpuCulling::Initialize(JobSystem* jobs, const Config& config) {
+        if (IsInitialized()) { return std::unexpected("CPU culling already initialized"); }
+        if (config.chunkSize == 0) { return std::unexpected("CPU culling chunk size must be non-zero"); }
+
+        mJobs             = jobs;
+        mConfig           = config;
+        mConfig.chunkSize = (config.chunkSize + CullingBounds::kLaneCount - 1) / CullingBounds::kLaneCount *
+                            CullingBounds::kLaneCount;
+        mInitialized = true;
+        return {};
+    }
+
+    void CpuCulling::Shutdown() {
+        mScratchIndices = {};
+        mScratchLods    = {};
+        mChunkCounts    = {};
+        mJobs           = nullptr;
+        mInitialized    = false;
+    }
+
+    Result<CpuCulling::Output> CpuCulling::Cull(const CullingBounds& bounds, const View& view, TransientRing& arena) {
+        if (!IsInitialized()) { return std::unexpected("CPU culling not initialized"); }
+        if (view.lodThresholds.size() >= kMaxLods) { return std::unexpected("Too many LOD thresholds"); }
+
+        CullSetup setup {};
+        setup.frustum   = Frustum::FromViewProjection(view.viewProjection);
+        setup.camera[0] = view.cameraPosition[0];
+        setup.camera[1] = view.cameraPosition[1];
+        setup.camera[2] = view.cameraPosition[2];
+        setup.scale2    = view.projectionScale * view.projectionScale;
+        setup.minSize2  = view.minProjectedSize * view.minProjectedSize;
+        setup.box       = view.shape == Shape::Box;
+        for (f32 threshold : view.lodThresholds) {
+            setup.thresholds2[setup.thresholdCount++] = threshold * threshold;
+        }
+
+        Output output;
+        output.lodCount = setup.thresholdCount + 1;
+        output.tested   = bounds.Size();
+        if (bounds.Size() == 0) { return output; }
+
+        const u32 count      = bounds.Size();
+        const u32 chunkSize  = mConfig.chunkSize;
+        const u32 chunkCount = (count + chunkSize - 1) / chunkSize;
+        if (mScratchIndices.size() < count) {
+            mScratchIndices.resize(count);
+            mScratchLods.resize(count);
+        }
+        mChunkCounts.assign(chunkCount, LodCounts {});
+
+        // Pass 1: test every chunk, packing its survivors at the start of the chunk's scratch range
+        const bool simd = mConfig.useSimd;
+        const auto test = [&](u32 begin, u32 end) {
+            LodCounts& counts = mChunkCounts[begin / chunkSize];
+            if (simd) {
+                CullChunkSimd(bounds, setup, begin, end, &mScratchIndices[begin], &mScratchLods[begin], counts);
+            } else {
+                CullChunkScalar(bounds, setup, begin, end, &mScratchIndices[begin], &mScratchLods[begin], counts);
+            }
+        };
+        if (mJobs) {
+            mJobs->ParallelFor(count, chunkSize, test);
+        } else {
+            for (u32 begin = 0; begin < count; begin += chunkSize) {
+                test(begin, std::min(begin + chunkSize, count));
+            }
+        }
+
+        // Turn the per-chunk counts into each chunk's write offset within each LOD's list
+        for (u32 lod = 0; lod < output.lodCount; lod++) {
+            u32 total = 0;
+            for (LodCounts& counts : mChunkCounts) {
+                const u32 chunkTotal = counts[lod];
+                counts[lod]          = total;
+                total += chunkTotal;
+            }
+
+            VisibleList& list = output.lods[lod];
+            list.count        = total;
+            output.visible += total;
+            if (total == 0) { continue; }
+
+            list.allocation = arena.Allocate(CAST<VkDeviceSize>(total) * sizeof(u32), sizeof(u32));
+            if (!list.allocation) { return std::unexpected("Transient arena is full; increase its bytes per frame"); }
+        }
+
+        // Pass 2: scatter each chunk's survivors into the final lists. Chunk order keeps every list ascending.
+        const auto scatterChunk = [&](u32 chunk) {
+            const u32 begin   = chunk * chunkSize;
+            LodCounts offsets = mChunkCounts[chunk];
+            u32 survivors     = 0;
+            u32* lists[kMaxLods] {};
+            for (u32 lod = 0; lod < output.lodCount; lod++) {
+                lists[lod] = static_cast<u32*>(output.lods[lod].allocation.mapped);
+                const u32 nextOffset =
+                  chunk + 1 < chunkCount ? mChunkCounts[chunk + 1][lod] : output.lods[lod].count;
+                survivors += nextOffset - offsets[lod];
+            }
+
+            for (u32 i = begin; i < begin + survivors; i++) {
+                const u8 lod               = mScratchLods[i];
+                lists[lod][offsets[lod]++] = mScratchIndices[i];
+            }
+        };
+        if (mJobs) {
+            mJobs->ParallelFor(chunkCount, 1, [&](u32 begin, u32 end) {
+                for (u32 chunk = begin; chunk < end; chunk++) {
+                    scatterChunk(chunk);
+                }
+            });
+        } else {
+            for (u32 chunk = 0; chunk < chunkCount; chunk++) {
+                scatterChunk(chunk);
+            }
+        }
+
+        return output;
+    }
+
+    const char* CpuCulling::GetSimdPath() {
+#if defined(VULKANO_CULL_AVX2)
+        return "AVX2";
+#elif defined(VULKANO_CULL_SSE)
+        return "SSE";
+#elif defined(VULKANO_CULL_NEON)
+        return "NEON";
+#else
+        return "Scalar";
+#endif
+    }
+}  // namespace Vulkano
@@ -0,0 +1,379 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "DebugDraw.hpp"
+#include "FrameSynchronizer.hpp"
+#include "PipelineCompiler.hpp"
+#include "VulkanContext.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdio>
+#include <tuple>
+
+namespace Vulkano {
+    namespace {
+        constexpr const char* kLayoutName {"Vulkano.DebugDraw"};
+
+        constexpr u32 kGraphBackground {DebugDraw::Rgba(0, 0, 0, 160)};
+        constexpr u32 kGraphBudgetLine {DebugDraw::Rgba(80, 200, 80, 200)};
+        constexpr u32 kFrameTimeColor {DebugDraw::Rgba(255, 210, 60)};
+        constexpr u32 kLabelColor {DebugDraw::Rgba(255, 255, 255)};
+        constexpr f32 kFrameBudgetMs {1000.0f / 60.0f};
+
+        /// @brief 5x7 glyphs for ' ' to '~', one byte per column, bit 0 at the top
+        constexpr u8 kFont[95][5] = {
+          {0x00, 0x00, 0x00, 0x00, 0x00}, {0x00, 0x00, 0x5F, 0x00, 0x00}, {0x00, 0x07, 0x00, 0x07, 0x00},
+          {0x14, 0x7F, 0x14, 0x7F, 0x14}, {0x24, 0x2A, 0x7F, 0x2A, 0x12}, {0x23, 0x13, 0x08, 0x64, 0x62},
+          {0x36, 0x49, 0x55, 0x22, 0x50}, {0x00, 0x05, 0x03, 0x00, 0x00}, {0x00, 0x1C, 0x22, 0x41, 0x00},
+          {0x00, 0x41, 0x22, 0x1C, 0x00}, {0x14, 0x08, 0x3E, 0x08, 0x14}, {0x08, 0x08, 0x3E, 0x08, 0x08},
+          {0x00, 0x50, 0x30, 0x00, 0x00}, {0x08, 0x08, 0x08, 0x08, 0x08}, {0x00, 0x60, 0x60, 0x00, 0x00},
+          {0x20, 0x10, 0x08, 0x04, 0x02}, {0x3E, 0x51, 0x49, 0x45, 0x3E}, {0x00, 0x42, 0x7F, 0x40, 0x00},
+          {0x42, 0x61, 0x51, 0x49, 0x46}, {0x21, 0x41, 0x45, 0x4B, 0x31}, {0x18, 0x14, 0x12, 0x7F, 0x10},
+          {0x27, 0x45, 0x45, 0x45, 0x39}, {0x3C, 0x4A, 0x49, 0x49, 0x30}, {0x01, 0x71, 0x09, 0x05, 0x03},
+          {0x36, 0x49, 0x49, 0x49, 0x36}, {0x06, 0x49, 0x49, 0x29, 0x1E}, {0x00, 0x36, 0x36, 0x00, 0x00},
+          {0x00, 0x56, 0x36, 0x00, 0x00}, {0x08, 0x14, 0x22, 0x41, 0x00}, {0x14, 0x14, 0x14, 0x14, 0x14},
+          {0x00, 0x41, 0x22, 0x14, 0x08}, {0x02, 0x01, 0x51, 0x09, 0x06}, {0x32, 0x49, 0x79, 0x41, 0x3E},
+          {0x7E, 0x11, 0x11, 0x11, 0x7E}, {0x7F, 0x49, 0x49, 0x49, 0x36}, {0x3E, 0x41, 0x41, 0x41, 0x22},
+          {0x7F, 0x41, 0x41, 0x22, 0x1C}, {0x7F, 0x49, 0x49, 0x49, 0x41}, {0x7F, 0x09, 0x09, 0x09, 0x01},
+          {0x3E, 0x41, 0x49, 0x49, 0x7A}, {0x7F, 0x08, 0x08, 0x08, 0x7F}, {0x00, 0x41, 0x7F, 0x41, 0x00},
+          {0x20, 0x40, 0x41, 0x3F, 0x01}, {0x7F, 0x08, 0x14, 0x22, 0x41}, {0x7F, 0x40, 0x40, 0x40, 0x40},
+          {0x7F, 0x02, 0x0C, 0x02, 0x7F}, {0x7F, 0x04, 0x08, 0x10, 0x7F}, {0x3E, 0x41, 0x41, 0x41, 0x3E},
+          {0x7F, 0x09, 0x09, 0x09, 0x06}, {0x3E, 0x41, 0x51, 0x21, 0x5E}, {0x7F, 0x09, 0x19, 0x29, 0x46},
+          {0x46, 0x49, 0x49, 0x49, 0x31}, {0x01, 0x01, 0x7F, 0x01, 0x01}, {0x3F, 0x40, 0x40, 0x40, 0x3F},
+          {0x1F, 0x20, 0x40, 0x20, 0x1F}, {0x3F, 0x40, 0x38, 0x40, 0x3F}, {0x63, 0x14, 0x08, 0x14, 0x63},
+          {0x07, 0x08, 0x70, 0x08, 0x07}, {0x61, 0x51, 0x49, 0x45, 0x43}, {0x00, 0x7F, 0x41, 0x41, 0x00},
+          {0x02, 0x04, 0x08, 0x10, 0x20}, {0x00, 0x41, 0x41, 0x7F, 0x00}, {0x04, 0x02, 0x01, 0x02, 0x04},
+          {0x40, 0x40, 0x40, 0x40, 0x40}, {0x00, 0x01, 0x02, 0x04, 0x00}, {0x20, 0x54, 0x54, 0x54, 0x78},
+          {0x7F, 0x48, 0x44, 0x44, 0x38}, {0x38, 0x44, 0x44, 0x44, 0x20}, {0x38, 0x44, 0x44, 0x48, 0x7F},
+          {0x38, 0x54, 0x54, 0x54, 0x18}, {0x08, 0x7E, 0x09, 0x01, 0x02}, {0x0C, 0x52, 0x52, 0x52, 0x3E},
+          {0x7F, 0x08, 0x04, 0x04, 0x78}, {0x00, 0x44, 0x7D, 0x40, 0x00}, {0x20, 0x40, 0x44, 0x3D, 0x00},
+          {0x7F, 0x10, 0x28, 0x44, 0x00}, {0x00, 0x41, 0x7F, 0x40, 0x00}, {0x7C, 0x04, 0x18, 0x04, 0x78},
+          {0x7C, 0x08, 0x04, 0x04, 0x78}, {0x38, 0x44, 0x44, 0x44, 0x38}, {0x7C, 0x14, 0x14, 0x14, 0x08},
+          {0x08, 0x14, 0x14, 0x18, 0x7C}, {0x7C, 0x08, 0x04, 0x04, 0x08}, {0x48, 0x54, 0x54, 0x54, 0x20},
+          {0x04, 0x3F, 0x44, 0x40, 0x20}, {0x3C, 0x40, 0x40, 0x20, 0x7C}, {0x1C, 0x20, 0x40, 0x20, 0x1C},
+          {0x3C, 0x40, 0x30, 0x40, 0x3C}, {0x44, 0x28, 0x10, 0x28, 0x44}, {0x0C, 0x50, 0x50, 0x50, 0x3C},
+          {0x44, 0x64, 0x54, 0x4C, 0x44}, {0x00, 0x08, 0x36, 0x41, 0x00}, {0x00, 0x00, 0x7F, 0x00, 0x00},
+          {0x00, 0x41, 0x36, 0x08, 0x00}, {0x08, 0x04, 0x08, 0x10, 0x08},
+        };
+
+        const u8* Glyph(char c) {
+            return c >= ' ' && c <= '~' ? kFont[c - ' '] : nullptr;
+        }
+
+        /// @brief Runs of set bits in a glyph column; each becomes one quad
+        u32 CountRuns(u8 column) {
+            const u32 bits = column;
+            return CAST<u32>(std::popcount(bits & ~(bits << 1)));
+        }
+
+        void WriteQuad(DebugVertex* out, f32 x0, f32 y0, f32 x1, f32 y1, u32 color) {
+            const DebugVertex a {{x0, y0, 0.0f}, color, 1};
+            const DebugVertex b {{x1, y0, 0.0f}, color, 1};
+            const DebugVertex c {{x1, y1, 0.0f}, color, 1};
+            const DebugVertex d {{x0, y1, 0.0f}, color, 1};
+            out[0] = a;
+            out[1] = b;
+            out[2] = c;
+            out[3] = a;
+            out[4] = c;
+            out[5] = d;
+        }
+    }  // namespace
+
+    DebugDraw::~DebugDraw() {
+        Shutdown();
+    }
+
+    Result<void> DebugDraw::Initialize(VulkanContext* context, PipelineCompiler* compiler, const Config& config) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (!compiler || !compiler->IsInitialized()) { return std::unexpected("Invalid or uninitialized compiler"); }
+
+        if (IsInitialized()) { return std::unexpected("Debug draw already created"); }
+
+        if (config.maxLineVertices == 0 || config.maxTriangleVertices == 0 || config.framesInFlight == 0) {
+            return std::unexpected("Vertex and frame counts must be greater than zero");
+        }
+
+        mContext = context;
+        mConfig  = config;
+
+        // Both streams come out of the same region; leave room for their alignment
+        const VkDeviceSize bytesPerFrame =
+          (CAST<VkDeviceSize>(config.maxLineVertices) + config.maxTriangleVertices) * sizeof(DebugVertex) + 512;
+        if (auto result =
+              mVertices.Initialize(context, bytesPerFrame, config.framesInFlight, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+            !result) {
+            Shutdown();
+            return result;
+        }
+
+        const VkPushConstantRange pushRange {VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(Constants)};
+
+        VkPipelineLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges    = &pushRange;
+        if (vkCreatePipelineLayout(context->GetDevice(), &layoutInfo, nullptr, &mPipelineLayout) != VK_SUCCESS) {
+            Shutdown();
+            return std::unexpected("Failed to create debug draw pipeline layout");
+        }
+        compiler->RegisterLayout(kLayoutName, mPipelineLayout);
+
+        GraphicsPipelineDesc desc;
+        desc.layout           = kLayoutName;
+        desc.stages           = {{VK_SHADER_STAGE_VERTEX_BIT, "DebugDraw.vert", "main", {}},
+                                 {VK_SHADER_STAGE_FRAGMENT_BIT, "DebugDraw.frag", "main", {}}};
+        desc.vertexBindings   = {{0, sizeof(DebugVertex), VK_VERTEX_INPUT_RATE_VERTEX}};
+        desc.vertexAttributes = {{0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(DebugVertex, position)},
+                                 {1, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(DebugVertex, color)},
+                                 {2, 0, VK_FORMAT_R32_UINT, offsetof(DebugVertex, screenSpace)}};
+        desc.depthTest        = config.depthTest && config.depthFormat != VK_FORMAT_UNDEFINED;
+        desc.alphaBlend       = true;
+        desc.colorFormats     = {config.colorFormat};
+        desc.depthFormat      = config.depthFormat;
+
+        desc.topology     = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        auto trianglePipe = compiler->Get(desc);
+        if (!trianglePipe) {
+            Shutdown();
+            return std::unexpected(trianglePipe.error());
+        }
+
+        desc.topology = VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+        auto linePipe = compiler->Get(desc);
+        if (!linePipe) {
+            Shutdown();
+            return std::unexpected(linePipe.error());
+        }
+
+        mTrianglePipeline = trianglePipe.value();
+        mLinePipeline     = linePipe.value();
+        return {};
+    }
+
+    void DebugDraw::Shutdown() {
+        if (!mContext) { return; }
+
+        if (mPipelineLayout != VK_NULL_HANDLE) {
+            vkDestroyPipelineLayout(mContext->GetDevice(), mPipelineLayout, nullptr);
+        }
+        mVertices.Shutdown();
+
+        for (Stream* stream : {&mLines, &mTriangles}) {
+            stream->vertices = nullptr;
+            stream->capacity = 0;
+            stream->count.store(0, std::memory_order_relaxed);
+        }
+        mDropped.store(0, std::memory_order_relaxed);
+
+        mPipelineLayout   = VK_NULL_HANDLE;
+        mLinePipeline     = VK_NULL_HANDLE;
+        mTrianglePipeline = VK_NULL_HANDLE;
+        mStats            = {};
+        mContext          = nullptr;
+    }
+
+    void DebugDraw::BeginFrame(const FrameSynchronizer& frames) {
+        if (!IsInitialized()) { return; }
+
+        mVertices.BeginFrame(frames.GetCurrentFrameIndex() % mConfig.framesInFlight);
+        mDropped.store(0, std::memory_order_relaxed);
+
+        const auto claim = [this](Stream& stream, u32 capacity) {
+            const TransientRing::Allocation allocation = mVertices.Allocate(capacity * sizeof(DebugVertex));
+            stream.vertices = CAST<DebugVertex*>(allocation.mapped);
+            stream.offset   = allocation.offset;
+            stream.capacity = allocation ? capacity : 0;
+            stream.count.store(0, std::memory_order_relaxed);
+        };
+        claim(mLines, mConfig.maxLineVertices);
+        claim(mTriangles, mConfig.maxTriangleVertices);
+    }
+
+    DebugVertex* DebugDraw::Reserve(Stream& stream, u32 count) {
+        // Compare-exchange rather than fetch_add so a failed claim never pushes count past capacity
+        u32 first = stream.count.load(std::memory_order_relaxed);
+        do {
+            if (count > stream.capacity - first) {
+                mDropped.fetch_add(count, std::memory_order_relaxed);
+                return nullptr;
+            }
+        } while (!stream.count.compare_exchange_weak(first, first + count, std::memory_order_relaxed));
+
+        return stream.vertices + first;
+    }
+
+    void DebugDraw::Line(const Float3& from, const Float3& to, u32 color) {
+        DebugVertex* out = Reserve(mLines, 2);
+        if (!out) { return; }
+
+        out[0] = {{from[0], from[1], from[2]}, color, 0};
+        out[1] = {{to[0], to[1], to[2]}, color, 0};
+    }
+
+    void DebugDraw::Box(const Float3& min, const Float3& max, u32 color) {
+        DebugVertex* out = Reserve(mLines, 24);
+        if (!out) { return; }
+
+        // Corner i takes x, y and z from max where bits 0, 1 and 2 of i are set
+        const auto corner = [&](u32 i) {
+            return DebugVertex {{(i & 1) ? max[0] : min[0], (i & 2) ? max[1] : min[1], (i & 4) ? max[2] : min[2]},
+                                color,
+                                0};
+        };
+        constexpr u8 kEdges[12][2] = {
+          {0, 1}, {2, 3}, {4, 5}, {6, 7}, {0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}};
+        for (const auto& edge : kEdges) {
+            *out++ = corner(edge[0]);
+            *out++ = corner(edge[1]);
+        }
+    }
+
+    void DebugDraw::ScreenLine(f32 x0, f32 y0, f32 x1, f32 y1, u32 color) {
+        DebugVertex* out = Reserve(mLines, 2);
+        if (!out) { return; }
+
+        out[0] = {{x0, y0, 0.0f}, color, 1};
+        out[1] = {{x1, y1, 0.0f}, color, 1};
+    }
+
+    void DebugDraw::Rect(f32 x, f32 y, f32 width, f32 height, u32 color) {
+        DebugVertex* out = Reserve(mTriangles, 6);
+        if (!out) { return; }
+
+        WriteQuad(out, x, y, x + width, y + height, color);
+    }
+
+    void DebugDraw::Text(f32 x, f32 y, std::string_view text, u32 color, f32 scale) {
+        // Count first so the whole string is one reservation; vertical runs of pixels share a quad
+        u32 quads = 0;
+        for (const char c : text) {
+            if (const u8* glyph = Glyph(c)) {
+                for (u32 column = 0; column < 5; column++) {
+                    quads += CountRuns(glyph[column]);
+                }
+            }
+        }
+        if (quads == 0) { return; }
+
+        DebugVertex* out = Reserve(mTriangles, quads * 6);
+        if (!out) { return; }
+
+        f32 penX = x;
+        f32 penY = y;
+        for (const char c : text) {
+            if (c == '\n') {
+                penX = x;
+                penY += kGlyphHeight * scale;
+                continue;
+            }
+
+            if (const u8* glyph = Glyph(c)) {
+                for (u32 column = 0; column < 5; column++) {
+                    const f32 left = penX + CAST<f32>(column) * scale;
+                    u32 bits       = glyph[column];
+                    for (u32 row = 0; bits != 0;) {
+                        const u32 start = row + CAST<u32>(std::countr_zero(bits));
+                        bits >>= start - row;
+                        const u32 length = CAST<u32>(std::countr_zero(~bits));
+                        bits >>= length;
+                        row = start + length;
+
+                        WriteQuad(out,
+                                  left,
+                                  penY + CAST<f32>(start) * scale,
+                                  left + scale,
+                                  penY + CAST<f32>(row) * scale,
+                                  color);
+                        out += 6;
+                    }
+                }
+            }
+            penX += kGlyphWidth * scale;
+        }
+    }
+
+    void DebugDraw::Graph(f32 x, f32 y, f32 width, f32 height, std::span<const f32> values, f32 maxValue, u32 color) {
+        Rect(x, y, width, height, kGraphBackground);
+        if (values.size() < 2) { return; }
+
+        if (maxValue <= 0.0f) { maxValue = *std::max_element(values.begin(), values.end()); }
+        if (maxValue <= 0.0f) { return; }
+
+        const u32 segments = CAST<u32>(values.size() - 1);
+        DebugVertex* out   = Reserve(mLines, segments * 2);
+        if (!out) { return; }
+
+        const f32 step   = width / CAST<f32>(segments);
+        const f32 bottom = y + height;
+        const auto point = [&](u32 i) {
+            const f32 value = std::clamp(values[i] / maxValue, 0.0f, 1.0f);
+            return DebugVertex {{x + step * CAST<f32>(i), bottom - value * height, 0.0f}, color, 1};
+        };
+        for (u32 i = 0; i < segments; i++) {
+            *out++ = point(i);
+            *out++ = point(i + 1);
+        }
+    }
+
+    void DebugDraw::FrameTimeGraph(const FrameSynchronizer& frames, f32 x, f32 y, f32 width, f32 height) {
+        std::array<f32, FrameSynchronizer::kFrameTimeHistory> times {};
+        const u32 count = frames.GetFrameTimeCount();
+        for (u32 i = 0; i < count; i++) {
+            times[i] = frames.GetFrameTime(count - 1 - i);
+        }
+
+        // Keep the scale steady until a frame blows through twice the budget
+        const f32 maxTime = frames.GetMaxFrameTime();
+        const f32 scale   = std::max(kFrameBudgetMs * 2.0f, maxTime);
+        Graph(x, y, width, height, std::span(times.data(), count), scale, kFrameTimeColor);
+
+        const f32 budgetY = y + height - kFrameBudgetMs / scale * height;
+        ScreenLine(x, budgetY, x + width, budgetY, kGraphBudgetLine);
+
+        char label[64];
+        std::snprintf(label, sizeof(label), "%.2f ms avg  %.2f ms max", frames.GetAverageFrameTime(), maxTime);
+        Text(x + 4.0f, y + 4.0f, label, kLabelColor);
+    }
+
+    Result<void> DebugDraw::Flush(const FrameSynchronizer& frames, const Mat4& viewProjection, VkExtent2D extent) {
+        if (!IsInitialized()) { return std::unexpected("Debug draw not initialized"); }
+
+        if (extent.width == 0 || extent.height == 0) { return std::unexpected("Viewport extent must not be empty"); }
+
+        mStats                  = {};
+        mStats.lineVertices     = mLines.count.load(std::memory_order_acquire);
+        mStats.triangleVertices = mTriangles.count.load(std::memory_order_acquire);
+        mStats.droppedVertices  = mDropped.load(std::memory_order_relaxed);
+        if (mStats.lineVertices == 0 && mStats.triangleVertices == 0) { return {}; }
+
+        const VkCommandBuffer cmd = frames.GetCurrentCommandBuffer();
+
+        Constants constants {};
+        constants.viewProjection = viewProjection;
+        constants.pixelToNdc[0]  = 2.0f / CAST<f32>(extent.width);
+        constants.pixelToNdc[1]  = 2.0f / CAST<f32>(extent.height);
+        constants.pixelToNdc[2]  = -1.0f;
+        constants.pixelToNdc[3]  = -1.0f;
+        vkCmdPushConstants(cmd, mPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(Constants), &constants);
+
+        // Triangles first so lines (graph curves, outlines) land on top of filled backgrounds
+        const VkBuffer buffer = mVertices.GetBuffer();
+        for (const auto& [stream, pipeline, vertexCount] :
+             {std::tuple {&mTriangles, mTrianglePipeline, mStats.triangleVertices},
+              std::tuple {&mLines, mLinePipeline, mStats.lineVertices}}) {
+            if (vertexCount == 0) { continue; }
+
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+            vkCmdBindVertexBuffers(cmd, 0, 1, &buffer, &stream->offset);
+            vkCmdDraw(cmd, vertexCount, 1, 0, 0);
+            mStats.draws++;
+        }
+
+        return {};
+    }
+}  // namespace Vulkano
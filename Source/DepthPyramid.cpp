@@ -0,0 +1,257 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "DepthPyramid.hpp"
+#include "PipelineCompiler.hpp"
+#include "VulkanContext.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace Vulkano {
+    namespace {
+        constexpr u32 kGroupSize {8};  // DepthReduce.comp local size in x and y
+
+        constexpr const char* kLayoutName {"Vulkano.DepthReduce"};
+
+        /// @brief DepthReduce.comp push constants
+        struct ReducePush {
+            f32 width;
+            f32 height;
+        };
+    }  // namespace
+
+    DepthPyramid::~DepthPyramid() {
+        Shutdown();
+    }
+
+    Result<void> DepthPyramid::Initialize(VulkanContext* context,
+                                          PipelineCompiler* compiler,
+                                          u32 depthWidth,
+                                          u32 depthHeight,
+                                          u32 framesInFlight) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (!compiler || !compiler->IsInitialized()) { return std::unexpected("Invalid or uninitialized compiler"); }
+
+        if (IsInitialized()) { return std::unexpected("Depth pyramid already created"); }
+
+        if (depthWidth < 2 || depthHeight < 2) { return std::unexpected("Depth buffer is too small for a pyramid"); }
+
+        mContext = context;
+
+        // Power of two so every level is exactly half the previous one and a 2x2 gather covers it
+        mWidth             = std::bit_floor(depthWidth);
+        mHeight            = std::bit_floor(depthHeight);
+        const u32 mipCount = CAST<u32>(std::bit_width(std::max(mWidth, mHeight)));
+
+        VkImageCreateInfo imageInfo {};
+        imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imageInfo.format        = VK_FORMAT_R32_SFLOAT;
+        imageInfo.extent        = {mWidth, mHeight, 1};
+        imageInfo.mipLevels     = mipCount;
+        imageInfo.arrayLayers   = 1;
+        imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage         = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VmaAllocationCreateInfo allocationInfo {};
+        allocationInfo.usage = VMA_MEMORY_USAGE_AUTO;
+
+        if (vmaCreateImage(context->GetAllocator(), &imageInfo, &allocationInfo, &mImage, &mAllocation, nullptr) !=
+            VK_SUCCESS) {
+            Shutdown();
+            return std::unexpected("Failed to create depth pyramid image");
+        }
+
+        const VkDevice device = context->GetDevice();
+
+        VkImageViewCreateInfo viewInfo {};
+        viewInfo.sType                       = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image                       = mImage;
+        viewInfo.viewType                    = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format                      = VK_FORMAT_R32_SFLOAT;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.levelCount = mipCount;
+        viewInfo.subresourceRange.layerCount = 1;
+        if (vkCreateImageView(device, &viewInfo, nullptr, &mView) != VK_SUCCESS) {
+            Shutdown();
+            return std::unexpected("Failed to create depth pyramid view");
+        }
+
+        mMipViews.resize(mipCount, VK_NULL_HANDLE);
+        for (u32 mip = 0; mip < mipCount; mip++) {
+            viewInfo.subresourceRange.baseMipLevel = mip;
+            viewInfo.subresourceRange.levelCount   = 1;
+            if (vkCreateImageView(device, &viewInfo, nullptr, &mMipViews[mip]) != VK_SUCCESS) {
+                Shutdown();
+                return std::unexpected("Failed to create depth pyramid mip view");
+            }
+        }
+
+        VkSamplerCreateInfo samplerInfo {};
+        samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter    = VK_FILTER_NEAREST;
+        samplerInfo.minFilter    = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod       = VK_LOD_CLAMP_NONE;
+        if (vkCreateSampler(device, &samplerInfo, nullptr, &mSampler) != VK_SUCCESS) {
+            Shutdown();
+            return std::unexpected("Failed to create depth pyramid sampler");
+        }
+
+        DescriptorStream::Config descriptorConfig;
+        descriptorConfig.bindings        = {{0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT},
+                                            {1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT}};
+        descriptorConfig.preferredPath   = DescriptorPath::Push;
+        descriptorConfig.framesInFlight  = framesInFlight;
+        descriptorConfig.maxSetsPerFrame = mipCount;
+        if (auto result = mDescriptors.Initialize(context, descriptorConfig); !result) {
+            Shutdown();
+            return result;
+        }
+
+        const VkDescriptorSetLayout setLayout = mDescriptors.GetSetLayout();
+        const VkPushConstantRange pushRange {VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(ReducePush)};
+
+        VkPipelineLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount         = 1;
+        layoutInfo.pSetLayouts            = &setLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges    = &pushRange;
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &mPipelineLayout) != VK_SUCCESS) {
+            Shutdown();
+            return std::unexpected("Failed to create depth pyramid pipeline layout");
+        }
+
+        compiler->RegisterLayout(kLayoutName, mPipelineLayout);
+
+        ComputePipelineDesc desc;
+        desc.stage.shader = "DepthReduce.comp";
+        desc.layout       = kLayoutName;
+
+        auto pipelineResult = compiler->Get(desc);
+        if (!pipelineResult) {
+            Shutdown();
+            return std::unexpected(pipelineResult.error());
+        }
+        mPipeline = pipelineResult.value();
+
+        return {};
+    }
+
+    void DepthPyramid::Shutdown() {
+        if (!mContext) { return; }
+
+        const VkDevice device = mContext->GetDevice();
+
+        mDescriptors.Shutdown();
+        if (mPipelineLayout != VK_NULL_HANDLE) { vkDestroyPipelineLayout(device, mPipelineLayout, nullptr); }
+        if (mSampler != VK_NULL_HANDLE) { vkDestroySampler(device, mSampler, nullptr); }
+        for (const VkImageView view : mMipViews) {
+            if (view != VK_NULL_HANDLE) { vkDestroyImageView(device, view, nullptr); }
+        }
+        if (mView != VK_NULL_HANDLE) { vkDestroyImageView(device, mView, nullptr); }
+        if (mImage != VK_NULL_HANDLE) { vmaDestroyImage(mContext->GetAllocator(), mImage, mAllocation); }
+
+        mPipelineLayout = VK_NULL_HANDLE;
+        mPipeline       = VK_NULL_HANDLE;
+        mSampler        = VK_NULL_HANDLE;
+        mView           = VK_NULL_HANDLE;
+        mImage          = VK_NULL_HANDLE;
+        mAllocation     = VK_NULL_HANDLE;
+        mMipViews.clear();
+        mWidth   = 0;
+        mHeight  = 0;
+        mContext = nullptr;
+    }
+
+    void DepthPyramid::Build(VkCommandBuffer commandBuffer,
+                             u32 frameIndex,
+                             VkImageView depthView,
+                             VkImageLayout depthLayout) {
+        if (!IsInitialized()) { return; }
+
+        mDescriptors.BeginFrame(frameIndex);
+
+        // Last frame's contents are irrelevant; the barrier also orders this after last frame's culling reads
+        VkImageMemoryBarrier barrier {};
+        barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask                   = VK_ACCESS_SHADER_READ_BIT;
+        barrier.dstAccessMask                   = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.oldLayout                       = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout                       = VK_IMAGE_LAYOUT_GENERAL;
+        barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image                           = mImage;
+        barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+        barrier.subresourceRange.levelCount     = GetMipCount();
+        barrier.subresourceRange.layerCount     = 1;
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr,
+                             1,
+                             &barrier);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mPipeline);
+
+        for (u32 mip = 0; mip < GetMipCount(); mip++) {
+            const u32 width  = std::max(mWidth >> mip, 1u);
+            const u32 height = std::max(mHeight >> mip, 1u);
+
+            const DescriptorWrite writes[] = {
+              mip == 0 ? DescriptorWrite::ForImage(0,
+                                                   VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                                   depthView,
+                                                   depthLayout,
+                                                   mSampler)
+                       : DescriptorWrite::ForImage(0,
+                                                   VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                                   mMipViews[mip - 1],
+                                                   VK_IMAGE_LAYOUT_GENERAL,
+                                                   mSampler),
+              DescriptorWrite::ForImage(1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, mMipViews[mip], VK_IMAGE_LAYOUT_GENERAL),
+            };
+            if (!mDescriptors.Bind(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mPipelineLayout, 0, writes)) {
+                return;
+            }
+
+            const ReducePush push {CAST<f32>(width), CAST<f32>(height)};
+            vkCmdPushConstants(commandBuffer, mPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+            vkCmdDispatch(commandBuffer,
+                          (width + kGroupSize - 1) / kGroupSize,
+                          (height + kGroupSize - 1) / kGroupSize,
+                          1);
+
+            // The next level reads this one; after the last level this publishes the pyramid to culling
+            barrier.srcAccessMask                 = VK_ACCESS_SHADER_WRITE_BIT;
+            barrier.dstAccessMask                 = VK_ACCESS_SHADER_READ_BIT;
+            barrier.oldLayout                     = VK_IMAGE_LAYOUT_GENERAL;
+            barrier.subresourceRange.baseMipLevel = mip;
+            barrier.subresourceRange.levelCount   = 1;
+            vkCmdPipelineBarrier(commandBuffer,
+                                 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0,
+                                 0,
+                                 nullptr,
+                                 0,
+                                 nullptr,
+                                 1,
+                                 &barrier);
+        }
+    }
+}  // namespace Vulkano
@@ -0,0 +1,371 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "DescriptorStream.hpp"
+#include "VulkanContext.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace Vulkano {
+    namespace {
+        bool IsBufferType(VkDescriptorType type) {
+            return type == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER || type == VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        }
+
+        // Samplers live in a separate sampler descriptor buffer; the stream only manages resource descriptors
+        bool IsResourceType(VkDescriptorType type) {
+            return IsBufferType(type) || type == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE ||
+                   type == VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        }
+    }  // namespace
+
+    const char* ToString(DescriptorPath path) {
+        switch (path) {
+            case DescriptorPath::Sets:
+                return "Sets";
+            case DescriptorPath::Push:
+                return "Push";
+            case DescriptorPath::Buffer:
+                return "Buffer";
+        }
+        return "Unknown";
+    }
+
+    DescriptorWrite DescriptorWrite::ForBuffer(u32 binding,
+                                               VkDescriptorType type,
+                                               const TransientRing::Allocation& range) {
+        DescriptorWrite write;
+        write.binding = binding;
+        write.type    = type;
+        write.buffer  = {range.buffer, range.offset, range.size};
+        write.address = range.address;
+        return write;
+    }
+
+    DescriptorWrite DescriptorWrite::ForBuffer(u32 binding,
+                                               VkDescriptorType type,
+                                               const Buffer& buffer,
+                                               VkDeviceSize offset,
+                                               VkDeviceSize range) {
+        if (range == VK_WHOLE_SIZE) { range = buffer.GetSize() - offset; }
+
+        DescriptorWrite write;
+        write.binding = binding;
+        write.type    = type;
+        write.buffer  = {buffer.GetBuffer(), offset, range};
+        write.address = buffer.GetDeviceAddress() != 0 ? buffer.GetDeviceAddress() + offset : 0;
+        return write;
+    }
+
+    DescriptorWrite DescriptorWrite::ForImage(u32 binding,
+                                              VkDescriptorType type,
+                                              VkImageView view,
+                                              VkImageLayout layout,
+                                              VkSampler sampler) {
+        DescriptorWrite write;
+        write.binding = binding;
+        write.type    = type;
+        write.image   = {sampler, view, layout};
+        return write;
+    }
+
+    DescriptorStream::~DescriptorStream() {
+        Shutdown();
+    }
+
+    Result<void> DescriptorStream::Initialize(VulkanContext* context, const Config& config) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (IsInitialized()) { return std::unexpected("Descriptor stream already created"); }
+
+        if (config.bindings.empty() || config.bindings.size() > kMaxWrites) {
+            return std::unexpected("Descriptor stream needs between 1 and 16 bindings");
+        }
+
+        if (config.framesInFlight == 0 || config.maxSetsPerFrame == 0) {
+            return std::unexpected("Frames in flight and sets per frame must be greater than zero");
+        }
+
+        mContext  = context;
+        mBindings = config.bindings;
+        mPath     = ChoosePath(config);
+
+        std::vector<VkDescriptorSetLayoutBinding> layoutBindings;
+        layoutBindings.reserve(mBindings.size());
+        for (const auto& binding : mBindings) {
+            layoutBindings.push_back({binding.binding, binding.type, 1, binding.stages, nullptr});
+        }
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = CAST<u32>(layoutBindings.size());
+        layoutInfo.pBindings    = layoutBindings.data();
+        if (mPath == DescriptorPath::Push) {
+            layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
+        } else if (mPath == DescriptorPath::Buffer) {
+            layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_DESCRIPTOR_BUFFER_BIT_EXT;
+        }
+
+        const VkDevice device = context->GetDevice();
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &mSetLayout) != VK_SUCCESS) {
+            Shutdown();
+            return std::unexpected("Failed to create descriptor set layout");
+        }
+
+        if (mPath == DescriptorPath::Sets) {
+            // One pool per frame, reset wholesale in BeginFrame instead of freeing sets one by one
+            std::vector<VkDescriptorPoolSize> poolSizes;
+            for (const auto& binding : mBindings) {
+                auto it = std::ranges::find(poolSizes, binding.type, &VkDescriptorPoolSize::type);
+                if (it == poolSizes.end()) {
+                    poolSizes.push_back({binding.type, config.maxSetsPerFrame});
+                } else {
+                    it->descriptorCount += config.maxSetsPerFrame;
+                }
+            }
+
+            VkDescriptorPoolCreateInfo poolInfo {};
+            poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+            poolInfo.maxSets       = config.maxSetsPerFrame;
+            poolInfo.poolSizeCount = CAST<u32>(poolSizes.size());
+            poolInfo.pPoolSizes    = poolSizes.data();
+
+            mPools.resize(config.framesInFlight, VK_NULL_HANDLE);
+            for (auto& pool : mPools) {
+                if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+                    Shutdown();
+                    return std::unexpected("Failed to create descriptor pool");
+                }
+            }
+        }
+
+        if (mPath == DescriptorPath::Buffer) {
+            const auto& dispatch   = context->GetDispatch();
+            const auto& properties = context->GetCapabilities().descriptorBufferProperties;
+
+            dispatch.getDescriptorSetLayoutSize(device, mSetLayout, &mSetSize);
+            const VkDeviceSize alignment = std::max<VkDeviceSize>(properties.descriptorBufferOffsetAlignment, 1);
+            mSetSize                     = (mSetSize + alignment - 1) & ~(alignment - 1);
+
+            mBindingOffsets.resize(mBindings.size());
+            for (size_t i = 0; i < mBindings.size(); i++) {
+                dispatch.getDescriptorSetLayoutBindingOffset(device, mSetLayout, mBindings[i].binding,
+                                                             &mBindingOffsets[i]);
+            }
+
+            if (auto result = mRing.Initialize(context,
+                                               mSetSize * config.maxSetsPerFrame,
+                                               config.framesInFlight,
+                                               VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT);
+                !result) {
+                Shutdown();
+                return result;
+            }
+        }
+
+        return {};
+    }
+
+    void DescriptorStream::Shutdown() {
+        if (!mContext) { return; }
+
+        const VkDevice device = mContext->GetDevice();
+
+        mRing.Shutdown();
+        for (const VkDescriptorPool pool : mPools) {
+            if (pool != VK_NULL_HANDLE) { vkDestroyDescriptorPool(device, pool, nullptr); }
+        }
+        mPools.clear();
+
+        if (mSetLayout != VK_NULL_HANDLE) {
+            vkDestroyDescriptorSetLayout(device, mSetLayout, nullptr);
+            mSetLayout = VK_NULL_HANDLE;
+        }
+
+        mBindings.clear();
+        mBindingOffsets.clear();
+        mSetSize    = 0;
+        mFrameIndex = 0;
+        mStats      = {};
+        mContext    = nullptr;
+    }
+
+    void DescriptorStream::BeginFrame(u32 frameIndex) {
+        if (!IsInitialized()) { return; }
+
+        mStats = {};
+        if (mPath == DescriptorPath::Sets) {
+            mFrameIndex = frameIndex % CAST<u32>(mPools.size());
+            vkResetDescriptorPool(mContext->GetDevice(), mPools[mFrameIndex], 0);
+        } else if (mPath == DescriptorPath::Buffer) {
+            mRing.BeginFrame(frameIndex);
+        }
+    }
+
+    void DescriptorStream::BindBuffers(VkCommandBuffer commandBuffer) const {
+        if (mPath != DescriptorPath::Buffer) { return; }
+
+        VkDescriptorBufferBindingInfoEXT bindingInfo {};
+        bindingInfo.sType   = VK_STRUCTURE_TYPE_DESCRIPTOR_BUFFER_BINDING_INFO_EXT;
+        bindingInfo.address = mRing.GetDeviceAddress();
+        bindingInfo.usage   = mRing.GetUsage();
+        mContext->GetDispatch().cmdBindDescriptorBuffers(commandBuffer, 1, &bindingInfo);
+    }
+
+    Result<void> DescriptorStream::Bind(VkCommandBuffer commandBuffer,
+                                        VkPipelineBindPoint bindPoint,
+                                        VkPipelineLayout pipelineLayout,
+                                        u32 set,
+                                        std::span<const DescriptorWrite> writes) {
+        if (!IsInitialized()) { return std::unexpected("Descriptor stream not initialized"); }
+
+        if (writes.size() > kMaxWrites) { return std::unexpected("Too many descriptor writes"); }
+
+        mStats.binds++;
+        Result<void> result = mPath == DescriptorPath::Buffer
+                                ? BindBuffer(commandBuffer, bindPoint, pipelineLayout, set, writes)
+                                : BindSet(commandBuffer, bindPoint, pipelineLayout, set, writes);
+        if (!result) { mStats.failed++; }
+        return result;
+    }
+
+    DescriptorPath DescriptorStream::ChoosePath(const Config& config) const {
+        const auto& capabilities = mContext->GetCapabilities();
+
+        const bool resourcesOnly = std::ranges::all_of(config.bindings, IsResourceType, &Binding::type);
+        if (config.preferredPath == DescriptorPath::Buffer && capabilities.descriptorBuffer && resourcesOnly) {
+            return DescriptorPath::Buffer;
+        }
+
+        if (config.preferredPath != DescriptorPath::Sets && capabilities.pushDescriptors &&
+            config.bindings.size() <= capabilities.maxPushDescriptors) {
+            return DescriptorPath::Push;
+        }
+
+        return DescriptorPath::Sets;
+    }
+
+    Result<void> DescriptorStream::BindSet(VkCommandBuffer commandBuffer,
+                                           VkPipelineBindPoint bindPoint,
+                                           VkPipelineLayout pipelineLayout,
+                                           u32 set,
+                                           std::span<const DescriptorWrite> writes) {
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        if (mPath == DescriptorPath::Sets) {
+            VkDescriptorSetAllocateInfo allocateInfo {};
+            allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+            allocateInfo.descriptorPool     = mPools[mFrameIndex];
+            allocateInfo.descriptorSetCount = 1;
+            allocateInfo.pSetLayouts        = &mSetLayout;
+            if (vkAllocateDescriptorSets(mContext->GetDevice(), &allocateInfo, &descriptorSet) != VK_SUCCESS) {
+                return std::unexpected("Descriptor pool exhausted for this frame");
+            }
+        }
+
+        // Same writes for both paths; dstSet is ignored when pushing
+        std::array<VkWriteDescriptorSet, kMaxWrites> vkWrites {};
+        for (size_t i = 0; i < writes.size(); i++) {
+            auto& vkWrite           = vkWrites[i];
+            vkWrite.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            vkWrite.dstSet          = descriptorSet;
+            vkWrite.dstBinding      = writes[i].binding;
+            vkWrite.descriptorCount = 1;
+            vkWrite.descriptorType  = writes[i].type;
+            if (IsBufferType(writes[i].type)) {
+                vkWrite.pBufferInfo = &writes[i].buffer;
+            } else {
+                vkWrite.pImageInfo = &writes[i].image;
+            }
+        }
+
+        const u32 writeCount = CAST<u32>(writes.size());
+        if (mPath == DescriptorPath::Push) {
+            mContext->GetDispatch().cmdPushDescriptorSet(commandBuffer,
+                                                         bindPoint,
+                                                         pipelineLayout,
+                                                         set,
+                                                         writeCount,
+                                                         vkWrites.data());
+            return {};
+        }
+
+        vkUpdateDescriptorSets(mContext->GetDevice(), writeCount, vkWrites.data(), 0, nullptr);
+        vkCmdBindDescriptorSets(commandBuffer, bindPoint, pipelineLayout, set, 1, &descriptorSet, 0, nullptr);
+        return {};
+    }
+
+    Result<void> DescriptorStream::BindBuffer(VkCommandBuffer commandBuffer,
+                                              VkPipelineBindPoint bindPoint,
+                                              VkPipelineLayout pipelineLayout,
+                                              u32 set,
+                                              std::span<const DescriptorWrite> writes) {
+        const auto allocation = mRing.Allocate(mSetSize);
+        if (!allocation) { return std::unexpected("Descriptor buffer exhausted for this frame"); }
+
+        const auto& dispatch  = mContext->GetDispatch();
+        const VkDevice device = mContext->GetDevice();
+        u8* const base        = CAST<u8*>(allocation.mapped);
+
+        for (const auto& write : writes) {
+            size_t index = 0;
+            while (index < mBindings.size() && mBindings[index].binding != write.binding) {
+                index++;
+            }
+            if (index == mBindings.size()) { return std::unexpected("Write targets a binding not in the layout"); }
+
+            VkDescriptorAddressInfoEXT addressInfo {};
+            addressInfo.sType   = VK_STRUCTURE_TYPE_DESCRIPTOR_ADDRESS_INFO_EXT;
+            addressInfo.address = write.address;
+            addressInfo.range   = write.buffer.range;
+
+            VkDescriptorGetInfoEXT getInfo {};
+            getInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_GET_INFO_EXT;
+            getInfo.type  = write.type;
+            switch (write.type) {
+                case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                    getInfo.data.pUniformBuffer = &addressInfo;
+                    break;
+                case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                    getInfo.data.pStorageBuffer = &addressInfo;
+                    break;
+                case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+                    getInfo.data.pSampledImage = &write.image;
+                    break;
+                case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+                    getInfo.data.pStorageImage = &write.image;
+                    break;
+                default:
+                    return std::unexpected("Descriptor type not supported on the descriptor buffer path");
+            }
+
+            if (IsBufferType(write.type) && write.address == 0) {
+                return std::unexpected("Buffer descriptor needs a device address on the descriptor buffer path");
+            }
+
+            dispatch.getDescriptor(device, &getInfo, GetDescriptorSize(write.type), base + mBindingOffsets[index]);
+        }
+
+        const u32 bufferIndex     = 0;
+        const VkDeviceSize offset = allocation.offset;
+        dispatch.cmdSetDescriptorBufferOffsets(commandBuffer, bindPoint, pipelineLayout, set, 1, &bufferIndex, &offset);
+        return {};
+    }
+
+    size_t DescriptorStream::GetDescriptorSize(VkDescriptorType type) const {
+        const auto& properties = mContext->GetCapabilities().descriptorBufferProperties;
+        switch (type) {
+            case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                return properties.uniformBufferDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+                return properties.storageBufferDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+                return properties.sampledImageDescriptorSize;
+            case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:
+                return properties.storageImageDescriptorSize;
+            default:
+                return 0;
+        }
+    }
+}  // namespace Vulkano
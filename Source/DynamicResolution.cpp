@@ -0,0 +1,458 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "DynamicResolution.hpp"
+#include "FrameSynchronizer.hpp"
+#include "ImageBarrier.hpp"
+#include "PipelineCompiler.hpp"
+#include "VulkanContext.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Vulkano {
+    namespace {
+        constexpr u32 kGroupSize {8};  // Upscale.comp local size in each dimension
+
+        constexpr const char* kLayoutName {"Vulkano.DynamicResolution"};
+
+        constexpr f32 kSmoothing {0.2f};     // Weight of each new GPU time sample
+        constexpr f32 kMaxDrop {0.85f};      // Largest per-step scale decrease...
+        constexpr f32 kMaxRaise {1.05f};     // ...and increase, so recovering is slower than backing off
+        constexpr f32 kDeadband {0.01f};     // Scale changes smaller than this are ignored
+    }  // namespace
+
+    DynamicResolution::~DynamicResolution() {
+        Shutdown();
+    }
+
+    Result<void>
+    DynamicResolution::Initialize(VulkanContext* context, PipelineCompiler* compiler, const Config& config) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (!compiler || !compiler->IsInitialized()) { return std::unexpected("Invalid or uninitialized compiler"); }
+
+        if (IsInitialized()) { return std::unexpected("Dynamic resolution already created"); }
+
+        if (config.outputExtent.width == 0 || config.outputExtent.height == 0 || config.framesInFlight == 0) {
+            return std::unexpected("Output extent and frame count must be greater than zero");
+        }
+
+        if (config.minScale <= 0.0f || config.minScale > config.maxScale || config.maxScale > 1.0f) {
+            return std::unexpected("Scale bounds must satisfy 0 < minScale <= maxScale <= 1");
+        }
+
+        mContext = context;
+        mConfig  = config;
+        mScale   = config.maxScale;
+
+        if (auto result = CreateImages(); !result) {
+            Shutdown();
+            return result;
+        }
+
+        const VkDevice device = context->GetDevice();
+
+        VkSamplerCreateInfo samplerInfo {};
+        samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter    = VK_FILTER_LINEAR;
+        samplerInfo.minFilter    = VK_FILTER_LINEAR;
+        samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        if (vkCreateSampler(device, &samplerInfo, nullptr, &mSampler) != VK_SUCCESS) {
+            Shutdown();
+            return std::unexpected("Failed to create upscale sampler");
+        }
+
+        // Without timestamps on graphics queues there is nothing to steer by, so the scale stays at maxScale
+        const auto& limits = context->GetDeviceProperties().limits;
+        if (limits.timestampComputeAndGraphics) {
+            VkQueryPoolCreateInfo queryInfo {};
+            queryInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            queryInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+            queryInfo.queryCount = config.framesInFlight * 2;
+            if (vkCreateQueryPool(device, &queryInfo, nullptr, &mQueries) != VK_SUCCESS) {
+                Shutdown();
+                return std::unexpected("Failed to create timestamp query pool");
+            }
+            mTimestampPeriod = limits.timestampPeriod;
+        }
+        mPending.assign(config.framesInFlight, false);
+
+        DescriptorStream::Config descriptorConfig;
+        descriptorConfig.bindings        = {{0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT},
+                                            {1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT}};
+        descriptorConfig.preferredPath   = DescriptorPath::Push;
+        descriptorConfig.framesInFlight  = config.framesInFlight;
+        descriptorConfig.maxSetsPerFrame = 1;
+        if (auto result = mDescriptors.Initialize(context, descriptorConfig); !result) {
+            Shutdown();
+            return result;
+        }
+
+        const VkDescriptorSetLayout setLayout = mDescriptors.GetSetLayout();
+        const VkPushConstantRange pushRange {VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(UpscalePush)};
+
+        VkPipelineLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount         = 1;
+        layoutInfo.pSetLayouts            = &setLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges    = &pushRange;
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &mPipelineLayout) != VK_SUCCESS) {
+            Shutdown();
+            return std::unexpected("Failed to create upscale pipeline layout");
+        }
+        compiler->RegisterLayout(kLayoutName, mPipelineLayout);
+
+        ComputePipelineDesc desc;
+        desc.stage.shader = "Upscale.comp";
+        desc.layout       = kLayoutName;
+
+        auto pipelineResult = compiler->Get(desc);
+        if (!pipelineResult) {
+            Shutdown();
+            return std::unexpected(pipelineResult.error());
+        }
+        mPipeline = pipelineResult.value();
+
+        return {};
+    }
+
+    void DynamicResolution::Shutdown() {
+        if (!mContext) { return; }
+
+        const VkDevice device = mContext->GetDevice();
+
+        mDescriptors.Shutdown();
+        if (mPipelineLayout != VK_NULL_HANDLE) { vkDestroyPipelineLayout(device, mPipelineLayout, nullptr); }
+        if (mQueries != VK_NULL_HANDLE) { vkDestroyQueryPool(device, mQueries, nullptr); }
+        if (mSampler != VK_NULL_HANDLE) { vkDestroySampler(device, mSampler, nullptr); }
+        DestroyImages();
+
+        mPipelineLayout  = VK_NULL_HANDLE;
+        mPipeline        = VK_NULL_HANDLE;
+        mQueries         = VK_NULL_HANDLE;
+        mSampler         = VK_NULL_HANDLE;
+        mTimestampPeriod = 0.0;
+        mScale           = 1.0f;
+        mCooldown        = 0;
+        mFrameSlot       = 0;
+        mPending.clear();
+        mStats   = {};
+        mContext = nullptr;
+    }
+
+    Result<void> DynamicResolution::Resize(VkExtent2D outputExtent) {
+        if (!IsInitialized()) { return std::unexpected("Dynamic resolution not initialized"); }
+
+        if (outputExtent.width == 0 || outputExtent.height == 0) {
+            return std::unexpected("Output extent must be greater than zero");
+        }
+
+        DestroyImages();
+        mConfig.outputExtent = outputExtent;
+        mPending.assign(mConfig.framesInFlight, false);
+        return CreateImages();
+    }
+
+    Result<void> DynamicResolution::CreateImages() {
+        mTargetExtent = {std::max(CAST<u32>(std::ceil(mConfig.outputExtent.width * mConfig.maxScale)), 1u),
+                         std::max(CAST<u32>(std::ceil(mConfig.outputExtent.height * mConfig.maxScale)), 1u)};
+        mRenderExtent = mTargetExtent;
+
+        auto result = CreateImage(mColor,
+                                  mTargetExtent,
+                                  mConfig.colorFormat,
+                                  VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT);
+        if (result && mConfig.depthFormat != VK_FORMAT_UNDEFINED) {
+            result =
+              CreateImage(mDepth, mTargetExtent, mConfig.depthFormat, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT);
+        }
+        if (result) {
+            result = CreateImage(mOutput,
+                                 mConfig.outputExtent,
+                                 kOutputFormat,
+                                 VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT);
+        }
+        return result;
+    }
+
+    void DynamicResolution::DestroyImages() {
+        for (Image* image : {&mColor, &mDepth, &mOutput}) {
+            DestroyImage(*image);
+        }
+        mTargetExtent = {0, 0};
+        mRenderExtent = {0, 0};
+    }
+
+    Result<void>
+    DynamicResolution::CreateImage(Image& image, VkExtent2D extent, VkFormat format, VkImageUsageFlags usage) {
+        const bool depth = (usage & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) != 0;
+
+        VkImageCreateInfo imageInfo {};
+        imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imageInfo.format        = format;
+        imageInfo.extent        = {extent.width, extent.height, 1};
+        imageInfo.mipLevels     = 1;
+        imageInfo.arrayLayers   = 1;
+        imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage         = usage;
+        imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        VmaAllocationCreateInfo allocationInfo {};
+        allocationInfo.usage = VMA_MEMORY_USAGE_AUTO;
+
+        if (vmaCreateImage(mContext->GetAllocator(),
+                           &imageInfo,
+                           &allocationInfo,
+                           &image.image,
+                           &image.allocation,
+                           nullptr) != VK_SUCCESS) {
+            return std::unexpected("Failed to create dynamic resolution image");
+        }
+
+        VkImageViewCreateInfo viewInfo {};
+        viewInfo.sType                       = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image                       = image.image;
+        viewInfo.viewType                    = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format                      = format;
+        viewInfo.subresourceRange.aspectMask = depth ? VK_IMAGE_ASPECT_DEPTH_BIT : VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.layerCount = 1;
+        if (vkCreateImageView(mContext->GetDevice(), &viewInfo, nullptr, &image.view) != VK_SUCCESS) {
+            return std::unexpected("Failed to create dynamic resolution image view");
+        }
+
+        return {};
+    }
+
+    void DynamicResolution::DestroyImage(Image& image) const {
+        if (image.view != VK_NULL_HANDLE) { vkDestroyImageView(mContext->GetDevice(), image.view, nullptr); }
+        if (image.image != VK_NULL_HANDLE) { vmaDestroyImage(mContext->GetAllocator(), image.image, image.allocation); }
+        image = {};
+    }
+
+    void DynamicResolution::BeginFrame(const FrameSynchronizer& frames) {
+        if (!IsInitialized()) { return; }
+
+        mFrameSlot = frames.GetCurrentFrameIndex() % mConfig.framesInFlight;
+        mDescriptors.BeginFrame(mFrameSlot);
+
+        // The fence wait in FrameSynchronizer::BeginFrame covers this slot's last timestamps
+        if (mQueries != VK_NULL_HANDLE && mPending[mFrameSlot]) {
+            u64 timestamps[2] = {};
+            const VkResult result = vkGetQueryPoolResults(mContext->GetDevice(),
+                                                          mQueries,
+                                                          mFrameSlot * 2,
+                                                          2,
+                                                          sizeof(timestamps),
+                                                          timestamps,
+                                                          sizeof(u64),
+                                                          VK_QUERY_RESULT_64_BIT);
+            if (result == VK_SUCCESS) {
+                mStats.gpuMs = CAST<f32>(CAST<f64>(timestamps[1] - timestamps[0]) * mTimestampPeriod / 1.0e6);
+
+                // Frames recorded before the last change still report the old scale's cost
+                if (mCooldown > 0) {
+                    mCooldown--;
+                } else {
+                    mStats.smoothedGpuMs = mStats.smoothedGpuMs > 0.0f
+                                             ? mStats.smoothedGpuMs + (mStats.gpuMs - mStats.smoothedGpuMs) * kSmoothing
+                                             : mStats.gpuMs;
+                    UpdateScale();
+                }
+            } else {
+                mContext->CheckDeviceLost(result);
+            }
+            mPending[mFrameSlot] = false;
+        }
+
+        const u32 width  = CAST<u32>(std::lround(mConfig.outputExtent.width * mScale));
+        const u32 height = CAST<u32>(std::lround(mConfig.outputExtent.height * mScale));
+        mRenderExtent    = {std::clamp(width, 1u, mTargetExtent.width), std::clamp(height, 1u, mTargetExtent.height)};
+        mStats.scale        = mScale;
+        mStats.renderExtent = mRenderExtent;
+    }
+
+    void DynamicResolution::UpdateScale() {
+        if (mStats.smoothedGpuMs <= 0.0f || mConfig.targetGpuMs <= 0.0f) { return; }
+
+        // Cost follows pixel count, so the per-axis scale moves with the square root of the time ratio
+        f32 scale = mScale * std::sqrt(mConfig.targetGpuMs / mStats.smoothedGpuMs);
+        scale     = std::clamp(scale, mScale * kMaxDrop, mScale * kMaxRaise);
+        scale     = std::clamp(scale, mConfig.minScale, mConfig.maxScale);
+        if (std::abs(scale - mScale) < kDeadband) { return; }
+
+        mScale               = scale;
+        mCooldown            = mConfig.framesInFlight - 1;
+        mStats.smoothedGpuMs = 0.0f;
+        mStats.changes++;
+    }
+
+    void DynamicResolution::BeginRendering(const FrameSynchronizer& frames, const VkClearColorValue& clearColor) {
+        if (!IsInitialized()) { return; }
+
+        const VkCommandBuffer commandBuffer = frames.GetCurrentCommandBuffer();
+
+        if (mQueries != VK_NULL_HANDLE) {
+            vkCmdResetQueryPool(commandBuffer, mQueries, mFrameSlot * 2, 2);
+            vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, mQueries, mFrameSlot * 2);
+        }
+
+        // Previous contents are never needed; the barriers only order against last frame's upscale and depth tests
+        ImageBarrier(commandBuffer,
+                     mColor.image,
+                     VK_IMAGE_ASPECT_COLOR_BIT,
+                     0,
+                     1,
+                     VK_IMAGE_LAYOUT_UNDEFINED,
+                     VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                     0,
+                     VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                     VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+        if (mDepth.image != VK_NULL_HANDLE) {
+            ImageBarrier(commandBuffer,
+                         mDepth.image,
+                         DepthAspect(mConfig.depthFormat),
+                         0,
+                         1,
+                         VK_IMAGE_LAYOUT_UNDEFINED,
+                         VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                         VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                         VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                         VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                         VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+        }
+
+        VkRenderingAttachmentInfo colorAttachment {};
+        colorAttachment.sType            = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        colorAttachment.imageView        = mColor.view;
+        colorAttachment.imageLayout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        colorAttachment.loadOp           = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        colorAttachment.storeOp          = VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachment.clearValue.color = clearColor;
+
+        VkRenderingAttachmentInfo depthAttachment {};
+        depthAttachment.sType                   = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        depthAttachment.imageView               = mDepth.view;
+        depthAttachment.imageLayout             = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depthAttachment.loadOp                  = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp                 = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.clearValue.depthStencil = {1.0f, 0};
+
+        // Only the top-left render extent is touched; the rest of the targets keeps stale data nobody samples
+        VkRenderingInfo renderingInfo {};
+        renderingInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO;
+        renderingInfo.renderArea           = {{0, 0}, mRenderExtent};
+        renderingInfo.layerCount           = 1;
+        renderingInfo.colorAttachmentCount = 1;
+        renderingInfo.pColorAttachments    = &colorAttachment;
+        renderingInfo.pDepthAttachment     = mDepth.view != VK_NULL_HANDLE ? &depthAttachment : nullptr;
+
+        const VkViewport viewport {
+          0.0f, 0.0f, CAST<f32>(mRenderExtent.width), CAST<f32>(mRenderExtent.height), 0.0f, 1.0f};
+        const VkRect2D scissor {{0, 0}, mRenderExtent};
+
+        vkCmdBeginRendering(commandBuffer, &renderingInfo);
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+    }
+
+    void DynamicResolution::EndRendering(const FrameSynchronizer& frames) const {
+        if (!IsInitialized()) { return; }
+
+        vkCmdEndRendering(frames.GetCurrentCommandBuffer());
+    }
+
+    Result<void> DynamicResolution::Upscale(const FrameSynchronizer& frames) {
+        if (!IsInitialized()) { return std::unexpected("Dynamic resolution not initialized"); }
+
+        const VkCommandBuffer commandBuffer = frames.GetCurrentCommandBuffer();
+
+        ImageBarrier(commandBuffer,
+                     mColor.image,
+                     VK_IMAGE_ASPECT_COLOR_BIT,
+                     0,
+                     1,
+                     VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                     VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                     VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                     VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                     VK_ACCESS_SHADER_READ_BIT);
+        // Also waits for last frame's copy out of the output image
+        ImageBarrier(commandBuffer,
+                     mOutput.image,
+                     VK_IMAGE_ASPECT_COLOR_BIT,
+                     0,
+                     1,
+                     VK_IMAGE_LAYOUT_UNDEFINED,
+                     VK_IMAGE_LAYOUT_GENERAL,
+                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+                     0,
+                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                     VK_ACCESS_SHADER_WRITE_BIT);
+
+        const DescriptorWrite writes[] = {
+          DescriptorWrite::ForImage(0,
+                                    VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                    mColor.view,
+                                    VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                    mSampler),
+          DescriptorWrite::ForImage(1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, mOutput.view, VK_IMAGE_LAYOUT_GENERAL),
+        };
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mPipeline);
+        if (auto result = mDescriptors.Bind(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mPipelineLayout, 0, writes);
+            !result) {
+            return result;
+        }
+
+        const VkExtent2D output = mConfig.outputExtent;
+        const f32 targetWidth   = CAST<f32>(mTargetExtent.width);
+        const f32 targetHeight  = CAST<f32>(mTargetExtent.height);
+
+        UpscalePush push {};
+        push.uvScale[0]    = CAST<f32>(mRenderExtent.width) / (CAST<f32>(output.width) * targetWidth);
+        push.uvScale[1]    = CAST<f32>(mRenderExtent.height) / (CAST<f32>(output.height) * targetHeight);
+        push.uvMax[0]      = (CAST<f32>(mRenderExtent.width) - 0.5f) / targetWidth;
+        push.uvMax[1]      = (CAST<f32>(mRenderExtent.height) - 0.5f) / targetHeight;
+        push.texel[0]      = 1.0f / targetWidth;
+        push.texel[1]      = 1.0f / targetHeight;
+        push.outputSize[0] = CAST<f32>(output.width);
+        push.outputSize[1] = CAST<f32>(output.height);
+        push.sharpness     = mConfig.filter == Filter::Sharpen ? std::clamp(mConfig.sharpness, 0.0f, 1.0f) : 0.0f;
+        vkCmdPushConstants(commandBuffer, mPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(push), &push);
+        vkCmdDispatch(commandBuffer,
+                      (output.width + kGroupSize - 1) / kGroupSize,
+                      (output.height + kGroupSize - 1) / kGroupSize,
+                      1);
+
+        ImageBarrier(commandBuffer,
+                     mOutput.image,
+                     VK_IMAGE_ASPECT_COLOR_BIT,
+                     0,
+                     1,
+                     VK_IMAGE_LAYOUT_GENERAL,
+                     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                     VK_ACCESS_SHADER_WRITE_BIT,
+                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+                     VK_ACCESS_TRANSFER_READ_BIT);
+
+        if (mQueries != VK_NULL_HANDLE) {
+            vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, mQueries, mFrameSlot * 2 + 1);
+            mPending[mFrameSlot] = true;
+        }
+
+        return {};
+    }
+}  // namespace Vulkano
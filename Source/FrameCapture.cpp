@@ -0,0 +1,722 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "FrameCapture.hpp"
+#include "VulkanContext.hpp"
+#include "ShaderLibrary.hpp"
+#include "PipelineCompiler.hpp"
+#include "RenderTarget.hpp"
+#include "Buffer.hpp"
+
+#include <cstring>
+
+namespace Vulkano {
+    namespace {
+        void WriteSpan(BinaryWriter& writer, std::span<const u8> data) {
+            writer.Write(CAST<u32>(data.size()));
+            writer.WriteBytes(data.data(), data.size());
+        }
+    }  // namespace
+
+    FrameCapture::~FrameCapture() {
+        Shutdown();
+    }
+
+    Result<void> FrameCapture::Initialize(VulkanContext* context, ShaderLibrary* shaders, PipelineCompiler* compiler) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (!shaders) { return std::unexpected("Frame capture needs the shader library pipelines refer to"); }
+
+        if (IsInitialized()) { return std::unexpected("Frame capture already initialized"); }
+
+        mContext    = context;
+        mShaders    = shaders;
+        mCompiler   = compiler;
+        mStateCache = std::make_unique<CommandStateCache>(*context);
+
+        return {};
+    }
+
+    void FrameCapture::Shutdown() {
+        if (!mContext) { return; }
+
+        ReleaseDeviceObjects();
+        mTargets.clear();
+        mTargetIds.clear();
+        mStateCache.reset();
+
+        mContext  = nullptr;
+        mShaders  = nullptr;
+        mCompiler = nullptr;
+    }
+
+    void FrameCapture::ReleaseDeviceObjects() {
+        // A file that spans two devices could reference handles that no longer mean anything
+        mCapturing       = false;
+        mRequestedFrames = 0;
+        mFramesLeft      = 0;
+        mActiveTarget    = nullptr;
+        mWriter.Clear();
+        mStreams.clear();
+        mUploads.clear();
+        mWrittenShaders.clear();
+        mWrittenPipelines.clear();
+
+        mLayouts.clear();
+        mLayoutIndices.clear();
+        mPipelines.clear();
+        mBuffers.clear();
+    }
+
+    Result<void> FrameCapture::RecreateDeviceObjects() {
+        return {};
+    }
+
+    void FrameCapture::Request(const std::filesystem::path& path, u32 frames) {
+        if (mCapturing || frames == 0) { return; }
+
+        mPath            = path;
+        mRequestedFrames = frames;
+    }
+
+    Result<void> FrameCapture::BeginFrame() {
+        if (mCapturing && mFramesLeft == 0) {
+            if (auto result = Finish(); !result) { return result; }
+        }
+
+        if (!mCapturing && mRequestedFrames > 0) {
+            mFramesLeft      = mRequestedFrames;
+            mRequestedFrames = 0;
+            if (auto result = Start(); !result) {
+                mWriter.Clear();
+                return result;
+            }
+        }
+
+        if (!mCapturing) { return {}; }
+
+        mWriter.Write(Record::Frame);
+        mWriter.Write(Timestamp());
+        mFramesLeft--;
+        mStats.frames++;
+
+        return {};
+    }
+
+    void FrameCapture::RegisterLayout(const std::string& name,
+                                      VkPipelineLayout layout,
+                                      std::span<const VkPushConstantRange> ranges) {
+        if (mLayoutIndices.contains(layout)) { return; }
+
+        mLayoutIndices.emplace(layout, CAST<u32>(mLayouts.size()));
+        mLayouts.push_back({name, {ranges.begin(), ranges.end()}});
+        if (mCapturing) { WriteLayout(mLayouts.back()); }
+    }
+
+    void FrameCapture::RegisterPipeline(VkPipeline pipeline, const PipelineDesc& desc) {
+        if (mPipelines.contains(pipeline)) { return; }
+        mPipelines.emplace(pipeline, PipelineInfo {mNextId++, desc});
+    }
+
+    FrameCapture::ResourceId
+    FrameCapture::RegisterBuffer(VkBuffer buffer, VkDeviceSize size, VkBufferUsageFlags usage, void* mapped) {
+        if (const auto it = mBuffers.find(buffer); it != mBuffers.end()) { return it->second.id; }
+
+        BufferInfo info {mNextId++, size, usage, mapped, 0};
+        if (usage & VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT) {
+            VkBufferDeviceAddressInfo addressInfo {};
+            addressInfo.sType  = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+            addressInfo.buffer = buffer;
+            info.address       = vkGetBufferDeviceAddress(mContext->GetDevice(), &addressInfo);
+        }
+        mBuffers.emplace(buffer, info);
+
+        // Created mid-capture: whatever the application writes next is recorded as uploads
+        if (mCapturing) {
+            std::vector<u8> data;
+            if (mapped) { data.assign(CAST<const u8*>(mapped), CAST<const u8*>(mapped) + size); }
+            WriteBufferRecord(info, data);
+        }
+
+        return info.id;
+    }
+
+    void FrameCapture::UnregisterBuffer(VkBuffer buffer) {
+        mBuffers.erase(buffer);
+    }
+
+    FrameCapture::ResourceId FrameCapture::RegisterTarget(const RenderTarget& target) {
+        const TargetInfo info {target.GetExtent(),
+                               target.GetLayerCount(),
+                               target.GetColorFormat(),
+                               target.GetDepthFormat(),
+                               target.IsMultiview()};
+
+        // Known targets are checked for a Resize since they were last written
+        if (const auto it = mTargetIds.find(&target); it != mTargetIds.end()) {
+            TargetInfo& known = mTargets[it->second - 1];
+            if (known.extent.width != info.extent.width || known.extent.height != info.extent.height) {
+                known = info;
+                if (mCapturing) { WriteTarget(it->second, known); }
+            }
+            return it->second;
+        }
+
+        mTargets.push_back(info);
+        const auto id = CAST<ResourceId>(mTargets.size());
+        mTargetIds.emplace(&target, id);
+        if (mCapturing) { WriteTarget(id, info); }
+
+        return id;
+    }
+
+    FrameCapture::ResourceId
+    FrameCapture::RegisterTarget(VkExtent2D extent, VkFormat colorFormat, VkFormat depthFormat) {
+        mTargets.push_back({extent, 1, colorFormat, depthFormat, false});
+        const auto id = CAST<ResourceId>(mTargets.size());
+        if (mCapturing) { WriteTarget(id, mTargets.back()); }
+
+        return id;
+    }
+
+    Result<void> FrameCapture::WriteBuffer(VkBuffer buffer, VkDeviceSize offset, std::span<const u8> data) {
+        const auto it = mBuffers.find(buffer);
+        if (it == mBuffers.end()) { return std::unexpected("Buffer is not registered with the frame capture"); }
+
+        const BufferInfo& info = it->second;
+        if (!info.mapped) { return std::unexpected("Buffer is not host-visible"); }
+
+        if (offset > info.size || data.size() > info.size - offset) {
+            return std::unexpected("Buffer write is out of range");
+        }
+
+        std::memcpy(CAST<u8*>(info.mapped) + offset, data.data(), data.size());
+        if (mCapturing) { mUploads.push_back({info.id, offset, {data.begin(), data.end()}}); }
+
+        return {};
+    }
+
+    void FrameCapture::Begin(VkCommandBuffer commandBuffer) {
+        mStateCache->Begin(commandBuffer);
+        mActiveTarget = nullptr;
+        if (mCapturing) { mStreams[commandBuffer].Clear(); }
+    }
+
+    Result<void> FrameCapture::BeginRendering(VkCommandBuffer commandBuffer,
+                                              RenderTarget& target,
+                                              const VkClearColorValue& clearColor,
+                                              u32 layer) {
+        if (auto result = target.BeginRendering(commandBuffer, clearColor, layer); !result) { return result; }
+        mActiveTarget = &target;
+        // The target set viewport and scissor behind the cache's back
+        mStateCache->Begin(commandBuffer);
+
+        const ResourceId id = RegisterTarget(target);
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::BeginRendering);
+            stream->Write(id);
+            stream->Write(clearColor);
+            stream->Write(layer);
+        }
+
+        return {};
+    }
+
+    void FrameCapture::BeginRendering(VkCommandBuffer commandBuffer, const VkRenderingInfo& info, ResourceId target) {
+        vkCmdBeginRendering(commandBuffer, &info);
+        mActiveTarget = nullptr;
+
+        if (auto* stream = Stream(commandBuffer)) {
+            const VkClearColorValue clearColor =
+              info.colorAttachmentCount > 0 ? info.pColorAttachments[0].clearValue.color : VkClearColorValue {};
+            stream->Write(Command::BeginRendering);
+            stream->Write(target);
+            stream->Write(clearColor);
+            stream->Write(UINT32_MAX);
+        }
+    }
+
+    void FrameCapture::EndRendering(VkCommandBuffer commandBuffer) {
+        if (mActiveTarget) {
+            mActiveTarget->EndRendering(commandBuffer);
+            mActiveTarget = nullptr;
+        } else {
+            vkCmdEndRendering(commandBuffer);
+        }
+
+        if (auto* stream = Stream(commandBuffer)) { stream->Write(Command::EndRendering); }
+    }
+
+    void FrameCapture::BindPipeline(VkCommandBuffer commandBuffer, VkPipelineBindPoint bindPoint, VkPipeline pipeline) {
+        const PipelineInfo* info = Describe(pipeline);
+        const auto* graphics     = info ? std::get_if<GraphicsPipelineDesc>(&info->desc) : nullptr;
+
+        mStateCache->BindPipeline(bindPoint, pipeline, graphics ? graphics->dynamicState : 0);
+        if (graphics) { mStateCache->ApplyDynamicState(*graphics); }
+
+        if (auto* stream = Stream(commandBuffer)) {
+            // Unknown pipelines are recorded as 0, and Replay skips their draws
+            ResourceId id = kNoResource;
+            if (info) {
+                id = info->id;
+                if (mWrittenPipelines.insert(id).second) { WritePipeline(*info); }
+            }
+            stream->Write(Command::BindPipeline);
+            stream->Write(bindPoint);
+            stream->Write(id);
+        }
+    }
+
+    void FrameCapture::SetViewport(VkCommandBuffer commandBuffer, const VkViewport& viewport) {
+        mStateCache->SetViewport(viewport);
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::SetViewport);
+            stream->Write(viewport);
+        }
+    }
+
+    void FrameCapture::SetScissor(VkCommandBuffer commandBuffer, const VkRect2D& scissor) {
+        mStateCache->SetScissor(scissor);
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::SetScissor);
+            stream->Write(scissor);
+        }
+    }
+
+    void FrameCapture::PushConstants(VkCommandBuffer commandBuffer,
+                                     VkPipelineLayout layout,
+                                     VkShaderStageFlags stages,
+                                     u32 offset,
+                                     std::span<const u8> data) {
+        vkCmdPushConstants(commandBuffer, layout, stages, offset, CAST<u32>(data.size()), data.data());
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::PushConstants);
+            stream->Write(FindLayout(layout));
+            stream->Write(stages);
+            stream->Write(offset);
+            WriteSpan(*stream, data);
+        }
+    }
+
+    void FrameCapture::PushBufferAddress(VkCommandBuffer commandBuffer,
+                                         VkPipelineLayout layout,
+                                         VkShaderStageFlags stages,
+                                         u32 offset,
+                                         VkBuffer buffer,
+                                         VkDeviceSize bufferOffset) {
+        const auto it                 = mBuffers.find(buffer);
+        const VkDeviceAddress base    = it != mBuffers.end() ? it->second.address : 0;
+        const VkDeviceAddress address = base + bufferOffset;
+        vkCmdPushConstants(commandBuffer, layout, stages, offset, sizeof(address), &address);
+
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::PushBufferAddress);
+            stream->Write(FindLayout(layout));
+            stream->Write(stages);
+            stream->Write(offset);
+            stream->Write(FindBuffer(buffer));
+            stream->Write(bufferOffset);
+        }
+    }
+
+    void FrameCapture::BindVertexBuffer(VkCommandBuffer commandBuffer,
+                                        u32 binding,
+                                        VkBuffer buffer,
+                                        VkDeviceSize offset) {
+        vkCmdBindVertexBuffers(commandBuffer, binding, 1, &buffer, &offset);
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::BindVertexBuffer);
+            stream->Write(binding);
+            stream->Write(FindBuffer(buffer));
+            stream->Write(offset);
+        }
+    }
+
+    void FrameCapture::BindIndexBuffer(VkCommandBuffer commandBuffer,
+                                       VkBuffer buffer,
+                                       VkDeviceSize offset,
+                                       VkIndexType type) {
+        vkCmdBindIndexBuffer(commandBuffer, buffer, offset, type);
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::BindIndexBuffer);
+            stream->Write(FindBuffer(buffer));
+            stream->Write(offset);
+            stream->Write(type);
+        }
+    }
+
+    void FrameCapture::Draw(VkCommandBuffer commandBuffer,
+                            u32 vertexCount,
+                            u32 instanceCount,
+                            u32 firstVertex,
+                            u32 firstInstance) {
+        vkCmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::Draw);
+            stream->Write(vertexCount);
+            stream->Write(instanceCount);
+            stream->Write(firstVertex);
+            stream->Write(firstInstance);
+        }
+    }
+
+    void FrameCapture::DrawIndexed(VkCommandBuffer commandBuffer,
+                                   u32 indexCount,
+                                   u32 instanceCount,
+                                   u32 firstIndex,
+                                   i32 vertexOffset,
+                                   u32 firstInstance) {
+        vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::DrawIndexed);
+            stream->Write(indexCount);
+            stream->Write(instanceCount);
+            stream->Write(firstIndex);
+            stream->Write(vertexOffset);
+            stream->Write(firstInstance);
+        }
+    }
+
+    void FrameCapture::DrawIndirect(VkCommandBuffer commandBuffer,
+                                    VkBuffer buffer,
+                                    VkDeviceSize offset,
+                                    u32 drawCount,
+                                    u32 stride) {
+        vkCmdDrawIndirect(commandBuffer, buffer, offset, drawCount, stride);
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::DrawIndirect);
+            stream->Write(FindBuffer(buffer));
+            stream->Write(offset);
+            stream->Write(drawCount);
+            stream->Write(stride);
+        }
+    }
+
+    void FrameCapture::DrawIndexedIndirect(VkCommandBuffer commandBuffer,
+                                           VkBuffer buffer,
+                                           VkDeviceSize offset,
+                                           u32 drawCount,
+                                           u32 stride) {
+        vkCmdDrawIndexedIndirect(commandBuffer, buffer, offset, drawCount, stride);
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::DrawIndexedIndirect);
+            stream->Write(FindBuffer(buffer));
+            stream->Write(offset);
+            stream->Write(drawCount);
+            stream->Write(stride);
+        }
+    }
+
+    void FrameCapture::Dispatch(VkCommandBuffer commandBuffer, u32 groupsX, u32 groupsY, u32 groupsZ) {
+        vkCmdDispatch(commandBuffer, groupsX, groupsY, groupsZ);
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::Dispatch);
+            stream->Write(groupsX);
+            stream->Write(groupsY);
+            stream->Write(groupsZ);
+        }
+    }
+
+    void FrameCapture::DispatchIndirect(VkCommandBuffer commandBuffer, VkBuffer buffer, VkDeviceSize offset) {
+        vkCmdDispatchIndirect(commandBuffer, buffer, offset);
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::DispatchIndirect);
+            stream->Write(FindBuffer(buffer));
+            stream->Write(offset);
+        }
+    }
+
+    void FrameCapture::FillBuffer(VkCommandBuffer commandBuffer,
+                                  VkBuffer buffer,
+                                  VkDeviceSize offset,
+                                  VkDeviceSize size,
+                                  u32 value) {
+        vkCmdFillBuffer(commandBuffer, buffer, offset, size, value);
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::FillBuffer);
+            stream->Write(FindBuffer(buffer));
+            stream->Write(offset);
+            stream->Write(size);
+            stream->Write(value);
+        }
+    }
+
+    void FrameCapture::CopyBuffer(VkCommandBuffer commandBuffer,
+                                  VkBuffer source,
+                                  VkBuffer destination,
+                                  const VkBufferCopy& region) {
+        vkCmdCopyBuffer(commandBuffer, source, destination, 1, &region);
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::CopyBuffer);
+            stream->Write(FindBuffer(source));
+            stream->Write(FindBuffer(destination));
+            stream->Write(region);
+        }
+    }
+
+    void FrameCapture::Barrier(VkCommandBuffer commandBuffer,
+                               VkPipelineStageFlags2 srcStage,
+                               VkAccessFlags2 srcAccess,
+                               VkPipelineStageFlags2 dstStage,
+                               VkAccessFlags2 dstAccess) {
+        VkMemoryBarrier2 barrier {};
+        barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        barrier.srcStageMask  = srcStage;
+        barrier.srcAccessMask = srcAccess;
+        barrier.dstStageMask  = dstStage;
+        barrier.dstAccessMask = dstAccess;
+
+        VkDependencyInfo dependency {};
+        dependency.sType              = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependency.memoryBarrierCount = 1;
+        dependency.pMemoryBarriers    = &barrier;
+        vkCmdPipelineBarrier2(commandBuffer, &dependency);
+
+        if (auto* stream = Stream(commandBuffer)) {
+            stream->Write(Command::Barrier);
+            stream->Write(srcStage);
+            stream->Write(srcAccess);
+            stream->Write(dstStage);
+            stream->Write(dstAccess);
+        }
+    }
+
+    Result<void> FrameCapture::Submit(VkQueue queue, const VkSubmitInfo& info, VkFence fence) {
+        const VkResult result = vkQueueSubmit(queue, 1, &info, fence);
+        if (result != VK_SUCCESS) {
+            if (mContext->CheckDeviceLost(result)) { return std::unexpected("Device lost during submit"); }
+            return std::unexpected("Failed to submit command buffers");
+        }
+
+        if (!mCapturing) { return {}; }
+
+        QueueKind kind = QueueKind::Other;
+        if (queue == mContext->GetGraphicsQueue()) {
+            kind = QueueKind::Graphics;
+        } else if (queue == mContext->GetComputeQueue()) {
+            kind = QueueKind::Compute;
+        } else if (queue == mContext->GetTransferQueue()) {
+            kind = QueueKind::Transfer;
+        }
+
+        mWriter.Write(Record::Submit);
+        mWriter.Write(kind);
+        mWriter.Write(Timestamp());
+
+        mWriter.Write(CAST<u32>(mUploads.size()));
+        for (const auto& upload : mUploads) {
+            mWriter.Write(upload.buffer);
+            mWriter.Write(upload.offset);
+            mWriter.WriteVector(upload.data);
+        }
+        mUploads.clear();
+
+        mWriter.Write(info.commandBufferCount);
+        for (u32 i = 0; i < info.commandBufferCount; i++) {
+            const auto it = mStreams.find(info.pCommandBuffers[i]);
+            if (it == mStreams.end()) {
+                mWriter.Write(0u);
+                continue;
+            }
+            mWriter.WriteVector(it->second.GetData());
+            mStreams.erase(it);
+        }
+
+        mStats.submits++;
+        mStats.bytes = mWriter.GetSize();
+
+        return {};
+    }
+
+    Result<void> FrameCapture::Start() {
+        // Once per capture, so buffer contents can be read without racing the GPU
+        mContext->WaitIdle();
+
+        mWriter.Clear();
+        mStreams.clear();
+        mUploads.clear();
+        mWrittenShaders.clear();
+        mWrittenPipelines.clear();
+        mStats = {};
+
+        mWriter.Write(kMagic);
+        mWriter.Write(kVersion);
+        mWriter.WriteString(mContext->GetDeviceProperties().deviceName);
+
+        for (const auto& layout : mLayouts) {
+            WriteLayout(layout);
+        }
+        for (u32 i = 0; i < mTargets.size(); i++) {
+            WriteTarget(i + 1, mTargets[i]);
+        }
+        for (const auto& [buffer, info] : mBuffers) {
+            std::vector<u8> data;
+            if (info.mapped) {
+                data.assign(CAST<const u8*>(info.mapped), CAST<const u8*>(info.mapped) + info.size);
+            } else if (info.usage & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) {
+                auto contents = ReadBack(buffer, info.size);
+                if (!contents) { return std::unexpected(contents.error()); }
+                data = std::move(*contents);
+            } else {
+                mStats.unreadableBuffers++;
+            }
+            WriteBufferRecord(info, data);
+        }
+
+        mCapturing = true;
+        mStart     = Clock::now();
+
+        return {};
+    }
+
+    Result<void> FrameCapture::Finish() {
+        mWriter.Write(Record::End);
+        mStats.bytes = mWriter.GetSize();
+        mCapturing   = false;
+        mStreams.clear();
+        mUploads.clear();
+
+        auto result = mWriter.SaveToFile(mPath);
+        mWriter.Clear();
+
+        return result;
+    }
+
+    Result<std::vector<u8>> FrameCapture::ReadBack(VkBuffer buffer, VkDeviceSize size) const {
+        Buffer staging;
+        Buffer::Config stagingConfig;
+        stagingConfig.size        = size;
+        stagingConfig.usage       = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        stagingConfig.hostVisible = true;
+        if (auto result = staging.Initialize(mContext, stagingConfig); !result) {
+            return std::unexpected(result.error());
+        }
+
+        const VkDevice device = mContext->GetDevice();
+        VkCommandPoolCreateInfo poolInfo {};
+        poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+        poolInfo.queueFamilyIndex = mContext->GetQueueFamilies().graphicsFamily;
+        VkCommandPool pool        = VK_NULL_HANDLE;
+        if (vkCreateCommandPool(device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+            return std::unexpected("Failed to create read-back command pool");
+        }
+
+        VkCommandBufferAllocateInfo allocateInfo {};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.commandPool        = pool;
+        allocateInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocateInfo.commandBufferCount = 1;
+        VkCommandBuffer commandBuffer   = VK_NULL_HANDLE;
+        VkResult result                 = vkAllocateCommandBuffers(device, &allocateInfo, &commandBuffer);
+
+        if (result == VK_SUCCESS) {
+            VkCommandBufferBeginInfo beginInfo {};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(commandBuffer, &beginInfo);
+            const VkBufferCopy region {0, 0, size};
+            vkCmdCopyBuffer(commandBuffer, buffer, staging.GetBuffer(), 1, &region);
+            vkEndCommandBuffer(commandBuffer);
+
+            VkSubmitInfo submitInfo {};
+            submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers    = &commandBuffer;
+            const VkQueue queue           = mContext->GetGraphicsQueue();
+            result                        = vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+            if (result == VK_SUCCESS) { result = vkQueueWaitIdle(queue); }
+        }
+        vkDestroyCommandPool(device, pool, nullptr);
+
+        if (result != VK_SUCCESS) {
+            mContext->CheckDeviceLost(result);
+            return std::unexpected("Failed to read back buffer contents");
+        }
+
+        const auto* contents = CAST<const u8*>(staging.GetMapped());
+        return std::vector<u8>(contents, contents + size);
+    }
+
+    void FrameCapture::WriteLayout(const LayoutInfo& layout) {
+        mWriter.Write(Record::Layout);
+        mWriter.WriteString(layout.name);
+        mWriter.WriteVector(layout.ranges);
+    }
+
+    void FrameCapture::WriteTarget(ResourceId id, const TargetInfo& target) {
+        mWriter.Write(Record::Target);
+        mWriter.Write(id);
+        mWriter.Write(target.extent);
+        mWriter.Write(target.layers);
+        mWriter.Write(target.colorFormat);
+        mWriter.Write(target.depthFormat);
+        mWriter.Write(CAST<u8>(target.multiview));
+    }
+
+    void FrameCapture::WriteBufferRecord(const BufferInfo& buffer, const std::vector<u8>& data) {
+        mWriter.Write(Record::Buffer);
+        mWriter.Write(buffer.id);
+        mWriter.Write(buffer.size);
+        mWriter.Write(buffer.usage);
+        mWriter.WriteVector(data);  // Empty for zeros
+    }
+
+    void FrameCapture::WritePipeline(const PipelineInfo& pipeline) {
+        const auto writeShader = [this](const ShaderStageDesc& stage) {
+            if (!mWrittenShaders.insert(stage.shader).second) { return; }
+            mWriter.Write(Record::Shader);
+            mWriter.WriteString(stage.shader);
+            mWriter.WriteVector(mShaders->GetCode(stage.shader));
+        };
+
+        if (const auto* graphics = std::get_if<GraphicsPipelineDesc>(&pipeline.desc)) {
+            for (const auto& stage : graphics->stages) {
+                writeShader(stage);
+            }
+            mWriter.Write(Record::Pipeline);
+            mWriter.Write(pipeline.id);
+            mWriter.Write(PipelineKind::Graphics);
+            graphics->Serialize(mWriter);
+        } else {
+            const auto& compute = std::get<ComputePipelineDesc>(pipeline.desc);
+            writeShader(compute.stage);
+            mWriter.Write(Record::Pipeline);
+            mWriter.Write(pipeline.id);
+            mWriter.Write(PipelineKind::Compute);
+            compute.Serialize(mWriter);
+        }
+    }
+
+    const FrameCapture::PipelineInfo* FrameCapture::Describe(VkPipeline pipeline) {
+        if (const auto it = mPipelines.find(pipeline); it != mPipelines.end()) { return &it->second; }
+        if (!mCompiler) { return nullptr; }
+
+        // Looked up once, then remembered like a registered pipeline
+        auto desc = mCompiler->FindDesc(pipeline);
+        if (!desc) { return nullptr; }
+        return &mPipelines.emplace(pipeline, PipelineInfo {mNextId++, std::move(*desc)}).first->second;
+    }
+
+    FrameCapture::ResourceId FrameCapture::FindBuffer(VkBuffer buffer) const {
+        const auto it = mBuffers.find(buffer);
+        return it != mBuffers.end() ? it->second.id : kNoResource;
+    }
+
+    u32 FrameCapture::FindLayout(VkPipelineLayout layout) const {
+        const auto it = mLayoutIndices.find(layout);
+        return it != mLayoutIndices.end() ? it->second : UINT32_MAX;
+    }
+
+    BinaryWriter* FrameCapture::Stream(VkCommandBuffer commandBuffer) {
+        if (!mCapturing) { return nullptr; }
+
+        mStats.commands++;
+        return &mStreams[commandBuffer];
+    }
+
+    i64 FrameCapture::Timestamp() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - mStart).count();
+    }
+}  // namespace Vulkano
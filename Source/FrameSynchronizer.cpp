@@ -3,21 +3,72 @@
 //
 
 #include "FrameSynchronizer.hpp"
+#include "Breadcrumbs.hpp"
+#include "SwapchainManager.hpp"
 #include "VulkanContext.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#if defined(__linux__)
+    #include <cerrno>
+    #include <time.h>
+#endif
+
 namespace Vulkano {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr f32 kInitialOversleepMs {0.5f};  // Starting guesses before any wakeup has been measured
+        constexpr f32 kInitialDeviationMs {0.125f};
+        constexpr f32 kMinSleepMarginMs {0.1f};
+        constexpr f32 kMaxSleepMarginMs {4.0f};
+        constexpr f32 kOversleepSmoothing {0.1f};
+        constexpr f32 kPresentSmoothing {0.05f};
+        constexpr f32 kPresentTolerance {0.1f};  // Relative deviation at which a present interval breaks the streak
+        constexpr u32 kSteadyPresentCount {8};   // Presents in a row needed before aligning to them
+
+        Clock::duration Milliseconds(f32 milliseconds) {
+            return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<f32, std::milli>(milliseconds));
+        }
+
+        f32 ToMilliseconds(Clock::duration duration) {
+            return std::chrono::duration<f32, std::milli>(duration).count();
+        }
+
+        void SleepUntil(Clock::time_point time) {
+#if defined(__linux__)
+            // steady_clock is CLOCK_MONOTONIC here; an absolute deadline doesn't drift when interrupted
+            const auto sinceEpoch = time.time_since_epoch();
+            const auto seconds    = std::chrono::duration_cast<std::chrono::seconds>(sinceEpoch);
+            timespec deadline {};
+            deadline.tv_sec  = CAST<time_t>(seconds.count());
+            deadline.tv_nsec = CAST<long>(std::chrono::nanoseconds(sinceEpoch - seconds).count());
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {}
+#else
+            std::this_thread::sleep_until(time);
+#endif
+        }
+    }  // namespace
+
     FrameSynchronizer::~FrameSynchronizer() {
         Shutdown();
     }
 
-    Result<void> FrameSynchronizer::Initialize(VulkanContext* context, u32 framesInFlight) {
+    Result<void> FrameSynchronizer::Initialize(VulkanContext* context, u32 framesInFlight, u32 queueFamily) {
         if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
 
         if (framesInFlight < 1 || framesInFlight > 4) {
             return std::unexpected("Frames in flight must be between 1 and 4");
         }
 
-        mContext = context;
+        auto scope = context->GetStartupProfiler().Measure("Frame synchronizer");
+
+        const u32 graphicsFamily = context->GetQueueFamilies().graphicsFamily;
+
+        mContext     = context;
+        mQueueFamily = queueFamily == VK_QUEUE_FAMILY_IGNORED ? graphicsFamily : queueFamily;
         mFrames.resize(framesInFlight);
 
         // Create frame contexts
@@ -47,7 +98,48 @@ namespace Vulkano {
 
         mFrames.clear();
         mContext           = nullptr;
+        mBreadcrumbs       = nullptr;
         mCurrentFrameIndex = 0;
+        mWindowCount       = 1;
+        mQueueFamily       = 0;
+        mFrameTimeCursor   = 0;
+        mFrameTimeCount    = 0;
+        mLastFrameEnd      = {};
+
+        mTargetPeriodMs       = 0.0f;
+        mSleepMarginMs        = 0.0f;
+        mOversleepMeanMs      = 0.0f;
+        mOversleepDeviationMs = 0.0f;
+        mNextDeadline         = {};
+        mWakeErrorCursor      = 0;
+        mWakeErrorCount       = 0;
+        mMissedDeadlines      = 0;
+        mPresentIntervalMs    = 0.0f;
+        mSteadyPresents       = 0;
+        mLastPresent          = {};
+    }
+
+    void FrameSynchronizer::ReleaseDeviceObjects() {
+        for (auto& frame : mFrames) {
+            DestroyFrameContext(frame);
+        }
+    }
+
+    Result<void> FrameSynchronizer::RecreateDeviceObjects() {
+        if (!mContext) { return std::unexpected("Frame synchronizer not initialized"); }
+
+        for (u32 i = 0; i < mFrames.size(); i++) {
+            if (auto result = CreateFrameContext(mFrames[i]); !result) {
+                for (u32 j = 0; j < i; j++) {
+                    DestroyFrameContext(mFrames[j]);
+                }
+                return result;
+            }
+        }
+
+        // Fences start signaled, so any slot could go first; start from 0 like Initialize
+        mCurrentFrameIndex = 0;
+        return SetWindowCount(mWindowCount);
     }
 
     Result<void> FrameSynchronizer::BeginFrame() const {
@@ -61,7 +153,8 @@ namespace Vulkano {
 
         // Reset command buffer
         VkCommandBuffer cmdBuffer = GetCurrentCommandBuffer();
-        if (vkResetCommandBuffer(cmdBuffer, 0) != VK_SUCCESS) {
+        if (const VkResult result = vkResetCommandBuffer(cmdBuffer, 0); result != VK_SUCCESS) {
+            mContext->CheckDeviceLost(result);
             return std::unexpected("Failed to reset command buffer");
         }
 
@@ -70,6 +163,201 @@ namespace Vulkano {
 
     void FrameSynchronizer::EndFrame() {
         mCurrentFrameIndex = (mCurrentFrameIndex + 1) % GetFramesInFlight();
+        if (mTargetPeriodMs > 0.0f) { WaitForDeadline(); }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (mLastFrameEnd != std::chrono::steady_clock::time_point {}) {
+            mFrameTimes[mFrameTimeCursor] = std::chrono::duration<f32, std::milli>(now - mLastFrameEnd).count();
+            mFrameTimeCursor              = (mFrameTimeCursor + 1) % kFrameTimeHistory;
+            mFrameTimeCount               = std::min(mFrameTimeCount + 1, kFrameTimeHistory);
+        }
+        mLastFrameEnd = now;
+    }
+
+    Result<void> FrameSynchronizer::SetWindowCount(u32 windows) {
+        if (!IsInitialized()) { return std::unexpected("Frame synchronizer not initialized"); }
+
+        if (windows < 1) { return std::unexpected("Window count must be at least 1"); }
+
+        const VkDevice device = mContext->GetDevice();
+        if (windows < mWindowCount) {
+            // A pending acquire may still signal one of the semaphores being dropped
+            mContext->WaitIdle();
+            for (auto& frame : mFrames) {
+                for (u32 i = windows - 1; i < frame.windowSemaphores.size(); i++) {
+                    vkDestroySemaphore(device, frame.windowSemaphores[i], nullptr);
+                }
+                frame.windowSemaphores.resize(windows - 1);
+            }
+        }
+
+        VkSemaphoreCreateInfo semaphoreInfo {};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        for (auto& frame : mFrames) {
+            while (frame.windowSemaphores.size() < windows - 1) {
+                VkSemaphore semaphore = VK_NULL_HANDLE;
+                if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+                    return std::unexpected("Failed to create window image available semaphore");
+                }
+                frame.windowSemaphores.push_back(semaphore);
+            }
+        }
+
+        mWindowCount = windows;
+        return {};
+    }
+
+    Result<u32> FrameSynchronizer::AcquireImages(std::span<SwapchainManager* const> swapchains,
+                                                 std::span<u32> imageIndices,
+                                                 u64 timeout) const {
+        if (!IsInitialized()) { return std::unexpected("Frame synchronizer not initialized"); }
+
+        if (swapchains.size() > mWindowCount || imageIndices.size() < swapchains.size()) {
+            return std::unexpected("More swapchains than windows or image indices");
+        }
+
+        u32 acquired = 0;
+        for (u32 window = 0; window < swapchains.size(); window++) {
+            auto result = swapchains[window]->AcquireNextImage(GetCurrentImageAvailableSemaphore(window), timeout);
+            imageIndices[window] = result ? result.value() : kNoImage;
+            if (result) { acquired++; }
+        }
+
+        return acquired;
+    }
+
+    void FrameSynchronizer::SetFrameRateLimit(f32 framesPerSecond) {
+        mTargetPeriodMs = framesPerSecond > 0.0f ? 1000.0f / framesPerSecond : 0.0f;
+        mNextDeadline   = {};
+        if (mSleepMarginMs == 0.0f) {
+            mOversleepMeanMs      = kInitialOversleepMs;
+            mOversleepDeviationMs = kInitialDeviationMs;
+            mSleepMarginMs        = kInitialOversleepMs + 4.0f * kInitialDeviationMs;
+        }
+    }
+
+    void FrameSynchronizer::ReportPresentTime(std::chrono::steady_clock::time_point presentTime) {
+        if (mLastPresent != Clock::time_point {} && presentTime > mLastPresent) {
+            const f32 interval = ToMilliseconds(presentTime - mLastPresent);
+            if (mPresentIntervalMs > 0.0f &&
+                std::abs(interval - mPresentIntervalMs) <= mPresentIntervalMs * kPresentTolerance) {
+                mPresentIntervalMs += (interval - mPresentIntervalMs) * kPresentSmoothing;
+                mSteadyPresents = std::min(mSteadyPresents + 1, kSteadyPresentCount);
+            } else {
+                // A dropped or doubled frame; start over from the raw interval
+                mPresentIntervalMs = interval;
+                mSteadyPresents    = 0;
+            }
+        }
+        mLastPresent = presentTime;
+    }
+
+    bool FrameSynchronizer::IsPresentAligned() const {
+        return mSteadyPresents >= kSteadyPresentCount && mPresentIntervalMs > 0.0f;
+    }
+
+    f32 FrameSynchronizer::GetPacingPeriod() const {
+        if (!IsPresentAligned()) { return mTargetPeriodMs; }
+
+        // Releasing frames off the display's cadence only moves the judder into the presents
+        const f32 intervals = std::max(std::round(mTargetPeriodMs / mPresentIntervalMs), 1.0f);
+        return intervals * mPresentIntervalMs;
+    }
+
+    void FrameSynchronizer::WaitForDeadline() {
+        const auto period = Milliseconds(GetPacingPeriod());
+        auto now          = Clock::now();
+
+        // The first limited frame only establishes the schedule
+        if (mNextDeadline == Clock::time_point {}) {
+            mNextDeadline = now + period;
+            return;
+        }
+
+        if (IsPresentAligned()) {
+            // Keep the deadline on the grid of present times, so frames are released at a steady phase before vblank
+            const auto interval = Milliseconds(mPresentIntervalMs);
+            auto offset         = (mNextDeadline - mLastPresent) % interval;
+            if (offset < Clock::duration::zero()) { offset += interval; }
+            mNextDeadline -= offset > interval / 2 ? offset - interval : offset;
+        }
+
+        if (now >= mNextDeadline) {
+            // Running slower than the cap: don't sprint through short frames to catch up
+            mMissedDeadlines++;
+            mNextDeadline = now + period;
+            return;
+        }
+
+        const auto wake = mNextDeadline - Milliseconds(mSleepMarginMs);
+        if (now < wake) {
+            SleepUntil(wake);
+
+            // Sleep past the margin often enough that the spin covers nearly every wakeup
+            const f32 oversleep = ToMilliseconds(Clock::now() - wake);
+            mOversleepMeanMs += (oversleep - mOversleepMeanMs) * kOversleepSmoothing;
+            const f32 deviation = std::abs(oversleep - mOversleepMeanMs);
+            mOversleepDeviationMs += (deviation - mOversleepDeviationMs) * kOversleepSmoothing;
+            mSleepMarginMs = std::clamp(mOversleepMeanMs + 4.0f * mOversleepDeviationMs,
+                                        kMinSleepMarginMs,
+                                        kMaxSleepMarginMs);
+        }
+
+        while ((now = Clock::now()) < mNextDeadline) {
+            std::this_thread::yield();
+        }
+
+        mWakeErrors[mWakeErrorCursor] = ToMilliseconds(now - mNextDeadline);
+        mWakeErrorCursor              = (mWakeErrorCursor + 1) % kFrameTimeHistory;
+        mWakeErrorCount               = std::min(mWakeErrorCount + 1, kFrameTimeHistory);
+        mNextDeadline += period;
+    }
+
+    FrameSynchronizer::LimiterStats FrameSynchronizer::GetLimiterStats() const {
+        LimiterStats stats;
+        stats.targetMs          = mTargetPeriodMs;
+        stats.periodMs          = mTargetPeriodMs > 0.0f ? GetPacingPeriod() : 0.0f;
+        stats.presentIntervalMs = mPresentIntervalMs;
+        stats.sleepMarginMs     = mSleepMarginMs;
+        stats.missedDeadlines   = mMissedDeadlines;
+        stats.presentAligned    = mTargetPeriodMs > 0.0f && IsPresentAligned();
+
+        for (u32 i = 0; i < mWakeErrorCount; i++) {
+            stats.averageWakeErrorMs += mWakeErrors[i];
+            stats.maxWakeErrorMs = std::max(stats.maxWakeErrorMs, mWakeErrors[i]);
+        }
+        if (mWakeErrorCount > 0) { stats.averageWakeErrorMs /= CAST<f32>(mWakeErrorCount); }
+
+        if (mFrameTimeCount > 1) {
+            const f32 mean = GetAverageFrameTime();
+            f32 variance   = 0.0f;
+            for (u32 i = 0; i < mFrameTimeCount; i++) {
+                variance += (mFrameTimes[i] - mean) * (mFrameTimes[i] - mean);
+            }
+            stats.jitterMs = std::sqrt(variance / CAST<f32>(mFrameTimeCount - 1));
+        }
+
+        return stats;
+    }
+
+    f32 FrameSynchronizer::GetFrameTime(u32 framesAgo) const {
+        if (framesAgo >= mFrameTimeCount) { return 0.0f; }
+        return mFrameTimes[(mFrameTimeCursor + kFrameTimeHistory - 1 - framesAgo) % kFrameTimeHistory];
+    }
+
+    f32 FrameSynchronizer::GetAverageFrameTime() const {
+        if (mFrameTimeCount == 0) { return 0.0f; }
+
+        f32 total = 0.0f;
+        for (u32 i = 0; i < mFrameTimeCount; i++) {
+            total += mFrameTimes[i];
+        }
+        return total / CAST<f32>(mFrameTimeCount);
+    }
+
+    f32 FrameSynchronizer::GetMaxFrameTime() const {
+        if (mFrameTimeCount == 0) { return 0.0f; }
+        return *std::max_element(mFrameTimes.begin(), mFrameTimes.begin() + mFrameTimeCount);
     }
 
     Result<void> FrameSynchronizer::WaitForFrame(u64 timeout) const {
@@ -77,9 +365,14 @@ namespace Vulkano {
 
         VkFence fence   = GetCurrentFence();
         VkResult result = vkWaitForFences(mContext->GetDevice(), 1, &fence, VK_TRUE, timeout);
-
-        if (result == VK_TIMEOUT) {
-            return std::unexpected("Timeout waiting for fence");
+        mContext->CheckDeviceLost(result);
+
+        // Which pass the GPU was stuck in is the first question after a hang
+        if (result == VK_TIMEOUT || result == VK_ERROR_DEVICE_LOST) {
+            const bool deviceLost = result == VK_ERROR_DEVICE_LOST;
+            std::string error     = deviceLost ? "Device lost waiting for fence" : "Timeout waiting for fence";
+            if (mBreadcrumbs && mBreadcrumbs->IsInitialized()) { error += "\n" + mBreadcrumbs->Describe(deviceLost); }
+            return std::unexpected(error);
         } else if (result != VK_SUCCESS) {
             return std::unexpected("Failed to wait for fence");
         }
@@ -123,7 +416,7 @@ namespace Vulkano {
         VkCommandPoolCreateInfo poolInfo {};
         poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
         poolInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-        poolInfo.queueFamilyIndex = mContext->GetQueueFamilies().graphicsFamily;
+        poolInfo.queueFamilyIndex = mQueueFamily;
 
         if (vkCreateCommandPool(device, &poolInfo, nullptr, &frame.commandPool) != VK_SUCCESS) {
             vkDestroyFence(device, frame.inFlightFence, nullptr);
@@ -162,6 +455,11 @@ namespace Vulkano {
             frame.commandBuffer = VK_NULL_HANDLE;
         }
 
+        for (VkSemaphore semaphore : frame.windowSemaphores) {
+            vkDestroySemaphore(device, semaphore, nullptr);
+        }
+        frame.windowSemaphores.clear();
+
         if (frame.renderFinishedSemaphore != VK_NULL_HANDLE) {
             vkDestroySemaphore(device, frame.renderFinishedSemaphore, nullptr);
             frame.renderFinishedSemaphore = VK_NULL_HANDLE;
@@ -0,0 +1,344 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "GeometryArena.hpp"
+#include "FrameSynchronizer.hpp"
+#include "VulkanContext.hpp"
+
+#include <cstring>
+
+namespace Vulkano {
+    namespace {
+        constexpr VkBufferUsageFlags kArenaUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                                   VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+        /// @brief Make transfer writes visible to every stage that reads geometry (and to a following transfer)
+        void GeometryBarrier(VkCommandBuffer commandBuffer) {
+            VkMemoryBarrier barrier {};
+            barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT |
+                                    VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+            vkCmdPipelineBarrier(commandBuffer,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                                   VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 0,
+                                 1,
+                                 &barrier,
+                                 0,
+                                 nullptr,
+                                 0,
+                                 nullptr);
+        }
+    }  // namespace
+
+    GeometryArena::~GeometryArena() {
+        Shutdown();
+    }
+
+    Result<void> GeometryArena::Initialize(VulkanContext* context, const Config& config) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (IsInitialized()) { return std::unexpected("Geometry arena already created"); }
+
+        if (config.vertexStride == 0 || config.vertexCapacity == 0 || config.indexCapacity == 0 ||
+            config.framesInFlight == 0) {
+            return std::unexpected("Vertex stride, capacities and frame count must be greater than zero");
+        }
+
+        mContext = context;
+        mConfig  = config;
+
+        auto vertices = CreateBuffer(CAST<VkDeviceSize>(config.vertexCapacity) * config.vertexStride,
+                                     VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+        if (!vertices) {
+            Shutdown();
+            return std::unexpected(vertices.error());
+        }
+
+        auto indices =
+          CreateBuffer(CAST<VkDeviceSize>(config.indexCapacity) * sizeof(u32), VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+        if (!indices) {
+            Shutdown();
+            return std::unexpected(indices.error());
+        }
+
+        if (auto result = mUploads.Initialize(context,
+                                              config.uploadBytesPerFrame,
+                                              config.framesInFlight,
+                                              VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+            !result) {
+            Shutdown();
+            return result;
+        }
+
+        mVertices = std::move(*vertices);
+        mIndices  = std::move(*indices);
+        mVertexAllocator.Reset(config.vertexCapacity);
+        mIndexAllocator.Reset(config.indexCapacity);
+        mDeferred.resize(config.framesInFlight);
+        mFrameSlot  = 0;
+        mGeneration = 0;
+
+        return {};
+    }
+
+    void GeometryArena::Shutdown() {
+        mDeferred.clear();
+        mPendingCopies.clear();
+        mUploads.Shutdown();
+        mMeshes.clear();
+        mFreeIds.clear();
+        mVertexAllocator.Reset(0);
+        mIndexAllocator.Reset(0);
+        mVertices.reset();
+        mIndices.reset();
+        mContext = nullptr;
+    }
+
+    void GeometryArena::BeginFrame(const FrameSynchronizer& frames) {
+        if (!IsInitialized()) { return; }
+
+        mFrameSlot = frames.GetCurrentFrameIndex() % mConfig.framesInFlight;
+        mUploads.BeginFrame(mFrameSlot);
+
+        // This slot's previous frame (and every frame before it) has finished, so its releases are safe now
+        Deferred& deferred = mDeferred[mFrameSlot];
+        for (const auto& allocation : deferred.vertices) {
+            mVertexAllocator.Free(allocation);
+        }
+        for (const auto& allocation : deferred.indices) {
+            mIndexAllocator.Free(allocation);
+        }
+        deferred.vertices.clear();
+        deferred.indices.clear();
+        deferred.buffers.clear();
+    }
+
+    Result<MeshId> GeometryArena::Upload(std::span<const std::byte> vertices, std::span<const u32> indices) {
+        if (!IsInitialized()) { return std::unexpected("Geometry arena not initialized"); }
+
+        if (vertices.empty() || vertices.size() % mConfig.vertexStride != 0) {
+            return std::unexpected("Vertex data must be a non-zero multiple of the vertex stride");
+        }
+
+        const u32 vertexCount = CAST<u32>(vertices.size() / mConfig.vertexStride);
+        const u32 indexCount  = CAST<u32>(indices.size());
+
+        MeshSlot slot;
+        slot.vertices = mVertexAllocator.Allocate(vertexCount);
+        if (!slot.vertices) { return std::unexpected("Geometry arena is out of vertex space"); }
+
+        if (indexCount > 0) {
+            slot.indices = mIndexAllocator.Allocate(indexCount);
+            if (!slot.indices) {
+                mVertexAllocator.Free(slot.vertices);
+                return std::unexpected("Geometry arena is out of index space");
+            }
+        }
+
+        const auto vertexStaging = mUploads.Allocate(vertices.size_bytes());
+        const auto indexStaging =
+          indexCount > 0 ? mUploads.Allocate(indices.size_bytes()) : TransientRing::Allocation {};
+        if (!vertexStaging || (indexCount > 0 && !indexStaging)) {
+            mVertexAllocator.Free(slot.vertices);
+            mIndexAllocator.Free(slot.indices);
+            return std::unexpected("Upload space exhausted for this frame");
+        }
+
+        const VkDeviceSize stride = mConfig.vertexStride;
+        std::memcpy(vertexStaging.mapped, vertices.data(), vertices.size_bytes());
+        mPendingCopies.push_back(
+          {mVertices->GetBuffer(), {vertexStaging.offset, slot.vertices.offset * stride, vertices.size_bytes()}});
+        if (indexCount > 0) {
+            std::memcpy(indexStaging.mapped, indices.data(), indices.size_bytes());
+            mPendingCopies.push_back(
+              {mIndices->GetBuffer(), {indexStaging.offset, slot.indices.offset * sizeof(u32), indices.size_bytes()}});
+        }
+
+        slot.range = {slot.vertices.offset, vertexCount, slot.indices ? slot.indices.offset : 0, indexCount};
+        slot.live  = true;
+
+        if (!mFreeIds.empty()) {
+            const MeshId mesh = mFreeIds.back();
+            mFreeIds.pop_back();
+            mMeshes[mesh] = slot;
+            return mesh;
+        }
+
+        mMeshes.push_back(slot);
+        return CAST<MeshId>(mMeshes.size() - 1);
+    }
+
+    void GeometryArena::Free(MeshId mesh) {
+        if (mesh >= mMeshes.size() || !mMeshes[mesh].live) { return; }
+
+        MeshSlot& slot     = mMeshes[mesh];
+        Deferred& deferred = mDeferred[mFrameSlot];
+        deferred.vertices.push_back(slot.vertices);
+        if (slot.indices) { deferred.indices.push_back(slot.indices); }
+
+        slot = {};
+        mFreeIds.push_back(mesh);
+    }
+
+    void GeometryArena::Flush(const FrameSynchronizer& frames) {
+        if (!IsInitialized() || mPendingCopies.empty()) { return; }
+
+        const VkCommandBuffer commandBuffer = frames.GetCurrentCommandBuffer();
+        RecordPendingCopies(commandBuffer);
+        GeometryBarrier(commandBuffer);
+    }
+
+    Result<void> GeometryArena::Compact(const FrameSynchronizer& frames, u32 vertexCapacity, u32 indexCapacity) {
+        if (!IsInitialized()) { return std::unexpected("Geometry arena not initialized"); }
+
+        if (vertexCapacity == 0) { vertexCapacity = mVertexAllocator.GetCapacity(); }
+        if (indexCapacity == 0) { indexCapacity = mIndexAllocator.GetCapacity(); }
+
+        // Ranges waiting in the deferred lists aren't copied, so only live meshes count
+        u32 liveVertices = 0;
+        u32 liveIndices  = 0;
+        for (const auto& slot : mMeshes) {
+            liveVertices += slot.range.vertexCount;
+            liveIndices += slot.range.indexCount;
+        }
+        if (liveVertices > vertexCapacity || liveIndices > indexCapacity) {
+            return std::unexpected("Compacted geometry doesn't fit the requested capacity");
+        }
+
+        // A fresh TLSF range hands out blocks front to back, so the live meshes end up packed. Place everything in
+        // scratch allocators first so a failure leaves the arena untouched.
+        TlsfAllocator vertexAllocator;
+        TlsfAllocator indexAllocator;
+        vertexAllocator.Reset(vertexCapacity);
+        indexAllocator.Reset(indexCapacity);
+
+        std::vector<TlsfAllocator::Allocation> vertexPlacements(mMeshes.size());
+        std::vector<TlsfAllocator::Allocation> indexPlacements(mMeshes.size());
+        for (size_t i = 0; i < mMeshes.size(); i++) {
+            const auto& slot = mMeshes[i];
+            if (!slot.live) { continue; }
+
+            vertexPlacements[i] = vertexAllocator.Allocate(slot.range.vertexCount);
+            if (!vertexPlacements[i]) { return std::unexpected("Failed to place mesh vertices in compacted arena"); }
+
+            if (slot.range.indexCount == 0) { continue; }
+            indexPlacements[i] = indexAllocator.Allocate(slot.range.indexCount);
+            if (!indexPlacements[i]) { return std::unexpected("Failed to place mesh indices in compacted arena"); }
+        }
+
+        auto vertices =
+          CreateBuffer(CAST<VkDeviceSize>(vertexCapacity) * mConfig.vertexStride, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+        if (!vertices) { return std::unexpected(vertices.error()); }
+
+        auto indices = CreateBuffer(CAST<VkDeviceSize>(indexCapacity) * sizeof(u32), VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+        if (!indices) { return std::unexpected(indices.error()); }
+
+        // Staged uploads land in the old buffers first so the repack below carries them over
+        const VkCommandBuffer commandBuffer = frames.GetCurrentCommandBuffer();
+        if (!mPendingCopies.empty()) {
+            RecordPendingCopies(commandBuffer);
+            GeometryBarrier(commandBuffer);
+        }
+
+        mVertexAllocator = std::move(vertexAllocator);
+        mIndexAllocator  = std::move(indexAllocator);
+
+        const VkDeviceSize stride = mConfig.vertexStride;
+        std::vector<VkBufferCopy> vertexCopies;
+        std::vector<VkBufferCopy> indexCopies;
+        for (size_t i = 0; i < mMeshes.size(); i++) {
+            auto& slot = mMeshes[i];
+            if (!slot.live) { continue; }
+
+            slot.vertices = vertexPlacements[i];
+            vertexCopies.push_back({slot.range.vertexOffset * stride,
+                                    slot.vertices.offset * stride,
+                                    slot.range.vertexCount * stride});
+            slot.range.vertexOffset = slot.vertices.offset;
+
+            if (slot.range.indexCount == 0) { continue; }
+            slot.indices = indexPlacements[i];
+            indexCopies.push_back({slot.range.firstIndex * sizeof(u32),
+                                   slot.indices.offset * sizeof(u32),
+                                   slot.range.indexCount * sizeof(u32)});
+            slot.range.firstIndex = slot.indices.offset;
+        }
+
+        if (!vertexCopies.empty()) {
+            vkCmdCopyBuffer(commandBuffer,
+                            mVertices->GetBuffer(),
+                            (*vertices)->GetBuffer(),
+                            CAST<u32>(vertexCopies.size()),
+                            vertexCopies.data());
+        }
+        if (!indexCopies.empty()) {
+            vkCmdCopyBuffer(commandBuffer,
+                            mIndices->GetBuffer(),
+                            (*indices)->GetBuffer(),
+                            CAST<u32>(indexCopies.size()),
+                            indexCopies.data());
+        }
+        GeometryBarrier(commandBuffer);
+
+        // In-flight frames and the copies above still read the old buffers; retire them with this frame. Pending
+        // releases referred to the old allocators and are simply dropped.
+        for (auto& deferred : mDeferred) {
+            deferred.vertices.clear();
+            deferred.indices.clear();
+        }
+        mDeferred[mFrameSlot].buffers.push_back(std::move(mVertices));
+        mDeferred[mFrameSlot].buffers.push_back(std::move(mIndices));
+        mVertices = std::move(*vertices);
+        mIndices  = std::move(*indices);
+        mGeneration++;
+
+        return {};
+    }
+
+    void GeometryArena::Bind(VkCommandBuffer commandBuffer) const {
+        const VkBuffer vertexBuffer = mVertices->GetBuffer();
+        const VkDeviceSize offset   = 0;
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &offset);
+        vkCmdBindIndexBuffer(commandBuffer, mIndices->GetBuffer(), 0, VK_INDEX_TYPE_UINT32);
+    }
+
+    const MeshRange* GeometryArena::GetMesh(MeshId mesh) const {
+        if (mesh >= mMeshes.size() || !mMeshes[mesh].live) { return nullptr; }
+        return &mMeshes[mesh].range;
+    }
+
+    GeometryArena::Stats GeometryArena::GetStats() const {
+        Stats stats;
+        stats.meshCount         = CAST<u32>(mMeshes.size() - mFreeIds.size());
+        stats.vertexUsed        = mVertexAllocator.GetUsed();
+        stats.vertexCapacity    = mVertexAllocator.GetCapacity();
+        stats.vertexLargestFree = mVertexAllocator.GetLargestFree();
+        stats.indexUsed         = mIndexAllocator.GetUsed();
+        stats.indexCapacity     = mIndexAllocator.GetCapacity();
+        stats.indexLargestFree  = mIndexAllocator.GetLargestFree();
+        return stats;
+    }
+
+    Result<std::unique_ptr<Buffer>> GeometryArena::CreateBuffer(VkDeviceSize size, VkBufferUsageFlags usage) const {
+        auto buffer = std::make_unique<Buffer>();
+
+        Buffer::Config config;
+        config.size  = size;
+        config.usage = usage | kArenaUsage;
+        if (auto result = buffer->Initialize(mContext, config); !result) {
+            return std::unexpected("Failed to create geometry buffer: " + result.error());
+        }
+        return buffer;
+    }
+
+    void GeometryArena::RecordPendingCopies(VkCommandBuffer commandBuffer) {
+        for (const auto& copy : mPendingCopies) {
+            vkCmdCopyBuffer(commandBuffer, mUploads.GetBuffer(), copy.destination, 1, &copy.region);
+        }
+        mPendingCopies.clear();
+    }
+}  // namespace Vulkano
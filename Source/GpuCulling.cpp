@@ -0,0 +1,350 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "GpuCulling.hpp"
+#include "DepthPyramid.hpp"
+#include "FrameSynchronizer.hpp"
+#include "PipelineCompiler.hpp"
+#include "VulkanContext.hpp"
+
+#include <cstring>
+
+namespace Vulkano {
+    namespace {
+        constexpr u32 kGroupSize {64};  // CullCommon.glsl local size
+
+        constexpr const char* kLayoutName {"Vulkano.GpuCulling"};
+        constexpr const char* kOcclusionLayoutName {"Vulkano.GpuCulling.HiZ"};
+
+        enum Binding : u32 { kParams, kInstanceData, kMeshData, kCommandData, kCountData, kPyramid };
+    }  // namespace
+
+    GpuCulling::~GpuCulling() {
+        Shutdown();
+    }
+
+    Result<void> GpuCulling::Initialize(VulkanContext* context, PipelineCompiler* compiler, const Config& config) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (!compiler || !compiler->IsInitialized()) { return std::unexpected("Invalid or uninitialized compiler"); }
+
+        if (IsInitialized()) { return std::unexpected("GPU culling already created"); }
+
+        if (config.maxInstances == 0 || config.maxMeshes == 0 || config.framesInFlight == 0) {
+            return std::unexpected("Instance, mesh and frame counts must be greater than zero");
+        }
+
+        const auto& capabilities = context->GetCapabilities();
+        if (!capabilities.drawIndirectFirstInstance) {
+            return std::unexpected("GPU culling needs the drawIndirectFirstInstance feature");
+        }
+
+        mContext   = context;
+        mConfig    = config;
+        mDrawCount = capabilities.drawIndirectCount;
+        mMultiDraw = capabilities.multiDrawIndirect;
+
+        const auto createBuffer = [context](Buffer& buffer, VkDeviceSize size, VkBufferUsageFlags usage, bool host) {
+            Buffer::Config bufferConfig;
+            bufferConfig.size        = size;
+            bufferConfig.usage       = usage;
+            bufferConfig.hostVisible = host;
+            return buffer.Initialize(context, bufferConfig);
+        };
+
+        constexpr VkBufferUsageFlags storage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        constexpr VkBufferUsageFlags indirect =
+          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+        const VkDeviceSize commandBytes =
+          sizeof(VkDrawIndexedIndirectCommand) * config.maxInstances * config.framesInFlight;
+
+        Result<void> result = createBuffer(mInstances, sizeof(GpuInstance) * config.maxInstances, storage, false);
+        if (result) { result = createBuffer(mMeshes, sizeof(GpuMeshDraw) * config.maxMeshes, storage, false); }
+        if (result) { result = createBuffer(mCommands, commandBytes, indirect, false); }
+        if (result) {
+            result = createBuffer(mCounts,
+                                  sizeof(u32) * config.framesInFlight,
+                                  indirect | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                  false);
+        }
+        if (result) {
+            result =
+              createBuffer(mReadback, sizeof(u32) * config.framesInFlight, VK_BUFFER_USAGE_TRANSFER_DST_BIT, true);
+        }
+        if (result) {
+            result = mUploads.Initialize(context,
+                                         config.uploadBytesPerFrame,
+                                         config.framesInFlight,
+                                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+        }
+        if (!result) {
+            Shutdown();
+            return result;
+        }
+        std::memset(mReadback.GetMapped(), 0, sizeof(u32) * config.framesInFlight);
+        mSubmitted.assign(config.framesInFlight, 0);
+
+        DescriptorStream::Config descriptorConfig;
+        descriptorConfig.bindings = {{kParams, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+                                     {kInstanceData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+                                     {kMeshData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+                                     {kCommandData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+                                     {kCountData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT}};
+        if (config.occlusion) {
+            descriptorConfig.bindings.push_back(
+              {kPyramid, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT});
+        }
+        descriptorConfig.preferredPath   = DescriptorPath::Push;
+        descriptorConfig.framesInFlight  = config.framesInFlight;
+        descriptorConfig.maxSetsPerFrame = 8;
+        if (result = mDescriptors.Initialize(context, descriptorConfig); !result) {
+            Shutdown();
+            return result;
+        }
+
+        const VkDescriptorSetLayout setLayout = mDescriptors.GetSetLayout();
+
+        VkPipelineLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts    = &setLayout;
+        if (vkCreatePipelineLayout(context->GetDevice(), &layoutInfo, nullptr, &mPipelineLayout) != VK_SUCCESS) {
+            Shutdown();
+            return std::unexpected("Failed to create culling pipeline layout");
+        }
+
+        const char* layoutName = config.occlusion ? kOcclusionLayoutName : kLayoutName;
+        compiler->RegisterLayout(layoutName, mPipelineLayout);
+
+        ComputePipelineDesc desc;
+        desc.stage.shader = config.occlusion ? "CullInstancesHiZ.comp" : "CullInstances.comp";
+        desc.layout       = layoutName;
+
+        auto pipelineResult = compiler->Get(desc);
+        if (!pipelineResult) {
+            Shutdown();
+            return std::unexpected(pipelineResult.error());
+        }
+        mPipeline = pipelineResult.value();
+
+        return {};
+    }
+
+    void GpuCulling::Shutdown() {
+        if (!mContext) { return; }
+
+        mDescriptors.Shutdown();
+        if (mPipelineLayout != VK_NULL_HANDLE) {
+            vkDestroyPipelineLayout(mContext->GetDevice(), mPipelineLayout, nullptr);
+        }
+        mUploads.Shutdown();
+        mReadback.Shutdown();
+        mCounts.Shutdown();
+        mCommands.Shutdown();
+        mMeshes.Shutdown();
+        mInstances.Shutdown();
+
+        mPipelineLayout = VK_NULL_HANDLE;
+        mPipeline       = VK_NULL_HANDLE;
+        mPendingCopies.clear();
+        mSubmitted.clear();
+        mStats   = {};
+        mContext = nullptr;
+    }
+
+    void GpuCulling::BeginFrame(const FrameSynchronizer& frames) {
+        if (!IsInitialized()) { return; }
+
+        // The fence wait in FrameSynchronizer::BeginFrame covers the count copy made by this slot's last Cull
+        const u32 frameIndex = frames.GetCurrentFrameIndex() % mConfig.framesInFlight;
+        mStats.submitted     = mSubmitted[frameIndex];
+        mStats.visible       = CAST<const u32*>(mReadback.GetMapped())[frameIndex];
+
+        mUploads.BeginFrame(frameIndex);
+        mDescriptors.BeginFrame(frameIndex);
+        mPendingCopies.clear();
+    }
+
+    Result<void> GpuCulling::UpdateInstances(u32 first, std::span<const GpuInstance> instances) {
+        if (CAST<u64>(first) + instances.size() > mConfig.maxInstances) {
+            return std::unexpected("Instance update out of range");
+        }
+        return Stage(mInstances, sizeof(GpuInstance) * first, instances.data(), instances.size_bytes());
+    }
+
+    Result<void> GpuCulling::UpdateMeshes(u32 first, std::span<const GpuMeshDraw> meshes) {
+        if (CAST<u64>(first) + meshes.size() > mConfig.maxMeshes) {
+            return std::unexpected("Mesh update out of range");
+        }
+        return Stage(mMeshes, sizeof(GpuMeshDraw) * first, meshes.data(), meshes.size_bytes());
+    }
+
+    Result<void>
+    GpuCulling::Stage(const Buffer& destination, VkDeviceSize offset, const void* data, VkDeviceSize size) {
+        if (!IsInitialized()) { return std::unexpected("GPU culling not initialized"); }
+
+        if (size == 0) { return {}; }
+
+        const auto staging = mUploads.Allocate(size);
+        if (!staging) { return std::unexpected("Upload space exhausted for this frame"); }
+
+        std::memcpy(staging.mapped, data, size);
+        mPendingCopies.push_back({destination.GetBuffer(), {staging.offset, offset, size}});
+        return {};
+    }
+
+    Result<void> GpuCulling::Cull(const FrameSynchronizer& frames, const View& view) {
+        if (!IsInitialized()) { return std::unexpected("GPU culling not initialized"); }
+
+        if (view.instanceCount > mConfig.maxInstances) { return std::unexpected("Instance count exceeds capacity"); }
+
+        const bool occlusion = mConfig.occlusion && view.pyramid && view.pyramid->IsInitialized();
+        if (mConfig.occlusion && !occlusion) { return std::unexpected("Occlusion culling needs a depth pyramid"); }
+
+        const VkCommandBuffer commandBuffer = frames.GetCurrentCommandBuffer();
+        const u32 frameIndex                = frames.GetCurrentFrameIndex() % mConfig.framesInFlight;
+
+        CullParams params {};
+        params.viewProjection = view.viewProjection;
+        const Frustum frustum = Frustum::FromViewProjection(view.viewProjection);
+        std::memcpy(params.planes, frustum.planes.data(), sizeof(params.planes));
+        params.pyramidSize[0] = occlusion ? CAST<f32>(view.pyramid->GetWidth()) : 0.0f;
+        params.pyramidSize[1] = occlusion ? CAST<f32>(view.pyramid->GetHeight()) : 0.0f;
+        params.instanceCount  = view.instanceCount;
+        params.frameSlot      = frameIndex;
+        params.commandOffset  = frameIndex * mConfig.maxInstances;
+        params.compact        = mDrawCount ? 1u : 0u;
+
+        const auto paramsAllocation = mUploads.Push(params);
+        if (!paramsAllocation) { return std::unexpected("Upload space exhausted for this frame"); }
+
+        // Previous frames' culling and vertex shader reads (earlier in submission order) must finish before
+        // instance and mesh data is overwritten
+        VkMemoryBarrier barrier {};
+        barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+
+        for (const auto& copy : mPendingCopies) {
+            vkCmdCopyBuffer(commandBuffer, mUploads.GetBuffer(), copy.destination, 1, &copy.region);
+        }
+        mPendingCopies.clear();
+        vkCmdFillBuffer(commandBuffer, mCounts.GetBuffer(), sizeof(u32) * frameIndex, sizeof(u32), 0);
+
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+
+        DescriptorWrite writes[6] = {
+          DescriptorWrite::ForBuffer(kParams, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, paramsAllocation),
+          DescriptorWrite::ForBuffer(kInstanceData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mInstances),
+          DescriptorWrite::ForBuffer(kMeshData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mMeshes),
+          DescriptorWrite::ForBuffer(kCommandData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mCommands),
+          DescriptorWrite::ForBuffer(kCountData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mCounts),
+          {},
+        };
+        size_t writeCount = 5;
+        if (occlusion) {
+            writes[writeCount++] = DescriptorWrite::ForImage(kPyramid,
+                                                             VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                                             view.pyramid->GetView(),
+                                                             VK_IMAGE_LAYOUT_GENERAL,
+                                                             view.pyramid->GetSampler());
+        }
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mPipeline);
+        if (auto result = mDescriptors.Bind(commandBuffer,
+                                            VK_PIPELINE_BIND_POINT_COMPUTE,
+                                            mPipelineLayout,
+                                            0,
+                                            std::span(writes, writeCount));
+            !result) {
+            return result;
+        }
+        vkCmdDispatch(commandBuffer, (view.instanceCount + kGroupSize - 1) / kGroupSize, 1, 1);
+
+        // Commands and count feed the draw; the count is also copied out for GetStats
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+
+        const VkBufferCopy countCopy {sizeof(u32) * frameIndex, sizeof(u32) * frameIndex, sizeof(u32)};
+        vkCmdCopyBuffer(commandBuffer, mCounts.GetBuffer(), mReadback.GetBuffer(), 1, &countCopy);
+
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_HOST_BIT,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+
+        mSubmitted[frameIndex] = view.instanceCount;
+        return {};
+    }
+
+    void GpuCulling::Draw(const FrameSynchronizer& frames) const {
+        if (!IsInitialized()) { return; }
+
+        const VkCommandBuffer commandBuffer = frames.GetCurrentCommandBuffer();
+        const u32 frameIndex                = frames.GetCurrentFrameIndex() % mConfig.framesInFlight;
+        const VkDeviceSize commandOffset =
+          sizeof(VkDrawIndexedIndirectCommand) * CAST<VkDeviceSize>(frameIndex) * mConfig.maxInstances;
+        constexpr u32 stride = sizeof(VkDrawIndexedIndirectCommand);
+
+        if (mDrawCount) {
+            vkCmdDrawIndexedIndirectCount(commandBuffer,
+                                          mCommands.GetBuffer(),
+                                          commandOffset,
+                                          mCounts.GetBuffer(),
+                                          sizeof(u32) * frameIndex,
+                                          mSubmitted[frameIndex],
+                                          stride);
+        } else if (mMultiDraw) {
+            // Not compacted: one command per instance, culled ones with instanceCount 0
+            vkCmdDrawIndexedIndirect(commandBuffer,
+                                     mCommands.GetBuffer(),
+                                     commandOffset,
+                                     mSubmitted[frameIndex],
+                                     stride);
+        } else {
+            for (u32 i = 0; i < mSubmitted[frameIndex]; i++) {
+                vkCmdDrawIndexedIndirect(commandBuffer, mCommands.GetBuffer(), commandOffset + i * stride, 1, stride);
+            }
+        }
+    }
+}  // namespace Vulkano
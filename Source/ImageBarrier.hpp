@@ -0,0 +1,49 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#pragma once
+
+#include "Types.hpp"
+
+namespace Vulkano {
+    /// @brief Aspects a depth attachment of the given format has to be transitioned with
+    inline VkImageAspectFlags DepthAspect(VkFormat format) {
+        switch (format) {
+            case VK_FORMAT_D16_UNORM_S8_UINT:
+            case VK_FORMAT_D24_UNORM_S8_UINT:
+            case VK_FORMAT_D32_SFLOAT_S8_UINT:
+                return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+            default:
+                return VK_IMAGE_ASPECT_DEPTH_BIT;
+        }
+    }
+
+    /// @brief Layout transition of the first mip of a range of array layers
+    inline void ImageBarrier(VkCommandBuffer commandBuffer,
+                             VkImage image,
+                             VkImageAspectFlags aspect,
+                             u32 baseLayer,
+                             u32 layers,
+                             VkImageLayout oldLayout,
+                             VkImageLayout newLayout,
+                             VkPipelineStageFlags srcStage,
+                             VkAccessFlags srcAccess,
+                             VkPipelineStageFlags dstStage,
+                             VkAccessFlags dstAccess) {
+        VkImageMemoryBarrier barrier {};
+        barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask                   = srcAccess;
+        barrier.dstAccessMask                   = dstAccess;
+        barrier.oldLayout                       = oldLayout;
+        barrier.newLayout                       = newLayout;
+        barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image                           = image;
+        barrier.subresourceRange.aspectMask     = aspect;
+        barrier.subresourceRange.levelCount     = 1;
+        barrier.subresourceRange.baseArrayLayer = baseLayer;
+        barrier.subresourceRange.layerCount     = layers;
+        vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+    }
+}  // namespace Vulkano
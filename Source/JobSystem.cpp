@@ -0,0 +1,145 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace Vulkano {
+    JobSystem::~JobSystem() {
+        Shutdown();
+    }
+
+    Result<void> JobSystem::Initialize(u32 threadCount) {
+        if (IsInitialized()) { return std::unexpected("Job system already initialized"); }
+
+        if (threadCount == 0) {
+            const u32 hardwareThreads = std::thread::hardware_concurrency();
+            threadCount               = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        mStopping = false;
+        try {
+            mWorkers.reserve(threadCount);
+            for (u32 i = 0; i < threadCount; i++) {
+                mWorkers.emplace_back([this] { WorkerLoop(); });
+            }
+        } catch (const std::system_error& e) {
+            Shutdown();
+            return std::unexpected(std::string("Failed to start worker threads: ") + e.what());
+        }
+
+        return {};
+    }
+
+    void JobSystem::Shutdown() {
+        {
+            std::lock_guard lock(mMutex);
+            mStopping = true;
+        }
+        mWorkAvailable.notify_all();
+
+        for (auto& worker : mWorkers) {
+            if (worker.joinable()) { worker.join(); }
+        }
+        mWorkers.clear();
+    }
+
+    JobHandle JobSystem::Submit(std::function<void()> job) {
+        std::packaged_task<void()> task(std::move(job));
+        JobHandle handle = task.get_future().share();
+
+        if (!IsInitialized()) {
+            task();
+            return handle;
+        }
+
+        {
+            std::lock_guard lock(mMutex);
+            mQueue.push_back(std::move(task));
+        }
+        mWorkAvailable.notify_one();
+
+        return handle;
+    }
+
+    void JobSystem::ParallelFor(u32 count, u32 chunkSize, const std::function<void(u32 begin, u32 end)>& fn) {
+        if (count == 0) { return; }
+
+        chunkSize            = std::max(chunkSize, 1u);
+        const u32 chunkCount = (count + chunkSize - 1) / chunkSize;
+
+        if (chunkCount == 1 || !IsInitialized()) {
+            fn(0, count);
+            return;
+        }
+
+        // Shared so helper jobs that start after the loop has finished can still touch it safely
+        struct LoopState {
+            std::atomic<u32> nextChunk {0};
+            std::atomic<u32> completedChunks {0};
+            std::mutex mutex;
+            std::condition_variable done;
+        };
+        auto state = std::make_shared<LoopState>();
+
+        // The callback is only invoked for claimed chunks, all of which finish before we return
+        auto runChunks = [state, &fn, count, chunkSize, chunkCount] {
+            for (;;) {
+                const u32 chunk = state->nextChunk.fetch_add(1, std::memory_order_relaxed);
+                if (chunk >= chunkCount) { return; }
+
+                const u32 begin = chunk * chunkSize;
+                fn(begin, std::min(begin + chunkSize, count));
+
+                if (state->completedChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == chunkCount) {
+                    std::lock_guard lock(state->mutex);
+                    state->done.notify_all();
+                }
+            }
+        };
+
+        const u32 helperCount = std::min(GetThreadCount(), chunkCount - 1);
+        for (u32 i = 0; i < helperCount; i++) {
+            Submit(runChunks);
+        }
+
+        runChunks();
+
+        std::unique_lock lock(state->mutex);
+        state->done.wait(lock, [&] { return state->completedChunks.load(std::memory_order_acquire) == chunkCount; });
+    }
+
+    void JobSystem::WaitIdle() {
+        std::unique_lock lock(mMutex);
+        mIdle.wait(lock, [this] { return mQueue.empty() && mActiveJobs == 0; });
+    }
+
+    void JobSystem::WorkerLoop() {
+        for (;;) {
+            std::packaged_task<void()> task;
+            {
+                std::unique_lock lock(mMutex);
+                mWorkAvailable.wait(lock, [this] { return mStopping || !mQueue.empty(); });
+
+                // Drain remaining work before exiting so no handle is left unresolved
+                if (mQueue.empty()) { return; }
+
+                task = std::move(mQueue.front());
+                mQueue.pop_front();
+                mActiveJobs++;
+            }
+
+            task();
+
+            {
+                std::lock_guard lock(mMutex);
+                mActiveJobs--;
+                if (mQueue.empty() && mActiveJobs == 0) { mIdle.notify_all(); }
+            }
+        }
+    }
+}  // namespace Vulkano
@@ -0,0 +1,544 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "MeshProcessing.hpp"
+#include "Hash.hpp"
+#include "Serialization.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace Vulkano {
+    namespace {
+        /// @brief Hash and compare source vertices by their bytes
+        struct VertexBytesHash {
+            size_t operator()(const SourceVertex& vertex) const {
+                return CAST<size_t>(Hasher().Bytes(&vertex, sizeof(vertex)).Get());
+            }
+        };
+
+        struct VertexBytesEqual {
+            bool operator()(const SourceVertex& a, const SourceVertex& b) const {
+                return std::memcmp(&a, &b, sizeof(SourceVertex)) == 0;
+            }
+        };
+
+        // Forsyth's scoring constants; the cache is modelled as LRU slightly larger than real hardware FIFOs
+        constexpr u32 kForsythCacheSize  = 32;
+        constexpr f32 kCacheDecayPower   = 1.5f;
+        constexpr f32 kLastTriangleScore = 0.75f;
+        constexpr f32 kValenceBoostScale = 2.0f;
+        constexpr f32 kValenceBoostPower = 0.5f;
+
+        f32 VertexScore(i32 cachePosition, u32 remainingTriangles) {
+            if (remainingTriangles == 0) { return -1.0f; }
+
+            f32 score = 0.0f;
+            if (cachePosition >= 0) {
+                if (cachePosition < 3) {
+                    // The last triangle's vertices get a fixed score so its neighbours aren't favoured over it
+                    score = kLastTriangleScore;
+                } else {
+                    const f32 scale = 1.0f / CAST<f32>(kForsythCacheSize - 3);
+                    score           = std::pow(1.0f - CAST<f32>(cachePosition - 3) * scale, kCacheDecayPower);
+                }
+            }
+
+            // Favour vertices with few triangles left so they leave the working set quickly
+            score += kValenceBoostScale * std::pow(CAST<f32>(remainingTriangles), -kValenceBoostPower);
+            return score;
+        }
+
+        i16 ToSnorm16(f32 value) {
+            return CAST<i16>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+        }
+        /// @brief Bounding sphere (around the box centre) and normal cone of one meshlet
+        MeshletBounds ComputeMeshletBounds(const Meshlet& meshlet,
+                                           const MeshletData& data,
+                                           std::span<const SourceVertex> vertices) {
+            const auto position = [&](u32 entry) {
+                return vertices[data.vertices[meshlet.vertexOffset + entry]].position;
+            };
+
+            f32 boundsMin[3] = {position(0)[0], position(0)[1], position(0)[2]};
+            f32 boundsMax[3] = {boundsMin[0], boundsMin[1], boundsMin[2]};
+            for (u32 i = 1; i < meshlet.vertexCount; i++) {
+                for (u32 axis = 0; axis < 3; axis++) {
+                    boundsMin[axis] = std::min(boundsMin[axis], position(i)[axis]);
+                    boundsMax[axis] = std::max(boundsMax[axis], position(i)[axis]);
+                }
+            }
+
+            MeshletBounds bounds;
+            for (u32 axis = 0; axis < 3; axis++) {
+                bounds.center[axis] = (boundsMin[axis] + boundsMax[axis]) * 0.5f;
+            }
+            for (u32 i = 0; i < meshlet.vertexCount; i++) {
+                const f32* p  = position(i);
+                const f32 dx  = p[0] - bounds.center[0];
+                const f32 dy  = p[1] - bounds.center[1];
+                const f32 dz  = p[2] - bounds.center[2];
+                bounds.radius = std::max(bounds.radius, std::sqrt(dx * dx + dy * dy + dz * dz));
+            }
+
+            // Unit triangle normals; degenerate triangles face nowhere and are left out
+            std::array<std::array<f32, 3>, kMaxMeshletTriangles> normals {};
+            u32 normalCount = 0;
+            f32 axis[3]     = {0.0f, 0.0f, 0.0f};
+            for (u32 t = 0; t < meshlet.triangleCount; t++) {
+                const u8* corners = &data.triangles[meshlet.triangleOffset + t * 3];
+                const f32* a      = position(corners[0]);
+                const f32* b      = position(corners[1]);
+                const f32* c      = position(corners[2]);
+                const f32 e1[3]   = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+                const f32 e2[3]   = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+                const f32 n[3]    = {e1[1] * e2[2] - e1[2] * e2[1],
+                                     e1[2] * e2[0] - e1[0] * e2[2],
+                                     e1[0] * e2[1] - e1[1] * e2[0]};
+                const f32 length  = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                if (length <= 0.0f) { continue; }
+
+                auto& normal = normals[normalCount++];
+                for (u32 i = 0; i < 3; i++) {
+                    normal[i] = n[i] / length;
+                    axis[i] += normal[i];
+                }
+            }
+
+            const f32 axisLength = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+            if (normalCount == 0 || axisLength <= 0.0f) { return bounds; }
+            for (u32 i = 0; i < 3; i++) {
+                bounds.coneAxis[i] = axis[i] / axisLength;
+            }
+
+            f32 minDot = 1.0f;
+            for (u32 t = 0; t < normalCount; t++) {
+                const auto& n    = normals[t];
+                const f32 cosine = n[0] * bounds.coneAxis[0] + n[1] * bounds.coneAxis[1] + n[2] * bounds.coneAxis[2];
+                minDot           = std::min(minDot, cosine);
+            }
+
+            // Past ~84 degrees the cone would almost never cull, so leave it disabled. Otherwise the backfacing
+            // region is the normal cone widened by 90 degrees and mirrored: cutoff = cos(angle + 90) negated.
+            if (minDot > 0.1f) { bounds.coneCutoff = std::sqrt(1.0f - minDot * minDot); }
+            return bounds;
+        }
+    }  // namespace
+
+    std::array<VkVertexInputAttributeDescription, 3> PackedVertex::GetAttributes(u32 binding) {
+        return {{
+          {0, binding, VK_FORMAT_R16G16B16A16_SNORM, CAST<u32>(offsetof(PackedVertex, position))},
+          {1, binding, VK_FORMAT_R16G16_SNORM, CAST<u32>(offsetof(PackedVertex, normal))},
+          {2, binding, VK_FORMAT_R16G16_SFLOAT, CAST<u32>(offsetof(PackedVertex, uv))},
+        }};
+    }
+
+    Result<void> ProcessedMesh::Save(const std::filesystem::path& path) const {
+        BinaryWriter writer;
+        writer.Write(kMagic);
+        writer.Write(kVersion);
+        writer.Write(positionOffset);
+        writer.Write(positionScale);
+        writer.WriteVector(vertices);
+        writer.WriteVector(indices);
+        writer.WriteVector(meshlets.meshlets);
+        writer.WriteVector(meshlets.bounds);
+        writer.WriteVector(meshlets.vertices);
+        writer.WriteVector(meshlets.triangles);
+        return writer.SaveToFile(path);
+    }
+
+    Result<ProcessedMesh> ProcessedMesh::Load(const std::filesystem::path& path) {
+        auto fileResult = BinaryReader::LoadFile(path);
+        if (!fileResult) { return std::unexpected(fileResult.error()); }
+
+        BinaryReader reader(fileResult.value());
+
+        u32 magic   = 0;
+        u32 version = 0;
+        if (!reader.Read(magic) || !reader.Read(version)) {
+            return std::unexpected("Mesh is truncated: " + path.string());
+        }
+        if (magic != kMagic) { return std::unexpected("Not a baked mesh: " + path.string()); }
+        if (version != kVersion) { return std::unexpected("Unsupported baked mesh version: " + path.string()); }
+
+        ProcessedMesh mesh;
+        if (!reader.Read(mesh.positionOffset) || !reader.Read(mesh.positionScale) ||
+            !reader.ReadVector(mesh.vertices) || !reader.ReadVector(mesh.indices) ||
+            !reader.ReadVector(mesh.meshlets.meshlets) || !reader.ReadVector(mesh.meshlets.bounds) ||
+            !reader.ReadVector(mesh.meshlets.vertices) || !reader.ReadVector(mesh.meshlets.triangles)) {
+            return std::unexpected("Mesh is truncated: " + path.string());
+        }
+
+        for (const u32 index : mesh.indices) {
+            if (index >= mesh.vertices.size()) { return std::unexpected("Mesh is corrupt: " + path.string()); }
+        }
+
+        const MeshletData& meshlets = mesh.meshlets;
+        bool meshletsValid          = meshlets.bounds.size() == meshlets.meshlets.size();
+        for (const Meshlet& meshlet : meshlets.meshlets) {
+            meshletsValid &= meshlet.vertexCount <= kMaxMeshletVertices &&
+                             meshlet.triangleCount <= kMaxMeshletTriangles &&
+                             CAST<u64>(meshlet.vertexOffset) + meshlet.vertexCount <= meshlets.vertices.size() &&
+                             CAST<u64>(meshlet.triangleOffset) + meshlet.triangleCount * 3 <= meshlets.triangles.size();
+        }
+        for (const u32 index : meshlets.vertices) {
+            meshletsValid &= index < mesh.vertices.size();
+        }
+        if (!meshletsValid) { return std::unexpected("Mesh is corrupt: " + path.string()); }
+
+        mesh.report.triangles = CAST<u32>(mesh.indices.size() / 3);
+        mesh.report.vertices  = CAST<u32>(mesh.vertices.size());
+        mesh.report.meshlets  = CAST<u32>(meshlets.meshlets.size());
+        return mesh;
+    }
+
+    Result<ProcessedMesh> ProcessMesh(std::span<const SourceVertex> vertices,
+                                      std::span<const u32> indices,
+                                      const MeshProcessOptions& options) {
+        const size_t indexCount = indices.empty() ? vertices.size() : indices.size();
+        if (vertices.empty() || indexCount % 3 != 0) {
+            return std::unexpected("Mesh must be a non-empty triangle list");
+        }
+        for (const u32 index : indices) {
+            if (index >= vertices.size()) { return std::unexpected("Mesh index out of range"); }
+        }
+
+        ProcessedMesh mesh;
+        MeshReport& report    = mesh.report;
+        report.triangles      = CAST<u32>(indexCount / 3);
+        report.sourceVertices = CAST<u32>(vertices.size());
+        report.bytesBefore    = vertices.size_bytes() + indices.size_bytes();
+
+        // Unindexed input runs the vertex shader once per corner
+        report.invocationsBefore =
+          indices.empty() ? CAST<u32>(indexCount) : SimulateVertexCache(indices, options.simulatedCacheSize);
+
+        std::vector<SourceVertex> working;
+        std::vector<u32> workingIndices;
+        if (options.weld) {
+            WeldVertices(vertices, indices, working, workingIndices);
+        } else {
+            working.assign(vertices.begin(), vertices.end());
+            if (indices.empty()) {
+                workingIndices.resize(indexCount);
+                for (u32 i = 0; i < indexCount; i++) {
+                    workingIndices[i] = i;
+                }
+            } else {
+                workingIndices.assign(indices.begin(), indices.end());
+            }
+        }
+
+        if (options.optimizeCache) { OptimizeVertexCache(workingIndices, CAST<u32>(working.size())); }
+        if (options.optimizeFetch) { OptimizeVertexFetch(workingIndices, working); }
+        if (options.buildMeshlets) { mesh.meshlets = BuildMeshlets(workingIndices, working); }
+
+        // Quantize positions to the bounds, centred so SNORM covers the full extent on every axis
+        f32 boundsMin[3] = {working[0].position[0], working[0].position[1], working[0].position[2]};
+        f32 boundsMax[3] = {boundsMin[0], boundsMin[1], boundsMin[2]};
+        for (const auto& vertex : working) {
+            for (u32 axis = 0; axis < 3; axis++) {
+                boundsMin[axis] = std::min(boundsMin[axis], vertex.position[axis]);
+                boundsMax[axis] = std::max(boundsMax[axis], vertex.position[axis]);
+            }
+        }
+        for (u32 axis = 0; axis < 3; axis++) {
+            const f32 halfExtent      = (boundsMax[axis] - boundsMin[axis]) * 0.5f;
+            mesh.positionOffset[axis] = (boundsMax[axis] + boundsMin[axis]) * 0.5f;
+            mesh.positionScale[axis]  = halfExtent > 0.0f ? halfExtent : 1.0f;
+        }
+
+        mesh.vertices.resize(working.size());
+        for (size_t i = 0; i < working.size(); i++) {
+            const SourceVertex& source = working[i];
+            PackedVertex& packed       = mesh.vertices[i];
+            for (u32 axis = 0; axis < 3; axis++) {
+                packed.position[axis] =
+                  ToSnorm16((source.position[axis] - mesh.positionOffset[axis]) / mesh.positionScale[axis]);
+            }
+            EncodeOctahedral(source.normal, packed.normal);
+            packed.uv[0] = FloatToHalf(source.uv[0]);
+            packed.uv[1] = FloatToHalf(source.uv[1]);
+        }
+        mesh.indices = std::move(workingIndices);
+
+        report.vertices         = CAST<u32>(mesh.vertices.size());
+        report.meshlets         = CAST<u32>(mesh.meshlets.meshlets.size());
+        report.invocationsAfter = SimulateVertexCache(mesh.indices, options.simulatedCacheSize);
+        report.bytesAfter       = mesh.vertices.size() * sizeof(PackedVertex) + mesh.indices.size() * sizeof(u32);
+        return mesh;
+    }
+
+    void WeldVertices(std::span<const SourceVertex> vertices,
+                      std::span<const u32> indices,
+                      std::vector<SourceVertex>& outVertices,
+                      std::vector<u32>& outIndices) {
+        const size_t indexCount = indices.empty() ? vertices.size() : indices.size();
+
+        std::unordered_map<SourceVertex, u32, VertexBytesHash, VertexBytesEqual> unique;
+        unique.reserve(vertices.size());
+        outVertices.clear();
+        outIndices.resize(indexCount);
+
+        for (size_t i = 0; i < indexCount; i++) {
+            const SourceVertex& vertex = vertices[indices.empty() ? i : indices[i]];
+            const auto [it, inserted]  = unique.try_emplace(vertex, CAST<u32>(outVertices.size()));
+            if (inserted) { outVertices.push_back(vertex); }
+            outIndices[i] = it->second;
+        }
+    }
+
+    void OptimizeVertexCache(std::span<u32> indices, u32 vertexCount) {
+        constexpr u32 kNone = ~0u;
+
+        const u32 triangleCount = CAST<u32>(indices.size() / 3);
+        if (triangleCount == 0 || vertexCount == 0) { return; }
+
+        // Triangles touching each vertex, as ranges into one array. remaining[v] is the live prefix of v's range.
+        std::vector<u32> remaining(vertexCount, 0);
+        for (const u32 index : indices) {
+            remaining[index]++;
+        }
+
+        std::vector<u32> firstTriangle(vertexCount + 1, 0);
+        for (u32 v = 0; v < vertexCount; v++) {
+            firstTriangle[v + 1] = firstTriangle[v] + remaining[v];
+        }
+
+        std::vector<u32> triangles(indices.size());
+        std::vector<u32> cursor(firstTriangle.begin(), firstTriangle.end() - 1);
+        for (u32 t = 0; t < triangleCount; t++) {
+            for (u32 corner = 0; corner < 3; corner++) {
+                triangles[cursor[indices[t * 3 + corner]]++] = t;
+            }
+        }
+
+        std::vector<i32> cachePosition(vertexCount, -1);
+        std::vector<f32> vertexScore(vertexCount);
+        for (u32 v = 0; v < vertexCount; v++) {
+            vertexScore[v] = VertexScore(-1, remaining[v]);
+        }
+
+        std::vector<f32> triangleScore(triangleCount);
+        std::vector<u8> emitted(triangleCount, 0);
+        for (u32 t = 0; t < triangleCount; t++) {
+            triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] +
+                               vertexScore[indices[t * 3 + 2]];
+        }
+
+        std::vector<u32> output;
+        output.reserve(indices.size());
+
+        u32 cache[kForsythCacheSize + 3];
+        u32 cacheCount = 0;
+        u32 scanCursor = 0;
+        u32 best = CAST<u32>(std::max_element(triangleScore.begin(), triangleScore.end()) - triangleScore.begin());
+
+        for (u32 emittedCount = 0; emittedCount < triangleCount; emittedCount++) {
+            if (best == kNone) {
+                // Nothing adjacent to the cache is left; restart from the next unemitted triangle
+                while (emitted[scanCursor]) {
+                    scanCursor++;
+                }
+                best = scanCursor;
+            }
+
+            const u32 corners[3] = {indices[best * 3], indices[best * 3 + 1], indices[best * 3 + 2]};
+            output.insert(output.end(), corners, corners + 3);
+            emitted[best] = 1;
+
+            // Drop the triangle from each corner's live range
+            for (const u32 v : corners) {
+                u32* begin = triangles.data() + firstTriangle[v];
+                u32* end   = begin + remaining[v];
+                std::iter_swap(std::find(begin, end, best), end - 1);
+                remaining[v]--;
+            }
+
+            // New LRU order: this triangle's corners first, then the previous entries that aren't among them
+            u32 newCache[kForsythCacheSize + 3];
+            u32 newCount = 0;
+            for (const u32 v : corners) {
+                newCache[newCount++] = v;
+            }
+            for (u32 i = 0; i < cacheCount; i++) {
+                const u32 v = cache[i];
+                if (v == corners[0] || v == corners[1] || v == corners[2]) { continue; }
+                newCache[newCount++] = v;
+            }
+
+            for (u32 i = 0; i < newCount; i++) {
+                const u32 v      = newCache[i];
+                cachePosition[v] = i < kForsythCacheSize ? CAST<i32>(i) : -1;
+                vertexScore[v]   = VertexScore(cachePosition[v], remaining[v]);
+            }
+
+            // Rescore triangles around everything that moved and pick the best of them
+            best          = kNone;
+            f32 bestScore = -1.0f;
+            for (u32 i = 0; i < newCount; i++) {
+                const u32 v = newCache[i];
+                for (u32 j = firstTriangle[v]; j < firstTriangle[v] + remaining[v]; j++) {
+                    const u32 t     = triangles[j];
+                    const f32 score = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] +
+                                      vertexScore[indices[t * 3 + 2]];
+                    triangleScore[t] = score;
+                    if (score > bestScore) {
+                        bestScore = score;
+                        best      = t;
+                    }
+                }
+            }
+
+            cacheCount = std::min(newCount, kForsythCacheSize);
+            std::copy(newCache, newCache + cacheCount, cache);
+        }
+
+        std::copy(output.begin(), output.end(), indices.begin());
+    }
+
+    void OptimizeVertexFetch(std::span<u32> indices, std::vector<SourceVertex>& vertices) {
+        constexpr u32 kUnassigned = ~0u;
+
+        std::vector<u32> remap(vertices.size(), kUnassigned);
+        std::vector<SourceVertex> reordered;
+        reordered.reserve(vertices.size());
+
+        for (u32& index : indices) {
+            if (remap[index] == kUnassigned) {
+                remap[index] = CAST<u32>(reordered.size());
+                reordered.push_back(vertices[index]);
+            }
+            index = remap[index];
+        }
+
+        vertices = std::move(reordered);
+    }
+
+    MeshletData BuildMeshlets(std::span<const u32> indices, std::span<const SourceVertex> vertices) {
+        constexpr u8 kNotInMeshlet = 0xFF;
+
+        MeshletData data;
+        if (indices.size() < 3) { return data; }
+
+        // Meshlet-local index of every vertex in the meshlet being filled
+        std::vector<u8> local(vertices.size(), kNotInMeshlet);
+        Meshlet current;
+
+        const auto finish = [&] {
+            if (current.triangleCount == 0) { return; }
+            for (u32 i = 0; i < current.vertexCount; i++) {
+                local[data.vertices[current.vertexOffset + i]] = kNotInMeshlet;
+            }
+            // Keep every meshlet's triangles 4-byte aligned so shaders can read them as words
+            data.triangles.resize((data.triangles.size() + 3) & ~size_t {3}, 0);
+            data.bounds.push_back(ComputeMeshletBounds(current, data, vertices));
+            data.meshlets.push_back(current);
+
+            current                = {};
+            current.vertexOffset   = CAST<u32>(data.vertices.size());
+            current.triangleOffset = CAST<u32>(data.triangles.size());
+        };
+
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            const u32 corners[3] = {indices[i], indices[i + 1], indices[i + 2]};
+
+            u32 newVertices = 0;
+            for (u32 c = 0; c < 3; c++) {
+                // A repeated corner (degenerate triangle) only needs one slot
+                const bool repeated = (c > 0 && corners[c] == corners[0]) || (c > 1 && corners[c] == corners[1]);
+                if (local[corners[c]] == kNotInMeshlet && !repeated) { newVertices++; }
+            }
+            if (current.vertexCount + newVertices > kMaxMeshletVertices ||
+                current.triangleCount == kMaxMeshletTriangles) {
+                finish();
+            }
+
+            for (const u32 vertex : corners) {
+                if (local[vertex] == kNotInMeshlet) {
+                    local[vertex] = CAST<u8>(current.vertexCount++);
+                    data.vertices.push_back(vertex);
+                }
+                data.triangles.push_back(local[vertex]);
+            }
+            current.triangleCount++;
+        }
+        finish();
+
+        return data;
+    }
+
+    u32 SimulateVertexCache(std::span<const u32> indices, u32 cacheSize) {
+        if (indices.empty()) { return 0; }
+
+        // A vertex is still cached if fewer than cacheSize misses happened since it was last loaded
+        const u32 vertexCount = *std::max_element(indices.begin(), indices.end()) + 1;
+        std::vector<u32> loadedAt(vertexCount, 0);
+        std::vector<u8> seen(vertexCount, 0);
+
+        u32 misses = 0;
+        for (const u32 index : indices) {
+            if (seen[index] && misses - loadedAt[index] < cacheSize) { continue; }
+            seen[index]     = 1;
+            loadedAt[index] = misses;
+            misses++;
+        }
+        return misses;
+    }
+
+    void EncodeOctahedral(const f32 normal[3], i16 out[2]) {
+        const f32 length = std::abs(normal[0]) + std::abs(normal[1]) + std::abs(normal[2]);
+        if (length == 0.0f) {
+            out[0] = 0;
+            out[1] = 0;
+            return;
+        }
+
+        f32 x = normal[0] / length;
+        f32 y = normal[1] / length;
+        if (normal[2] < 0.0f) {
+            // Fold the lower hemisphere over the diagonals
+            const f32 foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+            const f32 foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+            x                 = foldedX;
+            y                 = foldedY;
+        }
+
+        out[0] = ToSnorm16(x);
+        out[1] = ToSnorm16(y);
+    }
+
+    u16 FloatToHalf(f32 value) {
+        const u32 bits     = std::bit_cast<u32>(value);
+        const u32 sign     = (bits >> 16) & 0x8000u;
+        const u32 exponent = (bits >> 23) & 0xFFu;
+        u32 mantissa       = bits & 0x7FFFFFu;
+
+        if (exponent == 0xFFu) { return CAST<u16>(sign | 0x7C00u | (mantissa != 0 ? 0x200u : 0u)); }  // Inf/NaN
+
+        const i32 halfExponent = CAST<i32>(exponent) - 127 + 15;
+        if (halfExponent >= 0x1F) { return CAST<u16>(sign | 0x7C00u); }  // Overflow to infinity
+
+        if (halfExponent <= 0) {
+            // Subnormal half (or zero): shift the implicit bit in and round
+            if (halfExponent < -10) { return CAST<u16>(sign); }
+            mantissa |= 0x800000u;
+            const u32 shift   = CAST<u32>(14 - halfExponent);
+            u32 half          = mantissa >> shift;
+            const u32 rest    = mantissa & ((1u << shift) - 1u);
+            const u32 halfway = 1u << (shift - 1);
+            if (rest > halfway || (rest == halfway && (half & 1u))) { half++; }
+            return CAST<u16>(sign | half);
+        }
+
+        u32 half       = sign | (CAST<u32>(halfExponent) << 10) | (mantissa >> 13);
+        const u32 rest = mantissa & 0x1FFFu;
+        if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) { half++; }  // May carry into the exponent; fine
+        return CAST<u16>(half);
+    }
+}  // namespace Vulkano
@@ -0,0 +1,479 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "MeshletRenderer.hpp"
+#include "FrameSynchronizer.hpp"
+#include "PipelineCompiler.hpp"
+#include "VulkanContext.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Vulkano {
+    namespace {
+        constexpr u32 kTaskGroupSize {32};  // Meshlets per task workgroup (MeshletCommon.glsl)
+        constexpr u32 kCullFrustum {1u};
+        constexpr u32 kCullCone {2u};
+
+        constexpr const char* kMeshLayoutName {"Vulkano.MeshletRenderer"};
+        constexpr const char* kFallbackLayoutName {"Vulkano.MeshletRenderer.Fallback"};
+
+        enum Binding : u32 {
+            kParams,
+            kInstanceData,
+            kMeshData,
+            kMeshletData,
+            kBoundsData,
+            kMeshletVertexData,
+            kMeshletTriangleData,
+            kVertexData,
+        };
+    }  // namespace
+
+    MeshletRenderer::~MeshletRenderer() {
+        Shutdown();
+    }
+
+    Result<void> MeshletRenderer::Initialize(VulkanContext* context,
+                                             PipelineCompiler* compiler,
+                                             GeometryArena* arena,
+                                             const Config& config) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (!compiler || !compiler->IsInitialized()) { return std::unexpected("Invalid or uninitialized compiler"); }
+
+        if (!arena || !arena->IsInitialized()) { return std::unexpected("Invalid or uninitialized geometry arena"); }
+
+        if (IsInitialized()) { return std::unexpected("Meshlet renderer already created"); }
+
+        if (config.maxMeshes == 0 || config.maxMeshlets == 0 || config.maxInstances == 0 ||
+            config.framesInFlight == 0) {
+            return std::unexpected("Mesh, meshlet, instance and frame counts must be greater than zero");
+        }
+
+        const auto& capabilities = context->GetCapabilities();
+        if (!capabilities.drawIndirectFirstInstance) {
+            return std::unexpected("Meshlet renderer needs the drawIndirectFirstInstance feature");
+        }
+
+        mContext   = context;
+        mArena     = arena;
+        mConfig    = config;
+        mPath      = config.allowMeshShaders && capabilities.meshShaders ? Path::MeshShader : Path::MultiDrawIndirect;
+        mMultiDraw = capabilities.multiDrawIndirect;
+        mStages    = mPath == Path::MeshShader ? VK_SHADER_STAGE_TASK_BIT_EXT | VK_SHADER_STAGE_MESH_BIT_EXT
+                                               : VK_SHADER_STAGE_VERTEX_BIT;
+
+        const auto createBuffer = [context](Buffer& buffer, VkDeviceSize size) {
+            Buffer::Config bufferConfig;
+            bufferConfig.size  = size;
+            bufferConfig.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            return buffer.Initialize(context, bufferConfig);
+        };
+
+        Result<void> result = createBuffer(mInstances, sizeof(MeshletInstance) * config.maxInstances);
+        if (result) { result = createBuffer(mMeshes, sizeof(GpuMesh) * config.maxMeshes); }
+        if (result && mPath == Path::MeshShader) {
+            const VkDeviceSize meshlets = config.maxMeshlets;
+            result                      = createBuffer(mMeshlets, sizeof(Meshlet) * meshlets);
+            if (result) { result = createBuffer(mBounds, sizeof(MeshletBounds) * meshlets); }
+            if (result) { result = createBuffer(mMeshletVertices, sizeof(u32) * kMaxMeshletVertices * meshlets); }
+            if (result) { result = createBuffer(mMeshletTriangles, (kMaxMeshletTriangles * 3 + 3) / 4 * 4 * meshlets); }
+        }
+        if (result) {
+            result = mUploads.Initialize(context,
+                                         config.uploadBytesPerFrame,
+                                         config.framesInFlight,
+                                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+                                           VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+        }
+        if (!result) {
+            Shutdown();
+            return result;
+        }
+
+        DescriptorStream::Config descriptorConfig;
+        descriptorConfig.bindings = {{kParams, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, mStages},
+                                     {kInstanceData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mStages},
+                                     {kMeshData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mStages}};
+        if (mPath == Path::MeshShader) {
+            for (const u32 binding :
+                 {kMeshletData, kBoundsData, kMeshletVertexData, kMeshletTriangleData, kVertexData}) {
+                descriptorConfig.bindings.push_back({binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mStages});
+            }
+        }
+        descriptorConfig.preferredPath   = DescriptorPath::Push;
+        descriptorConfig.framesInFlight  = config.framesInFlight;
+        descriptorConfig.maxSetsPerFrame = 8;
+        if (result = mDescriptors.Initialize(context, descriptorConfig); !result) {
+            Shutdown();
+            return result;
+        }
+
+        if (result = CreatePipeline(compiler); !result) {
+            Shutdown();
+            return result;
+        }
+
+        mArenaGeneration = arena->GetGeneration();
+        return {};
+    }
+
+    Result<void> MeshletRenderer::CreatePipeline(PipelineCompiler* compiler) {
+        const VkDescriptorSetLayout setLayout = mDescriptors.GetSetLayout();
+        const VkPushConstantRange pushRange {mStages, 0, sizeof(DrawConstants)};
+
+        VkPipelineLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount         = 1;
+        layoutInfo.pSetLayouts            = &setLayout;
+        layoutInfo.pushConstantRangeCount = mPath == Path::MeshShader ? 1 : 0;
+        layoutInfo.pPushConstantRanges    = &pushRange;
+        if (vkCreatePipelineLayout(mContext->GetDevice(), &layoutInfo, nullptr, &mPipelineLayout) != VK_SUCCESS) {
+            return std::unexpected("Failed to create meshlet pipeline layout");
+        }
+
+        GraphicsPipelineDesc desc;
+        if (mPath == Path::MeshShader) {
+            desc.layout = kMeshLayoutName;
+            desc.stages = {{VK_SHADER_STAGE_TASK_BIT_EXT, "Meshlet.task", "main", {}},
+                           {VK_SHADER_STAGE_MESH_BIT_EXT, "Meshlet.mesh", "main", {}},
+                           {VK_SHADER_STAGE_FRAGMENT_BIT, "Meshlet.frag", "main", {}}};
+        } else {
+            const auto attributes = PackedVertex::GetAttributes(0);
+            desc.layout           = kFallbackLayoutName;
+            desc.stages           = {{VK_SHADER_STAGE_VERTEX_BIT, "MeshletFallback.vert", "main", {}},
+                                     {VK_SHADER_STAGE_FRAGMENT_BIT, "Meshlet.frag", "main", {}}};
+            desc.vertexBindings   = {{0, sizeof(PackedVertex), VK_VERTEX_INPUT_RATE_VERTEX}};
+            desc.vertexAttributes.assign(attributes.begin(), attributes.end());
+        }
+        desc.cullMode     = VK_CULL_MODE_BACK_BIT;
+        desc.frontFace    = mConfig.frontFace;
+        desc.depthTest    = mConfig.depthFormat != VK_FORMAT_UNDEFINED;
+        desc.depthWrite   = desc.depthTest;
+        desc.colorFormats = {mConfig.colorFormat};
+        desc.depthFormat  = mConfig.depthFormat;
+        compiler->RegisterLayout(desc.layout, mPipelineLayout);
+
+        auto pipelineResult = compiler->Get(desc);
+        if (!pipelineResult) { return std::unexpected(pipelineResult.error()); }
+        mPipeline = pipelineResult.value();
+
+        return {};
+    }
+
+    void MeshletRenderer::Shutdown() {
+        if (!mContext) { return; }
+
+        mDescriptors.Shutdown();
+        if (mPipelineLayout != VK_NULL_HANDLE) {
+            vkDestroyPipelineLayout(mContext->GetDevice(), mPipelineLayout, nullptr);
+        }
+        mUploads.Shutdown();
+        mMeshletTriangles.Shutdown();
+        mMeshletVertices.Shutdown();
+        mBounds.Shutdown();
+        mMeshlets.Shutdown();
+        mMeshes.Shutdown();
+        mInstances.Shutdown();
+
+        mPipelineLayout = VK_NULL_HANDLE;
+        mPipeline       = VK_NULL_HANDLE;
+        mSlots.clear();
+        mPendingCopies.clear();
+        mMeshletCount         = 0;
+        mMeshletVertexCount   = 0;
+        mMeshletTriangleBytes = 0;
+        mParams               = {};
+        mStats                = {};
+        mArena                = nullptr;
+        mContext              = nullptr;
+    }
+
+    void MeshletRenderer::BeginFrame(const FrameSynchronizer& frames) {
+        if (!IsInitialized()) { return; }
+
+        const u32 frameIndex = frames.GetCurrentFrameIndex() % mConfig.framesInFlight;
+        mUploads.BeginFrame(frameIndex);
+        mDescriptors.BeginFrame(frameIndex);
+        mPendingCopies.clear();
+        mParams = {};
+    }
+
+    Result<u32> MeshletRenderer::AddMesh(const ProcessedMesh& mesh) {
+        if (!IsInitialized()) { return std::unexpected("Meshlet renderer not initialized"); }
+
+        const MeshletData& data = mesh.meshlets;
+        if (data.meshlets.empty()) {
+            return std::unexpected("Mesh has no meshlets (process it with MeshProcessOptions::buildMeshlets)");
+        }
+        if (mSlots.size() == mConfig.maxMeshes) { return std::unexpected("Meshlet renderer mesh capacity reached"); }
+
+        const u32 meshletCount = CAST<u32>(data.meshlets.size());
+        if (CAST<u64>(mMeshletCount) + meshletCount > mConfig.maxMeshlets) {
+            return std::unexpected("Meshlet renderer meshlet capacity reached");
+        }
+
+        auto arenaMesh = mesh.Upload(*mArena);
+        if (!arenaMesh) { return std::unexpected(arenaMesh.error()); }
+
+        const MeshRange* range = mArena->GetMesh(arenaMesh.value());
+
+        MeshSlot slot {};
+        slot.arenaMesh          = arenaMesh.value();
+        slot.triangles          = CAST<u32>(mesh.indices.size() / 3);
+        slot.gpu.meshletOffset  = mMeshletCount;
+        slot.gpu.meshletCount   = meshletCount;
+        slot.gpu.vertexOffset   = range->vertexOffset;
+        slot.gpu.positionOffset = {mesh.positionOffset[0], mesh.positionOffset[1], mesh.positionOffset[2], 0.0f};
+        slot.gpu.positionScale  = {mesh.positionScale[0], mesh.positionScale[1], mesh.positionScale[2], 0.0f};
+
+        const u32 index     = CAST<u32>(mSlots.size());
+        Result<void> result = Stage(mMeshes, sizeof(GpuMesh) * index, &slot.gpu, sizeof(GpuMesh));
+
+        // The fallback draws the arena's index range; only the mesh shader path reads meshlets
+        std::vector<u8> triangles;
+        if (result && mPath == Path::MeshShader) {
+            std::vector<Meshlet> meshlets = data.meshlets;
+            for (Meshlet& meshlet : meshlets) {
+                meshlet.vertexOffset += mMeshletVertexCount;
+                meshlet.triangleOffset += mMeshletTriangleBytes;
+            }
+
+            triangles = data.triangles;
+            triangles.resize((triangles.size() + 3) & ~size_t {3}, 0);
+
+            result = Stage(mMeshlets, sizeof(Meshlet) * mMeshletCount, meshlets.data(), sizeof(Meshlet) * meshletCount);
+            if (result) {
+                result = Stage(mBounds,
+                               sizeof(MeshletBounds) * mMeshletCount,
+                               data.bounds.data(),
+                               sizeof(MeshletBounds) * data.bounds.size());
+            }
+            if (result) {
+                result = Stage(mMeshletVertices,
+                               sizeof(u32) * mMeshletVertexCount,
+                               data.vertices.data(),
+                               sizeof(u32) * data.vertices.size());
+            }
+            if (result) {
+                result = Stage(mMeshletTriangles, mMeshletTriangleBytes, triangles.data(), triangles.size());
+            }
+        }
+        if (!result) {
+            mArena->Free(slot.arenaMesh);
+            return std::unexpected(result.error());
+        }
+
+        if (mPath == Path::MeshShader) {
+            mMeshletVertexCount += CAST<u32>(data.vertices.size());
+            mMeshletTriangleBytes += CAST<u32>(triangles.size());
+        }
+        mMeshletCount += meshletCount;
+        mSlots.push_back(slot);
+        mStats.meshes   = CAST<u32>(mSlots.size());
+        mStats.meshlets = mMeshletCount;
+        return index;
+    }
+
+    Result<void> MeshletRenderer::StageMesh(u32 mesh) {
+        MeshSlot& slot = mSlots[mesh];
+
+        const MeshRange* range = mArena->GetMesh(slot.arenaMesh);
+        if (!range) { return std::unexpected("Meshlet renderer mesh missing from the geometry arena"); }
+
+        slot.gpu.vertexOffset = range->vertexOffset;
+        return Stage(mMeshes, sizeof(GpuMesh) * mesh, &slot.gpu, sizeof(GpuMesh));
+    }
+
+    Result<void> MeshletRenderer::UpdateInstances(u32 first, std::span<const MeshletInstance> instances) {
+        if (CAST<u64>(first) + instances.size() > mConfig.maxInstances) {
+            return std::unexpected("Instance update out of range");
+        }
+        return Stage(mInstances, sizeof(MeshletInstance) * first, instances.data(), instances.size_bytes());
+    }
+
+    Result<void>
+    MeshletRenderer::Stage(const Buffer& destination, VkDeviceSize offset, const void* data, VkDeviceSize size) {
+        if (!IsInitialized()) { return std::unexpected("Meshlet renderer not initialized"); }
+
+        if (size == 0) { return {}; }
+
+        const auto staging = mUploads.Allocate(size);
+        if (!staging) { return std::unexpected("Upload space exhausted for this frame"); }
+
+        std::memcpy(staging.mapped, data, size);
+        mPendingCopies.push_back({destination.GetBuffer(), {staging.offset, offset, size}});
+        return {};
+    }
+
+    Result<void> MeshletRenderer::Prepare(const FrameSynchronizer& frames, const View& view) {
+        if (!IsInitialized()) { return std::unexpected("Meshlet renderer not initialized"); }
+
+        // Compaction moved every mesh's vertices
+        if (mArena->GetGeneration() != mArenaGeneration) {
+            for (u32 mesh = 0; mesh < mSlots.size(); mesh++) {
+                if (auto result = StageMesh(mesh); !result) { return result; }
+            }
+            mArenaGeneration = mArena->GetGeneration();
+        }
+
+        Params params {};
+        params.viewProjection = view.viewProjection;
+        const Frustum frustum = Frustum::FromViewProjection(view.viewProjection);
+        std::memcpy(params.planes, frustum.planes.data(), sizeof(params.planes));
+        std::copy_n(view.cameraPosition, 3, params.cameraPosition);
+        params.cullFlags = (view.frustumCulling ? kCullFrustum : 0u) | (view.coneCulling ? kCullCone : 0u);
+
+        mParams = mUploads.Push(params);
+        if (!mParams) { return std::unexpected("Upload space exhausted for this frame"); }
+
+        const VkCommandBuffer commandBuffer = frames.GetCurrentCommandBuffer();
+        const VkPipelineStageFlags shaderStages =
+          mPath == Path::MeshShader ? VK_PIPELINE_STAGE_TASK_SHADER_BIT_EXT | VK_PIPELINE_STAGE_MESH_SHADER_BIT_EXT
+                                    : VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+
+        VkMemoryBarrier barrier {};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        if (!mPendingCopies.empty()) {
+            // Previous frames' draws (earlier in submission order) must finish reading before data is overwritten
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            vkCmdPipelineBarrier(commandBuffer,
+                                 shaderStages,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 0,
+                                 1,
+                                 &barrier,
+                                 0,
+                                 nullptr,
+                                 0,
+                                 nullptr);
+
+            for (const auto& copy : mPendingCopies) {
+                vkCmdCopyBuffer(commandBuffer, mUploads.GetBuffer(), copy.destination, 1, &copy.region);
+            }
+            mPendingCopies.clear();
+        }
+
+        // Also makes the arena's uploads visible to task and mesh shaders, which its own barrier doesn't cover
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             shaderStages,
+                             0,
+                             1,
+                             &barrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+
+        return {};
+    }
+
+    Result<void> MeshletRenderer::Draw(const FrameSynchronizer& frames, std::span<const Batch> batches) {
+        if (!IsInitialized()) { return std::unexpected("Meshlet renderer not initialized"); }
+
+        if (!mParams) { return std::unexpected("Prepare was not called this frame"); }
+
+        mStats.triangles    = 0;
+        mStats.taskGroups   = 0;
+        mStats.drawCommands = 0;
+        if (batches.empty()) { return {}; }
+
+        for (const Batch& batch : batches) {
+            if (batch.mesh >= mSlots.size()) { return std::unexpected("Batch references an unknown mesh"); }
+            if (CAST<u64>(batch.firstInstance) + batch.instanceCount > mConfig.maxInstances) {
+                return std::unexpected("Batch instance range out of range");
+            }
+        }
+
+        const VkCommandBuffer commandBuffer = frames.GetCurrentCommandBuffer();
+
+        DescriptorWrite writes[8] = {
+          DescriptorWrite::ForBuffer(kParams, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, mParams),
+          DescriptorWrite::ForBuffer(kInstanceData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mInstances),
+          DescriptorWrite::ForBuffer(kMeshData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mMeshes),
+          {},
+          {},
+          {},
+          {},
+          {},
+        };
+        size_t writeCount = 3;
+        if (mPath == Path::MeshShader) {
+            writes[writeCount++] =
+              DescriptorWrite::ForBuffer(kMeshletData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mMeshlets);
+            writes[writeCount++] = DescriptorWrite::ForBuffer(kBoundsData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mBounds);
+            writes[writeCount++] =
+              DescriptorWrite::ForBuffer(kMeshletVertexData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mMeshletVertices);
+            writes[writeCount++] =
+              DescriptorWrite::ForBuffer(kMeshletTriangleData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mMeshletTriangles);
+            writes[writeCount++] =
+              DescriptorWrite::ForBuffer(kVertexData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mArena->GetVertexBuffer());
+        }
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mPipeline);
+        if (auto result = mDescriptors.Bind(commandBuffer,
+                                            VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                            mPipelineLayout,
+                                            0,
+                                            std::span(writes, writeCount));
+            !result) {
+            return result;
+        }
+
+        if (mPath == Path::MeshShader) {
+            const auto& limits       = mContext->GetCapabilities().meshShaderProperties;
+            const auto drawMeshTasks = mContext->GetDispatch().cmdDrawMeshTasks;
+
+            for (const Batch& batch : batches) {
+                const MeshSlot& slot = mSlots[batch.mesh];
+                const u32 groupsX    = (slot.gpu.meshletCount + kTaskGroupSize - 1) / kTaskGroupSize;
+                if (groupsX > limits.maxTaskWorkGroupCount[0]) {
+                    return std::unexpected("Mesh has more meshlets than one task dispatch can cover");
+                }
+
+                // One row of task workgroups per instance, split to stay inside the dispatch limits
+                const u32 maxRows = std::max(
+                  1u, std::min(limits.maxTaskWorkGroupCount[1], limits.maxTaskWorkGroupTotalCount / groupsX));
+                for (u32 row = 0; row < batch.instanceCount; row += maxRows) {
+                    const u32 rows = std::min(maxRows, batch.instanceCount - row);
+                    const DrawConstants constants {batch.mesh, batch.firstInstance + row};
+                    vkCmdPushConstants(commandBuffer, mPipelineLayout, mStages, 0, sizeof(constants), &constants);
+                    drawMeshTasks(commandBuffer, groupsX, rows, 1);
+                    mStats.taskGroups += groupsX * rows;
+                }
+                mStats.triangles += CAST<u64>(slot.triangles) * batch.instanceCount;
+            }
+            return {};
+        }
+
+        const auto commands = mUploads.Allocate(sizeof(VkDrawIndexedIndirectCommand) * batches.size());
+        if (!commands) { return std::unexpected("Upload space exhausted for this frame"); }
+
+        auto* command = CAST<VkDrawIndexedIndirectCommand*>(commands.mapped);
+        for (const Batch& batch : batches) {
+            const MeshSlot& slot   = mSlots[batch.mesh];
+            const MeshRange* range = mArena->GetMesh(slot.arenaMesh);
+            *command++             = range->ToDrawCommand(batch.instanceCount, batch.firstInstance);
+            mStats.triangles += CAST<u64>(slot.triangles) * batch.instanceCount;
+        }
+
+        constexpr u32 stride = sizeof(VkDrawIndexedIndirectCommand);
+        const u32 drawCount  = CAST<u32>(batches.size());
+        mArena->Bind(commandBuffer);
+        if (mMultiDraw) {
+            vkCmdDrawIndexedIndirect(commandBuffer, commands.buffer, commands.offset, drawCount, stride);
+        } else {
+            for (u32 i = 0; i < drawCount; i++) {
+                vkCmdDrawIndexedIndirect(commandBuffer, commands.buffer, commands.offset + i * stride, 1, stride);
+            }
+        }
+        mStats.drawCommands = drawCount;
+        return {};
+    }
+}  // namespace Vulkano
@@ -0,0 +1,543 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "ParticleSystem.hpp"
+#include "FrameSynchronizer.hpp"
+#include "PipelineCompiler.hpp"
+#include "VulkanContext.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace Vulkano {
+    namespace {
+        constexpr u32 kGroupSize {256};  // ParticleCommon.glsl local size
+        constexpr u32 kMaxGroups {65535};
+
+        constexpr const char* kComputeLayoutName {"Vulkano.ParticleSystem"};
+        constexpr const char* kDrawLayoutName {"Vulkano.ParticleSystem.Draw"};
+
+        enum Binding : u32 { kParams, kSource, kDestination, kScanData, kBlockData, kCounterData };
+
+        static_assert(sizeof(GpuParticle) == 32);
+
+        u32 Groups(u32 count) {
+            return (count + kGroupSize - 1) / kGroupSize;
+        }
+
+        void ComputeBarrier(VkCommandBuffer commandBuffer,
+                            VkPipelineStageFlags srcStage,
+                            VkPipelineStageFlags dstStage,
+                            VkAccessFlags srcAccess,
+                            VkAccessFlags dstAccess) {
+            VkMemoryBarrier barrier {};
+            barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.srcAccessMask = srcAccess;
+            barrier.dstAccessMask = dstAccess;
+            vkCmdPipelineBarrier(commandBuffer, srcStage, dstStage, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        }
+    }  // namespace
+
+    ParticleSystem::~ParticleSystem() {
+        Shutdown();
+    }
+
+    Result<void> ParticleSystem::Initialize(VulkanContext* context, PipelineCompiler* compiler, const Config& config) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (!compiler || !compiler->IsInitialized()) { return std::unexpected("Invalid or uninitialized compiler"); }
+
+        if (IsInitialized()) { return std::unexpected("Particle system already created"); }
+
+        if (config.maxParticles == 0 || config.framesInFlight == 0) {
+            return std::unexpected("Particle and frame counts must be greater than zero");
+        }
+
+        // One workgroup per 256 particles, and the block scan runs in a single workgroup
+        if (Groups(config.maxParticles) > kMaxGroups) { return std::unexpected("Too many particles"); }
+
+        mContext = context;
+        mConfig  = config;
+
+        // Particles and counters are written on the compute queue and read by the graphics queue's draw
+        const auto createBuffer = [context](Buffer& buffer, VkDeviceSize size, VkBufferUsageFlags usage, bool host) {
+            constexpr VkBufferUsageFlags drawUsage =
+              VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+            Buffer::Config bufferConfig;
+            bufferConfig.size        = size;
+            bufferConfig.usage       = usage;
+            bufferConfig.hostVisible = host;
+            bufferConfig.concurrent  = (usage & drawUsage) != 0;
+            return buffer.Initialize(context, bufferConfig);
+        };
+
+        constexpr VkBufferUsageFlags particleUsage =
+          VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+        constexpr VkBufferUsageFlags counterUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                                    VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT |
+                                                    VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+        const VkDeviceSize particleBytes = sizeof(GpuParticle) * CAST<VkDeviceSize>(config.maxParticles);
+
+        Result<void> result = createBuffer(mParticles[0], particleBytes, particleUsage, false);
+        if (result) { result = createBuffer(mParticles[1], particleBytes, particleUsage, false); }
+        if (result) {
+            result = createBuffer(mScan, sizeof(u32) * config.maxParticles, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, false);
+        }
+        if (result) {
+            result = createBuffer(mBlockSums,
+                                  sizeof(u32) * Groups(config.maxParticles),
+                                  VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                  false);
+        }
+        if (result) { result = createBuffer(mCounters, sizeof(Counters), counterUsage, false); }
+        if (result) {
+            result =
+              createBuffer(mReadback, sizeof(u32) * config.framesInFlight, VK_BUFFER_USAGE_TRANSFER_DST_BIT, true);
+        }
+        if (result) {
+            result = mUploads.Initialize(context,
+                                         sizeof(SimulateParams) + 256,
+                                         config.framesInFlight,
+                                         VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+        }
+        if (!result) {
+            Shutdown();
+            return result;
+        }
+        std::fill_n(CAST<u32*>(mReadback.GetMapped()), config.framesInFlight, 0u);
+
+        DescriptorStream::Config descriptorConfig;
+        descriptorConfig.bindings = {{kParams, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+                                     {kSource, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+                                     {kDestination, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+                                     {kScanData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+                                     {kBlockData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT},
+                                     {kCounterData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT}};
+        descriptorConfig.preferredPath   = DescriptorPath::Push;
+        descriptorConfig.framesInFlight  = config.framesInFlight;
+        descriptorConfig.maxSetsPerFrame = 1;
+        if (result = mDescriptors.Initialize(context, descriptorConfig); !result) {
+            Shutdown();
+            return result;
+        }
+
+        if (result = CreateSync(); !result) {
+            Shutdown();
+            return result;
+        }
+
+        if (result = CreatePipelines(compiler); !result) {
+            Shutdown();
+            return result;
+        }
+
+        return {};
+    }
+
+    Result<void> ParticleSystem::CreateSync() {
+        const VkDevice device = mContext->GetDevice();
+
+        VkCommandPoolCreateInfo poolInfo {};
+        poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags            = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+        poolInfo.queueFamilyIndex = mContext->GetQueueFamilies().computeFamily;
+        if (vkCreateCommandPool(device, &poolInfo, nullptr, &mCommandPool) != VK_SUCCESS) {
+            return std::unexpected("Failed to create particle command pool");
+        }
+
+        mCommandBuffers.resize(mConfig.framesInFlight);
+        VkCommandBufferAllocateInfo allocInfo {};
+        allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool        = mCommandPool;
+        allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = mConfig.framesInFlight;
+        if (vkAllocateCommandBuffers(device, &allocInfo, mCommandBuffers.data()) != VK_SUCCESS) {
+            mCommandBuffers.clear();
+            return std::unexpected("Failed to allocate particle command buffers");
+        }
+
+        VkSemaphoreTypeCreateInfo typeInfo {};
+        typeInfo.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+        typeInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+        typeInfo.initialValue  = 0;
+
+        VkSemaphoreCreateInfo semaphoreInfo {};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+        semaphoreInfo.pNext = &typeInfo;
+        if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &mComputeTimeline) != VK_SUCCESS ||
+            vkCreateSemaphore(device, &semaphoreInfo, nullptr, &mGraphicsTimeline) != VK_SUCCESS) {
+            return std::unexpected("Failed to create particle timeline semaphores");
+        }
+
+        return {};
+    }
+
+    Result<void> ParticleSystem::CreatePipelines(PipelineCompiler* compiler) {
+        const VkDevice device                 = mContext->GetDevice();
+        const VkDescriptorSetLayout setLayout = mDescriptors.GetSetLayout();
+
+        VkPipelineLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType          = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount = 1;
+        layoutInfo.pSetLayouts    = &setLayout;
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &mComputeLayout) != VK_SUCCESS) {
+            return std::unexpected("Failed to create particle compute pipeline layout");
+        }
+        compiler->RegisterLayout(kComputeLayoutName, mComputeLayout);
+
+        const VkPushConstantRange pushRange {VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(DrawConstants)};
+        layoutInfo.setLayoutCount         = 0;
+        layoutInfo.pSetLayouts            = nullptr;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges    = &pushRange;
+        if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &mDrawLayout) != VK_SUCCESS) {
+            return std::unexpected("Failed to create particle draw pipeline layout");
+        }
+        compiler->RegisterLayout(kDrawLayoutName, mDrawLayout);
+
+        for (const auto& [pipeline, shader] : {std::pair {&mScanPipeline, "ParticleScan.comp"},
+                                               std::pair {&mScanBlocksPipeline, "ParticleScanBlocks.comp"},
+                                               std::pair {&mSimulatePipeline, "ParticleSimulate.comp"},
+                                               std::pair {&mEmitPipeline, "ParticleEmit.comp"}}) {
+            ComputePipelineDesc desc;
+            desc.stage.shader = shader;
+            desc.layout       = kComputeLayoutName;
+
+            auto pipelineResult = compiler->Get(desc);
+            if (!pipelineResult) { return std::unexpected(pipelineResult.error()); }
+            *pipeline = pipelineResult.value();
+        }
+
+        // Particles are instances of a four-vertex strip, read straight from the simulation's output buffer
+        GraphicsPipelineDesc desc;
+        desc.layout           = kDrawLayoutName;
+        desc.stages           = {{VK_SHADER_STAGE_VERTEX_BIT, "Particle.vert", "main", {}},
+                                 {VK_SHADER_STAGE_FRAGMENT_BIT, "Particle.frag", "main", {}}};
+        desc.vertexBindings   = {{0, sizeof(GpuParticle), VK_VERTEX_INPUT_RATE_INSTANCE}};
+        desc.vertexAttributes = {{0, 0, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(GpuParticle, position)},
+                                 {1, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(GpuParticle, color)}};
+        desc.topology         = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+        desc.depthTest        = mConfig.depthFormat != VK_FORMAT_UNDEFINED;
+        desc.depthWrite       = false;
+        desc.alphaBlend       = true;
+        desc.colorFormats     = {mConfig.colorFormat};
+        desc.depthFormat      = mConfig.depthFormat;
+
+        auto pipelineResult = compiler->Get(desc);
+        if (!pipelineResult) { return std::unexpected(pipelineResult.error()); }
+        mDrawPipeline = pipelineResult.value();
+
+        return {};
+    }
+
+    void ParticleSystem::Shutdown() {
+        if (!mContext) { return; }
+
+        const VkDevice device = mContext->GetDevice();
+
+        // The compute queue is ours to drain; the graphics queue is the caller's
+        if (mFrame > 0) {
+            VkSemaphoreWaitInfo waitInfo {};
+            waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores    = &mComputeTimeline;
+            waitInfo.pValues        = &mFrame;
+            vkWaitSemaphores(device, &waitInfo, std::numeric_limits<u64>::max());
+        }
+
+        if (mComputeLayout != VK_NULL_HANDLE) { vkDestroyPipelineLayout(device, mComputeLayout, nullptr); }
+        if (mDrawLayout != VK_NULL_HANDLE) { vkDestroyPipelineLayout(device, mDrawLayout, nullptr); }
+        if (mComputeTimeline != VK_NULL_HANDLE) { vkDestroySemaphore(device, mComputeTimeline, nullptr); }
+        if (mGraphicsTimeline != VK_NULL_HANDLE) { vkDestroySemaphore(device, mGraphicsTimeline, nullptr); }
+        if (mCommandPool != VK_NULL_HANDLE) { vkDestroyCommandPool(device, mCommandPool, nullptr); }
+
+        mDescriptors.Shutdown();
+        mUploads.Shutdown();
+        mReadback.Shutdown();
+        mCounters.Shutdown();
+        mBlockSums.Shutdown();
+        mScan.Shutdown();
+        for (Buffer& particles : mParticles) {
+            particles.Shutdown();
+        }
+
+        mCommandBuffers.clear();
+        mEmitRemainder.fill(0.0f);
+        mCommandPool        = VK_NULL_HANDLE;
+        mComputeTimeline    = VK_NULL_HANDLE;
+        mGraphicsTimeline   = VK_NULL_HANDLE;
+        mFrame              = 0;
+        mComputeLayout      = VK_NULL_HANDLE;
+        mDrawLayout         = VK_NULL_HANDLE;
+        mScanPipeline       = VK_NULL_HANDLE;
+        mScanBlocksPipeline = VK_NULL_HANDLE;
+        mSimulatePipeline   = VK_NULL_HANDLE;
+        mEmitPipeline       = VK_NULL_HANDLE;
+        mDrawPipeline       = VK_NULL_HANDLE;
+        mStats              = {};
+        mContext            = nullptr;
+    }
+
+    Result<void> ParticleSystem::Simulate(const Simulation& simulation, std::span<const ParticleEmitter> emitters) {
+        if (!IsInitialized()) { return std::unexpected("Particle system not initialized"); }
+
+        if (emitters.size() > kMaxEmitters) { return std::unexpected("Too many particle emitters"); }
+
+        const VkDevice device = mContext->GetDevice();
+        const u64 frame       = mFrame + 1;
+        const u32 slot        = CAST<u32>(frame % mConfig.framesInFlight);
+
+        // This slot's command buffer, parameters and descriptors were last used by simulation frame - framesInFlight
+        if (frame > mConfig.framesInFlight) {
+            const u64 value = frame - mConfig.framesInFlight;
+
+            VkSemaphoreWaitInfo waitInfo {};
+            waitInfo.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+            waitInfo.semaphoreCount = 1;
+            waitInfo.pSemaphores    = &mComputeTimeline;
+            waitInfo.pValues        = &value;
+            const VkResult waited = vkWaitSemaphores(device, &waitInfo, std::numeric_limits<u64>::max());
+            if (waited != VK_SUCCESS) {
+                mContext->CheckDeviceLost(waited);
+                return std::unexpected("Failed to wait for particle simulation");
+            }
+            mStats.alive = CAST<const u32*>(mReadback.GetMapped())[slot];
+        }
+
+        mUploads.BeginFrame(slot);
+        mDescriptors.BeginFrame(slot);
+
+        // Emission counts are the only per-frame CPU work: a whole number of particles per emitter, carrying the
+        // fraction over to the next frame
+        SimulateParams params {};
+        params.gravityDrag[0] = simulation.gravity[0];
+        params.gravityDrag[1] = simulation.gravity[1];
+        params.gravityDrag[2] = simulation.gravity[2];
+        params.gravityDrag[3] = simulation.drag;
+        params.deltaTime      = simulation.deltaTime;
+        params.emitterCount   = CAST<u32>(emitters.size());
+        params.maxParticles   = mConfig.maxParticles;
+        params.source         = CAST<u32>((frame + 1) % 2);
+        params.seed           = CAST<u32>(frame * 0x9E3779B9u);
+
+        u64 emitCount = 0;
+        for (size_t i = 0; i < emitters.size(); i++) {
+            const ParticleEmitter& emitter = emitters[i];
+            const f32 spawn                = mEmitRemainder[i] + std::max(emitter.rate, 0.0f) * simulation.deltaTime;
+            const f32 whole                = std::floor(spawn);
+            mEmitRemainder[i]              = spawn - whole;
+
+            GpuEmitter& gpu       = params.emitters[i];
+            gpu.positionRadius[0] = emitter.position[0];
+            gpu.positionRadius[1] = emitter.position[1];
+            gpu.positionRadius[2] = emitter.position[2];
+            gpu.positionRadius[3] = emitter.radius;
+            gpu.velocityJitter[0] = emitter.velocity[0];
+            gpu.velocityJitter[1] = emitter.velocity[1];
+            gpu.velocityJitter[2] = emitter.velocity[2];
+            gpu.velocityJitter[3] = emitter.velocityJitter;
+            gpu.lifetime[0]       = emitter.lifetime[0];
+            gpu.lifetime[1]       = std::max(emitter.lifetime[0], emitter.lifetime[1]);
+            gpu.color             = emitter.color;
+            gpu.firstParticle     = CAST<u32>(std::min<u64>(emitCount, mConfig.maxParticles));
+
+            emitCount += CAST<u64>(whole) + emitter.burst;
+        }
+        std::fill(mEmitRemainder.begin() + CAST<std::ptrdiff_t>(emitters.size()), mEmitRemainder.end(), 0.0f);
+        params.emitCount = CAST<u32>(std::min<u64>(emitCount, mConfig.maxParticles));
+
+        const auto paramsAllocation = mUploads.Push(params);
+        if (!paramsAllocation) { return std::unexpected("Upload space exhausted for this frame"); }
+
+        const VkCommandBuffer commandBuffer = mCommandBuffers[slot];
+        vkResetCommandBuffer(commandBuffer, 0);
+
+        VkCommandBufferBeginInfo beginInfo {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+            return std::unexpected("Failed to begin particle command buffer");
+        }
+        if (auto result = RecordSimulation(commandBuffer, frame, params.emitCount, paramsAllocation); !result) {
+            vkEndCommandBuffer(commandBuffer);
+            return result;
+        }
+        if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+            return std::unexpected("Failed to record particle command buffer");
+        }
+
+        // The destination buffer and its counters were last drawn by the graphics submit two simulations back
+        VkSemaphoreSubmitInfo waitInfo {};
+        waitInfo.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        waitInfo.semaphore = mGraphicsTimeline;
+        waitInfo.value     = frame - 2;
+        waitInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+        VkSemaphoreSubmitInfo signalInfo {};
+        signalInfo.sType     = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        signalInfo.semaphore = mComputeTimeline;
+        signalInfo.value     = frame;
+        signalInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+        VkCommandBufferSubmitInfo commandInfo {};
+        commandInfo.sType         = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+        commandInfo.commandBuffer = commandBuffer;
+
+        VkSubmitInfo2 submitInfo {};
+        submitInfo.sType                    = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        submitInfo.waitSemaphoreInfoCount   = frame > 2 ? 1 : 0;
+        submitInfo.pWaitSemaphoreInfos      = &waitInfo;
+        submitInfo.commandBufferInfoCount   = 1;
+        submitInfo.pCommandBufferInfos      = &commandInfo;
+        submitInfo.signalSemaphoreInfoCount = 1;
+        submitInfo.pSignalSemaphoreInfos    = &signalInfo;
+        const VkResult submitted = vkQueueSubmit2(mContext->GetComputeQueue(), 1, &submitInfo, VK_NULL_HANDLE);
+        if (submitted != VK_SUCCESS) {
+            mContext->CheckDeviceLost(submitted);
+            return std::unexpected("Failed to submit particle simulation");
+        }
+
+        mFrame         = frame;
+        mStats.emitted = params.emitCount;
+        mStats.frames  = frame;
+        return {};
+    }
+
+    Result<void> ParticleSystem::RecordSimulation(VkCommandBuffer commandBuffer,
+                                                  u64 frame,
+                                                  u32 emitCount,
+                                                  const TransientRing::Allocation& params) {
+        const u32 source      = CAST<u32>((frame + 1) % 2);
+        const u32 destination = CAST<u32>(frame % 2);
+        const u32 slot        = CAST<u32>(frame % mConfig.framesInFlight);
+
+        constexpr VkAccessFlags shaderAccess = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+        if (frame == 1) {
+            vkCmdFillBuffer(commandBuffer, mCounters.GetBuffer(), 0, VK_WHOLE_SIZE, 0);
+            ComputeBarrier(commandBuffer,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT,
+                           VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                           VK_ACCESS_TRANSFER_WRITE_BIT,
+                           VK_ACCESS_INDIRECT_COMMAND_READ_BIT | shaderAccess);
+        } else {
+            // The previous simulation (earlier on this queue) wrote the source particles, counts and dispatch size
+            ComputeBarrier(commandBuffer,
+                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                           VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                           VK_ACCESS_SHADER_WRITE_BIT,
+                           VK_ACCESS_INDIRECT_COMMAND_READ_BIT | shaderAccess);
+        }
+
+        const DescriptorWrite writes[] = {
+          DescriptorWrite::ForBuffer(kParams, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, params),
+          DescriptorWrite::ForBuffer(kSource, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mParticles[source]),
+          DescriptorWrite::ForBuffer(kDestination, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mParticles[destination]),
+          DescriptorWrite::ForBuffer(kScanData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mScan),
+          DescriptorWrite::ForBuffer(kBlockData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mBlockSums),
+          DescriptorWrite::ForBuffer(kCounterData, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, mCounters),
+        };
+
+        // The four pipelines share a layout, so the set stays bound across them
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mScanPipeline);
+        if (auto result =
+              mDescriptors.Bind(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mComputeLayout, 0, writes);
+            !result) {
+            return result;
+        }
+
+        const VkDeviceSize sourceDispatch =
+          offsetof(Counters, dispatch) + sizeof(VkDispatchIndirectCommand) * CAST<VkDeviceSize>(source);
+        const auto computeToCompute = [commandBuffer, shaderAccess] {
+            ComputeBarrier(commandBuffer,
+                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                           VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                           VK_ACCESS_SHADER_WRITE_BIT,
+                           shaderAccess);
+        };
+
+        // Flag survivors and scan the flags within each workgroup
+        vkCmdDispatchIndirect(commandBuffer, mCounters.GetBuffer(), sourceDispatch);
+        computeToCompute();
+
+        // Scan the workgroup totals and size the destination's dispatch and draw
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mScanBlocksPipeline);
+        vkCmdDispatch(commandBuffer, 1, 1, 1);
+        computeToCompute();
+
+        // Integrate survivors and scatter them to their compacted slots
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mSimulatePipeline);
+        vkCmdDispatchIndirect(commandBuffer, mCounters.GetBuffer(), sourceDispatch);
+
+        // Append new particles behind the survivors (writes disjoint slots, so no barrier in between)
+        if (emitCount > 0) {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mEmitPipeline);
+            vkCmdDispatch(commandBuffer, Groups(emitCount), 1, 1);
+        }
+
+        ComputeBarrier(commandBuffer,
+                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       VK_ACCESS_SHADER_WRITE_BIT,
+                       VK_ACCESS_TRANSFER_READ_BIT);
+        const VkBufferCopy countCopy {sizeof(u32) * destination, sizeof(u32) * slot, sizeof(u32)};
+        vkCmdCopyBuffer(commandBuffer, mCounters.GetBuffer(), mReadback.GetBuffer(), 1, &countCopy);
+        ComputeBarrier(commandBuffer,
+                       VK_PIPELINE_STAGE_TRANSFER_BIT,
+                       VK_PIPELINE_STAGE_HOST_BIT,
+                       VK_ACCESS_TRANSFER_WRITE_BIT,
+                       VK_ACCESS_HOST_READ_BIT);
+
+        return {};
+    }
+
+    ParticleSystem::GraphicsSync ParticleSystem::GetGraphicsSync() const {
+        GraphicsSync sync;
+        if (mFrame == 0) { return sync; }
+
+        sync.waitSemaphore   = mComputeTimeline;
+        sync.waitValue       = mFrame;
+        sync.waitStage       = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+        sync.signalSemaphore = mGraphicsTimeline;
+        sync.signalValue     = mFrame;
+        return sync;
+    }
+
+    void ParticleSystem::Draw(const FrameSynchronizer& frames, const View& view) const {
+        if (!IsInitialized() || mFrame == 0) { return; }
+
+        const VkCommandBuffer commandBuffer = frames.GetCurrentCommandBuffer();
+        const u32 destination               = CAST<u32>(mFrame % 2);
+
+        DrawConstants constants {};
+        constants.viewProjection = view.viewProjection;
+        constants.rightSize[0]   = view.right[0];
+        constants.rightSize[1]   = view.right[1];
+        constants.rightSize[2]   = view.right[2];
+        constants.rightSize[3]   = view.size;
+        constants.upFade[0]      = view.up[0];
+        constants.upFade[1]      = view.up[1];
+        constants.upFade[2]      = view.up[2];
+        constants.upFade[3]      = std::max(view.fadeTime, 1.0e-4f);
+
+        const VkBuffer particles = mParticles[destination].GetBuffer();
+        const VkDeviceSize zero  = 0;
+        const VkDeviceSize drawOffset =
+          offsetof(Counters, draw) + sizeof(VkDrawIndirectCommand) * CAST<VkDeviceSize>(destination);
+
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mDrawPipeline);
+        vkCmdPushConstants(commandBuffer,
+                           mDrawLayout,
+                           VK_SHADER_STAGE_VERTEX_BIT,
+                           0,
+                           sizeof(DrawConstants),
+                           &constants);
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &particles, &zero);
+        vkCmdDrawIndirect(commandBuffer, mCounters.GetBuffer(), drawOffset, 1, sizeof(VkDrawIndirectCommand));
+    }
+}  // namespace Vulkano
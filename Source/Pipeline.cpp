@@ -0,0 +1,338 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Pipeline.hpp"
+#include "ShaderLibrary.hpp"
+#include "Hash.hpp"
+#include "Serialization.hpp"
+
+#include <cstddef>
+
+namespace Vulkano {
+    namespace {
+        void HashStage(Hasher& hasher, const ShaderStageDesc& stage) {
+            hasher.Value(stage.stage).String(stage.shader).String(stage.entryPoint);
+            hasher.Value(CAST<u32>(stage.specialization.size()));
+            for (const auto& constant : stage.specialization) {
+                hasher.Value(constant.id).Value(constant.value);
+            }
+        }
+
+        void WriteStage(BinaryWriter& writer, const ShaderStageDesc& stage) {
+            writer.Write(stage.stage);
+            writer.WriteString(stage.shader);
+            writer.WriteString(stage.entryPoint);
+            writer.WriteVector(stage.specialization);
+        }
+
+        bool ReadStage(BinaryReader& reader, ShaderStageDesc& stage) {
+            return reader.Read(stage.stage) && reader.ReadString(stage.shader) && reader.ReadString(stage.entryPoint) &&
+                   reader.ReadVector(stage.specialization);
+        }
+
+        void WriteBool(BinaryWriter& writer, bool value) {
+            writer.Write(CAST<u8>(value ? 1 : 0));
+        }
+
+        bool ReadBool(BinaryReader& reader, bool& value) {
+            u8 byte = 0;
+            if (!reader.Read(byte)) { return false; }
+            value = byte != 0;
+            return true;
+        }
+
+        /// @brief Topologies that can be switched between dynamically without dynamicPrimitiveTopologyUnrestricted
+        u32 TopologyClass(VkPrimitiveTopology topology) {
+            switch (topology) {
+                case VK_PRIMITIVE_TOPOLOGY_POINT_LIST:
+                    return 0;
+                case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+                case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+                case VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY:
+                case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY:
+                    return 1;
+                case VK_PRIMITIVE_TOPOLOGY_PATCH_LIST:
+                    return 3;
+                default:
+                    return 2;
+            }
+        }
+    }  // namespace
+
+    u64 GraphicsPipelineDesc::Hash() const {
+        Hasher hasher;
+        hasher.Value(CAST<u32>(stages.size()));
+        for (const auto& stage : stages) {
+            HashStage(hasher, stage);
+        }
+        hasher.String(layout);
+
+        hasher.Value(CAST<u32>(vertexBindings.size()));
+        for (const auto& binding : vertexBindings) {
+            hasher.Value(binding.binding).Value(binding.stride).Value(binding.inputRate);
+        }
+        hasher.Value(CAST<u32>(vertexAttributes.size()));
+        for (const auto& attribute : vertexAttributes) {
+            hasher.Value(attribute.location).Value(attribute.binding).Value(attribute.format).Value(attribute.offset);
+        }
+
+        // Dynamic state is hashed as the mask only, so descriptions that differ in it share a pipeline
+        hasher.Value(dynamicState);
+        if (dynamicState & kDynamicTopology) {
+            hasher.Value(TopologyClass(topology));
+        } else {
+            hasher.Value(topology);
+        }
+        if (!(dynamicState & kDynamicPolygonMode)) { hasher.Value(polygonMode); }
+        if (!(dynamicState & kDynamicCullMode)) { hasher.Value(cullMode); }
+        if (!(dynamicState & kDynamicFrontFace)) { hasher.Value(frontFace); }
+        if (!(dynamicState & kDynamicDepth)) { hasher.Value(depthTest).Value(depthWrite).Value(depthCompareOp); }
+        if (!(dynamicState & kDynamicColorBlend)) { hasher.Value(alphaBlend); }
+
+        hasher.Value(CAST<u32>(colorFormats.size()));
+        for (const VkFormat format : colorFormats) {
+            hasher.Value(format);
+        }
+        hasher.Value(depthFormat);
+        hasher.Value(viewMask);
+        hasher.Value(descriptorBuffer);
+
+        return hasher.Get();
+    }
+
+    u64 ComputePipelineDesc::Hash() const {
+        Hasher hasher;
+        HashStage(hasher, stage);
+        hasher.String(layout);
+        hasher.Value(descriptorBuffer);
+        return hasher.Get();
+    }
+
+    VkPipelineColorBlendAttachmentState MakeBlendAttachment(bool alphaBlend) {
+        VkPipelineColorBlendAttachmentState blendAttachment {};
+        blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
+                                         VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+        if (alphaBlend) {
+            blendAttachment.blendEnable         = VK_TRUE;
+            blendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+            blendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+            blendAttachment.colorBlendOp        = VK_BLEND_OP_ADD;
+            blendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+            blendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+            blendAttachment.alphaBlendOp        = VK_BLEND_OP_ADD;
+        }
+        return blendAttachment;
+    }
+
+    void GraphicsPipelineDesc::Serialize(BinaryWriter& writer) const {
+        writer.Write(CAST<u32>(stages.size()));
+        for (const auto& stage : stages) {
+            WriteStage(writer, stage);
+        }
+        writer.WriteString(layout);
+        writer.WriteVector(vertexBindings);
+        writer.WriteVector(vertexAttributes);
+        writer.Write(topology);
+        writer.Write(polygonMode);
+        writer.Write(cullMode);
+        writer.Write(frontFace);
+        WriteBool(writer, depthTest);
+        WriteBool(writer, depthWrite);
+        writer.Write(depthCompareOp);
+        WriteBool(writer, alphaBlend);
+        writer.WriteVector(colorFormats);
+        writer.Write(depthFormat);
+        writer.Write(viewMask);
+        writer.Write(dynamicState);
+        WriteBool(writer, descriptorBuffer);
+    }
+
+    bool GraphicsPipelineDesc::Deserialize(BinaryReader& reader) {
+        u32 stageCount = 0;
+        if (!reader.Read(stageCount)) { return false; }
+        stages.clear();
+        for (u32 i = 0; i < stageCount; i++) {
+            ShaderStageDesc stage;
+            if (!ReadStage(reader, stage)) { return false; }
+            stages.push_back(std::move(stage));
+        }
+
+        return reader.ReadString(layout) && reader.ReadVector(vertexBindings) &&
+               reader.ReadVector(vertexAttributes) && reader.Read(topology) && reader.Read(polygonMode) &&
+               reader.Read(cullMode) && reader.Read(frontFace) && ReadBool(reader, depthTest) &&
+               ReadBool(reader, depthWrite) && reader.Read(depthCompareOp) && ReadBool(reader, alphaBlend) &&
+               reader.ReadVector(colorFormats) && reader.Read(depthFormat) && reader.Read(viewMask) &&
+               reader.Read(dynamicState) && ReadBool(reader, descriptorBuffer);
+    }
+
+    void ComputePipelineDesc::Serialize(BinaryWriter& writer) const {
+        WriteStage(writer, stage);
+        writer.WriteString(layout);
+        WriteBool(writer, descriptorBuffer);
+    }
+
+    bool ComputePipelineDesc::Deserialize(BinaryReader& reader) {
+        return ReadStage(reader, stage) && reader.ReadString(layout) && ReadBool(reader, descriptorBuffer);
+    }
+
+    Result<VkPipeline> PipelineBuilder::Build(const GraphicsPipelineDesc& desc, VkPipelineLayout layout) const {
+        if (desc.stages.empty()) { return std::unexpected("Graphics pipeline has no shader stages"); }
+
+        std::vector<VkPipelineShaderStageCreateInfo> stages;
+        std::vector<StageSpecialization> specializations(desc.stages.size());
+        stages.reserve(desc.stages.size());
+        bool meshShading = false;
+        for (size_t i = 0; i < desc.stages.size(); i++) {
+            auto stageResult = ResolveStage(desc.stages[i], specializations[i]);
+            if (!stageResult) { return std::unexpected(stageResult.error()); }
+            stages.push_back(stageResult.value());
+            meshShading |= desc.stages[i].stage == VK_SHADER_STAGE_MESH_BIT_EXT;
+        }
+
+        VkPipelineVertexInputStateCreateInfo vertexInput {};
+        vertexInput.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+        vertexInput.vertexBindingDescriptionCount   = CAST<u32>(desc.vertexBindings.size());
+        vertexInput.pVertexBindingDescriptions      = desc.vertexBindings.data();
+        vertexInput.vertexAttributeDescriptionCount = CAST<u32>(desc.vertexAttributes.size());
+        vertexInput.pVertexAttributeDescriptions    = desc.vertexAttributes.data();
+
+        VkPipelineInputAssemblyStateCreateInfo inputAssembly {};
+        inputAssembly.sType    = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+        inputAssembly.topology = desc.topology;
+
+        VkPipelineViewportStateCreateInfo viewportState {};
+        viewportState.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+        viewportState.viewportCount = 1;
+        viewportState.scissorCount  = 1;
+
+        VkPipelineRasterizationStateCreateInfo rasterization {};
+        rasterization.sType       = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+        rasterization.polygonMode = desc.polygonMode;
+        rasterization.cullMode    = desc.cullMode;
+        rasterization.frontFace   = desc.frontFace;
+        rasterization.lineWidth   = 1.0f;
+
+        VkPipelineMultisampleStateCreateInfo multisample {};
+        multisample.sType                = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+        multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+        VkPipelineDepthStencilStateCreateInfo depthStencil {};
+        depthStencil.sType            = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        depthStencil.depthTestEnable  = desc.depthTest ? VK_TRUE : VK_FALSE;
+        depthStencil.depthWriteEnable = desc.depthWrite ? VK_TRUE : VK_FALSE;
+        depthStencil.depthCompareOp   = desc.depthCompareOp;
+
+        const std::vector blendAttachments(desc.colorFormats.size(), MakeBlendAttachment(desc.alphaBlend));
+
+        VkPipelineColorBlendStateCreateInfo colorBlend {};
+        colorBlend.sType           = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+        colorBlend.attachmentCount = CAST<u32>(blendAttachments.size());
+        colorBlend.pAttachments    = blendAttachments.data();
+
+        std::vector<VkDynamicState> dynamicStates = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+        if (desc.dynamicState & kDynamicCullMode) { dynamicStates.push_back(VK_DYNAMIC_STATE_CULL_MODE); }
+        if (desc.dynamicState & kDynamicFrontFace) { dynamicStates.push_back(VK_DYNAMIC_STATE_FRONT_FACE); }
+        if ((desc.dynamicState & kDynamicTopology) && !meshShading) {
+            dynamicStates.push_back(VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY);
+        }
+        if (desc.dynamicState & kDynamicDepth) {
+            dynamicStates.insert(dynamicStates.end(),
+                                 {VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE,
+                                  VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE,
+                                  VK_DYNAMIC_STATE_DEPTH_COMPARE_OP});
+        }
+        if (desc.dynamicState & kDynamicPolygonMode) { dynamicStates.push_back(VK_DYNAMIC_STATE_POLYGON_MODE_EXT); }
+        if (desc.dynamicState & kDynamicColorBlend) {
+            dynamicStates.insert(dynamicStates.end(),
+                                 {VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT,
+                                  VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT,
+                                  VK_DYNAMIC_STATE_COLOR_WRITE_MASK_EXT});
+        }
+
+        VkPipelineDynamicStateCreateInfo dynamicState {};
+        dynamicState.sType             = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+        dynamicState.dynamicStateCount = CAST<u32>(dynamicStates.size());
+        dynamicState.pDynamicStates    = dynamicStates.data();
+
+        VkPipelineRenderingCreateInfo renderingInfo {};
+        renderingInfo.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
+        renderingInfo.colorAttachmentCount    = CAST<u32>(desc.colorFormats.size());
+        renderingInfo.pColorAttachmentFormats = desc.colorFormats.data();
+        renderingInfo.depthAttachmentFormat   = desc.depthFormat;
+        renderingInfo.viewMask                = desc.viewMask;
+
+        VkGraphicsPipelineCreateInfo pipelineInfo {};
+        pipelineInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+        pipelineInfo.pNext               = &renderingInfo;
+        pipelineInfo.stageCount          = CAST<u32>(stages.size());
+        pipelineInfo.pStages             = stages.data();
+        pipelineInfo.pVertexInputState   = meshShading ? nullptr : &vertexInput;  // Mesh shaders fetch their own
+        pipelineInfo.pInputAssemblyState = meshShading ? nullptr : &inputAssembly;
+        pipelineInfo.pViewportState      = &viewportState;
+        pipelineInfo.pRasterizationState = &rasterization;
+        pipelineInfo.pMultisampleState   = &multisample;
+        pipelineInfo.pDepthStencilState  = &depthStencil;
+        pipelineInfo.pColorBlendState    = &colorBlend;
+        pipelineInfo.pDynamicState       = &dynamicState;
+        pipelineInfo.layout              = layout;
+        if (desc.descriptorBuffer) { pipelineInfo.flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT; }
+
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        if (vkCreateGraphicsPipelines(mDevice, mCache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+            return std::unexpected("Failed to create graphics pipeline");
+        }
+
+        return pipeline;
+    }
+
+    Result<VkPipeline> PipelineBuilder::Build(const ComputePipelineDesc& desc, VkPipelineLayout layout) const {
+        StageSpecialization specialization;
+        auto stageResult = ResolveStage(desc.stage, specialization);
+        if (!stageResult) { return std::unexpected(stageResult.error()); }
+
+        VkComputePipelineCreateInfo pipelineInfo {};
+        pipelineInfo.sType  = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.stage  = stageResult.value();
+        pipelineInfo.layout = layout;
+        if (desc.descriptorBuffer) { pipelineInfo.flags |= VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT; }
+
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        if (vkCreateComputePipelines(mDevice, mCache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+            return std::unexpected("Failed to create compute pipeline");
+        }
+
+        return pipeline;
+    }
+
+    Result<VkPipelineShaderStageCreateInfo> PipelineBuilder::ResolveStage(const ShaderStageDesc& stage,
+                                                                          StageSpecialization& specialization) const {
+        const VkShaderModule module = mShaders.GetModule(stage.shader);
+        if (module == VK_NULL_HANDLE) { return std::unexpected("Unknown shader: " + stage.shader); }
+
+        VkPipelineShaderStageCreateInfo stageInfo {};
+        stageInfo.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stageInfo.stage  = stage.stage;
+        stageInfo.module = module;
+        stageInfo.pName  = stage.entryPoint.c_str();
+
+        if (!stage.specialization.empty()) {
+            // The constants are {id, value} pairs, so the map entries point straight at the description's values
+            specialization.entries.reserve(stage.specialization.size());
+            for (size_t i = 0; i < stage.specialization.size(); i++) {
+                specialization.entries.push_back({stage.specialization[i].id,
+                                                  CAST<u32>(i * sizeof(SpecializationConstant) +
+                                                            offsetof(SpecializationConstant, value)),
+                                                  sizeof(u32)});
+            }
+
+            specialization.info.mapEntryCount = CAST<u32>(specialization.entries.size());
+            specialization.info.pMapEntries   = specialization.entries.data();
+            specialization.info.dataSize      = stage.specialization.size() * sizeof(SpecializationConstant);
+            specialization.info.pData         = stage.specialization.data();
+            stageInfo.pSpecializationInfo     = &specialization.info;
+        }
+
+        return stageInfo;
+    }
+}  // namespace Vulkano
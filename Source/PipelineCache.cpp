@@ -0,0 +1,137 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "PipelineCache.hpp"
+#include "VulkanContext.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace Vulkano {
+    PipelineCache::~PipelineCache() {
+        Shutdown();
+    }
+
+    void PipelineCache::LoadAsync(JobSystem& jobs, const std::filesystem::path& path) {
+        mPath = path;
+        mInitialData.clear();
+
+        mLoadJob = jobs.Submit([this, path] {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file) { return; }
+
+            const std::streamsize size = file.tellg();
+            if (size <= 0) { return; }
+
+            std::vector<u8> data(CAST<size_t>(size));
+            file.seekg(0);
+            if (file.read(RCAST<char*>(data.data()), size)) { mInitialData = std::move(data); }
+        });
+    }
+
+    Result<void> PipelineCache::Initialize(VulkanContext* context) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (IsInitialized()) { return std::unexpected("Pipeline cache already initialized"); }
+
+        mContext = context;
+
+        auto scope = context->GetStartupProfiler().Measure("Pipeline cache");
+
+        if (mLoadJob.valid()) { mLoadJob.wait(); }
+
+        // Stale or foreign cache data is silently dropped; the driver would reject it anyway
+        mSeeded = IsCompatible(mInitialData);
+
+        VkPipelineCacheCreateInfo cacheInfo {};
+        cacheInfo.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        cacheInfo.initialDataSize = mSeeded ? mInitialData.size() : 0;
+        cacheInfo.pInitialData    = mSeeded ? mInitialData.data() : nullptr;
+
+        if (vkCreatePipelineCache(context->GetDevice(), &cacheInfo, nullptr, &mCache) != VK_SUCCESS) {
+            return std::unexpected("Failed to create pipeline cache");
+        }
+
+        mInitialData.clear();
+        mInitialData.shrink_to_fit();
+
+        return {};
+    }
+
+    Result<void> PipelineCache::Save() const {
+        if (!IsInitialized()) { return std::unexpected("Pipeline cache not initialized"); }
+
+        if (mPath.empty()) { return std::unexpected("No pipeline cache path set"); }
+
+        size_t size = 0;
+        if (vkGetPipelineCacheData(mContext->GetDevice(), mCache, &size, nullptr) != VK_SUCCESS) {
+            return std::unexpected("Failed to query pipeline cache size");
+        }
+
+        std::vector<u8> data(size);
+        if (vkGetPipelineCacheData(mContext->GetDevice(), mCache, &size, data.data()) != VK_SUCCESS) {
+            return std::unexpected("Failed to read pipeline cache data");
+        }
+
+        // Write to a temporary file first so a crash mid-write never leaves a truncated cache behind
+        std::filesystem::path tempPath = mPath;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file) { return std::unexpected("Failed to open pipeline cache file for writing"); }
+            file.write(RCAST<const char*>(data.data()), CAST<std::streamsize>(size));
+            if (!file) { return std::unexpected("Failed to write pipeline cache file"); }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, mPath, error);
+        if (error) { return std::unexpected("Failed to replace pipeline cache file: " + error.message()); }
+
+        return {};
+    }
+
+    void PipelineCache::Shutdown() {
+        if (mLoadJob.valid()) { mLoadJob.wait(); }
+
+        if (mContext && mCache != VK_NULL_HANDLE) {
+            vkDestroyPipelineCache(mContext->GetDevice(), mCache, nullptr);
+            mCache = VK_NULL_HANDLE;
+        }
+
+        mSeeded = false;
+    }
+
+    void PipelineCache::ReleaseDeviceObjects() {
+        if (!IsInitialized()) { return; }
+
+        // The cache data lives on the host, so it outlives the device and makes the recovery's recompiles hits
+        const VkDevice device = mContext->GetDevice();
+        size_t size           = 0;
+        if (vkGetPipelineCacheData(device, mCache, &size, nullptr) == VK_SUCCESS) {
+            mInitialData.resize(size);
+            if (vkGetPipelineCacheData(device, mCache, &size, mInitialData.data()) != VK_SUCCESS) {
+                mInitialData.clear();
+            }
+        }
+
+        Shutdown();
+    }
+
+    Result<void> PipelineCache::RecreateDeviceObjects() {
+        if (!mContext) { return std::unexpected("Pipeline cache not initialized"); }
+        return Initialize(mContext);
+    }
+
+    bool PipelineCache::IsCompatible(const std::vector<u8>& data) const {
+        if (data.size() < sizeof(VkPipelineCacheHeaderVersionOne)) { return false; }
+
+        VkPipelineCacheHeaderVersionOne header {};
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        const auto& properties = mContext->GetDeviceProperties();
+        return header.headerSize >= sizeof(header) && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+               header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+               std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+}  // namespace Vulkano
@@ -0,0 +1,376 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "PipelineCompiler.hpp"
+#include "VulkanContext.hpp"
+#include "JobSystem.hpp"
+#include "ShaderLibrary.hpp"
+#include "PipelineCache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <ranges>
+
+namespace Vulkano {
+    PipelineCompiler::~PipelineCompiler() {
+        Shutdown();
+    }
+
+    Result<void> PipelineCompiler::Initialize(VulkanContext* context,
+                                              JobSystem* jobs,
+                                              ShaderLibrary* shaders,
+                                              PipelineCache* cache) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (!jobs || !shaders) { return std::unexpected("Job system and shader library are required"); }
+
+        mContext = context;
+        mJobs    = jobs;
+        mShaders = shaders;
+        mCache   = cache;
+
+        const auto& capabilities = context->GetCapabilities();
+        mSupportedDynamicState   = kDynamicStateCore;
+        if (capabilities.dynamicPolygonMode) { mSupportedDynamicState |= kDynamicPolygonMode; }
+        if (capabilities.dynamicColorBlend) { mSupportedDynamicState |= kDynamicColorBlend; }
+
+        mStopWarmUp   = false;
+        mWarmUpThread = std::thread([this] { WarmUpLoop(); });
+
+        return {};
+    }
+
+    void PipelineCompiler::Shutdown() {
+        if (!mContext) { return; }
+
+        {
+            std::lock_guard lock(mMutex);
+            mStopWarmUp = true;
+        }
+        mWarmUpSignal.notify_all();
+        if (mWarmUpThread.joinable()) { mWarmUpThread.join(); }
+
+        std::unique_lock lock(mMutex);
+
+        // Queued work is dropped; jobs already handed to the job system still run but find the queue empty
+        for (const auto& request : mPending) {
+            mEntries.erase(request.key);
+        }
+        for (const auto& request : mWarmUpQueue) {
+            mEntries.erase(request.key);
+        }
+        mPending.clear();
+        mWarmUpQueue.clear();
+        mStateChanged.wait(lock, [this] { return mOutstandingJobs == 0; });
+
+        for (auto& [key, entry] : mEntries) {
+            if (entry.pipeline != VK_NULL_HANDLE) { vkDestroyPipeline(mContext->GetDevice(), entry.pipeline, nullptr); }
+        }
+
+        mEntries.clear();
+        mLayouts.clear();
+        mStats   = {};
+        mContext = nullptr;
+    }
+
+    void PipelineCompiler::ReleaseDeviceObjects() {
+        if (!mContext) { return; }
+
+        std::unique_lock lock(mMutex);
+
+        // Queued entries stay Pending and are queued again by RecreateDeviceObjects
+        mPending.clear();
+        mWarmUpQueue.clear();
+        mStateChanged.wait(lock, [this] { return mOutstandingJobs == 0 && !mWarmUpBusy; });
+
+        for (auto& [key, entry] : mEntries) {
+            if (entry.pipeline != VK_NULL_HANDLE) { vkDestroyPipeline(mContext->GetDevice(), entry.pipeline, nullptr); }
+            entry.pipeline = VK_NULL_HANDLE;
+            // Failures are retried too: a compile that hit the device loss must not stay failed on the new device
+            entry.state = State::Pending;
+            entry.error.clear();
+        }
+
+        // Layouts are owned by the application and die with the device
+        mLayouts.clear();
+        mGeneration.fetch_add(1, std::memory_order_release);
+    }
+
+    Result<void> PipelineCompiler::RecreateDeviceObjects() {
+        if (!mContext) { return std::unexpected("Pipeline compiler not initialized"); }
+
+        u32 jobs = 0;
+        {
+            std::lock_guard lock(mMutex);
+            for (const auto& [key, entry] : mEntries) {
+                if (entry.state != State::Pending) { continue; }
+                if (entry.speculative) {
+                    mWarmUpQueue.push_back({key, entry.desc});
+                } else {
+                    mPending.push_back({key, entry.desc});
+                    mOutstandingJobs++;
+                    jobs++;
+                }
+            }
+        }
+
+        for (u32 i = 0; i < jobs; i++) {
+            mJobs->Submit([this] { CompileNext(); });
+        }
+        mWarmUpSignal.notify_one();
+
+        return {};
+    }
+
+    void PipelineCompiler::RegisterLayout(const std::string& name, VkPipelineLayout layout) {
+        std::lock_guard lock(mMutex);
+        mLayouts[name] = layout;
+    }
+
+    u64 PipelineCompiler::CompileAsync(const GraphicsPipelineDesc& desc) {
+        GraphicsPipelineDesc normalized = Normalize(desc);
+        const u64 key                   = normalized.Hash();
+        return Enqueue(key, std::move(normalized));
+    }
+
+    u64 PipelineCompiler::CompileAsync(const ComputePipelineDesc& desc) {
+        return Enqueue(desc.Hash(), desc);
+    }
+
+    Result<VkPipeline> PipelineCompiler::Get(const GraphicsPipelineDesc& desc) {
+        const GraphicsPipelineDesc normalized = Normalize(desc);
+        return GetOrCompile(normalized.Hash(), normalized);
+    }
+
+    Result<VkPipeline> PipelineCompiler::Get(const ComputePipelineDesc& desc) {
+        return GetOrCompile(desc.Hash(), desc);
+    }
+
+    void PipelineCompiler::WarmUp(const PipelineManifest& manifest) {
+        if (!IsInitialized()) { return; }
+
+        {
+            std::lock_guard lock(mMutex);
+            for (auto& desc : manifest.GetEntries()) {
+                // The manifest may come from a device with different dynamic state support
+                if (auto* graphics = std::get_if<GraphicsPipelineDesc>(&desc)) { *graphics = Normalize(*graphics); }
+
+                const u64 key = std::visit([](const auto& d) { return d.Hash(); }, desc);
+                if (mEntries.contains(key)) { continue; }
+
+                Entry& entry      = mEntries[key];
+                entry.desc        = desc;
+                entry.speculative = true;
+                mWarmUpQueue.push_back({key, std::move(desc)});
+            }
+        }
+        mWarmUpSignal.notify_one();
+    }
+
+    VkPipeline PipelineCompiler::Find(u64 key) const {
+        std::lock_guard lock(mMutex);
+        const auto it = mEntries.find(key);
+        return it != mEntries.end() && it->second.state == State::Ready ? it->second.pipeline : VK_NULL_HANDLE;
+    }
+
+    std::optional<PipelineDesc> PipelineCompiler::FindDesc(VkPipeline pipeline) const {
+        if (pipeline == VK_NULL_HANDLE) { return std::nullopt; }
+
+        std::lock_guard lock(mMutex);
+        for (const auto& entry : mEntries | std::views::values) {
+            if (entry.state == State::Ready && entry.pipeline == pipeline) { return entry.desc; }
+        }
+        return std::nullopt;
+    }
+
+    VkPipeline PipelineCompiler::Acquire(u64 key) {
+        bool submit = false;
+        {
+            std::lock_guard lock(mMutex);
+            const auto it = mEntries.find(key);
+            if (it == mEntries.end()) { return VK_NULL_HANDLE; }
+
+            Entry& entry = it->second;
+            mUsage.RecordUse(key, entry.desc);
+            if (entry.state == State::Ready) { return entry.pipeline; }
+
+            if (entry.speculative) {
+                submit = Promote(key, entry);
+                if (submit) { mStats.boosted++; }
+            }
+        }
+
+        if (submit) { mJobs->Submit([this] { CompileNext(); }); }
+        return VK_NULL_HANDLE;
+    }
+
+    void PipelineCompiler::WaitIdle() {
+        std::unique_lock lock(mMutex);
+        mStateChanged.wait(lock, [this] {
+            return mPending.empty() && mWarmUpQueue.empty() && !mWarmUpBusy && mOutstandingJobs == 0;
+        });
+    }
+
+    PipelineCompiler::Stats PipelineCompiler::GetStats() const {
+        std::lock_guard lock(mMutex);
+        Stats stats   = mStats;
+        stats.pending = CAST<u32>(mPending.size() + mWarmUpQueue.size());
+        return stats;
+    }
+
+    GraphicsPipelineDesc PipelineCompiler::Normalize(GraphicsPipelineDesc desc) const {
+        desc.dynamicState &= mSupportedDynamicState;
+
+        // Mesh pipelines have no input assembly, so PipelineBuilder never declares topology dynamic for them
+        const auto meshStage = [](const ShaderStageDesc& stage) { return stage.stage == VK_SHADER_STAGE_MESH_BIT_EXT; };
+        if (std::ranges::any_of(desc.stages, meshStage)) { desc.dynamicState &= ~kDynamicTopology; }
+        return desc;
+    }
+
+    u64 PipelineCompiler::Enqueue(u64 key, Desc desc) {
+        if (!IsInitialized()) { return key; }
+
+        {
+            std::lock_guard lock(mMutex);
+            if (const auto it = mEntries.find(key); it != mEntries.end()) {
+                // Already known; if it is only waiting for warm-up, someone wants it now
+                if (!it->second.speculative || !Promote(key, it->second)) { return key; }
+            } else {
+                Entry& entry = mEntries[key];
+                entry.desc   = desc;
+                mPending.push_back({key, std::move(desc)});
+                mOutstandingJobs++;
+            }
+        }
+
+        mJobs->Submit([this] { CompileNext(); });
+        return key;
+    }
+
+    Result<VkPipeline> PipelineCompiler::GetOrCompile(u64 key, const Desc& desc) {
+        if (!IsInitialized()) { return std::unexpected("Pipeline compiler not initialized"); }
+
+        std::unique_lock lock(mMutex);
+
+        auto it = mEntries.find(key);
+        if (it == mEntries.end()) {
+            it              = mEntries.emplace(key, Entry {}).first;
+            it->second.desc = desc;
+        } else if (it->second.state == State::Pending) {
+            // Still queued: take it out of the queue and build it here instead of waiting behind other work
+            const auto matches = [key](const Request& request) { return request.key == key; };
+            std::erase_if(mPending, matches);
+            std::erase_if(mWarmUpQueue, matches);
+        }
+        it->second.speculative = false;
+
+        if (it->second.state == State::Pending) {
+            it->second.state = State::Compiling;
+            lock.unlock();
+            Compile(key, desc);
+            lock.lock();
+        }
+
+        mStateChanged.wait(lock, [&] {
+            const State state = mEntries.at(key).state;
+            return state == State::Ready || state == State::Failed;
+        });
+
+        const Entry& entry = mEntries.at(key);
+        if (entry.state == State::Failed) { return std::unexpected(entry.error); }
+        return entry.pipeline;
+    }
+
+    bool PipelineCompiler::Promote(u64 key, Entry& entry) {
+        entry.speculative = false;
+        if (entry.state != State::Pending) { return false; }
+
+        const auto it = std::ranges::find(mWarmUpQueue, key, &Request::key);
+        if (it == mWarmUpQueue.end()) { return false; }
+
+        mPending.push_front(std::move(*it));
+        mWarmUpQueue.erase(it);
+        mOutstandingJobs++;
+        return true;
+    }
+
+    void PipelineCompiler::CompileNext() {
+        std::unique_lock lock(mMutex);
+
+        if (!mPending.empty()) {
+            Request request = std::move(mPending.front());
+            mPending.pop_front();
+            mEntries[request.key].state = State::Compiling;
+
+            lock.unlock();
+            Compile(request.key, request.desc);
+            lock.lock();
+        }
+
+        mOutstandingJobs--;
+        mStateChanged.notify_all();
+    }
+
+    void PipelineCompiler::WarmUpLoop() {
+        std::unique_lock lock(mMutex);
+        while (true) {
+            mWarmUpSignal.wait(lock, [this] { return mStopWarmUp || !mWarmUpQueue.empty(); });
+            if (mStopWarmUp) { break; }
+
+            Request request = std::move(mWarmUpQueue.front());
+            mWarmUpQueue.pop_front();
+            mEntries[request.key].state = State::Compiling;
+            mWarmUpBusy                 = true;
+
+            lock.unlock();
+            Compile(request.key, request.desc);
+            lock.lock();
+
+            mWarmUpBusy = false;
+            mStateChanged.notify_all();
+        }
+    }
+
+    void PipelineCompiler::Compile(u64 key, const Desc& desc) {
+        const std::string& layoutName =
+          std::visit([](const auto& d) -> const std::string& { return d.layout; }, desc);
+
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+        {
+            std::lock_guard lock(mMutex);
+            if (const auto it = mLayouts.find(layoutName); it != mLayouts.end()) { layout = it->second; }
+        }
+
+        Result<VkPipeline> result = std::unexpected("Unknown pipeline layout: " + layoutName);
+        const auto start          = std::chrono::steady_clock::now();
+
+        if (layout != VK_NULL_HANDLE) {
+            const PipelineBuilder builder(mContext->GetDevice(), mCache ? mCache->GetCache() : VK_NULL_HANDLE, *mShaders);
+            result = std::visit([&](const auto& d) { return builder.Build(d, layout); }, desc);
+        }
+
+        const f64 elapsedMs =
+          std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        {
+            std::lock_guard lock(mMutex);
+            Entry& entry = mEntries[key];
+            if (result) {
+                entry.state    = State::Ready;
+                entry.pipeline = result.value();
+                mStats.compiled++;
+                mStats.totalCompileMs += elapsedMs;
+                if (entry.speculative) { mStats.warmedUp++; }
+            } else if (entry.speculative) {
+                // A stale manifest entry (renamed shader, unregistered layout); forget it rather than poison the key
+                mEntries.erase(key);
+            } else {
+                entry.state = State::Failed;
+                entry.error = result.error();
+                mStats.failed++;
+            }
+        }
+        mStateChanged.notify_all();
+    }
+}  // namespace Vulkano
@@ -0,0 +1,95 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "PipelineManifest.hpp"
+#include "Serialization.hpp"
+
+namespace Vulkano {
+    bool PipelineManifest::RecordUse(u64 key, const PipelineDesc& desc) {
+        std::lock_guard lock(mMutex);
+        if (!mKeys.insert(key).second) { return false; }
+        mEntries.push_back(desc);
+        return true;
+    }
+
+    Result<void> PipelineManifest::Load(const std::filesystem::path& path) {
+        auto fileResult = BinaryReader::LoadFile(path);
+        if (!fileResult) { return std::unexpected(fileResult.error()); }
+
+        BinaryReader reader(fileResult.value());
+
+        u32 magic   = 0;
+        u32 version = 0;
+        u32 count   = 0;
+        if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(count)) {
+            return std::unexpected("Pipeline manifest is truncated: " + path.string());
+        }
+        if (magic != kMagic) { return std::unexpected("Not a pipeline manifest: " + path.string()); }
+        if (version != kVersion) { return std::unexpected("Unsupported pipeline manifest version: " + path.string()); }
+
+        std::vector<PipelineDesc> entries;
+        std::unordered_set<u64> keys;
+        for (u32 i = 0; i < count; i++) {
+            Kind kind {};
+            if (!reader.Read(kind)) { break; }
+
+            PipelineDesc desc;
+            bool valid = false;
+            if (kind == Kind::Graphics) {
+                valid = desc.emplace<GraphicsPipelineDesc>().Deserialize(reader);
+            } else if (kind == Kind::Compute) {
+                valid = desc.emplace<ComputePipelineDesc>().Deserialize(reader);
+            }
+            if (!valid) { return std::unexpected("Pipeline manifest is corrupt: " + path.string()); }
+
+            // Keys are recomputed rather than stored, so a change to the hash just produces new keys
+            const u64 key = std::visit([](const auto& d) { return d.Hash(); }, desc);
+            if (keys.insert(key).second) { entries.push_back(std::move(desc)); }
+        }
+        if (reader.HasFailed()) { return std::unexpected("Pipeline manifest is truncated: " + path.string()); }
+
+        std::lock_guard lock(mMutex);
+        mEntries = std::move(entries);
+        mKeys    = std::move(keys);
+
+        return {};
+    }
+
+    Result<void> PipelineManifest::Save(const std::filesystem::path& path) const {
+        BinaryWriter writer;
+        {
+            std::lock_guard lock(mMutex);
+            writer.Write(kMagic);
+            writer.Write(kVersion);
+            writer.Write(CAST<u32>(mEntries.size()));
+            for (const auto& desc : mEntries) {
+                writer.Write(std::holds_alternative<GraphicsPipelineDesc>(desc) ? Kind::Graphics : Kind::Compute);
+                std::visit([&](const auto& d) { d.Serialize(writer); }, desc);
+            }
+        }
+
+        return writer.SaveToFile(path);
+    }
+
+    void PipelineManifest::Clear() {
+        std::lock_guard lock(mMutex);
+        mEntries.clear();
+        mKeys.clear();
+    }
+
+    std::vector<PipelineDesc> PipelineManifest::GetEntries() const {
+        std::lock_guard lock(mMutex);
+        return mEntries;
+    }
+
+    bool PipelineManifest::Contains(u64 key) const {
+        std::lock_guard lock(mMutex);
+        return mKeys.contains(key);
+    }
+
+    size_t PipelineManifest::GetSize() const {
+        std::lock_guard lock(mMutex);
+        return mEntries.size();
+    }
+}  // namespace Vulkano
@@ -0,0 +1,96 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "PresentBatcher.hpp"
+#include "SwapchainManager.hpp"
+#include "VulkanContext.hpp"
+
+#include <algorithm>
+
+namespace Vulkano {
+    PresentBatcher::~PresentBatcher() {
+        Shutdown();
+    }
+
+    Result<void> PresentBatcher::Initialize(VulkanContext* context) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (context->GetPresentQueue() == VK_NULL_HANDLE) { return std::unexpected("Device has no present queue"); }
+
+        mContext = context;
+        return {};
+    }
+
+    void PresentBatcher::Shutdown() {
+        mQueue = VK_NULL_HANDLE;
+        mSwapchains.clear();
+        mImageIndices.clear();
+        mWaitSemaphores.clear();
+        mResults.clear();
+        mContext = nullptr;
+    }
+
+    Result<void> PresentBatcher::Add(const SwapchainManager& swapchain, u32 imageIndex, VkSemaphore waitSemaphore) {
+        if (!IsInitialized()) { return std::unexpected("Present batcher not initialized"); }
+
+        if (!swapchain.IsInitialized()) { return std::unexpected("Swapchain not initialized"); }
+
+        if (imageIndex >= swapchain.GetImageCount()) { return std::unexpected("Swapchain image index out of range"); }
+
+        // A swapchain may appear only once in a VkPresentInfoKHR
+        if (std::ranges::find(mSwapchains, swapchain.GetSwapchain()) != mSwapchains.end()) {
+            return std::unexpected("Swapchain already added to this present batch");
+        }
+
+        if (mSwapchains.empty()) {
+            mQueue = swapchain.GetPresentQueue();
+        } else if (swapchain.GetPresentQueue() != mQueue) {
+            return std::unexpected("Swapchains in a present batch must share a present queue");
+        }
+
+        mSwapchains.push_back(swapchain.GetSwapchain());
+        mImageIndices.push_back(imageIndex);
+        const bool waited = std::ranges::find(mWaitSemaphores, waitSemaphore) != mWaitSemaphores.end();
+        if (waitSemaphore != VK_NULL_HANDLE && !waited) { mWaitSemaphores.push_back(waitSemaphore); }
+
+        return {};
+    }
+
+    Result<void> PresentBatcher::Present() {
+        if (!IsInitialized()) { return std::unexpected("Present batcher not initialized"); }
+
+        mResults.assign(mSwapchains.size(), VK_SUCCESS);
+        if (mSwapchains.empty()) { return {}; }
+
+        VkPresentInfoKHR presentInfo {};
+        presentInfo.sType              = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+        presentInfo.waitSemaphoreCount = CAST<u32>(mWaitSemaphores.size());
+        presentInfo.pWaitSemaphores    = mWaitSemaphores.data();
+        presentInfo.swapchainCount     = CAST<u32>(mSwapchains.size());
+        presentInfo.pSwapchains        = mSwapchains.data();
+        presentInfo.pImageIndices      = mImageIndices.data();
+        presentInfo.pResults           = mResults.data();
+
+        const VkResult result = vkQueuePresentKHR(mQueue, &presentInfo);
+
+        mQueue = VK_NULL_HANDLE;
+        mSwapchains.clear();
+        mImageIndices.clear();
+        mWaitSemaphores.clear();
+
+        // The overall result is the worst of the per-swapchain ones. Out-of-date and suboptimal are handled by the
+        // caller window by window; anything else is fatal whatever pResults holds.
+        if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR && result != VK_ERROR_OUT_OF_DATE_KHR) {
+            mContext->CheckDeviceLost(result);
+            return std::unexpected("Failed to present swapchain images");
+        }
+
+        return {};
+    }
+
+    bool PresentBatcher::NeedsRecreate(u32 entry) const {
+        if (entry >= mResults.size()) { return false; }
+        return mResults[entry] == VK_ERROR_OUT_OF_DATE_KHR || mResults[entry] == VK_SUBOPTIMAL_KHR;
+    }
+}  // namespace Vulkano
@@ -0,0 +1,307 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "RenderTarget.hpp"
+#include "ImageBarrier.hpp"
+#include "Pipeline.hpp"
+#include "VulkanContext.hpp"
+
+namespace Vulkano {
+    RenderTarget::~RenderTarget() {
+        Shutdown();
+    }
+
+    Result<void> RenderTarget::Initialize(VulkanContext* context, const Config& config) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (IsInitialized()) { return std::unexpected("Render target already created"); }
+
+        if (config.extent.width == 0 || config.extent.height == 0 || config.layers == 0) {
+            return std::unexpected("Render target extent and layer count must be greater than zero");
+        }
+
+        if (config.colorFormat == VK_FORMAT_UNDEFINED && config.depthFormat == VK_FORMAT_UNDEFINED) {
+            return std::unexpected("Render target needs a color or depth format");
+        }
+
+        if (config.cube && (config.layers != 6 || config.extent.width != config.extent.height)) {
+            return std::unexpected("Cube render targets need 6 square layers");
+        }
+
+        const auto& capabilities = context->GetCapabilities();
+        const bool multiview     = config.multiview && config.layers > 1;
+        if (multiview && (!capabilities.multiview || config.layers > capabilities.maxMultiviewViewCount)) {
+            return std::unexpected("Multiview is not supported for this many layers; render layers one at a time");
+        }
+
+        mContext   = context;
+        mConfig    = config;
+        mMultiview = multiview;
+
+        if (auto result = CreateImages(); !result) {
+            Shutdown();
+            return result;
+        }
+
+        return {};
+    }
+
+    void RenderTarget::Shutdown() {
+        if (!mContext) { return; }
+
+        DestroyImages();
+
+        mContext       = nullptr;
+        mConfig        = {};
+        mMultiview     = false;
+        mRenderedLayer = kAllLayers;
+    }
+
+    Result<void> RenderTarget::Resize(VkExtent2D extent) {
+        if (!IsInitialized()) { return std::unexpected("Render target not initialized"); }
+
+        if (extent.width == 0 || extent.height == 0) { return std::unexpected("Invalid render target extent"); }
+
+        if (mConfig.cube && extent.width != extent.height) { return std::unexpected("Cube render targets are square"); }
+
+        DestroyImages();
+        mConfig.extent = extent;
+        return CreateImages();
+    }
+
+    Result<void> RenderTarget::CreateImages() {
+        Result<void> result {};
+        if (mConfig.colorFormat != VK_FORMAT_UNDEFINED) {
+            result = CreateImage(mColor, mConfig.colorFormat, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, mConfig.colorUsage);
+        }
+        if (result && mConfig.depthFormat != VK_FORMAT_UNDEFINED) {
+            result = CreateImage(
+              mDepth, mConfig.depthFormat, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, mConfig.depthUsage);
+        }
+        return result;
+    }
+
+    void RenderTarget::DestroyImages() {
+        DestroyImage(mColor);
+        DestroyImage(mDepth);
+    }
+
+    Result<void> RenderTarget::CreateImage(Image& image,
+                                           VkFormat format,
+                                           VkImageUsageFlags usage,
+                                           VkImageUsageFlags extraUsage) {
+        const bool depth = (usage & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) != 0;
+        image.aspect     = depth ? DepthAspect(format) : CAST<VkImageAspectFlags>(VK_IMAGE_ASPECT_COLOR_BIT);
+        image.transient  = extraUsage == 0;
+        if (image.transient) { extraUsage = VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT; }
+
+        VkImageCreateInfo imageInfo {};
+        imageInfo.sType         = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.flags         = mConfig.cube ? CAST<VkImageCreateFlags>(VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT) : 0;
+        imageInfo.imageType     = VK_IMAGE_TYPE_2D;
+        imageInfo.format        = format;
+        imageInfo.extent        = {mConfig.extent.width, mConfig.extent.height, 1};
+        imageInfo.mipLevels     = 1;
+        imageInfo.arrayLayers   = mConfig.layers;
+        imageInfo.samples       = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling        = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage         = usage | extraUsage;
+        imageInfo.sharingMode   = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        // Desktop GPUs usually have no lazily allocated memory; transient images then live in ordinary device memory
+        VmaAllocationCreateInfo allocationInfo {};
+        allocationInfo.usage = image.transient ? VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED : VMA_MEMORY_USAGE_AUTO;
+
+        VkResult result = vmaCreateImage(
+          mContext->GetAllocator(), &imageInfo, &allocationInfo, &image.image, &image.allocation, nullptr);
+        if (result != VK_SUCCESS && image.transient) {
+            allocationInfo.usage = VMA_MEMORY_USAGE_AUTO;
+            result               = vmaCreateImage(
+              mContext->GetAllocator(), &imageInfo, &allocationInfo, &image.image, &image.allocation, nullptr);
+        }
+        if (result != VK_SUCCESS) { return std::unexpected("Failed to create render target image"); }
+
+        if (auto created = CreateView(image, format, VK_IMAGE_VIEW_TYPE_2D_ARRAY, 0, mConfig.layers, image.view);
+            !created) {
+            return created;
+        }
+
+        // Per-layer views for rendering layers one at a time and for sampling a single eye, face or cascade
+        image.layerViews.assign(mConfig.layers, VK_NULL_HANDLE);
+        for (u32 layer = 0; layer < mConfig.layers; layer++) {
+            if (auto created = CreateView(image, format, VK_IMAGE_VIEW_TYPE_2D, layer, 1, image.layerViews[layer]);
+                !created) {
+                return created;
+            }
+        }
+
+        if (mConfig.cube && !image.transient) {
+            return CreateView(image, format, VK_IMAGE_VIEW_TYPE_CUBE, 0, mConfig.layers, image.cubeView);
+        }
+
+        return {};
+    }
+
+    Result<void> RenderTarget::CreateView(const Image& image,
+                                          VkFormat format,
+                                          VkImageViewType type,
+                                          u32 baseLayer,
+                                          u32 layers,
+                                          VkImageView& view) const {
+        VkImageViewCreateInfo viewInfo {};
+        viewInfo.sType                           = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image                           = image.image;
+        viewInfo.viewType                        = type;
+        viewInfo.format                          = format;
+        viewInfo.subresourceRange.aspectMask     = image.aspect;
+        viewInfo.subresourceRange.levelCount     = 1;
+        viewInfo.subresourceRange.baseArrayLayer = baseLayer;
+        viewInfo.subresourceRange.layerCount     = layers;
+        if (vkCreateImageView(mContext->GetDevice(), &viewInfo, nullptr, &view) != VK_SUCCESS) {
+            return std::unexpected("Failed to create render target image view");
+        }
+
+        return {};
+    }
+
+    void RenderTarget::DestroyImage(Image& image) const {
+        const VkDevice device = mContext->GetDevice();
+        for (const VkImageView view : image.layerViews) {
+            if (view != VK_NULL_HANDLE) { vkDestroyImageView(device, view, nullptr); }
+        }
+        if (image.cubeView != VK_NULL_HANDLE) { vkDestroyImageView(device, image.cubeView, nullptr); }
+        if (image.view != VK_NULL_HANDLE) { vkDestroyImageView(device, image.view, nullptr); }
+        if (image.image != VK_NULL_HANDLE) { vmaDestroyImage(mContext->GetAllocator(), image.image, image.allocation); }
+        image = {};
+    }
+
+    Result<void>
+    RenderTarget::BeginRendering(VkCommandBuffer commandBuffer, const VkClearColorValue& clearColor, u32 layer) {
+        if (!IsInitialized()) { return std::unexpected("Render target not initialized"); }
+
+        if (layer != kAllLayers && layer >= mConfig.layers) {
+            return std::unexpected("Render target layer out of range");
+        }
+
+        const bool allLayers = layer == kAllLayers || mConfig.layers == 1;
+        const u32 baseLayer  = allLayers ? 0 : layer;
+        const u32 layers     = allLayers ? mConfig.layers : 1;
+        mRenderedLayer       = allLayers ? kAllLayers : layer;
+
+        // Previous contents are never needed; the barriers only order against last use as a texture or attachment
+        if (mColor.image != VK_NULL_HANDLE) {
+            ImageBarrier(commandBuffer,
+                         mColor.image,
+                         mColor.aspect,
+                         baseLayer,
+                         layers,
+                         VK_IMAGE_LAYOUT_UNDEFINED,
+                         VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
+                           VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         0,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+        }
+        if (mDepth.image != VK_NULL_HANDLE) {
+            ImageBarrier(commandBuffer,
+                         mDepth.image,
+                         mDepth.aspect,
+                         baseLayer,
+                         layers,
+                         VK_IMAGE_LAYOUT_UNDEFINED,
+                         VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT |
+                           VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                         VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                         VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                         VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+        }
+
+        // A multiview pass renders into the array views with the view mask; a single layer through its own view
+        VkRenderingAttachmentInfo colorAttachment {};
+        colorAttachment.sType            = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        colorAttachment.imageView        = allLayers ? mColor.view : mColor.layerViews[layer];
+        colorAttachment.imageLayout      = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        colorAttachment.loadOp           = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        colorAttachment.storeOp          = mColor.transient ? VK_ATTACHMENT_STORE_OP_DONT_CARE
+                                                            : VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachment.clearValue.color = clearColor;
+
+        VkRenderingAttachmentInfo depthAttachment {};
+        depthAttachment.sType                   = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        depthAttachment.imageView               = allLayers ? mDepth.view : mDepth.layerViews[layer];
+        depthAttachment.imageLayout             = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depthAttachment.loadOp                  = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp                 = mDepth.transient ? VK_ATTACHMENT_STORE_OP_DONT_CARE
+                                                                   : VK_ATTACHMENT_STORE_OP_STORE;
+        depthAttachment.clearValue.depthStencil = {1.0f, 0};
+
+        // layerCount is ignored once a view mask is set; without one, an all-layer pass is plain layered rendering
+        VkRenderingInfo renderingInfo {};
+        renderingInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO;
+        renderingInfo.renderArea           = {{0, 0}, mConfig.extent};
+        renderingInfo.layerCount           = layers;
+        renderingInfo.viewMask             = allLayers ? GetViewMask() : 0;
+        renderingInfo.colorAttachmentCount = mColor.image != VK_NULL_HANDLE ? 1 : 0;
+        renderingInfo.pColorAttachments    = mColor.image != VK_NULL_HANDLE ? &colorAttachment : nullptr;
+        renderingInfo.pDepthAttachment     = mDepth.image != VK_NULL_HANDLE ? &depthAttachment : nullptr;
+
+        const VkViewport viewport {
+          0.0f, 0.0f, CAST<f32>(mConfig.extent.width), CAST<f32>(mConfig.extent.height), 0.0f, 1.0f};
+        const VkRect2D scissor {{0, 0}, mConfig.extent};
+
+        vkCmdBeginRendering(commandBuffer, &renderingInfo);
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+        return {};
+    }
+
+    void RenderTarget::EndRendering(VkCommandBuffer commandBuffer) const {
+        if (!IsInitialized()) { return; }
+
+        vkCmdEndRendering(commandBuffer);
+
+        const u32 baseLayer = mRenderedLayer == kAllLayers ? 0 : mRenderedLayer;
+        const u32 layers    = mRenderedLayer == kAllLayers ? mConfig.layers : 1;
+        const VkPipelineStageFlags readers =
+          VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+        if (mColor.image != VK_NULL_HANDLE && (mConfig.colorUsage & VK_IMAGE_USAGE_SAMPLED_BIT)) {
+            ImageBarrier(commandBuffer,
+                         mColor.image,
+                         mColor.aspect,
+                         baseLayer,
+                         layers,
+                         VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                         readers,
+                         VK_ACCESS_SHADER_READ_BIT);
+        }
+        if (mDepth.image != VK_NULL_HANDLE && (mConfig.depthUsage & VK_IMAGE_USAGE_SAMPLED_BIT)) {
+            ImageBarrier(commandBuffer,
+                         mDepth.image,
+                         mDepth.aspect,
+                         baseLayer,
+                         layers,
+                         VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                         VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                         VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                         readers,
+                         VK_ACCESS_SHADER_READ_BIT);
+        }
+    }
+
+    void RenderTarget::ConfigurePipeline(GraphicsPipelineDesc& desc, bool allLayers) const {
+        desc.colorFormats.clear();
+        if (mConfig.colorFormat != VK_FORMAT_UNDEFINED) { desc.colorFormats.push_back(mConfig.colorFormat); }
+        desc.depthFormat = mConfig.depthFormat;
+        desc.viewMask    = allLayers ? GetViewMask() : 0;
+    }
+}  // namespace Vulkano
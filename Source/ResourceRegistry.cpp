@@ -0,0 +1,61 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "ResourceRegistry.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace Vulkano {
+    ResourceRegistry::Handle ResourceRegistry::Register(std::string_view name,
+                                                        RecoveryStage stage,
+                                                        std::function<void()> release,
+                                                        std::function<Result<void>()> recreate) {
+        std::lock_guard lock(mMutex);
+        const Handle handle = mNextHandle++;
+        mEntries.push_back({handle, std::string(name), stage, std::move(release), std::move(recreate)});
+        return handle;
+    }
+
+    void ResourceRegistry::Unregister(Handle handle) {
+        std::lock_guard lock(mMutex);
+        std::erase_if(mEntries, [handle](const Entry& entry) { return entry.handle == handle; });
+    }
+
+    void ResourceRegistry::ReleaseAll() {
+        const auto entries = Snapshot();
+        for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+            if (it->release) { it->release(); }
+        }
+    }
+
+    Result<void> ResourceRegistry::RecreateAll() {
+        for (const auto& entry : Snapshot()) {
+            if (!entry.recreate) { continue; }
+            if (auto result = entry.recreate(); !result) {
+                return std::unexpected("Failed to recreate " + entry.name + ": " + result.error());
+            }
+        }
+
+        return {};
+    }
+
+    size_t ResourceRegistry::GetCount() const {
+        std::lock_guard lock(mMutex);
+        return mEntries.size();
+    }
+
+    std::vector<ResourceRegistry::Entry> ResourceRegistry::Snapshot() const {
+        std::vector<Entry> entries;
+        {
+            std::lock_guard lock(mMutex);
+            entries = mEntries;
+        }
+        // Registration order within a stage; handles only ever grow
+        std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            return CAST<u8>(a.stage) < CAST<u8>(b.stage);
+        });
+        return entries;
+    }
+}  // namespace Vulkano
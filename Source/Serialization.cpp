@@ -0,0 +1,42 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "Serialization.hpp"
+
+#include <fstream>
+
+namespace Vulkano {
+    Result<void> BinaryWriter::SaveToFile(const std::filesystem::path& path) const {
+        std::filesystem::path tempPath = path;
+        tempPath += ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            if (!file) { return std::unexpected("Failed to open file for writing: " + tempPath.string()); }
+            file.write(RCAST<const char*>(mData.data()), CAST<std::streamsize>(mData.size()));
+            if (!file) { return std::unexpected("Failed to write file: " + tempPath.string()); }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if (error) { return std::unexpected("Failed to replace " + path.string() + ": " + error.message()); }
+
+        return {};
+    }
+
+    Result<std::vector<u8>> BinaryReader::LoadFile(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) { return std::unexpected("Failed to open file: " + path.string()); }
+
+        const std::streamsize size = file.tellg();
+        if (size < 0) { return std::unexpected("Failed to query file size: " + path.string()); }
+
+        std::vector<u8> data(CAST<size_t>(size));
+        file.seekg(0);
+        if (size > 0 && !file.read(RCAST<char*>(data.data()), size)) {
+            return std::unexpected("Failed to read file: " + path.string());
+        }
+
+        return data;
+    }
+}  // namespace Vulkano
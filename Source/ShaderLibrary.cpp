@@ -0,0 +1,150 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "ShaderLibrary.hpp"
+#include "VulkanContext.hpp"
+
+#include <fstream>
+
+namespace Vulkano {
+    ShaderLibrary::~ShaderLibrary() {
+        Shutdown();
+    }
+
+    void ShaderLibrary::LoadAsync(JobSystem& jobs, std::string name, const std::filesystem::path& path) {
+        std::lock_guard lock(mMutex);
+        if (mEntries.contains(name)) { return; }
+
+        // std::unordered_map never moves its nodes, so the job can hold on to the entry
+        Entry& entry = mEntries[name];
+
+        entry.loadJob = jobs.Submit([&entry, path] {
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file) {
+                entry.error = "Failed to open shader file: " + path.string();
+                return;
+            }
+
+            const std::streamsize size = file.tellg();
+            if (size <= 0 || size % sizeof(u32) != 0) {
+                entry.error = "Invalid SPIR-V file size: " + path.string();
+                return;
+            }
+
+            std::vector<u32> code(CAST<size_t>(size) / sizeof(u32));
+            file.seekg(0);
+            if (!file.read(RCAST<char*>(code.data()), size)) {
+                entry.error = "Failed to read shader file: " + path.string();
+                return;
+            }
+
+            entry.code = std::move(code);
+        });
+    }
+
+    Result<void> ShaderLibrary::Add(std::string name, std::vector<u32> code) {
+        if (code.empty()) { return std::unexpected("Empty SPIR-V code for shader: " + name); }
+
+        std::lock_guard lock(mMutex);
+        if (mEntries.contains(name)) { return std::unexpected("Shader already added: " + name); }
+
+        Entry& entry = mEntries[name];
+        entry.code   = std::move(code);
+
+        // Late additions get their module right away
+        if (mContext) { return CreateModule(name, entry); }
+
+        return {};
+    }
+
+    Result<void> ShaderLibrary::Initialize(VulkanContext* context) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        auto scope = context->GetStartupProfiler().Measure("Shader modules");
+
+        std::lock_guard lock(mMutex);
+        mContext = context;
+
+        for (auto& [name, entry] : mEntries) {
+            if (entry.module != VK_NULL_HANDLE) { continue; }
+            if (auto result = CreateModule(name, entry); !result) { return result; }
+        }
+
+        return {};
+    }
+
+    void ShaderLibrary::Shutdown() {
+        std::lock_guard lock(mMutex);
+
+        for (auto& [name, entry] : mEntries) {
+            if (entry.loadJob.valid()) { entry.loadJob.wait(); }
+            if (mContext && entry.module != VK_NULL_HANDLE) {
+                vkDestroyShaderModule(mContext->GetDevice(), entry.module, nullptr);
+            }
+        }
+
+        mEntries.clear();
+        mContext = nullptr;
+    }
+
+    void ShaderLibrary::ReleaseDeviceObjects() {
+        std::lock_guard lock(mMutex);
+        if (!mContext) { return; }
+
+        for (auto& [name, entry] : mEntries) {
+            if (entry.module == VK_NULL_HANDLE) { continue; }
+            vkDestroyShaderModule(mContext->GetDevice(), entry.module, nullptr);
+            entry.module = VK_NULL_HANDLE;
+        }
+    }
+
+    Result<void> ShaderLibrary::RecreateDeviceObjects() {
+        std::lock_guard lock(mMutex);
+        if (!mContext) { return std::unexpected("Shader library not initialized"); }
+
+        for (auto& [name, entry] : mEntries) {
+            if (entry.module != VK_NULL_HANDLE) { continue; }
+            if (auto result = CreateModule(name, entry); !result) { return result; }
+        }
+
+        return {};
+    }
+
+    VkShaderModule ShaderLibrary::GetModule(std::string_view name) const {
+        std::lock_guard lock(mMutex);
+        const auto it = mEntries.find(name);
+        return it != mEntries.end() ? it->second.module : VK_NULL_HANDLE;
+    }
+
+    std::vector<u32> ShaderLibrary::GetCode(std::string_view name) const {
+        std::lock_guard lock(mMutex);
+        const auto it = mEntries.find(name);
+        if (it == mEntries.end()) { return {}; }
+
+        if (it->second.loadJob.valid()) { it->second.loadJob.wait(); }
+        return it->second.code;
+    }
+
+    bool ShaderLibrary::Contains(std::string_view name) const {
+        std::lock_guard lock(mMutex);
+        return mEntries.contains(name);
+    }
+
+    Result<void> ShaderLibrary::CreateModule(const std::string& name, Entry& entry) const {
+        if (entry.loadJob.valid()) { entry.loadJob.wait(); }
+
+        if (!entry.error.empty()) { return std::unexpected(entry.error); }
+
+        VkShaderModuleCreateInfo moduleInfo {};
+        moduleInfo.sType    = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        moduleInfo.codeSize = entry.code.size() * sizeof(u32);
+        moduleInfo.pCode    = entry.code.data();
+
+        if (vkCreateShaderModule(mContext->GetDevice(), &moduleInfo, nullptr, &entry.module) != VK_SUCCESS) {
+            return std::unexpected("Failed to create shader module: " + name);
+        }
+
+        return {};
+    }
+}  // namespace Vulkano
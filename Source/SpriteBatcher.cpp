@@ -0,0 +1,420 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "SpriteBatcher.hpp"
+#include "FrameSynchronizer.hpp"
+#include "PipelineCompiler.hpp"
+#include "VulkanContext.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace Vulkano {
+    namespace {
+        constexpr const char* kLayoutName {"Vulkano.SpriteBatcher"};
+        constexpr u32 kMaxTextureIndex {1u << 16};  // Texture indices fill the low half of the sort key
+
+        enum Binding : u32 {
+            kSampler,
+            kTextures,
+        };
+
+        /// @brief Per-instance attribute streams, one vertex buffer binding each
+        enum Stream : u32 {
+            kPositionStream,
+            kSizeStream,
+            kRotationStream,
+            kUvStream,
+            kColorStream,
+            kTextureStream,
+            kStreamCount,
+        };
+
+        constexpr VkDeviceSize kStreamStrides[kStreamCount] = {
+          sizeof(f32) * 2,
+          sizeof(f32) * 2,
+          sizeof(f32),
+          sizeof(u16) * 4,
+          sizeof(u32),
+          sizeof(u32),
+        };
+
+        constexpr VkFormat kStreamFormats[kStreamCount] = {
+          VK_FORMAT_R32G32_SFLOAT,
+          VK_FORMAT_R32G32_SFLOAT,
+          VK_FORMAT_R32_SFLOAT,
+          VK_FORMAT_R16G16B16A16_UNORM,
+          VK_FORMAT_R8G8B8A8_UNORM,
+          VK_FORMAT_R32_UINT,
+        };
+
+        u16 ToUnorm16(f32 value) {
+            return CAST<u16>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+        }
+
+        /// @brief Stable LSD radix sort of count (key, value) pairs on 8-bit digits. Passes where every key has the
+        /// same digit are skipped, which is most of them when only a few layers and textures are in use. Results
+        /// end up in keys/values; the scratch arrays must hold count elements.
+        u32 RadixSort(u32*& keys, u32*& values, u32*& scratchKeys, u32*& scratchValues, u32 count) {
+            std::array<std::array<u32, 256>, 4> histograms {};
+            for (u32 i = 0; i < count; i++) {
+                const u32 key = keys[i];
+                histograms[0][key & 0xFF]++;
+                histograms[1][(key >> 8) & 0xFF]++;
+                histograms[2][(key >> 16) & 0xFF]++;
+                histograms[3][key >> 24]++;
+            }
+
+            u32 passes = 0;
+            for (u32 digit = 0; digit < 4; digit++) {
+                const u32 shift = digit * 8;
+                auto& histogram = histograms[digit];
+                if (histogram[(keys[0] >> shift) & 0xFF] == count) { continue; }
+
+                u32 offset = 0;
+                for (u32& bucket : histogram) {
+                    const u32 size = bucket;
+                    bucket         = offset;
+                    offset += size;
+                }
+
+                for (u32 i = 0; i < count; i++) {
+                    const u32 slot      = histogram[(keys[i] >> shift) & 0xFF]++;
+                    scratchKeys[slot]   = keys[i];
+                    scratchValues[slot] = values[i];
+                }
+                std::swap(keys, scratchKeys);
+                std::swap(values, scratchValues);
+                passes++;
+            }
+            return passes;
+        }
+    }  // namespace
+
+    SpriteBatcher::~SpriteBatcher() {
+        Shutdown();
+    }
+
+    Result<void> SpriteBatcher::Initialize(VulkanContext* context, PipelineCompiler* compiler, const Config& config) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (!compiler || !compiler->IsInitialized()) { return std::unexpected("Invalid or uninitialized compiler"); }
+
+        if (IsInitialized()) { return std::unexpected("Sprite batcher already created"); }
+
+        const auto& capabilities = context->GetCapabilities();
+        if (!capabilities.bindlessTextures) {
+            return std::unexpected("Sprite batcher needs descriptor indexing for bindless textures");
+        }
+
+        if (config.maxSprites == 0 || config.maxTextures == 0 || config.framesInFlight == 0) {
+            return std::unexpected("Sprite, texture and frame counts must be greater than zero");
+        }
+
+        if (config.maxTextures > std::min(kMaxTextureIndex, capabilities.maxBindlessTextures)) {
+            return std::unexpected("Texture table larger than the device or the sort key allows");
+        }
+
+        mContext = context;
+        mConfig  = config;
+
+        mSprites.reserve(config.maxSprites);
+        for (auto* scratch : {&mKeys, &mOrder, &mScratchKeys, &mScratchOrder}) {
+            scratch->resize(config.maxSprites);
+        }
+        mTextureUsed.assign(config.maxTextures, false);
+
+        // Each stream is aligned separately within the frame's region
+        VkDeviceSize bytesPerFrame = 0;
+        for (const VkDeviceSize stride : kStreamStrides) {
+            bytesPerFrame += stride * config.maxSprites + 256;
+        }
+        if (auto result =
+              mInstances.Initialize(context, bytesPerFrame, config.framesInFlight, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+            !result) {
+            Shutdown();
+            return result;
+        }
+
+        if (auto result = CreateTextureTable(); !result) {
+            Shutdown();
+            return result;
+        }
+
+        const VkPushConstantRange pushRange {VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(Constants)};
+
+        VkPipelineLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        layoutInfo.setLayoutCount         = 1;
+        layoutInfo.pSetLayouts            = &mSetLayout;
+        layoutInfo.pushConstantRangeCount = 1;
+        layoutInfo.pPushConstantRanges    = &pushRange;
+        if (vkCreatePipelineLayout(context->GetDevice(), &layoutInfo, nullptr, &mPipelineLayout) != VK_SUCCESS) {
+            Shutdown();
+            return std::unexpected("Failed to create sprite pipeline layout");
+        }
+        compiler->RegisterLayout(kLayoutName, mPipelineLayout);
+
+        GraphicsPipelineDesc desc;
+        desc.layout = kLayoutName;
+        desc.stages = {{VK_SHADER_STAGE_VERTEX_BIT, "Sprite.vert", "main", {}},
+                       {VK_SHADER_STAGE_FRAGMENT_BIT, "Sprite.frag", "main", {}}};
+        for (u32 stream = 0; stream < kStreamCount; stream++) {
+            desc.vertexBindings.push_back({stream, CAST<u32>(kStreamStrides[stream]), VK_VERTEX_INPUT_RATE_INSTANCE});
+            desc.vertexAttributes.push_back({stream, stream, kStreamFormats[stream], 0});
+        }
+        desc.topology     = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+        desc.alphaBlend   = true;
+        desc.colorFormats = {config.colorFormat};
+
+        auto pipelineResult = compiler->Get(desc);
+        if (!pipelineResult) {
+            Shutdown();
+            return std::unexpected(pipelineResult.error());
+        }
+        mPipeline = pipelineResult.value();
+
+        return {};
+    }
+
+    Result<void> SpriteBatcher::CreateTextureTable() {
+        const VkDevice device = mContext->GetDevice();
+
+        VkSamplerCreateInfo samplerInfo {};
+        samplerInfo.sType        = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter    = mConfig.filter;
+        samplerInfo.minFilter    = mConfig.filter;
+        samplerInfo.mipmapMode   = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.maxLod       = VK_LOD_CLAMP_NONE;
+        if (vkCreateSampler(device, &samplerInfo, nullptr, &mSampler) != VK_SUCCESS) {
+            return std::unexpected("Failed to create sprite sampler");
+        }
+
+        // Slots are written as textures are registered, possibly while earlier frames still use other slots
+        const VkDescriptorBindingFlags bindingFlags[] = {
+          0,
+          VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+            VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT,
+        };
+        const VkDescriptorSetLayoutBinding bindings[] = {
+          {kSampler, VK_DESCRIPTOR_TYPE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, &mSampler},
+          {kTextures, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, mConfig.maxTextures, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr},
+        };
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo flagsInfo {};
+        flagsInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        flagsInfo.bindingCount  = 2;
+        flagsInfo.pBindingFlags = bindingFlags;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo {};
+        layoutInfo.sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.pNext        = &flagsInfo;
+        layoutInfo.flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        layoutInfo.bindingCount = 2;
+        layoutInfo.pBindings    = bindings;
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &mSetLayout) != VK_SUCCESS) {
+            return std::unexpected("Failed to create sprite texture table layout");
+        }
+
+        const VkDescriptorPoolSize poolSizes[] = {
+          {VK_DESCRIPTOR_TYPE_SAMPLER, 1},
+          {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, mConfig.maxTextures},
+        };
+
+        VkDescriptorPoolCreateInfo poolInfo {};
+        poolInfo.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        poolInfo.maxSets       = 1;
+        poolInfo.poolSizeCount = 2;
+        poolInfo.pPoolSizes    = poolSizes;
+        if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &mPool) != VK_SUCCESS) {
+            return std::unexpected("Failed to create sprite texture table pool");
+        }
+
+        VkDescriptorSetAllocateInfo allocateInfo {};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.descriptorPool     = mPool;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts        = &mSetLayout;
+        if (vkAllocateDescriptorSets(device, &allocateInfo, &mTextureSet) != VK_SUCCESS) {
+            return std::unexpected("Failed to allocate sprite texture table");
+        }
+
+        return {};
+    }
+
+    void SpriteBatcher::Shutdown() {
+        if (!mContext) { return; }
+
+        const VkDevice device = mContext->GetDevice();
+        if (mPipelineLayout != VK_NULL_HANDLE) { vkDestroyPipelineLayout(device, mPipelineLayout, nullptr); }
+        if (mPool != VK_NULL_HANDLE) { vkDestroyDescriptorPool(device, mPool, nullptr); }
+        if (mSetLayout != VK_NULL_HANDLE) { vkDestroyDescriptorSetLayout(device, mSetLayout, nullptr); }
+        if (mSampler != VK_NULL_HANDLE) { vkDestroySampler(device, mSampler, nullptr); }
+        mInstances.Shutdown();
+
+        mPipelineLayout = VK_NULL_HANDLE;
+        mPipeline       = VK_NULL_HANDLE;
+        mPool           = VK_NULL_HANDLE;
+        mTextureSet     = VK_NULL_HANDLE;
+        mSetLayout      = VK_NULL_HANDLE;
+        mSampler        = VK_NULL_HANDLE;
+        mTextureUsed.clear();
+        mFreeTextures.clear();
+        mRetiredTextures.clear();
+        mSprites.clear();
+        mKeys.clear();
+        mOrder.clear();
+        mScratchKeys.clear();
+        mScratchOrder.clear();
+        mTextureCount = 0;
+        mFrameNumber  = 0;
+        mDropped      = 0;
+        mStats        = {};
+        mContext      = nullptr;
+    }
+
+    Result<u32> SpriteBatcher::RegisterTexture(VkImageView view) {
+        if (!IsInitialized()) { return std::unexpected("Sprite batcher not initialized"); }
+
+        u32 texture = 0;
+        if (!mFreeTextures.empty()) {
+            texture = mFreeTextures.back();
+            mFreeTextures.pop_back();
+        } else if (mTextureCount < mConfig.maxTextures) {
+            texture = mTextureCount++;
+        } else {
+            return std::unexpected("Sprite texture table is full");
+        }
+
+        const VkDescriptorImageInfo imageInfo {VK_NULL_HANDLE, view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+
+        VkWriteDescriptorSet write {};
+        write.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet          = mTextureSet;
+        write.dstBinding      = kTextures;
+        write.dstArrayElement = texture;
+        write.descriptorCount = 1;
+        write.descriptorType  = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+        write.pImageInfo      = &imageInfo;
+        vkUpdateDescriptorSets(mContext->GetDevice(), 1, &write, 0, nullptr);
+
+        mTextureUsed[texture] = true;
+        return texture;
+    }
+
+    void SpriteBatcher::ReleaseTexture(u32 texture) {
+        if (texture >= mTextureCount || !mTextureUsed[texture]) { return; }
+
+        mTextureUsed[texture] = false;
+        mRetiredTextures.emplace_back(texture, mFrameNumber);
+    }
+
+    void SpriteBatcher::BeginFrame(const FrameSynchronizer& frames) {
+        if (!IsInitialized()) { return; }
+
+        mInstances.BeginFrame(frames.GetCurrentFrameIndex() % mConfig.framesInFlight);
+        mSprites.clear();
+        mDropped = 0;
+        mFrameNumber++;
+
+        // A slot released during frame N may still be read by frames up to N + framesInFlight - 1
+        std::erase_if(mRetiredTextures, [this](const std::pair<u32, u64>& retired) {
+            if (retired.second + mConfig.framesInFlight > mFrameNumber) { return false; }
+            mFreeTextures.push_back(retired.first);
+            return true;
+        });
+    }
+
+    void SpriteBatcher::Add(const Sprite& sprite) {
+        if (mSprites.size() >= mConfig.maxSprites || sprite.texture >= mTextureCount || !mTextureUsed[sprite.texture]) {
+            mDropped++;
+            return;
+        }
+        mSprites.push_back(sprite);
+    }
+
+    void SpriteBatcher::Add(std::span<const Sprite> sprites) {
+        for (const Sprite& sprite : sprites) {
+            Add(sprite);
+        }
+    }
+
+    Result<void> SpriteBatcher::Flush(const FrameSynchronizer& frames, const View& view, VkExtent2D extent) {
+        if (!IsInitialized()) { return std::unexpected("Sprite batcher not initialized"); }
+
+        if (extent.width == 0 || extent.height == 0) { return std::unexpected("Viewport extent must not be empty"); }
+
+        mStats                = {};
+        mStats.droppedSprites = mDropped;
+        const u32 count       = CAST<u32>(mSprites.size());
+        if (count == 0) { return {}; }
+
+        // Layer in the high half so it dominates; the sort is stable, so equal keys keep submission order
+        u32* keys          = mKeys.data();
+        u32* order         = mOrder.data();
+        u32* scratchKeys   = mScratchKeys.data();
+        u32* scratchValues = mScratchOrder.data();
+        for (u32 i = 0; i < count; i++) {
+            keys[i]  = CAST<u32>(mSprites[i].layer) << 16 | mSprites[i].texture;
+            order[i] = i;
+        }
+        mStats.sortPasses = RadixSort(keys, order, scratchKeys, scratchValues, count);
+
+        std::array<TransientRing::Allocation, kStreamCount> streams {};
+        for (u32 stream = 0; stream < kStreamCount; stream++) {
+            streams[stream] = mInstances.Allocate(kStreamStrides[stream] * count);
+            if (!streams[stream]) { return std::unexpected("Sprite instance ring is full"); }
+        }
+
+        auto* positions = CAST<f32*>(streams[kPositionStream].mapped);
+        auto* sizes     = CAST<f32*>(streams[kSizeStream].mapped);
+        auto* rotations = CAST<f32*>(streams[kRotationStream].mapped);
+        auto* uvs       = CAST<u16*>(streams[kUvStream].mapped);
+        auto* colors    = CAST<u32*>(streams[kColorStream].mapped);
+        auto* textures  = CAST<u32*>(streams[kTextureStream].mapped);
+        for (u32 i = 0; i < count; i++) {
+            const Sprite& sprite = mSprites[order[i]];
+            positions[i * 2]     = sprite.position[0];
+            positions[i * 2 + 1] = sprite.position[1];
+            sizes[i * 2]         = sprite.size[0];
+            sizes[i * 2 + 1]     = sprite.size[1];
+            rotations[i]         = sprite.rotation;
+            for (u32 c = 0; c < 4; c++) {
+                uvs[i * 4 + c] = ToUnorm16(sprite.uvRect[c]);
+            }
+            colors[i]   = sprite.color;
+            textures[i] = sprite.texture;
+        }
+
+        // ndc = (world - view.position) * zoom * 2 / extent - 1
+        Constants constants {};
+        constants.worldToNdc[0] = 2.0f * view.zoom / CAST<f32>(extent.width);
+        constants.worldToNdc[1] = 2.0f * view.zoom / CAST<f32>(extent.height);
+        constants.worldToNdc[2] = -view.position[0] * constants.worldToNdc[0] - 1.0f;
+        constants.worldToNdc[3] = -view.position[1] * constants.worldToNdc[1] - 1.0f;
+
+        std::array<VkBuffer, kStreamCount> buffers {};
+        std::array<VkDeviceSize, kStreamCount> offsets {};
+        for (u32 stream = 0; stream < kStreamCount; stream++) {
+            buffers[stream] = streams[stream].buffer;
+            offsets[stream] = streams[stream].offset;
+        }
+
+        const VkCommandBuffer cmd = frames.GetCurrentCommandBuffer();
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, mPipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, mPipelineLayout, 0, 1, &mTextureSet, 0, nullptr);
+        vkCmdPushConstants(cmd, mPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(Constants), &constants);
+        vkCmdBindVertexBuffers(cmd, 0, kStreamCount, buffers.data(), offsets.data());
+        vkCmdDraw(cmd, 4, count, 0, 0);
+
+        mStats.sprites = count;
+        mStats.draws   = 1;
+        return {};
+    }
+}  // namespace Vulkano
@@ -0,0 +1,87 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "StartupProfiler.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace Vulkano {
+    void StartupProfiler::Reset() {
+        std::lock_guard lock(mMutex);
+        mOrigin = Clock::now();
+        mPhases.clear();
+        mTimeToFirstFrame.reset();
+    }
+
+    void StartupProfiler::Record(std::string_view name, TimePoint start, TimePoint end) {
+        std::lock_guard lock(mMutex);
+        const f64 startMs = ToMilliseconds(start);
+        mPhases.push_back({std::string(name), startMs, ToMilliseconds(end) - startMs});
+    }
+
+    void StartupProfiler::MarkFirstFrame() {
+        const TimePoint now = Clock::now();
+        std::lock_guard lock(mMutex);
+        if (!mTimeToFirstFrame) { mTimeToFirstFrame = ToMilliseconds(now); }
+    }
+
+    std::optional<f64> StartupProfiler::GetTimeToFirstFrame() const {
+        std::lock_guard lock(mMutex);
+        return mTimeToFirstFrame;
+    }
+
+    f64 StartupProfiler::GetPhaseDuration(std::string_view name) const {
+        std::lock_guard lock(mMutex);
+        f64 total = 0.0;
+        for (const auto& phase : mPhases) {
+            if (phase.name == name) { total += phase.durationMs; }
+        }
+        return total;
+    }
+
+    std::vector<StartupProfiler::Phase> StartupProfiler::GetPhases() const {
+        std::lock_guard lock(mMutex);
+        return mPhases;
+    }
+
+    std::string StartupProfiler::Report() const {
+        std::lock_guard lock(mMutex);
+
+        // Sort by start time so phases recorded from worker threads show up where they actually ran
+        std::vector<Phase> phases = mPhases;
+        std::ranges::stable_sort(phases, {}, &Phase::startMs);
+
+        size_t nameWidth = 0;
+        for (const auto& phase : phases) {
+            nameWidth = std::max(nameWidth, phase.name.size());
+        }
+
+        std::string report = "Startup profile:\n";
+        char line[256];
+        for (const auto& phase : phases) {
+            std::snprintf(line,
+                          sizeof(line),
+                          "  %-*s  %9.3f ms  (at %9.3f ms)\n",
+                          CAST<int>(nameWidth),
+                          phase.name.c_str(),
+                          phase.durationMs,
+                          phase.startMs);
+            report += line;
+        }
+
+        if (mTimeToFirstFrame) {
+            std::snprintf(line, sizeof(line), "  Time to first frame: %.3f ms\n", *mTimeToFirstFrame);
+            report += line;
+        } else {
+            report += "  Time to first frame: (no frame presented yet)\n";
+        }
+
+        return report;
+    }
+
+    f64 StartupProfiler::ToMilliseconds(TimePoint time) const {
+        return std::chrono::duration<f64, std::milli>(time - mOrigin).count();
+    }
+}  // namespace Vulkano
@@ -7,7 +7,17 @@
 
 #include <VkBootstrap.h>
 
+#include <algorithm>
+
 namespace Vulkano {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        f64 Milliseconds(Clock::duration duration) {
+            return std::chrono::duration<f64, std::milli>(duration).count();
+        }
+    }  // namespace
+
     struct SwapchainManager::Impl {
         std::unique_ptr<vkb::Swapchain> vkbSwapchain;
     };
@@ -33,10 +43,35 @@ namespace Vulkano {
         mSurface = surface;
         mConfig  = config;
 
-        // Create swapchain using vk-bootstrap
-        vkb::SwapchainBuilder swapchainBuilder(context->GetPhysicalDevice(), context->GetDevice(), surface);
+        auto scope = context->GetStartupProfiler().Measure("Swapchain");
+
+        // Formats and present modes don't change for the surface's lifetime; Recreate only needs capabilities
+        if (auto result = CacheSurfaceSupport(); !result) { return result; }
+
+        VkSurfaceCapabilitiesKHR capabilities {};
+        if (vkGetPhysicalDeviceSurfaceCapabilitiesKHR(context->GetPhysicalDevice(), surface, &capabilities) !=
+            VK_SUCCESS) {
+            return std::unexpected("Failed to query surface capabilities");
+        }
+
+        VkSurfaceFormatKHR desiredFormat {config.preferredFormat, config.preferredColorSpace};
+        const VkImageUsageFlags usage = ChooseImageUsage(capabilities, desiredFormat);
+
+        // Create swapchain using vk-bootstrap. The images are shared by the graphics family and whichever family
+        // presents, the same pair Recreate uses.
+        vkb::SwapchainBuilder swapchainBuilder(context->GetPhysicalDevice(),
+                                               context->GetDevice(),
+                                               surface,
+                                               context->GetQueueFamilies().graphicsFamily,
+                                               GetPresentFamily());
+
+        // Storage also constrains the fallback formats vk-bootstrap may pick
+        swapchainBuilder.set_image_usage_flags(usage);
+        if (usage & VK_IMAGE_USAGE_STORAGE_BIT) {
+            swapchainBuilder.add_format_feature_flags(VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT);
+        }
 
-        swapchainBuilder.set_desired_format({config.preferredFormat, config.preferredColorSpace})
+        swapchainBuilder.set_desired_format(desiredFormat)
           .set_desired_present_mode(config.preferredPresentMode)
           .set_desired_min_image_count(config.minImageCount)
           .set_desired_extent(width, height)
@@ -55,86 +90,327 @@ namespace Vulkano {
         mColorSpace         = mImpl->vkbSwapchain->color_space;
         mExtent             = mImpl->vkbSwapchain->extent;
         mPresentMode        = mImpl->vkbSwapchain->present_mode;
+        mImageUsage         = mImpl->vkbSwapchain->image_usage_flags;
 
-        // Get swapchain images
-        auto imagesResult = mImpl->vkbSwapchain->get_images();
-        if (!imagesResult) { return std::unexpected("Failed to get swapchain images"); }
-        mImages = imagesResult.value();
+        if (auto result = FetchImages(); !result) { return result; }
 
-        // Create image views
-        return CreateImageViews();
+        if (auto result = CreateImageViews(); !result) { return result; }
+
+        return CreateSyncObjects();
     }
 
     Result<void> SwapchainManager::Recreate(u32 width, u32 height) {
-        if (!mContext) { return std::unexpected("Context not set"); }
+        if (!mContext || !mImpl->vkbSwapchain) { return std::unexpected("Swapchain not initialized"); }
 
         if (width == 0 || height == 0) { return std::unexpected("Invalid swapchain dimensions"); }
 
+        const VkDevice device = mContext->GetDevice();
+
+        VkSurfaceCapabilitiesKHR capabilities {};
+        if (vkGetPhysicalDeviceSurfaceCapabilitiesKHR(mContext->GetPhysicalDevice(), mSurface, &capabilities) !=
+            VK_SUCCESS) {
+            return std::unexpected("Failed to query surface capabilities");
+        }
+
+        // A current extent of UINT32_MAX means the surface takes its size from the swapchain
+        VkExtent2D extent = capabilities.currentExtent;
+        if (extent.width == UINT32_MAX) {
+            extent.width  = std::clamp(width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
+            extent.height = std::clamp(height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
+        }
+        if (extent.width == 0 || extent.height == 0) { return std::unexpected("Surface has no area (minimized)"); }
+
+        u32 minImageCount = std::max(mConfig.minImageCount, capabilities.minImageCount);
+        if (capabilities.maxImageCount > 0) { minImageCount = std::min(minImageCount, capabilities.maxImageCount); }
+
+        // Same choices vk-bootstrap made in Initialize, minus the format and present mode queries
+        const QueueFamilyIndices& families = mContext->GetQueueFamilies();
+        const u32 queueFamilies[]          = {families.graphicsFamily, GetPresentFamily()};
+
+        VkSwapchainCreateInfoKHR createInfo {};
+        createInfo.sType            = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+        createInfo.surface          = mSurface;
+        createInfo.minImageCount    = minImageCount;
+        createInfo.imageFormat      = mFormat;
+        createInfo.imageColorSpace  = mColorSpace;
+        createInfo.imageExtent      = extent;
+        createInfo.imageArrayLayers = 1;
+        createInfo.imageUsage       = mImageUsage;
+        createInfo.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        createInfo.preTransform     = capabilities.currentTransform;
+        createInfo.compositeAlpha   = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+        createInfo.presentMode      = mPresentMode;
+        createInfo.clipped          = VK_TRUE;
+        createInfo.oldSwapchain     = mSwapchain;
+        if (queueFamilies[0] != queueFamilies[1]) {
+            createInfo.imageSharingMode      = VK_SHARING_MODE_CONCURRENT;
+            createInfo.queueFamilyIndexCount = 2;
+            createInfo.pQueueFamilyIndices   = queueFamilies;
+        }
+
         // Wait for device to be idle before recreating
         mContext->WaitIdle();
 
-        // Destroy old image views
+        VkSwapchainKHR swapchain = VK_NULL_HANDLE;
+        if (vkCreateSwapchainKHR(device, &createInfo, nullptr, &swapchain) != VK_SUCCESS) {
+            return std::unexpected("Failed to recreate swapchain");
+        }
+
+        // Views belong to the old images, so they always go; their storage is reused
         DestroyImageViews();
+        vkDestroySwapchainKHR(device, mSwapchain, nullptr);
 
-        // Create new swapchain with old one as reference for optimization
-        vkb::SwapchainBuilder swapchainBuilder(mContext->GetPhysicalDevice(), mContext->GetDevice(), mSurface);
+        mSwapchain                     = swapchain;
+        mExtent                        = extent;
+        mImpl->vkbSwapchain->swapchain = swapchain;  // Shutdown still destroys through vk-bootstrap
 
-        swapchainBuilder.set_desired_format({mConfig.preferredFormat, mConfig.preferredColorSpace})
-          .set_desired_present_mode(mConfig.preferredPresentMode)
-          .set_desired_min_image_count(mConfig.minImageCount)
-          .set_desired_extent(width, height)
-          .add_fallback_present_mode(VK_PRESENT_MODE_FIFO_KHR)
-          .add_fallback_format({VK_FORMAT_B8G8R8A8_SRGB, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR})
-          .add_fallback_format({VK_FORMAT_R8G8B8A8_SRGB, VK_COLOR_SPACE_SRGB_NONLINEAR_KHR});
+        const auto oldImageCount = CAST<u32>(mImages.size());
+        if (auto result = FetchImages(); !result) { return result; }
 
-        // Use old swapchain for better performance
-        if (mImpl->vkbSwapchain) { swapchainBuilder.set_old_swapchain(*mImpl->vkbSwapchain); }
+        if (auto result = CreateImageViews(); !result) { return result; }
 
-        auto swapchainResult = swapchainBuilder.build();
-        if (!swapchainResult) {
-            return std::unexpected(std::string("Failed to recreate swapchain: ") + swapchainResult.error().message());
+        // Semaphores and fences aren't tied to the swapchain; only a different image count needs new ones
+        if (mImages.size() == oldImageCount) {
+            mImageFences.assign(mImageFences.size(), VK_NULL_HANDLE);
+            return {};
         }
+        DestroySyncObjects();
+        return CreateSyncObjects();
+    }
 
-        // Destroy old swapchain
-        if (mImpl->vkbSwapchain) { vkb::destroy_swapchain(*mImpl->vkbSwapchain); }
+    Result<void> SwapchainManager::SetPresentMode(VkPresentModeKHR presentMode) {
+        if (!IsInitialized()) { return std::unexpected("Swapchain not initialized"); }
 
-        mImpl->vkbSwapchain = std::make_unique<vkb::Swapchain>(swapchainResult.value());
-        mSwapchain          = mImpl->vkbSwapchain->swapchain;
-        mFormat             = mImpl->vkbSwapchain->image_format;
-        mColorSpace         = mImpl->vkbSwapchain->color_space;
-        mExtent             = mImpl->vkbSwapchain->extent;
-        mPresentMode        = mImpl->vkbSwapchain->present_mode;
+        if (!SupportsPresentMode(presentMode)) { return std::unexpected("Present mode not supported by the surface"); }
+
+        if (presentMode == mPresentMode) { return {}; }
+
+        mPresentMode = presentMode;
+        return Recreate(mExtent.width, mExtent.height);
+    }
+
+    bool SwapchainManager::SupportsPresentMode(VkPresentModeKHR presentMode) const {
+        return std::ranges::find(mPresentModes, presentMode) != mPresentModes.end();
+    }
+
+    Result<void> SwapchainManager::CacheSurfaceSupport() {
+        const VkPhysicalDevice physicalDevice = mContext->GetPhysicalDevice();
+
+        u32 count = 0;
+        if (vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, mSurface, &count, nullptr) != VK_SUCCESS) {
+            return std::unexpected("Failed to query surface formats");
+        }
+        mSurfaceFormats.resize(count);
+        vkGetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, mSurface, &count, mSurfaceFormats.data());
+        mSurfaceFormats.resize(count);
+
+        if (vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, mSurface, &count, nullptr) != VK_SUCCESS) {
+            return std::unexpected("Failed to query surface present modes");
+        }
+        mPresentModes.resize(count);
+        vkGetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, mSurface, &count, mPresentModes.data());
+        mPresentModes.resize(count);
+
+        VkBool32 computePresent = VK_FALSE;
+        const u32 computeFamily = mContext->GetQueueFamilies().computeFamily;
+        if (vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, computeFamily, mSurface, &computePresent) !=
+            VK_SUCCESS) {
+            return std::unexpected("Failed to query compute queue present support");
+        }
+        mComputeCanPresent  = computePresent == VK_TRUE;
+        mPresentFromCompute = mConfig.presentFromCompute && mComputeCanPresent;
+
+        return {};
+    }
+
+    VkImageUsageFlags SwapchainManager::ChooseImageUsage(const VkSurfaceCapabilitiesKHR& capabilities,
+                                                         VkSurfaceFormatKHR& format) const {
+        const VkImageUsageFlags supported = mConfig.imageUsage & capabilities.supportedUsageFlags;
+        VkImageUsageFlags usage           = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | supported;
+        if (!(usage & VK_IMAGE_USAGE_STORAGE_BIT) || SupportsStorage(format.format)) { return usage; }
+
+        // sRGB formats rarely allow storage; a UNORM sibling in the same color space usually does (the compute pass
+        // then encodes sRGB itself)
+        const auto storable = std::ranges::find_if(mSurfaceFormats, [&](const VkSurfaceFormatKHR& candidate) {
+            return candidate.colorSpace == format.colorSpace && SupportsStorage(candidate.format);
+        });
+        if (storable != mSurfaceFormats.end()) {
+            format = *storable;
+        } else {
+            usage &= ~VK_IMAGE_USAGE_STORAGE_BIT;
+        }
+        return usage;
+    }
+
+    bool SwapchainManager::SupportsStorage(VkFormat format) const {
+        VkFormatProperties properties {};
+        vkGetPhysicalDeviceFormatProperties(mContext->GetPhysicalDevice(), format, &properties);
+        return (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0;
+    }
+
+    Result<void> SwapchainManager::FetchImages() {
+        const VkDevice device = mContext->GetDevice();
+
+        // Reuses mImages' storage; the count only changes if the surface's limits do
+        u32 count = 0;
+        if (vkGetSwapchainImagesKHR(device, mSwapchain, &count, nullptr) != VK_SUCCESS) {
+            return std::unexpected("Failed to get swapchain images");
+        }
+        mImages.resize(count);
+        if (vkGetSwapchainImagesKHR(device, mSwapchain, &count, mImages.data()) != VK_SUCCESS) {
+            return std::unexpected("Failed to get swapchain images");
+        }
+
+        return {};
+    }
+
+    Result<u32> SwapchainManager::AcquireNextImage(VkSemaphore signalSemaphore, u64 timeout) {
+        if (!mContext || mSwapchain == VK_NULL_HANDLE) { return std::unexpected("Swapchain not initialized"); }
+
+        const AcquireResult result = TryAcquireNextImage(signalSemaphore, timeout);
+        switch (result.status) {
+            case AcquireStatus::Acquired:
+            case AcquireStatus::Suboptimal:
+                // Suboptimal still hands out a usable image; the caller may recreate next frame
+                return result.imageIndex;
+            case AcquireStatus::NotReady:
+                return std::unexpected("Swapchain image not ready");
+            case AcquireStatus::OutOfDate:
+                return std::unexpected("Swapchain out of date - needs recreation");
+            default:
+                return std::unexpected("Failed to acquire swapchain image");
+        }
+    }
 
-        // Get new swapchain images
-        auto imagesResult = mImpl->vkbSwapchain->get_images();
-        if (!imagesResult) { return std::unexpected("Failed to get swapchain images"); }
-        mImages = imagesResult.value();
+    SwapchainManager::AcquireResult SwapchainManager::TryAcquireNextImage(VkSemaphore signalSemaphore, u64 timeout) {
+        const auto start           = Clock::now();
+        const AcquireResult result = Acquire(signalSemaphore, timeout);
+        const f64 waitMs           = Milliseconds(Clock::now() - start);
 
-        return CreateImageViews();
+        if (result.HasImage()) {
+            RecordAcquireWait(waitMs, waitMs);
+        } else if (result.status == AcquireStatus::NotReady) {
+            mAcquireStats.notReadyPolls++;
+        }
+
+        return result;
     }
 
-    Result<u32> SwapchainManager::AcquireNextImage(VkSemaphore signalSemaphore, u64 timeout) const {
+    SwapchainManager::AcquireResult SwapchainManager::PollNextImage(VkSemaphore signalSemaphore,
+                                                                    Clock::time_point deadline,
+                                                                    const std::function<bool()>& idleWork) {
+        const auto start = Clock::now();
+        f64 blockedMs    = 0.0;
+        bool working     = CAST<bool>(idleWork);
+
+        for (;;) {
+            // Poll while there is work to fill the gaps with, then block for whatever time is left
+            const auto attemptStart = Clock::now();
+            u64 timeout             = 0;
+            if (!working && attemptStart < deadline) {
+                timeout = CAST<u64>(std::chrono::nanoseconds(deadline - attemptStart).count());
+            }
+
+            const AcquireResult result = Acquire(signalSemaphore, timeout);
+            const auto attemptEnd      = Clock::now();
+            blockedMs += Milliseconds(attemptEnd - attemptStart);
+
+            if (result.status != AcquireStatus::NotReady) {
+                if (result.HasImage()) { RecordAcquireWait(Milliseconds(attemptEnd - start), blockedMs); }
+                return result;
+            }
+
+            mAcquireStats.notReadyPolls++;
+            if (attemptEnd >= deadline) {
+                mAcquireStats.missedDeadlines++;
+                return result;
+            }
+            if (working) { working = idleWork(); }
+        }
+    }
+
+    SwapchainManager::AcquireResult SwapchainManager::Acquire(VkSemaphore signalSemaphore, u64 timeout) {
+        if (!mContext || mSwapchain == VK_NULL_HANDLE) { return {}; }
+
+        const VkDevice device = mContext->GetDevice();
+
+        // The slot's fence was last used image-count acquires ago, so it has almost always signaled by now
+        const u32 slot = mAcquireSlot;
+        VkFence fence  = VK_NULL_HANDLE;
+        if (!mAcquireFences.empty()) {
+            fence = mAcquireFences[slot];
+            if (mAcquireFencePending[slot]) {
+                const auto waitStart = Clock::now();
+                const VkResult wait  = vkWaitForFences(device, 1, &fence, VK_TRUE, timeout);
+                if (wait == VK_TIMEOUT) { return {AcquireStatus::NotReady}; }
+                if (wait != VK_SUCCESS) {
+                    mContext->CheckDeviceLost(wait);
+                    return {AcquireStatus::Failed};
+                }
+
+                // The fence wait and the acquire share the caller's timeout (UINT64_MAX stays infinite)
+                if (timeout != UINT64_MAX) {
+                    const auto waited = CAST<u64>(std::chrono::nanoseconds(Clock::now() - waitStart).count());
+                    timeout           = waited < timeout ? timeout - waited : 0;
+                }
+            }
+            vkResetFences(device, 1, &fence);
+            mAcquireFencePending[slot] = false;
+            mAcquireSlot               = (slot + 1) % CAST<u32>(mAcquireFences.size());
+        }
+
+        u32 imageIndex        = 0;
+        const VkResult result = vkAcquireNextImageKHR(device, mSwapchain, timeout, signalSemaphore, fence, &imageIndex);
+
+        switch (result) {
+            case VK_SUCCESS:
+            case VK_SUBOPTIMAL_KHR:
+                // Only an acquire that hands out an image signals its fence
+                if (fence != VK_NULL_HANDLE) {
+                    mAcquireFencePending[slot] = true;
+                    mImageFences[imageIndex]   = fence;
+                }
+                return {result == VK_SUCCESS ? AcquireStatus::Acquired : AcquireStatus::Suboptimal, imageIndex};
+            case VK_NOT_READY:
+            case VK_TIMEOUT:
+                return {AcquireStatus::NotReady};
+            case VK_ERROR_OUT_OF_DATE_KHR:
+                return {AcquireStatus::OutOfDate};
+            default:
+                mContext->CheckDeviceLost(result);
+                return {AcquireStatus::Failed};
+        }
+    }
+
+    void SwapchainManager::RecordAcquireWait(f64 waitMs, f64 blockedMs) {
+        u32 bucket = 0;
+        while (bucket + 1 < AcquireStats::kBuckets && waitMs >= AcquireStats::GetBucketLimit(bucket)) {
+            bucket++;
+        }
+
+        mAcquireStats.waitHistogram[bucket]++;
+        mAcquireStats.acquired++;
+        mAcquireStats.totalWaitMs += waitMs;
+        mAcquireStats.blockedMs += blockedMs;
+        mAcquireStats.maxWaitMs = std::max(mAcquireStats.maxWaitMs, CAST<f32>(waitMs));
+    }
+
+    Result<void> SwapchainManager::WaitForImage(u32 imageIndex, u64 timeout) const {
         if (!mContext || mSwapchain == VK_NULL_HANDLE) { return std::unexpected("Swapchain not initialized"); }
 
-        u32 imageIndex;
-        const VkResult result = vkAcquireNextImageKHR(mContext->GetDevice(),
-                                                      mSwapchain,
-                                                      timeout,
-                                                      signalSemaphore,
-                                                      VK_NULL_HANDLE,
-                                                      &imageIndex);
+        if (imageIndex >= mImages.size()) { return std::unexpected("Swapchain image index out of range"); }
 
-        if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-            return std::unexpected("Swapchain out of date - needs recreation");
-        } else if (result == VK_SUBOPTIMAL_KHR) {
-            // Still return the image but log that it's suboptimal
-            // User may want to recreate on next frame
-            return imageIndex;
+        if (mImageFences.empty() || mImageFences[imageIndex] == VK_NULL_HANDLE) { return {}; }
+
+        const VkResult result = vkWaitForFences(mContext->GetDevice(), 1, &mImageFences[imageIndex], VK_TRUE, timeout);
+        if (result == VK_TIMEOUT) {
+            return std::unexpected("Timeout waiting for swapchain image");
         } else if (result != VK_SUCCESS) {
-            return std::unexpected("Failed to acquire swapchain image");
+            mContext->CheckDeviceLost(result);
+            return std::unexpected("Failed to wait for swapchain image");
         }
 
-        return imageIndex;
+        return {};
     }
 
     Result<void> SwapchainManager::Present(u32 imageIndex, VkSemaphore waitSemaphore) const {
@@ -149,11 +425,12 @@ namespace Vulkano {
         presentInfo.pImageIndices      = &imageIndex;
         presentInfo.pResults           = nullptr;  // Optional
 
-        const VkResult result = vkQueuePresentKHR(mContext->GetPresentQueue(), &presentInfo);
+        const VkResult result = vkQueuePresentKHR(GetPresentQueue(), &presentInfo);
 
         if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
             return std::unexpected("Swapchain out of date - needs recreation");
         } else if (result != VK_SUCCESS) {
+            mContext->CheckDeviceLost(result);
             return std::unexpected("Failed to present swapchain image");
         }
 
@@ -170,18 +447,113 @@ namespace Vulkano {
             mImpl->vkbSwapchain.reset();
             mSwapchain = VK_NULL_HANDLE;
         }
+        DestroySyncObjects();
 
         mImages.clear();
+        mComputeCanPresent  = false;
+        mPresentFromCompute = false;
+    }
+
+    void SwapchainManager::ReleaseDeviceObjects() {
+        Shutdown();
+    }
+
+    Result<void> SwapchainManager::RecreateDeviceObjects() {
+        if (!mContext || mSurface == VK_NULL_HANDLE) { return std::unexpected("Swapchain not initialized"); }
+
+        // Ask for what the swapchain ended up with rather than the original preferences; SetPresentMode may have
+        // switched modes since
+        SwapchainConfig config      = mConfig;
+        config.preferredFormat      = mFormat;
+        config.preferredColorSpace  = mColorSpace;
+        config.preferredPresentMode = mPresentMode;
+        return Initialize(mContext, mSurface, mExtent.width, mExtent.height, config);
+    }
+
+    VkQueue SwapchainManager::GetPresentQueue() const {
+        if (!mContext) { return VK_NULL_HANDLE; }
+        return mPresentFromCompute ? mContext->GetComputeQueue() : mContext->GetPresentQueue();
+    }
+
+    u32 SwapchainManager::GetPresentFamily() const {
+        if (!mContext) { return VK_QUEUE_FAMILY_IGNORED; }
+        const QueueFamilyIndices& families = mContext->GetQueueFamilies();
+        return mPresentFromCompute ? families.computeFamily : families.presentFamily;
     }
 
     Result<void> SwapchainManager::CreateImageViews() {
-        auto imageViewsResult = mImpl->vkbSwapchain->get_image_views();
-        if (!imageViewsResult) { return std::unexpected("Failed to create swapchain image views"); }
+        VkImageViewCreateInfo viewInfo {};
+        viewInfo.sType                       = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.viewType                    = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format                      = mFormat;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.layerCount = 1;
+
+        mImageViews.resize(mImages.size(), VK_NULL_HANDLE);
+        for (u32 i = 0; i < mImages.size(); i++) {
+            viewInfo.image = mImages[i];
+            if (vkCreateImageView(mContext->GetDevice(), &viewInfo, nullptr, &mImageViews[i]) != VK_SUCCESS) {
+                return std::unexpected("Failed to create swapchain image views");
+            }
+        }
 
-        mImageViews = imageViewsResult.value();
         return {};
     }
 
+    Result<void> SwapchainManager::CreateSyncObjects() {
+        const VkDevice device = mContext->GetDevice();
+        const auto imageCount = CAST<u32>(mImages.size());
+
+        VkSemaphoreCreateInfo semaphoreInfo {};
+        semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+        mPresentSemaphores.resize(imageCount, VK_NULL_HANDLE);
+        for (VkSemaphore& semaphore : mPresentSemaphores) {
+            if (vkCreateSemaphore(device, &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+                return std::unexpected("Failed to create present semaphore");
+            }
+        }
+
+        if (!mConfig.acquireFences) { return {}; }
+
+        VkFenceCreateInfo fenceInfo {};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+        mAcquireFences.resize(imageCount, VK_NULL_HANDLE);
+        mAcquireFencePending.assign(imageCount, false);
+        mImageFences.assign(imageCount, VK_NULL_HANDLE);
+        mAcquireSlot = 0;
+        for (VkFence& fence : mAcquireFences) {
+            if (vkCreateFence(device, &fenceInfo, nullptr, &fence) != VK_SUCCESS) {
+                return std::unexpected("Failed to create acquire fence");
+            }
+        }
+
+        return {};
+    }
+
+    void SwapchainManager::DestroySyncObjects() {
+        if (!mContext) { return; }
+
+        const VkDevice device = mContext->GetDevice();
+
+        for (u32 i = 0; i < mAcquireFences.size(); i++) {
+            if (mAcquireFences[i] == VK_NULL_HANDLE) { continue; }
+            if (mAcquireFencePending[i]) { vkWaitForFences(device, 1, &mAcquireFences[i], VK_TRUE, UINT64_MAX); }
+            vkDestroyFence(device, mAcquireFences[i], nullptr);
+        }
+        mAcquireFences.clear();
+        mAcquireFencePending.clear();
+        mImageFences.clear();
+        mAcquireSlot = 0;
+
+        for (VkSemaphore semaphore : mPresentSemaphores) {
+            if (semaphore != VK_NULL_HANDLE) { vkDestroySemaphore(device, semaphore, nullptr); }
+        }
+        mPresentSemaphores.clear();
+    }
+
     void SwapchainManager::DestroyImageViews() {
         if (!mContext) { return; }
 
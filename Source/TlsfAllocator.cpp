@@ -0,0 +1,210 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "TlsfAllocator.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace Vulkano {
+    void TlsfAllocator::Reset(u32 capacity) {
+        mBlocks.clear();
+        mUnusedBlocks.clear();
+        for (auto& firstLevel : mFreeHeads) {
+            std::fill(std::begin(firstLevel), std::end(firstLevel), kInvalid);
+        }
+        mFirstLevelBitmap = 0;
+        std::fill(std::begin(mSecondLevelBitmaps), std::end(mSecondLevelBitmaps), 0u);
+
+        mCapacity        = capacity;
+        mUsed            = 0;
+        mAllocationCount = 0;
+        if (capacity == 0) { return; }
+
+        const u32 block     = NewBlock();
+        mBlocks[block].size = capacity;
+        InsertFree(block);
+    }
+
+    TlsfAllocator::Allocation TlsfAllocator::Allocate(u32 size) {
+        if (size == 0 || size > mCapacity - mUsed) { return {}; }
+
+        const u32 block = FindFree(size);
+        if (block == kInvalid) { return {}; }
+        RemoveFree(block);
+
+        // Split off the tail as a new free block
+        if (mBlocks[block].size > size) {
+            const u32 remainder = NewBlock();  // May reallocate mBlocks
+            Block& used         = mBlocks[block];
+            Block& tail         = mBlocks[remainder];
+            tail.offset         = used.offset + size;
+            tail.size           = used.size - size;
+            tail.prevPhysical   = block;
+            tail.nextPhysical   = used.nextPhysical;
+            if (used.nextPhysical != kInvalid) { mBlocks[used.nextPhysical].prevPhysical = remainder; }
+            used.nextPhysical = remainder;
+            used.size         = size;
+            InsertFree(remainder);
+        }
+
+        mUsed += size;
+        mAllocationCount++;
+        return {mBlocks[block].offset, size, block};
+    }
+
+    void TlsfAllocator::Free(const Allocation& allocation) {
+        if (!allocation || allocation.block >= mBlocks.size() || mBlocks[allocation.block].free) { return; }
+
+        u32 block = allocation.block;
+        mUsed -= mBlocks[block].size;
+        mAllocationCount--;
+
+        // Merge with the previous block, then the next, so free blocks never sit side by side
+        const u32 previous = mBlocks[block].prevPhysical;
+        if (previous != kInvalid && mBlocks[previous].free) {
+            RemoveFree(previous);
+            mBlocks[previous].size += mBlocks[block].size;
+            mBlocks[previous].nextPhysical = mBlocks[block].nextPhysical;
+            if (const u32 after = mBlocks[block].nextPhysical; after != kInvalid) {
+                mBlocks[after].prevPhysical = previous;
+            }
+            ReleaseBlock(block);
+            block = previous;
+        }
+
+        const u32 next = mBlocks[block].nextPhysical;
+        if (next != kInvalid && mBlocks[next].free) {
+            RemoveFree(next);
+            mBlocks[block].size += mBlocks[next].size;
+            mBlocks[block].nextPhysical = mBlocks[next].nextPhysical;
+            if (mBlocks[next].nextPhysical != kInvalid) { mBlocks[mBlocks[next].nextPhysical].prevPhysical = block; }
+            ReleaseBlock(next);
+        }
+
+        InsertFree(block);
+    }
+
+    u32 TlsfAllocator::GetLargestFree() const {
+        if (mFirstLevelBitmap == 0) { return 0; }
+
+        // The largest block is somewhere in the highest non-empty bin
+        const u32 firstLevel  = 31 - CAST<u32>(std::countl_zero(mFirstLevelBitmap));
+        const u32 secondLevel = 31 - CAST<u32>(std::countl_zero(mSecondLevelBitmaps[firstLevel]));
+
+        u32 largest = 0;
+        for (u32 block = mFreeHeads[firstLevel][secondLevel]; block != kInvalid; block = mBlocks[block].nextFree) {
+            largest = std::max(largest, mBlocks[block].size);
+        }
+        return largest;
+    }
+
+    u32 TlsfAllocator::FindFree(u32 size) const {
+        // Round up to the next size class boundary so every block in the bin we land in is large enough
+        u64 searchSize = size;
+        if (size >= kSecondLevelCount) {
+            const u32 log = CAST<u32>(std::bit_width(size)) - 1;
+            searchSize += (u64 {1} << (log - kSecondLevelBits)) - 1;
+        }
+
+        // Near capacity the rounded size can exceed every block; search from the capacity's bin instead, where
+        // blocks are no longer guaranteed to fit
+        const bool clamped = searchSize > mCapacity;
+        searchSize         = std::min<u64>(searchSize, mCapacity);
+
+        u32 firstLevel  = 0;
+        u32 secondLevel = 0;
+        Mapping(CAST<u32>(searchSize), firstLevel, secondLevel);
+
+        u32 secondMap = mSecondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+        if (secondMap == 0) {
+            const u32 firstMap = firstLevel + 1 < kFirstLevelCount ? mFirstLevelBitmap & (~0u << (firstLevel + 1)) : 0u;
+            if (firstMap != 0) {
+                firstLevel = CAST<u32>(std::countr_zero(firstMap));
+                secondMap  = mSecondLevelBitmaps[firstLevel];
+            }
+        }
+        if (secondMap != 0) {
+            const u32 head = mFreeHeads[firstLevel][CAST<u32>(std::countr_zero(secondMap))];
+            if (!clamped) { return head; }
+            for (u32 block = head; block != kInvalid; block = mBlocks[block].nextFree) {
+                if (mBlocks[block].size >= size) { return block; }
+            }
+        }
+
+        // Nothing in a larger bin; a block in the request's own bin may still be big enough
+        Mapping(size, firstLevel, secondLevel);
+        for (u32 block = mFreeHeads[firstLevel][secondLevel]; block != kInvalid; block = mBlocks[block].nextFree) {
+            if (mBlocks[block].size >= size) { return block; }
+        }
+        return kInvalid;
+    }
+
+    void TlsfAllocator::Mapping(u32 size, u32& firstLevel, u32& secondLevel) {
+        // Sizes below 16 get one bin each in the first class; above that each power of two is split 16 ways
+        if (size < kSecondLevelCount) {
+            firstLevel  = 0;
+            secondLevel = size;
+            return;
+        }
+
+        const u32 log = CAST<u32>(std::bit_width(size)) - 1;
+        firstLevel    = log - kSecondLevelBits + 1;
+        secondLevel   = (size >> (log - kSecondLevelBits)) - kSecondLevelCount;
+    }
+
+    u32 TlsfAllocator::NewBlock() {
+        if (!mUnusedBlocks.empty()) {
+            const u32 block = mUnusedBlocks.back();
+            mUnusedBlocks.pop_back();
+            mBlocks[block] = {};
+            return block;
+        }
+
+        mBlocks.emplace_back();
+        return CAST<u32>(mBlocks.size() - 1);
+    }
+
+    void TlsfAllocator::ReleaseBlock(u32 block) {
+        mBlocks[block] = {};
+        mUnusedBlocks.push_back(block);
+    }
+
+    void TlsfAllocator::InsertFree(u32 block) {
+        u32 firstLevel  = 0;
+        u32 secondLevel = 0;
+        Mapping(mBlocks[block].size, firstLevel, secondLevel);
+
+        const u32 head          = mFreeHeads[firstLevel][secondLevel];
+        mBlocks[block].free     = true;
+        mBlocks[block].prevFree = kInvalid;
+        mBlocks[block].nextFree = head;
+        if (head != kInvalid) { mBlocks[head].prevFree = block; }
+
+        mFreeHeads[firstLevel][secondLevel] = block;
+        mFirstLevelBitmap |= 1u << firstLevel;
+        mSecondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+    }
+
+    void TlsfAllocator::RemoveFree(u32 block) {
+        u32 firstLevel  = 0;
+        u32 secondLevel = 0;
+        Mapping(mBlocks[block].size, firstLevel, secondLevel);
+
+        Block& entry = mBlocks[block];
+        if (entry.prevFree != kInvalid) { mBlocks[entry.prevFree].nextFree = entry.nextFree; }
+        if (entry.nextFree != kInvalid) { mBlocks[entry.nextFree].prevFree = entry.prevFree; }
+        if (mFreeHeads[firstLevel][secondLevel] == block) {
+            mFreeHeads[firstLevel][secondLevel] = entry.nextFree;
+            if (entry.nextFree == kInvalid) {
+                mSecondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+                if (mSecondLevelBitmaps[firstLevel] == 0) { mFirstLevelBitmap &= ~(1u << firstLevel); }
+            }
+        }
+
+        entry.free     = false;
+        entry.prevFree = kInvalid;
+        entry.nextFree = kInvalid;
+    }
+}  // namespace Vulkano
@@ -0,0 +1,98 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include "TransientRing.hpp"
+#include "VulkanContext.hpp"
+
+#include <algorithm>
+
+namespace Vulkano {
+    namespace {
+        constexpr VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment) {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+    }  // namespace
+
+    TransientRing::~TransientRing() {
+        Shutdown();
+    }
+
+    Result<void> TransientRing::Initialize(VulkanContext* context,
+                                           VkDeviceSize bytesPerFrame,
+                                           u32 framesInFlight,
+                                           VkBufferUsageFlags usage) {
+        if (!context || !context->IsInitialized()) { return std::unexpected("Invalid or uninitialized context"); }
+
+        if (bytesPerFrame == 0 || framesInFlight == 0) {
+            return std::unexpected("Ring size and frames in flight must be greater than zero");
+        }
+
+        // Every offset handed out must be usable for any of the buffer's usages
+        const auto& limits = context->GetDeviceProperties().limits;
+        mMinAlignment      = 16;
+        if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT) {
+            mMinAlignment = std::max(mMinAlignment, limits.minUniformBufferOffsetAlignment);
+        }
+        if (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) {
+            mMinAlignment = std::max(mMinAlignment, limits.minStorageBufferOffsetAlignment);
+        }
+        constexpr VkBufferUsageFlags descriptorBufferUsage =
+          VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT | VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT;
+        if (usage & descriptorBufferUsage) {
+            const auto& properties = context->GetCapabilities().descriptorBufferProperties;
+            mMinAlignment          = std::max(mMinAlignment, properties.descriptorBufferOffsetAlignment);
+        }
+
+        mBytesPerFrame  = AlignUp(bytesPerFrame, mMinAlignment);
+        mFramesInFlight = framesInFlight;
+        mUsage          = usage | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+
+        Buffer::Config config;
+        config.size        = mBytesPerFrame * framesInFlight;
+        config.usage       = mUsage;
+        config.hostVisible = true;
+        if (auto result = mBuffer.Initialize(context, config); !result) { return result; }
+
+        mMapped        = CAST<u8*>(mBuffer.GetMapped());
+        mFrameIndex    = 0;
+        mHighWaterMark = 0;
+        mHead.store(0, std::memory_order_relaxed);
+
+        return {};
+    }
+
+    void TransientRing::Shutdown() {
+        mBuffer.Shutdown();
+        mMapped         = nullptr;
+        mBytesPerFrame  = 0;
+        mFramesInFlight = 0;
+    }
+
+    void TransientRing::BeginFrame(u32 frameIndex) {
+        mHighWaterMark = std::max(mHighWaterMark, mHead.load(std::memory_order_relaxed));
+        mFrameIndex    = frameIndex % std::max(mFramesInFlight, 1u);
+        mHead.store(0, std::memory_order_relaxed);
+    }
+
+    TransientRing::Allocation TransientRing::Allocate(VkDeviceSize size, VkDeviceSize alignment) {
+        if (!mMapped || size == 0) { return {}; }
+
+        alignment               = std::max(alignment, mMinAlignment);
+        const VkDeviceSize base = CAST<VkDeviceSize>(mFrameIndex) * mBytesPerFrame;
+        VkDeviceSize head       = mHead.load(std::memory_order_relaxed);
+        VkDeviceSize start      = 0;
+        do {
+            start = AlignUp(base + head, alignment) - base;
+            if (start + size > mBytesPerFrame) { return {}; }
+        } while (!mHead.compare_exchange_weak(head, start + size, std::memory_order_relaxed));
+
+        Allocation allocation;
+        allocation.buffer  = mBuffer.GetBuffer();
+        allocation.offset  = base + start;
+        allocation.size    = size;
+        allocation.mapped  = mMapped + allocation.offset;
+        allocation.address = mBuffer.GetDeviceAddress() + allocation.offset;
+        return allocation;
+    }
+}  // namespace Vulkano
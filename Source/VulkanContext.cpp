@@ -5,6 +5,7 @@
 #include "VulkanContext.hpp"
 
 #include <VkBootstrap.h>
+#include <algorithm>
 
 namespace Vulkano {
     struct VulkanContext::Impl {
@@ -24,6 +25,30 @@ namespace Vulkano {
 
         mValidationEnabled = config.enableValidation;
 
+        // First call into the loader; resolves and loads the ICD manifests
+        {
+            auto scope      = mStartupProfiler.Measure("Loader init");
+            u32 apiVersion  = 0;
+            VkResult result = vkEnumerateInstanceVersion(&apiVersion);
+            if (result != VK_SUCCESS || apiVersion < VK_API_VERSION_1_3) {
+                return std::unexpected("Vulkan 1.3 loader not available");
+            }
+        }
+
+        // Enumerate layers and instance extensions up front so a missing validation layer doesn't fail the build
+        bool validationAvailable = false;
+        {
+            auto scope            = mStartupProfiler.Measure("Layer discovery");
+            auto systemInfoResult = vkb::SystemInfo::get_system_info();
+            if (!systemInfoResult) {
+                return std::unexpected(std::string("Failed to query system info: ") +
+                                       systemInfoResult.error().message());
+            }
+            validationAvailable = systemInfoResult.value().validation_layers_available;
+        }
+
+        auto scope = mStartupProfiler.Measure("Instance creation");
+
         // Create instance using vk-bootstrap
         vkb::InstanceBuilder instanceBuilder;
         instanceBuilder.set_app_name(config.applicationName)
@@ -36,7 +61,11 @@ namespace Vulkano {
         }
 
 #ifndef NDEBUG
-        if (mValidationEnabled) { instanceBuilder.request_validation_layers().use_default_debug_messenger(); }
+        if (mValidationEnabled && validationAvailable) {
+            instanceBuilder.request_validation_layers().use_default_debug_messenger();
+        }
+#else
+        (void)validationAvailable;
 #endif
 
         auto instanceResult = instanceBuilder.build();
@@ -55,9 +84,23 @@ namespace Vulkano {
 
         if (HasDevice()) { return std::unexpected("Device already created"); }
 
-        // Select physical device
+        // Select physical device. Buffer device address backs the transient ring and descriptor buffers; timeline
+        // semaphores order work across queues (both are mandatory in 1.2).
+        VkPhysicalDeviceVulkan12Features features12 {};
+        features12.sType               = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        features12.bufferDeviceAddress = VK_TRUE;
+        features12.timelineSemaphore   = VK_TRUE;
+
+        VkPhysicalDeviceVulkan13Features features13 {};
+        features13.sType            = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+        features13.dynamicRendering = VK_TRUE;
+        features13.synchronization2 = VK_TRUE;
+
         vkb::PhysicalDeviceSelector selector(*mImpl->vkbInstance);
-        selector.set_minimum_version(1, 3).prefer_gpu_device_type(vkb::PreferredDeviceType::discrete);
+        selector.set_minimum_version(1, 3)
+          .prefer_gpu_device_type(vkb::PreferredDeviceType::discrete)
+          .set_required_features_12(features12)
+          .set_required_features_13(features13);
 
         // Set surface if provided for presentation support
         if (config.surface != VK_NULL_HANDLE) { selector.set_surface(config.surface); }
@@ -67,7 +110,10 @@ namespace Vulkano {
             selector.add_required_extension(ext);
         }
 
+        auto enumerationScope     = mStartupProfiler.Measure("Device enumeration");
         auto physicalDeviceResult = selector.select();
+        enumerationScope.Stop();
+
         if (!physicalDeviceResult) {
             return std::unexpected(std::string("Failed to select physical device: ") +
                                    physicalDeviceResult.error().message());
@@ -80,7 +126,22 @@ namespace Vulkano {
         vkGetPhysicalDeviceProperties(mPhysicalDevice, &mDeviceProperties);
         vkGetPhysicalDeviceFeatures(mPhysicalDevice, &mDeviceFeatures);
 
+        EnableOptionalFeatures(config);
+        mHasSurface = config.surface != VK_NULL_HANDLE;
+
         // Create logical device
+        auto creationScope = mStartupProfiler.Measure("Device creation");
+        if (auto result = BuildDevice(); !result) { return result; }
+        creationScope.Stop();
+
+        // Initialize VMA
+        auto allocatorScope = mStartupProfiler.Measure("Allocator");
+        if (auto result = InitializeAllocator(); !result) { return result; }
+
+        return {};
+    }
+
+    Result<void> VulkanContext::BuildDevice() {
         vkb::DeviceBuilder deviceBuilder(*mImpl->vkbPhysicalDevice);
 
         auto deviceResult = deviceBuilder.build();
@@ -91,6 +152,8 @@ namespace Vulkano {
         mImpl->vkbDevice = std::make_unique<vkb::Device>(deviceResult.value());
         mDevice          = mImpl->vkbDevice->device;
 
+        LoadDispatch();
+
         // Get queues
         auto graphicsQueueResult = mImpl->vkbDevice->get_queue(vkb::QueueType::graphics);
         if (!graphicsQueueResult) { return std::unexpected("Failed to get graphics queue"); }
@@ -104,7 +167,7 @@ namespace Vulkano {
         mTransferQueue = transferQueueResult.has_value() ? transferQueueResult.value() : mGraphicsQueue;
 
         // Only get present queue if surface was provided
-        if (config.surface != VK_NULL_HANDLE) {
+        if (mHasSurface) {
             auto presentQueueResult = mImpl->vkbDevice->get_queue(vkb::QueueType::present);
             mPresentQueue           = presentQueueResult.has_value() ? presentQueueResult.value() : mGraphicsQueue;
         } else {
@@ -124,7 +187,7 @@ namespace Vulkano {
         mQueueFamilies.transferFamily =
           transferFamilyResult.has_value() ? transferFamilyResult.value() : mQueueFamilies.graphicsFamily;
 
-        if (config.surface != VK_NULL_HANDLE) {
+        if (mHasSurface) {
             auto presentFamilyResult = mImpl->vkbDevice->get_queue_index(vkb::QueueType::present);
             mQueueFamilies.presentFamily =
               presentFamilyResult.has_value() ? presentFamilyResult.value() : mQueueFamilies.graphicsFamily;
@@ -137,9 +200,6 @@ namespace Vulkano {
         mQueueFamilies.hasDiscreteTransfer =
           transferFamilyResult.has_value() && transferFamilyResult.value() != mQueueFamilies.graphicsFamily;
 
-        // Initialize VMA
-        if (auto result = InitializeAllocator(); !result) { return result; }
-
         return {};
     }
 
@@ -151,7 +211,66 @@ namespace Vulkano {
 
     void VulkanContext::Shutdown() {
         WaitIdle();
+        DestroyDevice();
+        mDeviceLost.store(false, std::memory_order_release);
+
+        if (mImpl->vkbPhysicalDevice) {
+            mImpl->vkbPhysicalDevice.reset();
+            mPhysicalDevice = VK_NULL_HANDLE;
+        }
+
+        mCapabilities = {};
+        mDispatch     = {};
+
+        if (mImpl->vkbInstance) {
+            vkb::destroy_instance(*mImpl->vkbInstance);
+            mImpl->vkbInstance.reset();
+            mInstance = VK_NULL_HANDLE;
+        }
+    }
+
+    void VulkanContext::WaitIdle() const {
+        if (mDevice) { CheckDeviceLost(vkDeviceWaitIdle(mDevice)); }
+    }
+
+    bool VulkanContext::CheckDeviceLost(VkResult result) const {
+        if (result != VK_ERROR_DEVICE_LOST) { return false; }
+        mDeviceLost.store(true, std::memory_order_release);
+        return true;
+    }
+
+    Result<void> VulkanContext::RecoverDevice() {
+        if (!HasDevice()) { return std::unexpected("No device to recover"); }
+
+        const auto start = StartupProfiler::Clock::now();
+
+        // Returns right away on a lost device; makes recovering a healthy one (to test the path) safe
+        WaitIdle();
+
+        // Handles of a lost device can still be destroyed, and have to be before the device is
+        mResources.ReleaseAll();
+        DestroyDevice();
 
+        // The physical device keeps the extensions and features EnableOptionalFeatures turned on, so the new device
+        // has the same capabilities and nothing cached against them goes stale
+        if (auto result = BuildDevice(); !result) { return result; }
+        if (auto result = InitializeAllocator(); !result) { return result; }
+        mDeviceLost.store(false, std::memory_order_release);
+
+        if (auto result = mResources.RecreateAll(); !result) { return result; }
+
+        const auto end = StartupProfiler::Clock::now();
+        mStartupProfiler.Record("Device recovery", start, end);
+
+        const f64 elapsedMs = std::chrono::duration<f64, std::milli>(end - start).count();
+        mRecoveryStats.recoveries++;
+        mRecoveryStats.lastRecoveryMs = elapsedMs;
+        mRecoveryStats.totalRecoveryMs += elapsedMs;
+
+        return {};
+    }
+
+    void VulkanContext::DestroyDevice() {
         if (mAllocator) {
             vmaDestroyAllocator(mAllocator);
             mAllocator = VK_NULL_HANDLE;
@@ -163,24 +282,277 @@ namespace Vulkano {
             mDevice = VK_NULL_HANDLE;
         }
 
-        if (mImpl->vkbPhysicalDevice) {
-            mImpl->vkbPhysicalDevice.reset();
-            mPhysicalDevice = VK_NULL_HANDLE;
+        mGraphicsQueue = VK_NULL_HANDLE;
+        mComputeQueue  = VK_NULL_HANDLE;
+        mTransferQueue = VK_NULL_HANDLE;
+        mPresentQueue  = VK_NULL_HANDLE;
+    }
+
+    void VulkanContext::EnableOptionalFeatures(const DeviceConfig& config) {
+        mCapabilities        = {};
+        auto& physicalDevice = *mImpl->vkbPhysicalDevice;
+
+        {
+            VkPhysicalDeviceFeatures requested {};
+            requested.multiDrawIndirect         = mDeviceFeatures.multiDrawIndirect;
+            requested.drawIndirectFirstInstance = mDeviceFeatures.drawIndirectFirstInstance;
+            if (physicalDevice.enable_features_if_present(requested)) {
+                mCapabilities.multiDrawIndirect         = requested.multiDrawIndirect == VK_TRUE;
+                mCapabilities.drawIndirectFirstInstance = requested.drawIndirectFirstInstance == VK_TRUE;
+            }
         }
 
-        if (mImpl->vkbInstance) {
-            vkb::destroy_instance(*mImpl->vkbInstance);
-            mImpl->vkbInstance.reset();
-            mInstance = VK_NULL_HANDLE;
+        {
+            VkPhysicalDeviceVulkan12Features supported {};
+            supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+            VkPhysicalDeviceFeatures2 features2 {};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &supported;
+            vkGetPhysicalDeviceFeatures2(mPhysicalDevice, &features2);
+
+            const bool bindless = config.enableBindlessTextures && supported.runtimeDescriptorArray &&
+                                  supported.shaderSampledImageArrayNonUniformIndexing &&
+                                  supported.descriptorBindingPartiallyBound &&
+                                  supported.descriptorBindingSampledImageUpdateAfterBind &&
+                                  supported.descriptorBindingUpdateUnusedWhilePending;
+            const VkBool32 enableBindless = bindless ? VK_TRUE : VK_FALSE;
+
+            // Merged with the required 1.2 features by vk-bootstrap
+            VkPhysicalDeviceVulkan12Features requested {};
+            requested.sType                                        = supported.sType;
+            requested.bufferDeviceAddress                          = VK_TRUE;
+            requested.timelineSemaphore                            = VK_TRUE;
+            requested.drawIndirectCount                            = supported.drawIndirectCount;
+            requested.runtimeDescriptorArray                       = enableBindless;
+            requested.shaderSampledImageArrayNonUniformIndexing    = enableBindless;
+            requested.descriptorBindingPartiallyBound              = enableBindless;
+            requested.descriptorBindingSampledImageUpdateAfterBind = enableBindless;
+            requested.descriptorBindingUpdateUnusedWhilePending    = enableBindless;
+            if ((requested.drawIndirectCount || bindless) &&
+                physicalDevice.enable_extension_features_if_present(requested)) {
+                mCapabilities.drawIndirectCount = requested.drawIndirectCount == VK_TRUE;
+                mCapabilities.bindlessTextures  = bindless;
+            }
+
+            if (mCapabilities.bindlessTextures) {
+                VkPhysicalDeviceVulkan12Properties properties {};
+                properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+
+                VkPhysicalDeviceProperties2 properties2 {};
+                properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                properties2.pNext = &properties;
+                vkGetPhysicalDeviceProperties2(mPhysicalDevice, &properties2);
+
+                mCapabilities.maxBindlessTextures =
+                  std::min(properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                           properties.maxDescriptorSetUpdateAfterBindSampledImages);
+            }
+        }
+
+        // Core since 1.1 but still an optional feature; one draw stream renders every view of a layered target
+        if (config.enableMultiview) {
+            VkPhysicalDeviceVulkan11Features supported {};
+            supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_FEATURES;
+
+            VkPhysicalDeviceFeatures2 features2 {};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &supported;
+            vkGetPhysicalDeviceFeatures2(mPhysicalDevice, &features2);
+
+            VkPhysicalDeviceVulkan11Features requested {};
+            requested.sType     = supported.sType;
+            requested.multiview = VK_TRUE;
+
+            if (supported.multiview && physicalDevice.enable_extension_features_if_present(requested)) {
+                VkPhysicalDeviceVulkan11Properties properties {};
+                properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_1_PROPERTIES;
+
+                VkPhysicalDeviceProperties2 properties2 {};
+                properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                properties2.pNext = &properties;
+                vkGetPhysicalDeviceProperties2(mPhysicalDevice, &properties2);
+
+                mCapabilities.multiview             = true;
+                mCapabilities.maxMultiviewViewCount = properties.maxMultiviewViewCount;
+            }
+        }
+
+        // Extended dynamic state 1 and 2 are core in 1.3; only the parts of 3 we use are optional
+        if (config.enableExtendedDynamicState3 &&
+            physicalDevice.is_extension_present(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME)) {
+            VkPhysicalDeviceExtendedDynamicState3FeaturesEXT supported {};
+            supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+
+            VkPhysicalDeviceFeatures2 features2 {};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &supported;
+            vkGetPhysicalDeviceFeatures2(mPhysicalDevice, &features2);
+
+            const bool colorBlend = supported.extendedDynamicState3ColorBlendEnable &&
+                                    supported.extendedDynamicState3ColorBlendEquation &&
+                                    supported.extendedDynamicState3ColorWriteMask;
+
+            VkPhysicalDeviceExtendedDynamicState3FeaturesEXT requested {};
+            requested.sType                                   = supported.sType;
+            requested.extendedDynamicState3PolygonMode        = supported.extendedDynamicState3PolygonMode;
+            requested.extendedDynamicState3ColorBlendEnable   = colorBlend ? VK_TRUE : VK_FALSE;
+            requested.extendedDynamicState3ColorBlendEquation = colorBlend ? VK_TRUE : VK_FALSE;
+            requested.extendedDynamicState3ColorWriteMask     = colorBlend ? VK_TRUE : VK_FALSE;
+
+            if ((requested.extendedDynamicState3PolygonMode || colorBlend) &&
+                physicalDevice.enable_extension_if_present(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME) &&
+                physicalDevice.enable_extension_features_if_present(requested)) {
+                mCapabilities.dynamicPolygonMode = requested.extendedDynamicState3PolygonMode == VK_TRUE;
+                mCapabilities.dynamicColorBlend  = colorBlend;
+            }
+        }
+
+        if (config.enablePushDescriptors &&
+            physicalDevice.enable_extension_if_present(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME)) {
+            VkPhysicalDevicePushDescriptorPropertiesKHR pushProperties {};
+            pushProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PUSH_DESCRIPTOR_PROPERTIES_KHR;
+
+            VkPhysicalDeviceProperties2 properties2 {};
+            properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+            properties2.pNext = &pushProperties;
+            vkGetPhysicalDeviceProperties2(mPhysicalDevice, &properties2);
+
+            mCapabilities.pushDescriptors    = true;
+            mCapabilities.maxPushDescriptors = pushProperties.maxPushDescriptors;
+        }
+
+        if (config.enableDescriptorBuffer &&
+            physicalDevice.is_extension_present(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME)) {
+            VkPhysicalDeviceDescriptorBufferFeaturesEXT supported {};
+            supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_FEATURES_EXT;
+
+            VkPhysicalDeviceFeatures2 features2 {};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &supported;
+            vkGetPhysicalDeviceFeatures2(mPhysicalDevice, &features2);
+
+            VkPhysicalDeviceDescriptorBufferFeaturesEXT requested {};
+            requested.sType            = supported.sType;
+            requested.descriptorBuffer = VK_TRUE;
+
+            if (supported.descriptorBuffer &&
+                physicalDevice.enable_extension_if_present(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME) &&
+                physicalDevice.enable_extension_features_if_present(requested)) {
+                auto& properties = mCapabilities.descriptorBufferProperties;
+                properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_BUFFER_PROPERTIES_EXT;
+
+                VkPhysicalDeviceProperties2 properties2 {};
+                properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                properties2.pNext = &properties;
+                vkGetPhysicalDeviceProperties2(mPhysicalDevice, &properties2);
+                properties.pNext = nullptr;
+
+                mCapabilities.descriptorBuffer = true;
+            }
+        }
+
+        if (config.enableMeshShaders && physicalDevice.is_extension_present(VK_EXT_MESH_SHADER_EXTENSION_NAME)) {
+            VkPhysicalDeviceMeshShaderFeaturesEXT supported {};
+            supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_FEATURES_EXT;
+
+            VkPhysicalDeviceFeatures2 features2 {};
+            features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+            features2.pNext = &supported;
+            vkGetPhysicalDeviceFeatures2(mPhysicalDevice, &features2);
+
+            // Only the task and mesh stages; multiview, shading rate and query support stay off
+            VkPhysicalDeviceMeshShaderFeaturesEXT requested {};
+            requested.sType      = supported.sType;
+            requested.taskShader = VK_TRUE;
+            requested.meshShader = VK_TRUE;
+
+            if (supported.taskShader && supported.meshShader &&
+                physicalDevice.enable_extension_if_present(VK_EXT_MESH_SHADER_EXTENSION_NAME) &&
+                physicalDevice.enable_extension_features_if_present(requested)) {
+                auto& properties = mCapabilities.meshShaderProperties;
+                properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MESH_SHADER_PROPERTIES_EXT;
+
+                VkPhysicalDeviceProperties2 properties2 {};
+                properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+                properties2.pNext = &properties;
+                vkGetPhysicalDeviceProperties2(mPhysicalDevice, &properties2);
+                properties.pNext = nullptr;
+
+                mCapabilities.meshShaders = true;
+            }
+        }
+
+        // Breadcrumb hardware support: cheap enough to leave on, and only consulted after a hang or device loss
+        if (config.enableCrashDiagnostics) {
+            mCapabilities.bufferMarkers =
+              physicalDevice.enable_extension_if_present(VK_AMD_BUFFER_MARKER_EXTENSION_NAME);
+            mCapabilities.diagnosticCheckpoints =
+              physicalDevice.enable_extension_if_present(VK_NV_DEVICE_DIAGNOSTIC_CHECKPOINTS_EXTENSION_NAME);
+
+            if (physicalDevice.is_extension_present(VK_EXT_DEVICE_FAULT_EXTENSION_NAME)) {
+                VkPhysicalDeviceFaultFeaturesEXT supported {};
+                supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FAULT_FEATURES_EXT;
+
+                VkPhysicalDeviceFeatures2 features2 {};
+                features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+                features2.pNext = &supported;
+                vkGetPhysicalDeviceFeatures2(mPhysicalDevice, &features2);
+
+                VkPhysicalDeviceFaultFeaturesEXT requested {};
+                requested.sType                   = supported.sType;
+                requested.deviceFault             = VK_TRUE;
+                requested.deviceFaultVendorBinary = supported.deviceFaultVendorBinary;
+
+                if (supported.deviceFault &&
+                    physicalDevice.enable_extension_if_present(VK_EXT_DEVICE_FAULT_EXTENSION_NAME) &&
+                    physicalDevice.enable_extension_features_if_present(requested)) {
+                    mCapabilities.deviceFault             = true;
+                    mCapabilities.deviceFaultVendorBinary = requested.deviceFaultVendorBinary == VK_TRUE;
+                }
+            }
         }
     }
 
-    void VulkanContext::WaitIdle() const {
-        if (mDevice) { vkDeviceWaitIdle(mDevice); }
+    void VulkanContext::LoadDispatch() {
+        mDispatch = {};
+
+        const auto load = [this]<typename T>(T& function, const char* name) {
+            function = RCAST<T>(vkGetDeviceProcAddr(mDevice, name));
+        };
+
+        if (mCapabilities.dynamicPolygonMode) { load(mDispatch.cmdSetPolygonMode, "vkCmdSetPolygonModeEXT"); }
+        if (mCapabilities.dynamicColorBlend) {
+            load(mDispatch.cmdSetColorBlendEnable, "vkCmdSetColorBlendEnableEXT");
+            load(mDispatch.cmdSetColorBlendEquation, "vkCmdSetColorBlendEquationEXT");
+            load(mDispatch.cmdSetColorWriteMask, "vkCmdSetColorWriteMaskEXT");
+        }
+        if (mCapabilities.pushDescriptors) { load(mDispatch.cmdPushDescriptorSet, "vkCmdPushDescriptorSetKHR"); }
+        if (mCapabilities.descriptorBuffer) {
+            load(mDispatch.getDescriptorSetLayoutSize, "vkGetDescriptorSetLayoutSizeEXT");
+            load(mDispatch.getDescriptorSetLayoutBindingOffset, "vkGetDescriptorSetLayoutBindingOffsetEXT");
+            load(mDispatch.getDescriptor, "vkGetDescriptorEXT");
+            load(mDispatch.cmdBindDescriptorBuffers, "vkCmdBindDescriptorBuffersEXT");
+            load(mDispatch.cmdSetDescriptorBufferOffsets, "vkCmdSetDescriptorBufferOffsetsEXT");
+        }
+        if (mCapabilities.meshShaders) {
+            load(mDispatch.cmdDrawMeshTasks, "vkCmdDrawMeshTasksEXT");
+            load(mDispatch.cmdDrawMeshTasksIndirect, "vkCmdDrawMeshTasksIndirectEXT");
+            if (mCapabilities.drawIndirectCount) {
+                load(mDispatch.cmdDrawMeshTasksIndirectCount, "vkCmdDrawMeshTasksIndirectCountEXT");
+            }
+        }
+        if (mCapabilities.bufferMarkers) { load(mDispatch.cmdWriteBufferMarker2, "vkCmdWriteBufferMarker2AMD"); }
+        if (mCapabilities.diagnosticCheckpoints) {
+            load(mDispatch.cmdSetCheckpoint, "vkCmdSetCheckpointNV");
+            load(mDispatch.getQueueCheckpointData, "vkGetQueueCheckpointDataNV");
+        }
+        if (mCapabilities.deviceFault) { load(mDispatch.getDeviceFaultInfo, "vkGetDeviceFaultInfoEXT"); }
     }
 
     Result<void> VulkanContext::InitializeAllocator() {
         VmaAllocatorCreateInfo allocatorInfo {};
+        allocatorInfo.flags            = VMA_ALLOCATOR_CREATE_BUFFER_DEVICE_ADDRESS_BIT;
         allocatorInfo.vulkanApiVersion = VK_API_VERSION_1_3;
         allocatorInfo.instance         = mInstance;
         allocatorInfo.physicalDevice   = mPhysicalDevice;
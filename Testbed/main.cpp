@@ -5,19 +5,64 @@
 #include <Vulkano/VulkanContext.hpp>
 #include <Vulkano/SwapchainManager.hpp>
 #include <Vulkano/FrameSynchronizer.hpp>
+#include <Vulkano/JobSystem.hpp>
+#include <Vulkano/PipelineCache.hpp>
+#include <Vulkano/ShaderLibrary.hpp>
+#include <Vulkano/PipelineCompiler.hpp>
+#include <Vulkano/PipelineVariants.hpp>
+#include <Vulkano/FrameCapture.hpp>
+#include <Vulkano/DebugDraw.hpp>
+#include <Vulkano/Breadcrumbs.hpp>
 
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
 static Vulkano::VulkanContext gContext;
 static Vulkano::SwapchainManager gSwapchain;
 static Vulkano::FrameSynchronizer gFrameSync;
+static Vulkano::JobSystem gJobs;
+static Vulkano::PipelineCache gPipelineCache;
+static Vulkano::ShaderLibrary gShaders;
+static Vulkano::PipelineCompiler gPipelines;
+static VkPipelineLayout gEmptyLayout;
+// Triangle.frag: constant 0 switches to grayscale (toggled with G)
+using TriangleVariant = Vulkano::PermutationKey<Vulkano::PermutationOption {0, 1}>;
+
+static std::unique_ptr<Vulkano::PipelineVariants<TriangleVariant>> gTriangleVariants;
+static bool gGrayscale {false};
+static Vulkano::FrameCapture gCapture;
+static Vulkano::FrameCapture::ResourceId gSwapchainTarget {0};
+static Vulkano::DebugDraw gDebugDraw;
+static Vulkano::Breadcrumbs gBreadcrumbs;
+static uint32_t gClearPass {0};
+static uint32_t gScenePass {0};
 static GLFWwindow* gWindow;
 static VkSurfaceKHR gSurface;
+static bool gFirstFramePresented {false};
 
 inline constexpr int kWindowWidth {1280};
 inline constexpr int kWindowHeight {720};
 inline constexpr std::string_view kWindowTitle {"Testbed"};
+inline constexpr std::string_view kPipelineCachePath {"pipeline_cache.bin"};
+inline constexpr std::string_view kPipelineManifestPath {"pipeline_manifest.bin"};
+inline constexpr std::string_view kShaderDirectory {"Shaders"};
+inline constexpr float kFrameRateLimit {120.0f};  // The swapchain prefers mailbox, which would otherwise never block
+inline constexpr std::string_view kCapturePath {"frame.vcap"};  // Written by C, replayed by Tools/Replay
+inline constexpr uint32_t kCaptureFrames {60};
+
+static Vulkano::GraphicsPipelineDesc TrianglePipelineDesc(VkFormat colorFormat) {
+    Vulkano::GraphicsPipelineDesc desc;
+    desc.stages       = {{VK_SHADER_STAGE_VERTEX_BIT, "Triangle.vert", "main", {}},
+                         {VK_SHADER_STAGE_FRAGMENT_BIT, "Triangle.frag", "main", {}}};
+    desc.layout       = "Empty";
+    desc.colorFormats = {colorFormat};
+    desc.dynamicState = Vulkano::kDynamicStateAll;
+    return desc;
+}
 
 static std::vector<const char*> InitializeGLFW() {
     if (!glfwInit()) { throw std::runtime_error("Failed to initialize GLFW"); }
@@ -45,6 +90,10 @@ static void RecordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageInd
     if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
         throw std::runtime_error("Failed to begin recording command buffer");
     }
+    gCapture.Begin(commandBuffer);
+
+    const VkQueue queue = gContext.GetGraphicsQueue();
+    gBreadcrumbs.BeginPass(commandBuffer, queue, gClearPass);
 
     // Transition image to transfer dst layout
     VkImageMemoryBarrier barrier {};
@@ -88,15 +137,75 @@ static void RecordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageInd
                          &clearColor,
                          1,
                          &range);
+    gBreadcrumbs.EndPass(commandBuffer, queue, gClearPass);
 
-    // Transition image to present layout
+    // Transition image to color attachment layout for the triangle pass
     barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    barrier.newLayout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    barrier.newLayout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
     barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-    barrier.dstAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
 
     vkCmdPipelineBarrier(commandBuffer,
                          VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                         0,
+                         0,
+                         nullptr,
+                         0,
+                         nullptr,
+                         1,
+                         &barrier);
+
+    // Draw the triangle once its pipeline has finished compiling in the background; never stall the frame on it
+    const VkPipeline trianglePipeline =
+      gTriangleVariants ? gTriangleVariants->Get(TriangleVariant {}.With<0>(gGrayscale)) : VK_NULL_HANDLE;
+    gBreadcrumbs.BeginPass(commandBuffer, queue, gScenePass);
+    if (trianglePipeline != VK_NULL_HANDLE || gDebugDraw.IsInitialized()) {
+        VkRenderingAttachmentInfo colorAttachment {};
+        colorAttachment.sType       = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
+        colorAttachment.imageView   = gSwapchain.GetImageView(imageIndex);
+        colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        colorAttachment.loadOp      = VK_ATTACHMENT_LOAD_OP_LOAD;
+        colorAttachment.storeOp     = VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachment.clearValue  = {.color = clearColor};  // Replay clears where this loads
+
+        VkRenderingInfo renderingInfo {};
+        renderingInfo.sType                = VK_STRUCTURE_TYPE_RENDERING_INFO;
+        renderingInfo.renderArea           = {{0, 0}, gSwapchain.GetExtent()};
+        renderingInfo.layerCount           = 1;
+        renderingInfo.colorAttachmentCount = 1;
+        renderingInfo.pColorAttachments    = &colorAttachment;
+
+        const VkExtent2D extent = gSwapchain.GetExtent();
+        const VkViewport viewport {0.0f, 0.0f, CAST<float>(extent.width), CAST<float>(extent.height), 0.0f, 1.0f};
+        const VkRect2D scissor {{0, 0}, extent};
+
+        // Through the capture so C can record it; the clear pass above and the HUD below aren't captured
+        gCapture.BeginRendering(commandBuffer, renderingInfo, gSwapchainTarget);
+        gCapture.SetViewport(commandBuffer, viewport);
+        gCapture.SetScissor(commandBuffer, scissor);
+        if (trianglePipeline != VK_NULL_HANDLE) {
+            gCapture.BindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, trianglePipeline);
+            gCapture.Draw(commandBuffer, 3, 1, 0, 0);
+        }
+
+        // Frame-time HUD in the top-left corner (binds its own pipelines, so it goes last)
+        if (gDebugDraw.IsInitialized()) {
+            gDebugDraw.FrameTimeGraph(gFrameSync, 10.0f, 10.0f, 240.0f, 60.0f);
+            Vulkano::AssertResult(gDebugDraw.Flush(gFrameSync, {}, extent));
+        }
+        gCapture.EndRendering(commandBuffer);
+    }
+    gBreadcrumbs.EndPass(commandBuffer, queue, gScenePass);
+
+    // Transition image to present layout
+    barrier.oldLayout     = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    barrier.newLayout     = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    barrier.dstAccessMask = 0;
+
+    vkCmdPipelineBarrier(commandBuffer,
+                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
                          VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
                          0,
                          0,
@@ -111,9 +220,37 @@ static void RecordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageInd
     }
 }
 
+static void RecoverDevice() {
+    Vulkano::AssertResult(gContext.RecoverDevice());
+    std::cout << "Recovered from device loss in " << gContext.GetRecoveryStats().lastRecoveryMs << " ms\n";
+}
+
 static void DrawFrame() {
+    // Any wait, acquire, present or submit that hit a lost device last frame flagged it
+    if (gContext.IsDeviceLost()) {
+        RecoverDevice();
+        return;
+    }
+
     // Begin frame (waits on fence, resets command buffer)
-    Vulkano::AssertResult(gFrameSync.BeginFrame());
+    if (auto result = gFrameSync.BeginFrame(); !result) {
+        if (!gContext.IsDeviceLost()) { throw std::runtime_error(result.error()); }
+        // Carries the breadcrumb report, which doesn't survive recovery
+        std::cerr << result.error() << '\n';
+        return;
+    }
+    gBreadcrumbs.BeginFrame();
+    gDebugDraw.BeginFrame(gFrameSync);
+
+    // Starts a requested capture, or saves one that has all its frames
+    const bool wasCapturing = gCapture.IsCapturing();
+    if (auto result = gCapture.BeginFrame(); !result) {
+        std::cerr << result.error() << '\n';
+    } else if (wasCapturing && !gCapture.IsCapturing()) {
+        const auto& stats = gCapture.GetStats();
+        std::cout << "Captured " << stats.frames << " frames to " << kCapturePath << " (" << stats.bytes / 1024
+                  << " KiB)\n";
+    }
 
     // Acquire image from swapchain
     auto imageIndexResult = gSwapchain.AcquireNextImage(gFrameSync.GetCurrentImageAvailableSemaphore());
@@ -141,25 +278,111 @@ static void DrawFrame() {
     submitInfo.commandBufferCount     = 1;
     submitInfo.pCommandBuffers        = &currentCommandBuffer;
 
-    VkSemaphore signalSemaphores[]  = {gFrameSync.GetCurrentRenderFinishedSemaphore()};
+    VkSemaphore signalSemaphores[]  = {gSwapchain.GetPresentSemaphore(imageIndex)};
     submitInfo.signalSemaphoreCount = 1;
     submitInfo.pSignalSemaphores    = signalSemaphores;
 
-    if (vkQueueSubmit(gContext.GetGraphicsQueue(), 1, &submitInfo, gFrameSync.GetCurrentFence()) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to submit draw command buffer");
+    if (auto result = gCapture.Submit(gContext.GetGraphicsQueue(), submitInfo, gFrameSync.GetCurrentFence());
+        !result) {
+        if (!gContext.IsDeviceLost()) { throw std::runtime_error(result.error()); }
+        gFrameSync.EndFrame();
+        return;
     }
 
     // Present
-    auto presentResult = gSwapchain.Present(imageIndex, gFrameSync.GetCurrentRenderFinishedSemaphore());
+    auto presentResult = gSwapchain.Present(imageIndex, gSwapchain.GetPresentSemaphore(imageIndex));
     if (!presentResult) {
         // Swapchain out of date, will be handled next frame
+    } else if (!gFirstFramePresented) {
+        gFirstFramePresented = true;
+        gContext.GetStartupProfiler().MarkFirstFrame();
+        std::cout << gContext.GetStartupProfiler().Report();
     }
 
     // End frame (advance to next frame)
     gFrameSync.EndFrame();
 }
 
+static Vulkano::Result<void> CreateEmptyLayout() {
+    VkPipelineLayoutCreateInfo layoutInfo {};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    if (vkCreatePipelineLayout(gContext.GetDevice(), &layoutInfo, nullptr, &gEmptyLayout) != VK_SUCCESS) {
+        return std::unexpected("Failed to create pipeline layout");
+    }
+    gPipelines.RegisterLayout("Empty", gEmptyLayout);
+    return {};
+}
+
+static void WarmUpPipelines() {
+    Vulkano::AssertResult(gPipelineCache.Initialize(&gContext));
+    Vulkano::AssertResult(gShaders.Initialize(&gContext));
+    Vulkano::AssertResult(gPipelines.Initialize(&gContext, &gJobs, &gShaders, &gPipelineCache));
+    Vulkano::AssertResult(CreateEmptyLayout());
+
+    // Replay last run's first-use order on the compiler's background thread
+    Vulkano::PipelineManifest manifest;
+    if (manifest.Load(kPipelineManifestPath)) { gPipelines.WarmUp(manifest); }
+
+    // The swapchain is still being created, so compile against the format we expect it to pick. If it ends up
+    // with a fallback format the first frames simply skip the triangle until the right pipeline is built.
+    if (gShaders.Contains("Triangle.vert")) {
+        gTriangleVariants = std::make_unique<Vulkano::PipelineVariants<TriangleVariant>>(
+          gPipelines,
+          TrianglePipelineDesc(Vulkano::SwapchainConfig {}.preferredFormat));
+        gTriangleVariants->Prepare(TriangleVariant {});
+        gTriangleVariants->Prepare(TriangleVariant {}.With<0>(1));
+    }
+}
+
+// Device loss rebuilds all of this in place (see RecoverDevice). Layouts, and DebugDraw which registers its own,
+// come back a stage ahead of the compiler so the pipelines it queues again can find them.
+static void RegisterRecovery(const Vulkano::DebugDraw::Config& debugConfig) {
+    using Vulkano::RecoveryStage;
+    auto& resources = gContext.GetResources();
+
+    resources.Register("Frame synchronizer", RecoveryStage::Core, gFrameSync);
+    resources.Register("Swapchain", RecoveryStage::Core, gSwapchain);
+    resources.Register("Breadcrumbs", RecoveryStage::Core, gBreadcrumbs);
+    resources.Register("Frame capture", RecoveryStage::Core, gCapture);
+
+    resources.Register("Shaders", RecoveryStage::Resources, gShaders);
+    resources.Register("Pipeline cache", RecoveryStage::Resources, gPipelineCache);
+    resources.Register(
+      "Empty layout",
+      RecoveryStage::Resources,
+      [] {
+          vkDestroyPipelineLayout(gContext.GetDevice(), gEmptyLayout, nullptr);
+          gEmptyLayout = VK_NULL_HANDLE;
+      },
+      CreateEmptyLayout);
+    if (gDebugDraw.IsInitialized()) {
+        resources.Register(
+          "Debug draw",
+          RecoveryStage::Resources,
+          [] { gDebugDraw.Shutdown(); },
+          [debugConfig] { return gDebugDraw.Initialize(&gContext, &gPipelines, debugConfig); });
+    }
+
+    resources.Register("Pipelines", RecoveryStage::Pipelines, gPipelines);
+}
+
 static void InitializeVulkano(const std::vector<const char*>& instanceExtensions) {
+    // Step 0: Start file IO on worker threads so it overlaps instance and device creation
+    Vulkano::AssertResult(gJobs.Initialize());
+    gPipelineCache.LoadAsync(gJobs, kPipelineCachePath);
+
+    const std::filesystem::path shaderDirectory {kShaderDirectory};
+    if (std::filesystem::exists(shaderDirectory / "Triangle.vert.spv") &&
+        std::filesystem::exists(shaderDirectory / "Triangle.frag.spv")) {
+        gShaders.LoadAsync(gJobs, "Triangle.vert", shaderDirectory / "Triangle.vert.spv");
+        gShaders.LoadAsync(gJobs, "Triangle.frag", shaderDirectory / "Triangle.frag.spv");
+    }
+    if (std::filesystem::exists(shaderDirectory / "DebugDraw.vert.spv") &&
+        std::filesystem::exists(shaderDirectory / "DebugDraw.frag.spv")) {
+        gShaders.LoadAsync(gJobs, "DebugDraw.vert", shaderDirectory / "DebugDraw.vert.spv");
+        gShaders.LoadAsync(gJobs, "DebugDraw.frag", shaderDirectory / "DebugDraw.frag.spv");
+    }
+
     // Step 1: Create Vulkan instance
     Vulkano::VulkanContext::InstanceConfig instanceConfig;
     instanceConfig.instanceExtensions = instanceExtensions;
@@ -179,14 +402,59 @@ static void InitializeVulkano(const std::vector<const char*>& instanceExtensions
     deviceConfig.surface = gSurface;
     Vulkano::AssertResult(gContext.CreateDevice(deviceConfig));
 
-    // Step 4: Create swapchain
+    // Step 4: Everything below only depends on the device, so the frame synchronizer (manages all sync objects
+    // and command buffers) and the pipeline warm-up run on workers while this thread creates the swapchain
+    const Vulkano::JobHandle frameSyncJob =
+      gJobs.Submit([] { Vulkano::AssertResult(gFrameSync.Initialize(&gContext, 2)); });  // 2 frames in flight
+    const Vulkano::JobHandle warmUpJob = gJobs.Submit(WarmUpPipelines);
+
     Vulkano::AssertResult(gSwapchain.Initialize(&gContext, gSurface, kWindowWidth, kWindowHeight));
 
-    // Step 5: Create frame synchronizer (manages all sync objects and command buffers)
-    Vulkano::AssertResult(gFrameSync.Initialize(&gContext, 2));  // 2 frames in flight
+    // Rethrows anything the jobs threw
+    frameSyncJob.get();
+    warmUpJob.get();
+
+    // Cheap enough to leave on: a hung frame reports the last pass the GPU finished
+    Vulkano::AssertResult(gBreadcrumbs.Initialize(&gContext, {}));
+    gClearPass = gBreadcrumbs.RegisterPass("Clear").value();
+    gScenePass = gBreadcrumbs.RegisterPass("Scene").value();
+    gFrameSync.SetBreadcrumbs(&gBreadcrumbs);
+
+    // Pipelines are described by the compiler; the swapchain stands in as a plain target
+    Vulkano::AssertResult(gCapture.Initialize(&gContext, &gShaders, &gPipelines));
+    gSwapchainTarget = gCapture.RegisterTarget(gSwapchain.GetExtent(), gSwapchain.GetFormat());
+
+    Vulkano::DebugDraw::Config debugConfig;
+    debugConfig.colorFormat = gSwapchain.GetFormat();
+    if (gShaders.Contains("DebugDraw.vert") && gShaders.Contains("DebugDraw.frag")) {
+        if (auto result = gDebugDraw.Initialize(&gContext, &gPipelines, debugConfig); !result) {
+            std::cerr << result.error() << '\n';
+        }
+    }
+
+    // Only needed if the swapchain picked a different format than the warm-up guessed
+    if (gTriangleVariants && gTriangleVariants->GetBase().colorFormats[0] != gSwapchain.GetFormat()) {
+        gTriangleVariants = std::make_unique<Vulkano::PipelineVariants<TriangleVariant>>(
+          gPipelines,
+          TrianglePipelineDesc(gSwapchain.GetFormat()));
+        gTriangleVariants->Prepare(TriangleVariant {});
+    }
+
+    RegisterRecovery(debugConfig);
+}
+
+static void OnKey(GLFWwindow*, int key, int, int action, int) {
+    if (key == GLFW_KEY_G && action == GLFW_PRESS) { gGrayscale = !gGrayscale; }
+    if (key == GLFW_KEY_C && action == GLFW_PRESS && !gCapture.IsCapturing()) {
+        gCapture.Request(kCapturePath, kCaptureFrames);
+        std::cout << "Capturing " << kCaptureFrames << " frames\n";
+    }
 }
 
 static void Run() {
+    glfwSetKeyCallback(gWindow, OnKey);
+    gFrameSync.SetFrameRateLimit(kFrameRateLimit);
+
     while (!glfwWindowShouldClose(gWindow)) {
         glfwPollEvents();
         DrawFrame();
@@ -199,9 +467,24 @@ static void Run() {
 static void Cleanup() {
     // Cleanup in reverse order of creation
     gFrameSync.Shutdown();
+    gBreadcrumbs.Shutdown();
+    gTriangleVariants.reset();
+    gCapture.Shutdown();
+    gDebugDraw.Shutdown();
+    if (auto result = gPipelines.GetUsage().Save(kPipelineManifestPath); !result) {
+        std::cerr << result.error() << '\n';
+    }
+    gPipelines.Shutdown();
+    vkDestroyPipelineLayout(gContext.GetDevice(), gEmptyLayout, nullptr);
+
+    if (auto result = gPipelineCache.Save(); !result) { std::cerr << result.error() << '\n'; }
+    gPipelineCache.Shutdown();
+    gShaders.Shutdown();
+
     gSwapchain.Shutdown();
     vkDestroySurfaceKHR(gContext.GetInstance(), gSurface, nullptr);
     gContext.Shutdown();
+    gJobs.Shutdown();
     glfwDestroyWindow(gWindow);
     glfwTerminate();
 }
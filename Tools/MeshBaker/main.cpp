@@ -0,0 +1,150 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include <Vulkano/MeshProcessing.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    using Vulkano::f32;
+    using Vulkano::i32;
+    using Vulkano::Result;
+    using Vulkano::SourceVertex;
+    using Vulkano::u32;
+
+    /// @brief Resolve a 1-based (or negative, relative) OBJ index against the number of elements read so far
+    bool ResolveIndex(i32 index, size_t count, size_t& out) {
+        if (index > 0 && CAST<size_t>(index) <= count) {
+            out = CAST<size_t>(index - 1);
+            return true;
+        }
+        if (index < 0 && CAST<size_t>(-index) <= count) {
+            out = count - CAST<size_t>(-index);
+            return true;
+        }
+        return false;
+    }
+
+    /// @brief Read positions, normals and UVs of a Wavefront OBJ as a triangle list (polygons are fanned)
+    Result<std::vector<SourceVertex>> LoadObj(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) { return std::unexpected("Failed to open " + path); }
+
+        std::vector<f32> positions;
+        std::vector<f32> normals;
+        std::vector<f32> uvs;
+        std::vector<SourceVertex> triangles;
+
+        std::string line;
+        for (u32 lineNumber = 1; std::getline(file, line); lineNumber++) {
+            std::istringstream stream(line);
+            std::string keyword;
+            stream >> keyword;
+
+            if (keyword == "v") {
+                f32 x = 0.0f, y = 0.0f, z = 0.0f;
+                stream >> x >> y >> z;
+                positions.insert(positions.end(), {x, y, z});
+            } else if (keyword == "vn") {
+                f32 x = 0.0f, y = 0.0f, z = 0.0f;
+                stream >> x >> y >> z;
+                normals.insert(normals.end(), {x, y, z});
+            } else if (keyword == "vt") {
+                f32 u = 0.0f, v = 0.0f;
+                stream >> u >> v;
+                uvs.insert(uvs.end(), {u, 1.0f - v});  // OBJ puts v = 0 at the bottom
+            } else if (keyword == "f") {
+                std::vector<SourceVertex> polygon;
+                std::string corner;
+                while (stream >> corner) {
+                    // v, v/vt, v//vn or v/vt/vn
+                    i32 indices[3] = {0, 0, 0};
+                    size_t start   = 0;
+                    for (u32 part = 0; part < 3 && start <= corner.size(); part++) {
+                        const size_t slash = corner.find('/', start);
+                        const std::string token =
+                          corner.substr(start, slash == std::string::npos ? std::string::npos : slash - start);
+                        if (!token.empty()) { indices[part] = std::atoi(token.c_str()); }
+                        if (slash == std::string::npos) { break; }
+                        start = slash + 1;
+                    }
+
+                    SourceVertex vertex;
+                    size_t index = 0;
+                    if (!ResolveIndex(indices[0], positions.size() / 3, index)) {
+                        return std::unexpected(path + ":" + std::to_string(lineNumber) + ": bad position index");
+                    }
+                    std::copy_n(&positions[index * 3], 3, vertex.position);
+                    if (indices[1] != 0 && ResolveIndex(indices[1], uvs.size() / 2, index)) {
+                        std::copy_n(&uvs[index * 2], 2, vertex.uv);
+                    }
+                    if (indices[2] != 0 && ResolveIndex(indices[2], normals.size() / 3, index)) {
+                        std::copy_n(&normals[index * 3], 3, vertex.normal);
+                    }
+                    polygon.push_back(vertex);
+                }
+
+                for (size_t i = 2; i < polygon.size(); i++) {
+                    triangles.insert(triangles.end(), {polygon[0], polygon[i - 1], polygon[i]});
+                }
+            }
+        }
+
+        if (triangles.empty()) { return std::unexpected(path + " contains no faces"); }
+        return triangles;
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::fprintf(stderr, "Usage: MeshBaker <input.obj> <output.vmesh> [--cache <entries>]\n");
+        return EXIT_FAILURE;
+    }
+
+    Vulkano::MeshProcessOptions options;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        if (std::string(argv[i]) == "--cache") { options.simulatedCacheSize = CAST<u32>(std::atoi(argv[i + 1])); }
+    }
+
+    const auto source = LoadObj(argv[1]);
+    if (!source) {
+        std::fprintf(stderr, "%s\n", source.error().c_str());
+        return EXIT_FAILURE;
+    }
+
+    const auto mesh = Vulkano::ProcessMesh(*source, {}, options);
+    if (!mesh) {
+        std::fprintf(stderr, "%s\n", mesh.error().c_str());
+        return EXIT_FAILURE;
+    }
+
+    if (auto result = mesh->Save(argv[2]); !result) {
+        std::fprintf(stderr, "%s\n", result.error().c_str());
+        return EXIT_FAILURE;
+    }
+
+    // The OBJ is read as a triangle list, so "before" is the unindexed cost
+    const Vulkano::MeshReport& report = mesh->report;
+    std::printf("%s: %u triangles, %u unique vertices\n", argv[1], report.triangles, report.vertices);
+    std::printf("  VS invocations: %u -> %u (ACMR %.3f -> %.3f, %u-entry FIFO)\n",
+                report.invocationsBefore,
+                report.invocationsAfter,
+                report.AcmrBefore(),
+                report.AcmrAfter(),
+                options.simulatedCacheSize);
+    std::printf("  Meshlets: %u (up to %u vertices and %u triangles each)\n",
+                report.meshlets,
+                Vulkano::kMaxMeshletVertices,
+                Vulkano::kMaxMeshletTriangles);
+    std::printf("  Size: %llu -> %llu bytes\n",
+                CAST<unsigned long long>(report.bytesBefore),
+                CAST<unsigned long long>(report.bytesAfter));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,1186 @@
+// Author: Jake Rieger
+// Created: 10/18/26.
+//
+
+#include <Vulkano/VulkanContext.hpp>
+#include <Vulkano/Buffer.hpp>
+#include <Vulkano/CommandStateCache.hpp>
+#include <Vulkano/FrameCapture.hpp>
+#include <Vulkano/JobSystem.hpp>
+#include <Vulkano/PipelineCompiler.hpp>
+#include <Vulkano/RenderTarget.hpp>
+#include <Vulkano/ShaderLibrary.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <variant>
+#include <vector>
+
+namespace {
+    using Vulkano::BinaryReader;
+    using Vulkano::Buffer;
+    using Vulkano::CommandStateCache;
+    using Vulkano::ComputePipelineDesc;
+    using Vulkano::f64;
+    using Vulkano::FrameCapture;
+    using Vulkano::GraphicsPipelineDesc;
+    using Vulkano::i32;
+    using Vulkano::i64;
+    using Vulkano::PipelineDesc;
+    using Vulkano::RenderTarget;
+    using Vulkano::Result;
+    using Vulkano::u32;
+    using Vulkano::u64;
+    using Vulkano::u8;
+    using Vulkano::VulkanContext;
+
+    using Clock      = std::chrono::steady_clock;
+    using Command    = FrameCapture::Command;
+    using Record     = FrameCapture::Record;
+    using ResourceId = FrameCapture::ResourceId;
+
+    struct Options {
+        const char* path {nullptr};
+        u32 loops {10};
+        bool paced {false};     // Submit at the captured offsets instead of back to back
+        bool perFrame {false};  // Print every frame, not just the summary
+    };
+
+    struct TargetRecord {
+        VkExtent2D extent {0, 0};
+        u32 layers {1};
+        VkFormat colorFormat {VK_FORMAT_UNDEFINED};
+        VkFormat depthFormat {VK_FORMAT_UNDEFINED};
+        bool multiview {false};
+    };
+
+    struct BufferRecord {
+        VkDeviceSize size {0};
+        VkBufferUsageFlags usage {0};
+        std::vector<u8> data;  // Empty for zeros
+    };
+
+    struct UploadRecord {
+        ResourceId buffer {FrameCapture::kNoResource};
+        VkDeviceSize offset {0};
+        std::vector<u8> data;
+    };
+
+    struct SubmitRecord {
+        i64 time {0};
+        std::vector<UploadRecord> uploads;
+        std::vector<std::vector<u8>> streams;  // One per command buffer
+    };
+
+    struct FrameRecord {
+        i64 time {0};
+        std::vector<SubmitRecord> submits;
+    };
+
+    struct LayoutRecord {
+        std::string name;
+        std::vector<VkPushConstantRange> ranges;
+    };
+
+    struct ShaderRecord {
+        std::string name;
+        std::vector<u32> code;
+    };
+
+    /// @brief Everything in a capture file, parsed up front so replay never touches the file. Resources created
+    /// mid-capture are created before the first frame; a target resized mid-capture replays at its last size.
+    struct Capture {
+        std::string device;
+        std::vector<ShaderRecord> shaders;
+        std::vector<LayoutRecord> layouts;
+        std::unordered_map<ResourceId, PipelineDesc> pipelines;
+        std::unordered_map<ResourceId, BufferRecord> buffers;
+        std::unordered_map<ResourceId, TargetRecord> targets;
+        std::vector<FrameRecord> frames;
+        u64 streamBytes {0};
+    };
+
+    struct FrameTiming {
+        bool executed {false};  // Frames without submits have nothing to time
+        f64 cpuMs {0.0};        // First submit to fence
+        f64 gpuMs {-1.0};       // Negative without timestamps
+    };
+
+    Result<Capture> LoadCapture(const char* path) {
+        auto bytes = BinaryReader::LoadFile(path);
+        if (!bytes) { return std::unexpected(bytes.error()); }
+
+        const std::string corrupt = std::string("Frame capture is truncated/corrupt: ") + path;
+        BinaryReader reader(*bytes);
+        u32 magic   = 0;
+        u32 version = 0;
+        if (!reader.Read(magic) || magic != FrameCapture::kMagic) {
+            return std::unexpected(std::string("Not a frame capture: ") + path);
+        }
+        if (!reader.Read(version) || version != FrameCapture::kVersion) {
+            return std::unexpected(std::string("Unsupported frame capture version: ") + path);
+        }
+
+        Capture capture;
+        reader.ReadString(capture.device);
+
+        bool ended = false;
+        while (!ended && !reader.HasFailed()) {
+            Record record {};
+            if (!reader.Read(record)) { break; }
+
+            switch (record) {
+                case Record::Shader: {
+                    auto& shader = capture.shaders.emplace_back();
+                    reader.ReadString(shader.name);
+                    reader.ReadVector(shader.code);
+                    break;
+                }
+                case Record::Layout: {
+                    auto& layout = capture.layouts.emplace_back();
+                    reader.ReadString(layout.name);
+                    reader.ReadVector(layout.ranges);
+                    break;
+                }
+                case Record::Pipeline: {
+                    ResourceId id                   = FrameCapture::kNoResource;
+                    FrameCapture::PipelineKind kind = {};
+                    reader.Read(id);
+                    reader.Read(kind);
+
+                    PipelineDesc desc;
+                    bool valid = false;
+                    if (kind == FrameCapture::PipelineKind::Graphics) {
+                        valid = desc.emplace<GraphicsPipelineDesc>().Deserialize(reader);
+                    } else if (kind == FrameCapture::PipelineKind::Compute) {
+                        valid = desc.emplace<ComputePipelineDesc>().Deserialize(reader);
+                    }
+                    if (!valid) { return std::unexpected(corrupt); }
+                    capture.pipelines[id] = std::move(desc);
+                    break;
+                }
+                case Record::Buffer: {
+                    ResourceId id = FrameCapture::kNoResource;
+                    BufferRecord buffer;
+                    reader.Read(id);
+                    reader.Read(buffer.size);
+                    reader.Read(buffer.usage);
+                    reader.ReadVector(buffer.data);
+                    capture.buffers[id] = std::move(buffer);
+                    break;
+                }
+                case Record::Target: {
+                    ResourceId id = FrameCapture::kNoResource;
+                    TargetRecord target;
+                    u8 multiview = 0;
+                    reader.Read(id);
+                    reader.Read(target.extent);
+                    reader.Read(target.layers);
+                    reader.Read(target.colorFormat);
+                    reader.Read(target.depthFormat);
+                    reader.Read(multiview);
+                    target.multiview    = multiview != 0;
+                    capture.targets[id] = target;
+                    break;
+                }
+                case Record::Frame: {
+                    reader.Read(capture.frames.emplace_back().time);
+                    break;
+                }
+                case Record::Submit: {
+                    if (capture.frames.empty()) { return std::unexpected(corrupt); }
+
+                    FrameCapture::QueueKind queue = {};
+                    SubmitRecord submit;
+                    reader.Read(queue);
+                    reader.Read(submit.time);
+
+                    u32 uploadCount = 0;
+                    reader.Read(uploadCount);
+                    for (u32 i = 0; i < uploadCount && !reader.HasFailed(); i++) {
+                        auto& upload = submit.uploads.emplace_back();
+                        reader.Read(upload.buffer);
+                        reader.Read(upload.offset);
+                        reader.ReadVector(upload.data);
+                    }
+
+                    u32 streamCount = 0;
+                    reader.Read(streamCount);
+                    for (u32 i = 0; i < streamCount && !reader.HasFailed(); i++) {
+                        reader.ReadVector(submit.streams.emplace_back());
+                        capture.streamBytes += submit.streams.back().size();
+                    }
+                    capture.frames.back().submits.push_back(std::move(submit));
+                    break;
+                }
+                case Record::End: {
+                    ended = true;
+                    break;
+                }
+                default:
+                    return std::unexpected(corrupt);
+            }
+        }
+
+        if (!ended || reader.HasFailed()) { return std::unexpected(corrupt); }
+        return capture;
+    }
+
+    /// @brief Rebuilds a capture's resources on this device, records every submit once and re-executes them
+    class Replayer {
+    public:
+        explicit Replayer(VulkanContext& context) : mContext(context), mStateCache(context) {}
+
+        ~Replayer() {
+            Shutdown();
+        }
+
+        Replayer(const Replayer&)            = delete;
+        Replayer& operator=(const Replayer&) = delete;
+
+        /// @brief Create shaders, layouts, pipelines, buffers (with their captured contents) and render targets
+        Result<void> CreateResources(const Capture& capture);
+
+        /// @brief Record the command buffers of every submit, with the uploads attached to it
+        Result<void> RecordCommands(const Capture& capture);
+
+        /// @brief Execute every frame once, waiting for each to finish before the next
+        /// @param paced Hold each submit back until its captured offset from the first frame
+        Result<void> Run(const Capture& capture, bool paced, std::vector<FrameTiming>& timings);
+
+        void Shutdown();
+
+        V_ND f64 GetCompileMs() const {
+            return mCompileMs;
+        }
+
+        V_ND u32 GetSkippedCommands() const {
+            return mSkipped;
+        }
+
+        V_ND u32 GetMissingPipelines() const {
+            return mMissingPipelines;
+        }
+
+        V_ND bool HasTimestamps() const {
+            return mQueries != VK_NULL_HANDLE;
+        }
+
+    private:
+        struct Pipeline {
+            VkPipeline pipeline {VK_NULL_HANDLE};
+            GraphicsPipelineDesc graphics;  // Dynamic state to apply on bind
+            bool isGraphics {false};
+        };
+
+        struct RecordedSubmit {
+            std::vector<VkCommandBuffer> commandBuffers;
+        };
+
+        /// @brief Bound pipelines and pass of the command buffer being decoded
+        struct DecodeState {
+            bool graphicsBound {false};
+            bool computeBound {false};
+            RenderTarget* target {nullptr};
+        };
+
+        Result<void> CreateLayouts(const Capture& capture);
+        Result<void> CreatePipelines(const Capture& capture);
+        Result<void> CreateBuffers(const Capture& capture);
+        Result<void> CreateTargets(const Capture& capture);
+
+        /// @brief Record and run a command buffer immediately (setup work)
+        Result<void> SubmitNow(const std::function<void(VkCommandBuffer)>& record);
+
+        /// @brief Copy a submit's uploads into a staging buffer and record their copies
+        Result<void> RecordUploads(VkCommandBuffer commandBuffer, const std::vector<UploadRecord>& uploads);
+
+        /// @brief Decode one command buffer stream into the command buffer
+        Result<void> Decode(VkCommandBuffer commandBuffer, const std::vector<u8>& stream, DecodeState& state);
+
+        V_ND Buffer* FindBuffer(ResourceId id) const;
+
+        VulkanContext& mContext;
+        Vulkano::JobSystem mJobs;
+        Vulkano::ShaderLibrary mShaders;
+        Vulkano::PipelineCompiler mCompiler;
+        CommandStateCache mStateCache;
+
+        std::vector<VkPipelineLayout> mLayouts;       // Capture order; PushConstants refer to these by index
+        std::vector<VkPipelineLayout> mExtraLayouts;  // Empty stand-ins for layouts the capture didn't describe
+        std::unordered_map<ResourceId, Pipeline> mPipelines;
+        std::unordered_map<ResourceId, std::unique_ptr<Buffer>> mBuffers;
+        std::unordered_map<ResourceId, std::unique_ptr<RenderTarget>> mTargets;
+        std::vector<std::unique_ptr<Buffer>> mStaging;  // Per-submit uploads, kept for every loop
+
+        VkCommandPool mPool {VK_NULL_HANDLE};
+        VkQueryPool mQueries {VK_NULL_HANDLE};
+        VkFence mFence {VK_NULL_HANDLE};
+        std::vector<std::vector<RecordedSubmit>> mFrames;
+
+        f64 mCompileMs {0.0};
+        u32 mSkipped {0};
+        u32 mMissingPipelines {0};
+    };
+
+    Result<void> Replayer::CreateResources(const Capture& capture) {
+        if (auto result = mJobs.Initialize(); !result) { return result; }
+
+        for (const auto& shader : capture.shaders) {
+            if (auto result = mShaders.Add(shader.name, shader.code); !result) { return result; }
+        }
+        if (auto result = mShaders.Initialize(&mContext); !result) { return result; }
+        if (auto result = mCompiler.Initialize(&mContext, &mJobs, &mShaders); !result) { return result; }
+
+        const VkDevice device = mContext.GetDevice();
+
+        VkCommandPoolCreateInfo poolInfo {};
+        poolInfo.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.queueFamilyIndex = mContext.GetQueueFamilies().graphicsFamily;
+        if (vkCreateCommandPool(device, &poolInfo, nullptr, &mPool) != VK_SUCCESS) {
+            return std::unexpected("Failed to create command pool");
+        }
+
+        VkFenceCreateInfo fenceInfo {};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        if (vkCreateFence(device, &fenceInfo, nullptr, &mFence) != VK_SUCCESS) {
+            return std::unexpected("Failed to create fence");
+        }
+
+        // Two timestamps per frame; without them only CPU times are reported
+        if (mContext.GetDeviceProperties().limits.timestampComputeAndGraphics && !capture.frames.empty()) {
+            VkQueryPoolCreateInfo queryInfo {};
+            queryInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+            queryInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+            queryInfo.queryCount = CAST<u32>(capture.frames.size()) * 2;
+            if (vkCreateQueryPool(device, &queryInfo, nullptr, &mQueries) != VK_SUCCESS) { mQueries = VK_NULL_HANDLE; }
+        }
+
+        if (auto result = CreateLayouts(capture); !result) { return result; }
+        if (auto result = CreatePipelines(capture); !result) { return result; }
+        if (auto result = CreateBuffers(capture); !result) { return result; }
+        return CreateTargets(capture);
+    }
+
+    Result<void> Replayer::CreateLayouts(const Capture& capture) {
+        const VkDevice device = mContext.GetDevice();
+        std::unordered_set<std::string> known;
+
+        const auto createLayout = [device](const std::vector<VkPushConstantRange>& ranges) -> Result<VkPipelineLayout> {
+            VkPipelineLayoutCreateInfo layoutInfo {};
+            layoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            layoutInfo.pushConstantRangeCount = CAST<u32>(ranges.size());
+            layoutInfo.pPushConstantRanges    = ranges.data();
+            VkPipelineLayout layout           = VK_NULL_HANDLE;
+            if (vkCreatePipelineLayout(device, &layoutInfo, nullptr, &layout) != VK_SUCCESS) {
+                return std::unexpected("Failed to create pipeline layout");
+            }
+            return layout;
+        };
+
+        for (const auto& record : capture.layouts) {
+            auto layout = createLayout(record.ranges);
+            if (!layout) { return std::unexpected(layout.error()); }
+            mLayouts.push_back(*layout);
+            if (known.insert(record.name).second) { mCompiler.RegisterLayout(record.name, *layout); }
+        }
+
+        // Pipelines whose layout was never registered with the capture get one without push constants
+        for (const auto& desc : capture.pipelines | std::views::values) {
+            const std::string& name = std::visit([](const auto& d) -> const std::string& { return d.layout; }, desc);
+            if (!known.insert(name).second) { continue; }
+
+            std::fprintf(stderr, "Layout '%s' wasn't captured; replaying it without push constants\n", name.c_str());
+            auto layout = createLayout({});
+            if (!layout) { return std::unexpected(layout.error()); }
+            mExtraLayouts.push_back(*layout);
+            mCompiler.RegisterLayout(name, *layout);
+        }
+
+        return {};
+    }
+
+    Result<void> Replayer::CreatePipelines(const Capture& capture) {
+        const bool multiview = mContext.GetCapabilities().multiview;
+        const auto start     = Clock::now();
+
+        // Queue everything so the job system compiles in parallel, then collect
+        std::vector<std::pair<ResourceId, PipelineDesc>> descs;
+        for (const auto& [id, captured] : capture.pipelines) {
+            PipelineDesc desc = captured;
+            if (auto* graphics = std::get_if<GraphicsPipelineDesc>(&desc)) {
+                if (!multiview) { graphics->viewMask = 0; }
+                mCompiler.CompileAsync(*graphics);
+            } else {
+                mCompiler.CompileAsync(std::get<ComputePipelineDesc>(desc));
+            }
+            descs.emplace_back(id, std::move(desc));
+        }
+
+        for (const auto& [id, desc] : descs) {
+            Pipeline pipeline;
+            Result<VkPipeline> result = std::unexpected("");
+            if (const auto* graphics = std::get_if<GraphicsPipelineDesc>(&desc)) {
+                result              = mCompiler.Get(*graphics);
+                pipeline.graphics   = *graphics;
+                pipeline.isGraphics = true;
+            } else {
+                result = mCompiler.Get(std::get<ComputePipelineDesc>(desc));
+            }
+
+            // Draws using it are skipped rather than failing the whole replay
+            if (!result) {
+                std::fprintf(stderr, "Pipeline %u failed to build: %s\n", id, result.error().c_str());
+                mMissingPipelines++;
+                continue;
+            }
+            pipeline.pipeline = *result;
+            mPipelines.emplace(id, std::move(pipeline));
+        }
+
+        mCompileMs = std::chrono::duration<f64, std::milli>(Clock::now() - start).count();
+        return {};
+    }
+
+    Result<void> Replayer::CreateBuffers(const Capture& capture) {
+        std::vector<std::unique_ptr<Buffer>> staging;
+        for (const auto& [id, record] : capture.buffers) {
+            auto buffer = std::make_unique<Buffer>();
+            Buffer::Config config;
+            config.size  = record.size;
+            config.usage = record.usage | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+            if (auto result = buffer->Initialize(&mContext, config); !result) { return result; }
+
+            if (!record.data.empty()) {
+                auto& upload = staging.emplace_back(std::make_unique<Buffer>());
+                Buffer::Config uploadConfig;
+                uploadConfig.size        = record.data.size();
+                uploadConfig.usage       = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+                uploadConfig.hostVisible = true;
+                if (auto result = upload->Initialize(&mContext, uploadConfig); !result) { return result; }
+                std::memcpy(upload->GetMapped(), record.data.data(), record.data.size());
+            }
+            mBuffers.emplace(id, std::move(buffer));
+        }
+
+        // Captured contents in one go; buffers captured as zeros are filled
+        return SubmitNow([&](VkCommandBuffer commandBuffer) {
+            size_t next = 0;
+            for (const auto& [id, record] : capture.buffers) {
+                const VkBuffer buffer = mBuffers.at(id)->GetBuffer();
+                if (record.data.empty()) {
+                    vkCmdFillBuffer(commandBuffer, buffer, 0, VK_WHOLE_SIZE, 0);
+                    continue;
+                }
+                const VkBufferCopy region {0, 0, record.data.size()};
+                vkCmdCopyBuffer(commandBuffer, staging[next++]->GetBuffer(), buffer, 1, &region);
+            }
+        });
+    }
+
+    Result<void> Replayer::CreateTargets(const Capture& capture) {
+        const bool multiview = mContext.GetCapabilities().multiview;
+        for (const auto& [id, record] : capture.targets) {
+            RenderTarget::Config config;
+            config.extent      = record.extent;
+            config.layers      = record.layers;
+            config.colorFormat = record.colorFormat;
+            config.depthFormat = record.depthFormat;
+            config.multiview   = record.multiview && multiview;
+
+            auto target = std::make_unique<RenderTarget>();
+            if (auto result = target->Initialize(&mContext, config); !result) { return result; }
+            mTargets.emplace(id, std::move(target));
+        }
+
+        return {};
+    }
+
+    Result<void> Replayer::RecordCommands(const Capture& capture) {
+        const VkDevice device = mContext.GetDevice();
+
+        for (u32 frameIndex = 0; frameIndex < capture.frames.size(); frameIndex++) {
+            const FrameRecord& frame = capture.frames[frameIndex];
+            auto& recorded           = mFrames.emplace_back();
+
+            for (u32 submitIndex = 0; submitIndex < frame.submits.size(); submitIndex++) {
+                const SubmitRecord& submit = frame.submits[submitIndex];
+                const bool firstSubmit     = submitIndex == 0;
+                const bool lastSubmit      = submitIndex + 1 == frame.submits.size();
+
+                // Uploads and timestamps need a command buffer even when the submit had none
+                const auto count = std::max(CAST<u32>(submit.streams.size()), 1u);
+                RecordedSubmit& out = recorded.emplace_back();
+                out.commandBuffers.resize(count);
+
+                VkCommandBufferAllocateInfo allocateInfo {};
+                allocateInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+                allocateInfo.commandPool        = mPool;
+                allocateInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                allocateInfo.commandBufferCount = count;
+                if (vkAllocateCommandBuffers(device, &allocateInfo, out.commandBuffers.data()) != VK_SUCCESS) {
+                    return std::unexpected("Failed to allocate command buffers");
+                }
+
+                for (u32 i = 0; i < count; i++) {
+                    const VkCommandBuffer commandBuffer = out.commandBuffers[i];
+                    VkCommandBufferBeginInfo beginInfo {};
+                    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+                    if (mQueries && firstSubmit && i == 0) {
+                        vkCmdResetQueryPool(commandBuffer, mQueries, frameIndex * 2, 2);
+                        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, mQueries, frameIndex * 2);
+                    }
+                    if (i == 0 && !submit.uploads.empty()) {
+                        if (auto result = RecordUploads(commandBuffer, submit.uploads); !result) { return result; }
+                    }
+
+                    mStateCache.Begin(commandBuffer);
+                    DecodeState state;
+                    if (i < submit.streams.size()) {
+                        if (auto result = Decode(commandBuffer, submit.streams[i], state); !result) { return result; }
+                    }
+                    if (state.target) { state.target->EndRendering(commandBuffer); }
+
+                    if (mQueries && lastSubmit && i + 1 == count) {
+                        vkCmdWriteTimestamp(commandBuffer,
+                                            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                            mQueries,
+                                            frameIndex * 2 + 1);
+                    }
+                    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+                        return std::unexpected("Failed to record command buffer");
+                    }
+                }
+            }
+        }
+
+        return {};
+    }
+
+    Result<void> Replayer::RecordUploads(VkCommandBuffer commandBuffer, const std::vector<UploadRecord>& uploads) {
+        VkDeviceSize size = 0;
+        for (const auto& upload : uploads) {
+            size += upload.data.size();
+        }
+        if (size == 0) { return {}; }
+
+        auto& staging = mStaging.emplace_back(std::make_unique<Buffer>());
+        Buffer::Config config;
+        config.size        = size;
+        config.usage       = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+        config.hostVisible = true;
+        if (auto result = staging->Initialize(&mContext, config); !result) { return result; }
+
+        auto* mapped        = CAST<u8*>(staging->GetMapped());
+        VkDeviceSize offset = 0;
+        for (const auto& upload : uploads) {
+            const Buffer* buffer = FindBuffer(upload.buffer);
+            if (!buffer || upload.data.empty() || upload.offset + upload.data.size() > buffer->GetSize()) {
+                mSkipped++;
+                continue;
+            }
+            std::memcpy(mapped + offset, upload.data.data(), upload.data.size());
+            const VkBufferCopy region {offset, upload.offset, upload.data.size()};
+            vkCmdCopyBuffer(commandBuffer, staging->GetBuffer(), buffer->GetBuffer(), 1, &region);
+            offset += upload.data.size();
+        }
+
+        VkMemoryBarrier2 barrier {};
+        barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        barrier.srcStageMask  = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+        barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        barrier.dstStageMask  = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+        VkDependencyInfo dependency {};
+        dependency.sType              = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependency.memoryBarrierCount = 1;
+        dependency.pMemoryBarriers    = &barrier;
+        vkCmdPipelineBarrier2(commandBuffer, &dependency);
+
+        return {};
+    }
+
+    Result<void> Replayer::Decode(VkCommandBuffer commandBuffer, const std::vector<u8>& stream, DecodeState& state) {
+        BinaryReader reader(stream);
+        const auto canDraw = [&] {
+            if (state.graphicsBound && state.target) { return true; }
+            mSkipped++;
+            return false;
+        };
+
+        while (!reader.AtEnd() && !reader.HasFailed()) {
+            Command command {};
+            reader.Read(command);
+
+            switch (command) {
+                case Command::BeginRendering: {
+                    ResourceId id = FrameCapture::kNoResource;
+                    VkClearColorValue clearColor {};
+                    u32 layer = RenderTarget::kAllLayers;
+                    reader.Read(id);
+                    reader.Read(clearColor);
+                    reader.Read(layer);
+
+                    const auto it = mTargets.find(id);
+                    if (it == mTargets.end() || state.target) {
+                        mSkipped++;
+                        break;
+                    }
+                    if (layer != RenderTarget::kAllLayers && layer >= it->second->GetLayerCount()) {
+                        layer = RenderTarget::kAllLayers;
+                    }
+                    if (!it->second->BeginRendering(commandBuffer, clearColor, layer)) {
+                        mSkipped++;
+                        break;
+                    }
+                    state.target = it->second.get();
+                    mStateCache.Begin(commandBuffer);  // Same as FrameCapture: the target set viewport and scissor
+                    break;
+                }
+                case Command::EndRendering: {
+                    if (!state.target) {
+                        mSkipped++;
+                        break;
+                    }
+                    state.target->EndRendering(commandBuffer);
+                    state.target = nullptr;
+                    break;
+                }
+                case Command::BindPipeline: {
+                    VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+                    ResourceId id                 = FrameCapture::kNoResource;
+                    reader.Read(bindPoint);
+                    reader.Read(id);
+
+                    const bool graphics = bindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS;
+                    const auto it       = mPipelines.find(id);
+                    (graphics ? state.graphicsBound : state.computeBound) = it != mPipelines.end();
+                    if (it == mPipelines.end()) {
+                        mSkipped++;
+                        break;
+                    }
+
+                    const Pipeline& pipeline = it->second;
+                    mStateCache.BindPipeline(bindPoint,
+                                             pipeline.pipeline,
+                                             pipeline.isGraphics ? pipeline.graphics.dynamicState : 0);
+                    if (pipeline.isGraphics) { mStateCache.ApplyDynamicState(pipeline.graphics); }
+                    break;
+                }
+                case Command::SetViewport: {
+                    VkViewport viewport {};
+                    reader.Read(viewport);
+                    mStateCache.SetViewport(viewport);
+                    break;
+                }
+                case Command::SetScissor: {
+                    VkRect2D scissor {};
+                    reader.Read(scissor);
+                    mStateCache.SetScissor(scissor);
+                    break;
+                }
+                case Command::PushConstants: {
+                    u32 layout                = 0;
+                    VkShaderStageFlags stages = 0;
+                    u32 offset                = 0;
+                    std::vector<u8> data;
+                    reader.Read(layout);
+                    reader.Read(stages);
+                    reader.Read(offset);
+                    reader.ReadVector(data);
+
+                    if (layout >= mLayouts.size() || data.empty()) {
+                        mSkipped++;
+                        break;
+                    }
+                    const auto size = CAST<u32>(data.size());
+                    vkCmdPushConstants(commandBuffer, mLayouts[layout], stages, offset, size, data.data());
+                    break;
+                }
+                case Command::PushBufferAddress: {
+                    u32 layout                = 0;
+                    VkShaderStageFlags stages = 0;
+                    u32 offset                = 0;
+                    ResourceId id             = FrameCapture::kNoResource;
+                    VkDeviceSize bufferOffset = 0;
+                    reader.Read(layout);
+                    reader.Read(stages);
+                    reader.Read(offset);
+                    reader.Read(id);
+                    reader.Read(bufferOffset);
+
+                    const Buffer* buffer = FindBuffer(id);
+                    if (layout >= mLayouts.size() || !buffer || buffer->GetDeviceAddress() == 0) {
+                        mSkipped++;
+                        break;
+                    }
+                    // This device's address for the captured buffer
+                    const VkDeviceAddress address = buffer->GetDeviceAddress() + bufferOffset;
+                    vkCmdPushConstants(commandBuffer, mLayouts[layout], stages, offset, sizeof(address), &address);
+                    break;
+                }
+                case Command::BindVertexBuffer: {
+                    u32 binding         = 0;
+                    ResourceId id       = FrameCapture::kNoResource;
+                    VkDeviceSize offset = 0;
+                    reader.Read(binding);
+                    reader.Read(id);
+                    reader.Read(offset);
+
+                    const Buffer* buffer = FindBuffer(id);
+                    if (!buffer) {
+                        mSkipped++;
+                        break;
+                    }
+                    const VkBuffer handle = buffer->GetBuffer();
+                    vkCmdBindVertexBuffers(commandBuffer, binding, 1, &handle, &offset);
+                    break;
+                }
+                case Command::BindIndexBuffer: {
+                    ResourceId id       = FrameCapture::kNoResource;
+                    VkDeviceSize offset = 0;
+                    VkIndexType type    = VK_INDEX_TYPE_UINT32;
+                    reader.Read(id);
+                    reader.Read(offset);
+                    reader.Read(type);
+
+                    const Buffer* buffer = FindBuffer(id);
+                    if (!buffer) {
+                        mSkipped++;
+                        break;
+                    }
+                    vkCmdBindIndexBuffer(commandBuffer, buffer->GetBuffer(), offset, type);
+                    break;
+                }
+                case Command::Draw: {
+                    u32 args[4] = {};
+                    reader.Read(args);
+                    if (canDraw()) { vkCmdDraw(commandBuffer, args[0], args[1], args[2], args[3]); }
+                    break;
+                }
+                case Command::DrawIndexed: {
+                    u32 indexCount    = 0;
+                    u32 instanceCount = 0;
+                    u32 firstIndex    = 0;
+                    i32 vertexOffset  = 0;
+                    u32 firstInstance = 0;
+                    reader.Read(indexCount);
+                    reader.Read(instanceCount);
+                    reader.Read(firstIndex);
+                    reader.Read(vertexOffset);
+                    reader.Read(firstInstance);
+                    if (canDraw()) {
+                        vkCmdDrawIndexed(commandBuffer,
+                                         indexCount,
+                                         instanceCount,
+                                         firstIndex,
+                                         vertexOffset,
+                                         firstInstance);
+                    }
+                    break;
+                }
+                case Command::DrawIndirect:
+                case Command::DrawIndexedIndirect: {
+                    ResourceId id       = FrameCapture::kNoResource;
+                    VkDeviceSize offset = 0;
+                    u32 drawCount       = 0;
+                    u32 stride          = 0;
+                    reader.Read(id);
+                    reader.Read(offset);
+                    reader.Read(drawCount);
+                    reader.Read(stride);
+
+                    const Buffer* buffer = FindBuffer(id);
+                    if (!buffer || !canDraw()) {
+                        if (!buffer) { mSkipped++; }
+                        break;
+                    }
+                    if (command == Command::DrawIndirect) {
+                        vkCmdDrawIndirect(commandBuffer, buffer->GetBuffer(), offset, drawCount, stride);
+                    } else {
+                        vkCmdDrawIndexedIndirect(commandBuffer, buffer->GetBuffer(), offset, drawCount, stride);
+                    }
+                    break;
+                }
+                case Command::Dispatch: {
+                    u32 groups[3] = {};
+                    reader.Read(groups);
+                    if (!state.computeBound) {
+                        mSkipped++;
+                        break;
+                    }
+                    vkCmdDispatch(commandBuffer, groups[0], groups[1], groups[2]);
+                    break;
+                }
+                case Command::DispatchIndirect: {
+                    ResourceId id       = FrameCapture::kNoResource;
+                    VkDeviceSize offset = 0;
+                    reader.Read(id);
+                    reader.Read(offset);
+
+                    const Buffer* buffer = FindBuffer(id);
+                    if (!buffer || !state.computeBound) {
+                        mSkipped++;
+                        break;
+                    }
+                    vkCmdDispatchIndirect(commandBuffer, buffer->GetBuffer(), offset);
+                    break;
+                }
+                case Command::FillBuffer: {
+                    ResourceId id       = FrameCapture::kNoResource;
+                    VkDeviceSize offset = 0;
+                    VkDeviceSize size   = 0;
+                    u32 value           = 0;
+                    reader.Read(id);
+                    reader.Read(offset);
+                    reader.Read(size);
+                    reader.Read(value);
+
+                    const Buffer* buffer = FindBuffer(id);
+                    if (!buffer || state.target) {
+                        mSkipped++;
+                        break;
+                    }
+                    vkCmdFillBuffer(commandBuffer, buffer->GetBuffer(), offset, size, value);
+                    break;
+                }
+                case Command::CopyBuffer: {
+                    ResourceId sourceId      = FrameCapture::kNoResource;
+                    ResourceId destinationId = FrameCapture::kNoResource;
+                    VkBufferCopy region {};
+                    reader.Read(sourceId);
+                    reader.Read(destinationId);
+                    reader.Read(region);
+
+                    const Buffer* source      = FindBuffer(sourceId);
+                    const Buffer* destination = FindBuffer(destinationId);
+                    if (!source || !destination || state.target) {
+                        mSkipped++;
+                        break;
+                    }
+                    vkCmdCopyBuffer(commandBuffer, source->GetBuffer(), destination->GetBuffer(), 1, &region);
+                    break;
+                }
+                case Command::Barrier: {
+                    VkMemoryBarrier2 barrier {};
+                    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+                    reader.Read(barrier.srcStageMask);
+                    reader.Read(barrier.srcAccessMask);
+                    reader.Read(barrier.dstStageMask);
+                    reader.Read(barrier.dstAccessMask);
+
+                    VkDependencyInfo dependency {};
+                    dependency.sType              = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+                    dependency.memoryBarrierCount = 1;
+                    dependency.pMemoryBarriers    = &barrier;
+                    vkCmdPipelineBarrier2(commandBuffer, &dependency);
+                    break;
+                }
+                default:
+                    return std::unexpected("Unknown command in frame capture stream");
+            }
+        }
+
+        if (reader.HasFailed()) { return std::unexpected("Command stream in frame capture is truncated"); }
+        return {};
+    }
+
+    Result<void> Replayer::Run(const Capture& capture, bool paced, std::vector<FrameTiming>& timings) {
+        const VkDevice device = mContext.GetDevice();
+        const VkQueue queue   = mContext.GetGraphicsQueue();
+        const f64 period      = mContext.GetDeviceProperties().limits.timestampPeriod;
+        const i64 origin      = capture.frames.empty() ? 0 : capture.frames.front().time;
+        const auto start      = Clock::now();
+
+        for (u32 frameIndex = 0; frameIndex < mFrames.size(); frameIndex++) {
+            const auto& submits = mFrames[frameIndex];
+            FrameTiming timing;
+            if (submits.empty()) {
+                timings.push_back(timing);
+                continue;
+            }
+
+            Clock::time_point frameStart {};
+            for (u32 i = 0; i < submits.size(); i++) {
+                if (paced) {
+                    const i64 offset = capture.frames[frameIndex].submits[i].time - origin;
+                    std::this_thread::sleep_until(start + std::chrono::nanoseconds(offset));
+                }
+                if (i == 0) { frameStart = Clock::now(); }
+
+                VkSubmitInfo submitInfo {};
+                submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                submitInfo.commandBufferCount = CAST<u32>(submits[i].commandBuffers.size());
+                submitInfo.pCommandBuffers    = submits[i].commandBuffers.data();
+                const VkFence fence           = i + 1 == submits.size() ? mFence : VK_NULL_HANDLE;
+                if (const VkResult result = vkQueueSubmit(queue, 1, &submitInfo, fence); result != VK_SUCCESS) {
+                    mContext.CheckDeviceLost(result);
+                    return std::unexpected("Failed to submit replayed frame");
+                }
+            }
+
+            const VkResult waitResult = vkWaitForFences(device, 1, &mFence, VK_TRUE, UINT64_MAX);
+            if (waitResult != VK_SUCCESS) {
+                mContext.CheckDeviceLost(waitResult);
+                return std::unexpected("Failed to wait for replayed frame");
+            }
+            vkResetFences(device, 1, &mFence);
+            timing.executed = true;
+            timing.cpuMs    = std::chrono::duration<f64, std::milli>(Clock::now() - frameStart).count();
+
+            u64 timestamps[2] = {};
+            if (mQueries && vkGetQueryPoolResults(device,
+                                                  mQueries,
+                                                  frameIndex * 2,
+                                                  2,
+                                                  sizeof(timestamps),
+                                                  timestamps,
+                                                  sizeof(u64),
+                                                  VK_QUERY_RESULT_64_BIT) == VK_SUCCESS) {
+                timing.gpuMs = CAST<f64>(timestamps[1] - timestamps[0]) * period / 1.0e6;
+            }
+            timings.push_back(timing);
+        }
+
+        return {};
+    }
+
+    Result<void> Replayer::SubmitNow(const std::function<void(VkCommandBuffer)>& record) {
+        const VkDevice device = mContext.GetDevice();
+
+        VkCommandBufferAllocateInfo allocateInfo {};
+        allocateInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocateInfo.commandPool        = mPool;
+        allocateInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocateInfo.commandBufferCount = 1;
+        VkCommandBuffer commandBuffer   = VK_NULL_HANDLE;
+        if (vkAllocateCommandBuffers(device, &allocateInfo, &commandBuffer) != VK_SUCCESS) {
+            return std::unexpected("Failed to allocate command buffer");
+        }
+
+        VkCommandBufferBeginInfo beginInfo {};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        vkBeginCommandBuffer(commandBuffer, &beginInfo);
+        record(commandBuffer);
+        vkEndCommandBuffer(commandBuffer);
+
+        VkSubmitInfo submitInfo {};
+        submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers    = &commandBuffer;
+        VkResult result               = vkQueueSubmit(mContext.GetGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
+        if (result == VK_SUCCESS) { result = vkQueueWaitIdle(mContext.GetGraphicsQueue()); }
+        vkFreeCommandBuffers(device, mPool, 1, &commandBuffer);
+
+        if (result != VK_SUCCESS) {
+            mContext.CheckDeviceLost(result);
+            return std::unexpected("Failed to upload captured buffer contents");
+        }
+        return {};
+    }
+
+    Buffer* Replayer::FindBuffer(ResourceId id) const {
+        const auto it = mBuffers.find(id);
+        return it != mBuffers.end() ? it->second.get() : nullptr;
+    }
+
+    void Replayer::Shutdown() {
+        if (!mContext.IsInitialized() || mContext.GetDevice() == VK_NULL_HANDLE) { return; }
+
+        mContext.WaitIdle();
+        const VkDevice device = mContext.GetDevice();
+
+        mFrames.clear();
+        mStaging.clear();
+        mTargets.clear();
+        mBuffers.clear();
+        mPipelines.clear();
+        mCompiler.Shutdown();
+        for (const VkPipelineLayout layout : mLayouts) {
+            vkDestroyPipelineLayout(device, layout, nullptr);
+        }
+        for (const VkPipelineLayout layout : mExtraLayouts) {
+            vkDestroyPipelineLayout(device, layout, nullptr);
+        }
+        mLayouts.clear();
+        mExtraLayouts.clear();
+        mShaders.Shutdown();
+        mJobs.Shutdown();
+
+        if (mQueries) { vkDestroyQueryPool(device, mQueries, nullptr); }
+        if (mFence) { vkDestroyFence(device, mFence, nullptr); }
+        if (mPool) { vkDestroyCommandPool(device, mPool, nullptr); }
+        mQueries = VK_NULL_HANDLE;
+        mFence   = VK_NULL_HANDLE;
+        mPool    = VK_NULL_HANDLE;
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            if (arg == "--paced") {
+                options.paced = true;
+            } else if (arg == "--per-frame") {
+                options.perFrame = true;
+            } else if (arg == "--loops" && i + 1 < argc) {
+                options.loops = std::max(CAST<u32>(std::strtoul(argv[++i], nullptr, 10)), 1u);
+            } else if (!options.path && arg[0] != '-') {
+                options.path = argv[i];
+            } else {
+                return false;
+            }
+        }
+        return options.path != nullptr;
+    }
+
+    struct Summary {
+        f64 mean {0.0};
+        f64 median {0.0};
+        f64 max {0.0};
+    };
+
+    Summary Summarize(std::vector<f64> samples) {
+        Summary summary;
+        if (samples.empty()) { return summary; }
+
+        std::ranges::sort(samples);
+        for (const f64 sample : samples) {
+            summary.mean += sample;
+        }
+        summary.mean /= CAST<f64>(samples.size());
+        summary.median = samples[samples.size() / 2];
+        summary.max    = samples.back();
+        return summary;
+    }
+
+    void PrintSummary(const char* label, const std::vector<f64>& samples) {
+        if (samples.empty()) {
+            std::printf("%-20s %10s %10s %10s\n", label, "-", "-", "-");
+            return;
+        }
+        const Summary summary = Summarize(samples);
+        std::printf("%-20s %10.3f %10.3f %10.3f\n", label, summary.mean, summary.median, summary.max);
+    }
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "Usage: %s <capture.vcap> [--paced] [--loops N] [--per-frame]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    auto capture = LoadCapture(options.path);
+    if (!capture) {
+        std::fprintf(stderr, "%s\n", capture.error().c_str());
+        return EXIT_FAILURE;
+    }
+
+    VulkanContext context;
+    VulkanContext::Config config;
+    config.instance.applicationName  = "VulkanoReplay";
+    config.instance.enableValidation = false;
+    if (auto result = context.Initialize(config); !result) {
+        std::fprintf(stderr, "%s\n", result.error().c_str());
+        return EXIT_FAILURE;
+    }
+
+    int status = EXIT_SUCCESS;
+    {
+        Replayer replayer(context);
+        const auto recordStart = Clock::now();
+        Result<void> result    = replayer.CreateResources(*capture);
+        if (result) { result = replayer.RecordCommands(*capture); }
+        const f64 setupMs = std::chrono::duration<f64, std::milli>(Clock::now() - recordStart).count();
+
+        // First loop warms caches and clocks and isn't counted
+        std::vector<std::vector<FrameTiming>> loops(options.loops + 1);
+        for (auto& timings : loops) {
+            if (!result) { break; }
+            result = replayer.Run(*capture, options.paced, timings);
+        }
+
+        if (!result) {
+            std::fprintf(stderr, "%s\n", result.error().c_str());
+            status = EXIT_FAILURE;
+        } else {
+            u32 submits = 0;
+            for (const auto& frame : capture->frames) {
+                submits += CAST<u32>(frame.submits.size());
+            }
+            std::vector<f64> intervals;
+            for (size_t i = 1; i < capture->frames.size(); i++) {
+                intervals.push_back(CAST<f64>(capture->frames[i].time - capture->frames[i - 1].time) / 1.0e6);
+            }
+
+            std::printf("Capture: %s (from %s)\n", options.path, capture->device.c_str());
+            std::printf("Replaying on: %s\n", context.GetDeviceProperties().deviceName);
+            std::printf("%zu frames, %u submits, %zu pipelines, %zu buffers, %zu targets, %.1f KiB of commands\n",
+                        capture->frames.size(),
+                        submits,
+                        capture->pipelines.size(),
+                        capture->buffers.size(),
+                        capture->targets.size(),
+                        CAST<f64>(capture->streamBytes) / 1024.0);
+            std::printf("Setup %.1f ms (pipelines %.1f ms)", setupMs, replayer.GetCompileMs());
+            if (replayer.GetMissingPipelines() > 0) {
+                std::printf(", %u pipelines failed", replayer.GetMissingPipelines());
+            }
+            if (replayer.GetSkippedCommands() > 0) {
+                std::printf(", %u commands skipped", replayer.GetSkippedCommands());
+            }
+            std::printf("\n%u loops, %s\n", options.loops, options.paced ? "captured pacing" : "as fast as possible");
+
+            std::vector<f64> cpuSamples;
+            std::vector<f64> gpuSamples;
+            for (size_t loop = 1; loop < loops.size(); loop++) {
+                for (const auto& timing : loops[loop]) {
+                    if (!timing.executed) { continue; }
+                    cpuSamples.push_back(timing.cpuMs);
+                    if (timing.gpuMs >= 0.0) { gpuSamples.push_back(timing.gpuMs); }
+                }
+            }
+            std::printf("%-20s %10s %10s %10s\n", "", "Mean ms", "Median ms", "Max ms");
+            PrintSummary("Captured interval", intervals);
+            PrintSummary("Submit to idle", cpuSamples);
+            PrintSummary("GPU", gpuSamples);
+
+            // Medians across loops, to find the frame that spikes
+            if (options.perFrame) {
+                std::printf("\n%-8s %14s %14s %10s\n", "Frame", "Captured ms", "Submit ms", "GPU ms");
+                for (size_t frame = 0; frame < capture->frames.size(); frame++) {
+                    std::vector<f64> cpu;
+                    std::vector<f64> gpu;
+                    for (size_t loop = 1; loop < loops.size(); loop++) {
+                        const FrameTiming& timing = loops[loop][frame];
+                        if (timing.executed) { cpu.push_back(timing.cpuMs); }
+                        if (timing.gpuMs >= 0.0) { gpu.push_back(timing.gpuMs); }
+                    }
+                    const f64 interval = frame < intervals.size() ? intervals[frame] : 0.0;
+                    std::printf("%-8zu %14.3f %14.3f %10.3f\n",
+                                frame,
+                                interval,
+                                Summarize(cpu).median,
+                                Summarize(gpu).median);
+                }
+            }
+        }
+    }
+
+    context.Shutdown();
+    return status;
+}